@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE aBLAS_allocators
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/allocators.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using namespace aBLAS;
+
+template<class M>
+bool isAligned(M const& m, std::size_t alignment){
+	return reinterpret_cast<std::uintptr_t>(m.storage().data()) % alignment == 0;
+}
+
+//computes C=AB with containers using the allocator types of A,B and C
+template<class MatA, class MatB, class MatC>
+void checkProduct(MatA& A, MatB& B, MatC& C){
+	for(std::size_t i = 0; i != A.size1(); ++i){
+		for(std::size_t k = 0; k != A.size2(); ++k){
+			A(i,k) = i+0.5*k;
+		}
+	}
+	for(std::size_t k = 0; k != B.size1(); ++k){
+		for(std::size_t j = 0; j != B.size2(); ++j){
+			B(k,j) = 0.25*k-j;
+		}
+	}
+	noalias(C) = prod(A,B);
+	C.wait();
+	for(std::size_t i = 0; i != C.size1(); ++i){
+		for(std::size_t j = 0; j != C.size2(); ++j){
+			double result = 0;
+			for(std::size_t k = 0; k != A.size2(); ++k){
+				result += A(i,k)*B(k,j);
+			}
+			BOOST_CHECK_CLOSE(C(i,j), result, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_allocators)
+
+BOOST_AUTO_TEST_CASE( aBLAS_allocators_default ){
+	matrix<double> A(20,10);
+	matrix<double,column_major> B(10,30);
+	matrix<double> C(20,30);
+	BOOST_CHECK(isAligned(A,detail::storage_alignment));
+	BOOST_CHECK(isAligned(B,detail::storage_alignment));
+	checkProduct(A,B,C);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_allocators_hugepage ){
+	typedef hugepage_allocator<double> allocator;
+	//large enough to span several huge pages
+	matrix<double,row_major,allocator> A(512,600);
+	matrix<double,row_major,allocator> B(600,20);
+	matrix<double,row_major,allocator> C(512,20);
+	BOOST_CHECK(isAligned(A,allocator::huge_page_size));
+	BOOST_CHECK(isAligned(B,detail::storage_alignment));
+	checkProduct(A,B,C);
+
+	vector<double,allocator> v(100,1.0);
+	BOOST_CHECK(isAligned(v,detail::storage_alignment));
+	vector<double,allocator> w(v);
+	w.wait();
+	for(std::size_t i = 0; i != 100; ++i){
+		BOOST_CHECK_EQUAL(w(i), 1.0);
+	}
+}
+
+#ifdef ABLAS_USE_NUMA
+BOOST_AUTO_TEST_CASE( aBLAS_allocators_numa ){
+	typedef numa_allocator<double> allocator;
+	allocator alloc(0);
+	matrix<double,row_major,allocator> A(20,10,alloc);
+	matrix<double,row_major,allocator> B(10,30,alloc);
+	matrix<double,row_major,allocator> C(20,30,alloc);
+	BOOST_CHECK_EQUAL(C.get_allocator().node(), 0);
+	BOOST_CHECK(isAligned(A,detail::storage_alignment));
+	checkProduct(A,B,C);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( aBLAS_allocators_arena ){
+	typedef arena_allocator<double> allocator;
+	memory_arena arena(1 << 20);
+	{
+		allocator alloc(arena);
+		matrix<double,row_major,allocator> A(20,10,alloc);
+		matrix<double,column_major,allocator> B(10,30,alloc);
+		matrix<double,row_major,allocator> C(20,30,alloc);
+		BOOST_CHECK(isAligned(A,detail::storage_alignment));
+		BOOST_CHECK(isAligned(B,detail::storage_alignment));
+		BOOST_CHECK(isAligned(C,detail::storage_alignment));
+		BOOST_CHECK(arena.used() >= (20*10+10*30+20*30)*sizeof(double));
+		checkProduct(A,B,C);
+
+		//copies and resized containers stay in the arena
+		matrix<double,row_major,allocator> D(C);
+		BOOST_CHECK(D.get_allocator() == alloc);
+		D.resize(5,5);
+		BOOST_CHECK(D.get_allocator() == alloc);
+	}
+	arena.reset();
+	BOOST_CHECK_EQUAL(arena.used(), 0u);
+
+	memory_arena small(64);
+	allocator alloc(small);
+	BOOST_CHECK_THROW((vector<double,allocator>(100,alloc)), std::bad_alloc);
+	BOOST_CHECK_EQUAL(small.used(), 0u);
+}
+
+//requests which do not fit never make requests which fit fail
+BOOST_AUTO_TEST_CASE( aBLAS_allocators_arena_concurrent ){
+	std::size_t const block = detail::storage_alignment;
+	std::size_t const blocks = 1000;
+	memory_arena arena(blocks * block);
+	std::atomic<bool> done(false);
+	std::atomic<std::size_t> failed(0);
+	std::thread large([&](){
+		while(!done){
+			try{
+				arena.allocate(arena.capacity() + block);
+			}catch(std::bad_alloc const&){}
+		}
+	});
+	for(std::size_t i = 0; i != blocks; ++i){
+		try{
+			arena.allocate(block);
+		}catch(std::bad_alloc const&){
+			++failed;
+		}
+		std::this_thread::yield();
+	}
+	done = true;
+	large.join();
+	BOOST_CHECK_EQUAL(failed.load(), 0u);
+	BOOST_CHECK_EQUAL(arena.used(), blocks * block);
+	BOOST_CHECK_THROW(arena.allocate(1), std::bad_alloc);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
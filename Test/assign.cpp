@@ -6,6 +6,7 @@
 #include <aBLAS/kernels/matrix_assign.hpp>
 #include <aBLAS/vector.hpp>
 #include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
 
 
 using namespace aBLAS;
@@ -77,6 +78,38 @@ BOOST_AUTO_TEST_CASE( aBLAS_assign_vector_dense ){
 	}
 }
 
+//floating point vectors with stride, as they are handed to the level 1 bindings
+BOOST_AUTO_TEST_CASE( aBLAS_assign_vector_strided ){
+	std::cout<<"testing strided vector assignment"<<std::endl;
+	matrix<double,row_major> storage(10,3,-1.0);
+	matrix_column<matrix<double,row_major> > target(storage,1);
+	vector<double> source(10);
+	vector<double> result(10);
+	for(std::size_t i = 0; i != 10; ++i){
+		source(i) = 0.5*i-1;
+	}
+
+	kernels::assign<scalar_assign>(target,source,1.0);
+	checkVectorEqual(target,source);
+	kernels::assign<scalar_assign>(target,source,3.0);
+	for(std::size_t i = 0; i != 10; ++i){
+		result(i) = 3*source(i);
+	}
+	checkVectorEqual(target,result);
+	kernels::assign<scalar_plus_assign>(target,source,-2.0);
+	checkVectorEqual(target,source);
+	kernels::assign<scalar_multiply_assign>(target,4.0);
+	for(std::size_t i = 0; i != 10; ++i){
+		result(i) = 4*source(i);
+	}
+	checkVectorEqual(target,result);
+	//the other columns are untouched
+	for(std::size_t i = 0; i != 10; ++i){
+		BOOST_CHECK_EQUAL(storage(i,0),-1.0);
+		BOOST_CHECK_EQUAL(storage(i,2),-1.0);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( aBLAS_assign_matrix_dense ){
 	std::cout<<"testing dense matrix assignment"<<std::endl;
 	matrix<unsigned int,row_major> source_rm(10,20);
@@ -225,4 +258,64 @@ BOOST_AUTO_TEST_CASE( aBLAS_assign_matrix_dense ){
 
 
 
+//whole matrices and ranges of whole major lines are assigned as a single vector
+BOOST_AUTO_TEST_CASE( aBLAS_assign_matrix_contiguous ){
+	matrix<unsigned int,row_major> source_rm(10,20);
+	matrix<unsigned int,column_major> source_cm(10,20);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 20; ++j){
+			source_rm(i,j) = source_cm(i,j) = 2*i+j+1;
+		}
+	}
+	BOOST_CHECK(bindings::traits::is_contiguous(source_rm));
+	BOOST_CHECK(bindings::traits::is_contiguous(source_cm));
+	BOOST_CHECK(bindings::traits::is_contiguous(rows(source_rm,2,7)));
+	BOOST_CHECK(bindings::traits::is_contiguous(columns(source_cm,3,9)));
+	BOOST_CHECK(!bindings::traits::is_contiguous(columns(source_rm,3,9)));
+	BOOST_CHECK(!bindings::traits::is_contiguous(subrange(source_cm,1,5,3,9)));
+	//a single line only needs unit stride
+	BOOST_CHECK(bindings::traits::is_contiguous(subrange(source_rm,4,5,3,9)));
+
+	{
+		matrix<unsigned int,row_major> target(10,20,1);
+		kernels::assign<scalar_plus_assign>(target,source_rm,2);
+		auto target_rows = rows(target,2,7);
+		kernels::assign<scalar_assign>(target_rows,rows(source_rm,3,8),3);
+		for(std::size_t i = 0; i != 10; ++i){
+			for(std::size_t j = 0; j != 20; ++j){
+				unsigned int result = (i >= 2 && i < 7)? 3*source_rm(i+1,j): 1+2*source_rm(i,j);
+				BOOST_CHECK_EQUAL(target(i,j), result);
+			}
+		}
+	}
+	{
+		matrix<unsigned int,column_major> target(10,20,1);
+		auto target_columns = columns(target,3,9);
+		kernels::assign<scalar_assign>(target_columns,columns(source_cm,3,9),1);
+		//not contiguous
+		auto target_block = subrange(target,1,5,10,15);
+		kernels::assign<scalar_plus_assign>(target_block,subrange(source_cm,1,5,10,15),1);
+		for(std::size_t i = 0; i != 10; ++i){
+			for(std::size_t j = 0; j != 20; ++j){
+				unsigned int result = 1;
+				if(j >= 3 && j < 9)
+					result = source_cm(i,j);
+				if(i >= 1 && i < 5 && j >= 10 && j < 15)
+					result += source_cm(i,j);
+				BOOST_CHECK_EQUAL(target(i,j), result);
+			}
+		}
+	}
+	//ranges of major lines
+	{
+		matrix<unsigned int,row_major> target(10,20,1);
+		kernels::assign<scalar_assign>(target,source_rm,1,4,6);
+		for(std::size_t i = 0; i != 10; ++i){
+			for(std::size_t j = 0; j != 20; ++j){
+				BOOST_CHECK_EQUAL(target(i,j), (i >= 4 && i < 6)? source_rm(i,j): 1u);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+#define BOOST_TEST_MODULE aBLAS_cblas_split
+//pretend that cblas only takes sizes up to 7, so that the bindings split the products
+#define ABLAS_CBLAS_MAX_INDEX 7
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/kernels/gemm.hpp>
+#include <aBLAS/kernels/gemv.hpp>
+#include <aBLAS/kernels/ger.hpp>
+#include <aBLAS/kernels/dot.hpp>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + i - 0.5*j;
+		}
+	}
+}
+
+template<class Arg1, class Arg2, class Result>
+void checkMatrixMatrixMultiply(Arg1 const& arg1, Arg2 const& arg2, Result const& result, double factor, double init){
+	BOOST_REQUIRE_EQUAL(arg1.size1(), result.size1());
+	BOOST_REQUIRE_EQUAL(arg2.size2(), result.size2());
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			double test_result = init;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += factor * arg1(i,k)*arg2(k,j);
+			}
+			BOOST_CHECK_CLOSE(result(i,j), test_result,1.e-10);
+		}
+	}
+}
+
+struct BindingFixture{
+	//all sizes use the bindings
+	BindingFixture():previous(kernels::tuning()){
+		kernels::tuning().gemm_binding_min_size = 0;
+		kernels::tuning().gemm_thin_inner_binding_min_size = 0;
+		kernels::tuning().gemm_thin_outer_binding_min_size = 0;
+		kernels::tuning().gemv_binding_min_size = 0;
+		kernels::tuning().gemv_tall_binding_min_size = 0;
+		kernels::tuning().gemv_wide_binding_min_size = 0;
+		kernels::tuning().vector_binding_min_size = 0;
+	}
+	~BindingFixture(){
+		kernels::tuning() = previous;
+	}
+	kernels::tuning_parameters previous;
+};
+
+BOOST_FIXTURE_TEST_SUITE (aBLAS_cblas_split, BindingFixture)
+
+BOOST_AUTO_TEST_CASE( aBLAS_cblas_split_gemm ){
+	//m and n are split, the leading dimensions fit
+	matrix<double,row_major> A(20,5);
+	matrix<double,row_major> B(5,6);
+	matrix<double,column_major> C(20,6,1.5);
+	fillMatrix(A,1.0);
+	fillMatrix(B,-2.0);
+	kernels::gemm(A,B,C,2.0,-1.0);
+	checkMatrixMatrixMultiply(A,B,C,2.0,-1.5);
+
+	matrix<double,column_major> At(6,17);
+	matrix<double,column_major> Bt(17,19);
+	matrix<double,column_major> Ct(6,19,1.0);
+	fillMatrix(At,0.5);
+	fillMatrix(Bt,1.0);
+	kernels::gemm(At,Bt,Ct,-1.0,0.0);
+	checkMatrixMatrixMultiply(At,Bt,Ct,-1.0,0.0);
+
+	//k is split and accumulated
+	matrix<double,column_major> Ak(6,20);
+	matrix<double,row_major> Bk(20,6);
+	matrix<double,row_major> Ck(6,6,2.0);
+	fillMatrix(Ak,1.0);
+	fillMatrix(Bk,-1.0);
+	kernels::gemm(Ak,Bk,Ck,1.0,3.0);
+	checkMatrixMatrixMultiply(Ak,Bk,Ck,1.0,6.0);
+
+	//leading dimension too large for cblas, the default kernel is used
+	matrix<double,row_major> D(4,30,0.0);
+	matrix<double,row_major> Ad(4,3);
+	matrix<double,column_major> Bd(3,30);
+	fillMatrix(Ad,1.0);
+	fillMatrix(Bd,2.0);
+	kernels::gemm(Ad,Bd,D,1.0,0.0);
+	checkMatrixMatrixMultiply(Ad,Bd,D,1.0,0.0);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_cblas_split_gemv ){
+	matrix<double,column_major> A(7,25);
+	fillMatrix(A,1.0);
+	vector<double> x(25);
+	for(std::size_t j = 0; j != 25; ++j)
+		x(j) = 0.5*j - 2;
+	vector<double> y(7,1.0);
+	kernels::gemv(A,x,y,2.0,-1.0);
+	for(std::size_t i = 0; i != 7; ++i){
+		double result = -1.0;
+		for(std::size_t j = 0; j != 25; ++j)
+			result += 2*A(i,j)*x(j);
+		BOOST_CHECK_CLOSE(y(i), result, 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_cblas_split_vector ){
+	std::size_t size = 30;
+	vector<double> x(size);
+	vector<double> y(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 1.0 + i;
+		y(i) = 2.0 - 0.5*i;
+	}
+	double result = 0;
+	kernels::dot(x,y,result);
+	double test_result = 0;
+	for(std::size_t i = 0; i != size; ++i)
+		test_result += x(i)*y(i);
+	BOOST_CHECK_CLOSE(result, test_result, 1.e-10);
+
+	vector<double> z(size,-1.0);
+	kernels::assign<scalar_assign>(z,x,3.0);
+	kernels::assign<scalar_plus_assign>(z,y,2.0);
+	kernels::assign<scalar_multiply_assign>(z,0.5);
+	for(std::size_t i = 0; i != size; ++i)
+		BOOST_CHECK_CLOSE(z(i), 0.5*(3*x(i)+2*y(i)), 1.e-10);
+
+	//rank one update of a matrix with leading dimension 7
+	vector<double> u(7);
+	for(std::size_t i = 0; i != 7; ++i)
+		u(i) = i - 3.0;
+	matrix<double,column_major> A(7,size,1.0);
+	kernels::ger(u,x,A,2.0);
+	for(std::size_t i = 0; i != 7; ++i)
+		for(std::size_t j = 0; j != size; ++j)
+			BOOST_CHECK_CLOSE(A(i,j), 1+2*u(i)*x(j), 1.e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+#define BOOST_TEST_MODULE aBLAS_elementwise
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + 0.1*i - 0.05*j;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_elementwise)
+
+BOOST_AUTO_TEST_CASE( aBLAS_elementwise_vector_unary ){
+	std::size_t size = 103;
+	vector<double> x(size);
+	vector<double> y(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 0.1 + 0.02*i;
+		y(i) = 1.5 - 0.03*i;
+	}
+	vector<double> r1 = exp(x);
+	vector<double> r2 = log(x);
+	vector<double> r3 = sqrt(x);
+	vector<double> r4 = abs(y);
+	vector<double> r5 = tanh(y);
+	vector<double> r6 = sqr(y);
+	vector<double> r7 = pow(x,3.0);
+	vector<double> r8 = max(y,0.0);
+	vector<double> r9 = min(y,0.5);
+	//the whole expression is computed in one pass
+	vector<double> r10 = 2*exp(x-y) + sin(y);
+	r1.wait();
+	r2.wait();
+	r3.wait();
+	r4.wait();
+	r5.wait();
+	r6.wait();
+	r7.wait();
+	r8.wait();
+	r9.wait();
+	r10.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_CLOSE(r1(i), std::exp(x(i)), 1.e-10);
+		BOOST_CHECK_CLOSE(r2(i), std::log(x(i)), 1.e-10);
+		BOOST_CHECK_CLOSE(r3(i), std::sqrt(x(i)), 1.e-10);
+		BOOST_CHECK_EQUAL(r4(i), std::abs(y(i)));
+		BOOST_CHECK_CLOSE(r5(i), std::tanh(y(i)), 1.e-10);
+		BOOST_CHECK_CLOSE(r6(i), y(i)*y(i), 1.e-10);
+		BOOST_CHECK_CLOSE(r7(i), x(i)*x(i)*x(i), 1.e-10);
+		BOOST_CHECK_EQUAL(r8(i), std::max(y(i),0.0));
+		BOOST_CHECK_EQUAL(r9(i), std::min(y(i),0.5));
+		BOOST_CHECK_CLOSE(r10(i), 2*std::exp(x(i)-y(i)) + std::sin(y(i)), 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_elementwise_vector_binary ){
+	std::size_t size = 57;
+	vector<double> x(size);
+	vector<double> y(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 1.0 + i;
+		y(i) = (i % 3 == 0)? 0.0 : 2.0 - 0.1*i;
+	}
+	vector<double> prod_xy = element_prod(x,y);
+	vector<double> div_xy = element_div(x,y+1.0);
+	vector<double> safe_xy = safe_div(x,y,-1.0);
+	vector<double> max_xy = max(x,y);
+	vector<double> min_xy = min(x,y);
+	vector<double> pow_xy = pow(x,y);
+	vector<double> z(size,1.0);
+	noalias(z) += 2*element_prod(x,y);
+	prod_xy.wait();
+	div_xy.wait();
+	safe_xy.wait();
+	max_xy.wait();
+	min_xy.wait();
+	pow_xy.wait();
+	z.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_CLOSE(prod_xy(i), x(i)*y(i), 1.e-10);
+		BOOST_CHECK_CLOSE(div_xy(i), x(i)/(y(i)+1.0), 1.e-10);
+		BOOST_CHECK_EQUAL(safe_xy(i), y(i) == 0.0? -1.0: x(i)/y(i));
+		BOOST_CHECK_EQUAL(max_xy(i), std::max(x(i),y(i)));
+		BOOST_CHECK_EQUAL(min_xy(i), std::min(x(i),y(i)));
+		BOOST_CHECK_CLOSE(pow_xy(i), std::pow(x(i),y(i)), 1.e-10);
+		BOOST_CHECK_CLOSE(z(i), 1+2*x(i)*y(i), 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_elementwise_vector_compare ){
+	vector<double> x(9);
+	for(std::size_t i = 0; i != 9; ++i){
+		x(i) = i;
+	}
+	vector<double> lt = x < 4.0;
+	vector<double> le = x <= 4.0;
+	vector<double> gt = x > 4.0;
+	vector<double> ge = x >= 4.0;
+	vector<double> eq = x == 4.0;
+	vector<double> ne = x != 4.0;
+	lt.wait();
+	le.wait();
+	gt.wait();
+	ge.wait();
+	eq.wait();
+	ne.wait();
+	for(std::size_t i = 0; i != 9; ++i){
+		BOOST_CHECK_EQUAL(lt(i), i < 4? 1.0: 0.0);
+		BOOST_CHECK_EQUAL(le(i), i <= 4? 1.0: 0.0);
+		BOOST_CHECK_EQUAL(gt(i), i > 4? 1.0: 0.0);
+		BOOST_CHECK_EQUAL(ge(i), i >= 4? 1.0: 0.0);
+		BOOST_CHECK_EQUAL(eq(i), i == 4? 1.0: 0.0);
+		BOOST_CHECK_EQUAL(ne(i), i != 4? 1.0: 0.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_elementwise_matrix ){
+	std::size_t rows = 31;
+	std::size_t columns = 17;
+	matrix<double> A(rows,columns);
+	matrix<double,column_major> B(rows,columns);
+	fillMatrix(A,1.0);
+	fillMatrix(B,-0.5);
+	matrix<double> E = exp(A);
+	matrix<double,column_major> T = tanh(B);
+	matrix<double> P = element_prod(A,B);
+	matrix<double> M = max(A-2.0,B);
+	matrix<double> D = safe_div(A,B,0.0);
+	matrix<double> C = A > 1.5;
+	matrix<double> S(rows,columns,1.0);
+	noalias(S) += 3*sqrt(A);
+	E.wait();
+	T.wait();
+	P.wait();
+	M.wait();
+	D.wait();
+	C.wait();
+	S.wait();
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_CLOSE(E(i,j), std::exp(A(i,j)), 1.e-10);
+			BOOST_CHECK_CLOSE(T(i,j), std::tanh(B(i,j)), 1.e-10);
+			BOOST_CHECK_CLOSE(P(i,j), A(i,j)*B(i,j), 1.e-10);
+			BOOST_CHECK_EQUAL(M(i,j), std::max(A(i,j)-2.0,B(i,j)));
+			BOOST_CHECK_EQUAL(D(i,j), B(i,j) == 0.0? 0.0 : A(i,j)/B(i,j));
+			BOOST_CHECK_EQUAL(C(i,j), A(i,j) > 1.5? 1.0: 0.0);
+			BOOST_CHECK_CLOSE(S(i,j), 1+3*std::sqrt(A(i,j)), 1.e-10);
+		}
+	}
+}
+
+//blockwise arguments are evaluated into a temporary before the functor is applied
+BOOST_AUTO_TEST_CASE( aBLAS_elementwise_blockwise_argument ){
+	matrix<double> A(12,8);
+	matrix<double> B(8,10);
+	fillMatrix(A,0.5);
+	fillMatrix(B,-0.25);
+	vector<double> x(8,0.5);
+
+	matrix<double> AB(12,10,0.0);
+	kernels::gemm(A,B,AB,1.0);
+	matrix<double> R = tanh(prod(A,B));
+	matrix<double> Q = element_prod(prod(A,B), AB);
+	vector<double> v = exp(prod(A,x));
+	vector<double> w(12,1.0);
+	noalias(w) += 2*max(prod(A,x),1.0);
+	R.wait();
+	Q.wait();
+	v.wait();
+	w.wait();
+	for(std::size_t i = 0; i != 12; ++i){
+		double Ax = 0;
+		for(std::size_t k = 0; k != 8; ++k){
+			Ax += 0.5*A(i,k);
+		}
+		BOOST_CHECK_CLOSE(v(i), std::exp(Ax), 1.e-10);
+		BOOST_CHECK_CLOSE(w(i), 1+2*std::max(Ax,1.0), 1.e-10);
+		for(std::size_t j = 0; j != 10; ++j){
+			BOOST_CHECK_CLOSE(R(i,j), std::tanh(AB(i,j)), 1.e-10);
+			BOOST_CHECK_CLOSE(Q(i,j), AB(i,j)*AB(i,j), 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
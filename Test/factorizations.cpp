@@ -0,0 +1,529 @@
+#define BOOST_TEST_MODULE aBLAS_factorizations
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/factorizations.hpp>
+
+#include <cmath>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = std::sin(1.0 + 3.1*i + 0.7*j) + ((i == j)? 0.5: 0.0);
+		}
+	}
+}
+
+//a symmetric positive definite matrix BB^T+I
+template<class M>
+void fillSymmetric(M& m){
+	std::size_t n = m.size1();
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double x = (i == j)? 1.0: 0.0;
+			for(std::size_t k = 0; k != n; ++k){
+				x += std::sin(1.0 + 3.1*i + 0.7*k) * std::sin(1.0 + 3.1*j + 0.7*k);
+			}
+			m(i,j) = x;
+		}
+	}
+}
+
+//sets the tuning parameters for the lifetime of the object
+struct scoped_tuning{
+	scoped_tuning(std::size_t factorization_tile_size, std::size_t triangular_block_size)
+	:m_parameters(kernels::tuning()){
+		kernels::tuning().factorization_tile_size = factorization_tile_size;
+		kernels::tuning().triangular_block_size = triangular_block_size;
+	}
+	~scoped_tuning(){
+		kernels::tuning() = m_parameters;
+	}
+	kernels::tuning_parameters m_parameters;
+};
+
+//checks A=LL^T or A=U^TU and that the other triangle is cleared
+template<class TriangularType, class M1, class M2>
+void checkCholesky(M1 const& A, M2 const& C, double tolerance){
+	std::size_t n = A.size1();
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double x = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				x += TriangularType::is_upper? C(k,i) * C(k,j): C(i,k) * C(j,k);
+			}
+			BOOST_CHECK_SMALL(x - A(i,j), tolerance);
+			if(TriangularType::is_upper? i > j: j > i){
+				BOOST_CHECK_EQUAL(C(i,j), 0.0);
+			}
+		}
+	}
+}
+
+//checks PA=LU
+template<class M1, class M2, class V>
+void checkLU(M1 const& A, M2 const& LU, V const& P, double tolerance){
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	matrix<double> PA(m, n);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			PA(i,j) = A(i,j);
+		}
+	}
+	PA.wait();
+	kernels::laswp(P, PA);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double x = 0;
+			for(std::size_t k = 0; k <= std::min(i, j) && k != std::min(m, n); ++k){
+				x += ((k == i)? 1.0: LU(i,k)) * LU(k,j);
+			}
+			BOOST_CHECK_SMALL(x - PA(i,j), tolerance);
+		}
+	}
+}
+
+//checks Q^TA=R, Q^T is applied by larfb with all reflections
+template<class M1, class M2, class VecTau>
+void checkQR(M1 const& A, M2 const& QR, VecTau const& tau, double tolerance){
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	std::size_t k = std::min(m, n);
+	matrix<double> QtA(m, n);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			QtA(i,j) = A(i,j);
+		}
+	}
+	matrix<double> V(m, k);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != k; ++j){
+			V(i,j) = QR(i,j);
+		}
+	}
+	vector<double> t(k);
+	for(std::size_t j = 0; j != k; ++j){
+		t(j) = tau(j);
+	}
+	matrix<double> T(k, k);
+	QtA.wait();
+	V.wait();
+	t.wait();
+	T.wait();
+	kernels::larft(V, t, T);
+	kernels::larfb(V, T, QtA);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			BOOST_CHECK_SMALL(QtA(i,j) - ((j >= i)? QR(i,j): 0.0), tolerance);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_factorizations)
+
+//the kernels on single precision and a proxy of a larger matrix
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_kernels ){
+	scoped_tuning tuning(kernels::tuning().factorization_tile_size, 4);
+	std::size_t n = 13;
+	matrix<double> S(n, n);
+	fillSymmetric(S);
+	matrix<float> A(n+3, n+2, -1.0f);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			A(i+2,j+1) = float(S(i,j));
+		}
+	}
+	matrix<float,column_major> B(n+3, n+2, -1.0f);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			B(i+1,j+2) = float(S(i,j));
+		}
+	}
+	A.wait();
+	B.wait();
+	matrix_range<matrix<float> > L = subrange(A, 2, n+2, 1, n+1);
+	matrix_range<matrix<float,column_major> > U = subrange(B, 1, n+1, 2, n+2);
+	BOOST_CHECK_EQUAL(kernels::potrf<lower>(L), 0u);
+	BOOST_CHECK_EQUAL(kernels::potrf<upper>(U), 0u);
+	checkCholesky<lower>(S, L, 1.e-3);
+	checkCholesky<upper>(S, U, 1.e-3);
+	//the elements around the proxies are not changed
+	for(std::size_t j = 0; j != n+2; ++j){
+		BOOST_CHECK_EQUAL(A(0,j), -1.0f);
+		BOOST_CHECK_EQUAL(B(n+2,j), -1.0f);
+	}
+	
+	//the first pivot which is not positive is returned
+	matrix<double> N(n, n);
+	fillSymmetric(N);
+	N(5,5) = -1.0;
+	N.wait();
+	BOOST_CHECK_EQUAL(kernels::potrf<lower>(N), 6u);
+	
+	for(std::size_t m: {std::size_t(5), std::size_t(13), std::size_t(30)}){
+		matrix<double> M(m, n);
+		fillMatrix(M);
+		matrix<double,column_major> LU = M;
+		matrix<double> QR = M;
+		vector<std::size_t> P(std::min(m, n));
+		vector<double> tau(std::min(m, n));
+		LU.wait();
+		QR.wait();
+		P.wait();
+		tau.wait();
+		kernels::getrf(LU, P);
+		kernels::geqrf(QR, tau);
+		checkLU(M, LU, P, 1.e-10);
+		checkQR(M, QR, tau, 1.e-10);
+	}
+}
+
+template<class TriangularType, class Orientation>
+void checkPotrf(std::size_t n){
+	matrix<double,Orientation> A(n, n);
+	fillSymmetric(A);
+	matrix<double,Orientation> C = A;
+	potrf<TriangularType>(C);
+	//products are computed after the decomposition
+	matrix<double,Orientation> CCT(n, n);
+	if(TriangularType::is_upper)
+		noalias(CCT) = prod(trans(C), C);
+	else
+		noalias(CCT) = prod(C, trans(C));
+	C.wait();
+	CCT.wait();
+	checkCholesky<TriangularType>(A, C, 1.e-10);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			BOOST_CHECK_SMALL(CCT(i,j) - A(i,j), 1.e-10);
+		}
+	}
+}
+
+template<class Orientation>
+void checkGetrf(std::size_t m, std::size_t n){
+	matrix<double,Orientation> A(m, n);
+	fillMatrix(A);
+	matrix<double,Orientation> LU = A;
+	vector<std::size_t> P(std::min(m, n));
+	getrf(LU, P);
+	LU.wait();
+	P.wait();
+	checkLU(A, LU, P, 1.e-10);
+}
+
+template<class Orientation>
+void checkGeqrf(std::size_t m, std::size_t n){
+	matrix<double,Orientation> A(m, n);
+	fillMatrix(A);
+	matrix<double,Orientation> QR = A;
+	vector<double> tau(std::min(m, n));
+	geqrf(QR, tau);
+	QR.wait();
+	tau.wait();
+	checkQR(A, QR, tau, 1.e-10);
+}
+
+//tiles of size 8 with partial tiles at the border
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_potrf ){
+	scoped_tuning tuning(8, 3);
+	for(std::size_t n: {1, 5, 8, 21, 40}){
+		checkPotrf<lower,row_major>(n);
+		checkPotrf<lower,column_major>(n);
+		checkPotrf<upper,row_major>(n);
+		checkPotrf<upper,column_major>(n);
+	}
+	//a matrix which is not positive definite gives NaNs
+	matrix<double> A(21, 21);
+	fillSymmetric(A);
+	A(10,10) = -1.0;
+	potrf<lower>(A);
+	A.wait();
+	BOOST_CHECK(std::isnan(A(20,20)));
+	//a block of a larger matrix
+	matrix<double> S(20, 20);
+	fillSymmetric(S);
+	matrix<double> B(25, 25, 3.0);
+	noalias(subrange(B, 2, 22, 3, 23)) = S;
+	potrf<lower>(subrange(B, 2, 22, 3, 23));
+	B.wait();
+	checkCholesky<lower>(S, subrange(B, 2, 22, 3, 23), 1.e-10);
+	BOOST_CHECK_EQUAL(B(0,0), 3.0);
+	BOOST_CHECK_EQUAL(B(24,24), 3.0);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_getrf ){
+	scoped_tuning tuning(8, 3);
+	for(std::size_t n: {1, 5, 8, 21, 40}){
+		checkGetrf<row_major>(n, n);
+		checkGetrf<column_major>(n, n);
+	}
+	checkGetrf<row_major>(40, 17);
+	checkGetrf<column_major>(17, 40);
+	checkGetrf<row_major>(33, 8);
+	checkGetrf<column_major>(8, 33);
+	//a singular matrix is decomposed as well
+	matrix<double> A(21, 21);
+	fillMatrix(A);
+	for(std::size_t j = 0; j != 21; ++j){
+		A(12,j) = 2 * A(3,j);
+	}
+	matrix<double> LU = A;
+	vector<std::size_t> P(21);
+	getrf(LU, P);
+	LU.wait();
+	P.wait();
+	checkLU(A, LU, P, 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_geqrf ){
+	scoped_tuning tuning(8, 3);
+	for(std::size_t n: {1, 5, 8, 21, 40}){
+		checkGeqrf<row_major>(n, n);
+		checkGeqrf<column_major>(n, n);
+	}
+	checkGeqrf<row_major>(40, 17);
+	checkGeqrf<column_major>(17, 40);
+	checkGeqrf<row_major>(33, 8);
+	checkGeqrf<column_major>(8, 33);
+}
+
+//checks A = V diag(w) V^T with orthogonal V and ascending w
+template<class M1, class M2, class V>
+void checkEigen(M1 const& A, M2 const& Q, V const& w, double tolerance){
+	std::size_t n = A.size1();
+	for(std::size_t i = 0; i + 1 < n; ++i){
+		BOOST_CHECK_LE(w(i), w(i+1));
+	}
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double QTQ = 0;
+			double AQ = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				QTQ += Q(k,i) * Q(k,j);
+				AQ += A(i,k) * Q(k,j);
+			}
+			BOOST_CHECK_SMALL(QTQ - ((i == j)? 1.0: 0.0), tolerance);
+			BOOST_CHECK_SMALL(AQ - Q(i,j) * w(j), tolerance);
+		}
+	}
+}
+
+//checks A = U diag(s) VT with orthonormal columns of U, orthonormal rows of VT and descending s
+template<class M1, class V, class M2, class M3>
+void checkSVD(M1 const& A, V const& s, M2 const& U, M3 const& VT, double tolerance){
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	std::size_t k = s.size();
+	for(std::size_t i = 0; i != k; ++i){
+		BOOST_CHECK_GE(s(i), 0.0);
+		if(i + 1 < k){
+			BOOST_CHECK_GE(s(i), s(i+1));
+		}
+	}
+	for(std::size_t i = 0; i != k; ++i){
+		for(std::size_t j = 0; j != k; ++j){
+			double UTU = 0;
+			for(std::size_t l = 0; l != m; ++l){
+				UTU += U(l,i) * U(l,j);
+			}
+			double VVT = 0;
+			for(std::size_t l = 0; l != n; ++l){
+				VVT += VT(i,l) * VT(j,l);
+			}
+			BOOST_CHECK_SMALL(UTU - ((i == j)? 1.0: 0.0), tolerance);
+			BOOST_CHECK_SMALL(VVT - ((i == j)? 1.0: 0.0), tolerance);
+		}
+	}
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double x = 0;
+			for(std::size_t l = 0; l != k; ++l){
+				x += U(i,l) * s(l) * VT(l,j);
+			}
+			BOOST_CHECK_SMALL(x - A(i,j), tolerance);
+		}
+	}
+}
+
+//the upper triangle is not read
+template<class Orientation>
+void checkSyevd(std::size_t n){
+	matrix<double,Orientation> A(n, n);
+	fillMatrix(A);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != i; ++j){
+			A(j,i) = A(i,j);
+		}
+	}
+	matrix<double,Orientation> Q = A;
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = i + 1; j != n; ++j){
+			Q(i,j) = 100.0;
+		}
+	}
+	vector<double> w(n);
+	syevd(Q, w);
+	Q.wait();
+	w.wait();
+	checkEigen(A, Q, w, 1.e-10);
+}
+
+template<class Orientation>
+void checkGesdd(std::size_t m, std::size_t n){
+	std::size_t k = std::min(m, n);
+	matrix<double,Orientation> A(m, n);
+	fillMatrix(A);
+	matrix<double,Orientation> B = A;
+	vector<double> s(k);
+	matrix<double,Orientation> U(m, k);
+	matrix<double,Orientation> VT(k, n);
+	gesdd(B, s, U, VT);
+	s.wait();
+	U.wait();
+	VT.wait();
+	checkSVD(A, s, U, VT, 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_syevd ){
+	for(std::size_t n: {1, 2, 5, 8, 21, 40}){
+		checkSyevd<row_major>(n);
+		checkSyevd<column_major>(n);
+	}
+	//multiple eigenvalues
+	matrix<double> A(9, 9, 1.0);
+	for(std::size_t i = 0; i != 9; ++i){
+		A(i,i) = 3.0;
+	}
+	matrix<double> Q = A;
+	vector<double> w(9);
+	syevd(Q, w);
+	Q.wait();
+	w.wait();
+	checkEigen(A, Q, w, 1.e-10);
+	for(std::size_t i = 0; i != 8; ++i){
+		BOOST_CHECK_CLOSE(w(i), 2.0, 1.e-10);
+	}
+	BOOST_CHECK_CLOSE(w(8), 11.0, 1.e-10);
+	//a block of a larger matrix
+	matrix<float,column_major> S(25, 25);
+	fillSymmetric(S);
+	matrix<float,column_major> V = S;
+	vector<float> v(20);
+	syevd(subrange(V, 3, 23, 3, 23), v);
+	V.wait();
+	v.wait();
+	checkEigen(subrange(S, 3, 23, 3, 23), subrange(V, 3, 23, 3, 23), v, 1.e-3);
+	BOOST_CHECK_EQUAL(V(2,2), S(2,2));
+	BOOST_CHECK_EQUAL(V(23,23), S(23,23));
+	BOOST_CHECK_EQUAL(V(3,24), S(3,24));
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_gesdd ){
+	for(std::size_t n: {1, 2, 5, 8, 21}){
+		checkGesdd<row_major>(n, n);
+		checkGesdd<column_major>(n, n);
+	}
+	checkGesdd<row_major>(40, 17);
+	checkGesdd<column_major>(17, 40);
+	checkGesdd<row_major>(8, 33);
+	checkGesdd<column_major>(33, 8);
+	//a matrix of rank 2, the missing columns of U and rows of VT are completed
+	matrix<double> A(12, 7);
+	for(std::size_t i = 0; i != 12; ++i){
+		for(std::size_t j = 0; j != 7; ++j){
+			A(i,j) = std::sin(1.0 + i) * std::cos(0.5 * j) + 0.1 * i * j;
+		}
+	}
+	matrix<double> AT = trans(A);
+	AT.wait();
+	for(matrix<double>* M: {&A, &AT}){
+		matrix<double> B = *M;
+		vector<double> s(7);
+		matrix<double> U(M->size1(), 7);
+		matrix<double> VT(7, M->size2());
+		gesdd(B, s, U, VT);
+		s.wait();
+		U.wait();
+		VT.wait();
+		checkSVD(*M, s, U, VT, 1.e-10);
+		for(std::size_t i = 2; i != 7; ++i){
+			BOOST_CHECK_SMALL(s(i), 1.e-10);
+		}
+	}
+	//the zero matrix
+	matrix<double,column_major> Z(6, 4, 0.0);
+	vector<double> s(4);
+	matrix<double,column_major> U(6, 4);
+	matrix<double,column_major> VT(4, 4);
+	gesdd(Z, s, U, VT);
+	s.wait();
+	U.wait();
+	VT.wait();
+	checkSVD(matrix<double,column_major>(6, 4, 0.0), s, U, VT, 1.e-10);
+}
+
+//with a binding, both the binding and the default kernels are used depending on the size
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_bindings ){
+#ifdef ABLAS_USE_LAPACK
+	BOOST_CHECK((bindings::has_optimized_potrf<matrix<double> >::value));
+	BOOST_CHECK((bindings::has_optimized_getrf<matrix<float,column_major>, vector<std::size_t> >::value));
+	BOOST_CHECK((!bindings::has_optimized_getrf<matrix<double>, vector<std::size_t> >::value));
+	BOOST_CHECK((bindings::has_optimized_geqrf<matrix<double,column_major>, vector<double> >::value));
+	BOOST_CHECK((bindings::has_optimized_syevd<matrix<double>, vector<double> >::value));
+	BOOST_CHECK((!bindings::has_optimized_syevd<matrix<int>, vector<int> >::value));
+	BOOST_CHECK((bindings::has_optimized_gesdd<matrix<double>, vector<double>, matrix<double>, matrix<double> >::value));
+	BOOST_CHECK((!bindings::has_optimized_gesdd<matrix<double>, vector<double>, matrix<double,column_major>, matrix<double> >::value));
+#endif
+	for(std::size_t threshold: {std::size_t(0), std::size_t(-1)}){
+		scoped_tuning tuning(16, 4);
+		kernels::tuning().gemm_binding_min_size = threshold;
+		checkPotrf<lower,row_major>(37);
+		checkPotrf<upper,column_major>(37);
+		checkGetrf<column_major>(37, 30);
+		checkGeqrf<column_major>(30, 37);
+		checkSyevd<row_major>(30);
+		checkSyevd<column_major>(30);
+		checkGesdd<row_major>(30, 23);
+		checkGesdd<column_major>(23, 30);
+		//leading dimensions larger than the sizes
+		matrix<double> A(30, 25);
+		fillMatrix(A);
+		matrix<double> B(34, 29, -1.0);
+		noalias(subrange(B, 2, 32, 1, 26)) = A;
+		vector<double> s(25);
+		matrix<double> U(32, 27);
+		matrix<double> VT(28, 29);
+		matrix_range<matrix<double> > B_range = subrange(B, 2, 32, 1, 26);
+		matrix_range<matrix<double> > U_range = subrange(U, 1, 31, 1, 26);
+		matrix_range<matrix<double> > VT_range = subrange(VT, 2, 27, 3, 28);
+		B.wait();
+		s.wait();
+		U.wait();
+		VT.wait();
+		BOOST_CHECK_EQUAL(kernels::gesdd(B_range, s, U_range, VT_range), 0u);
+		checkSVD(A, s, U_range, VT_range, 1.e-10);
+		BOOST_CHECK_EQUAL(B(0,0), -1.0);
+		BOOST_CHECK_EQUAL(B(33,28), -1.0);
+	}
+}
+
+//many tiles computed in parallel
+BOOST_AUTO_TEST_CASE( aBLAS_factorizations_large ){
+	scoped_tuning tuning(32, 8);
+	checkPotrf<lower,row_major>(150);
+	checkPotrf<upper,column_major>(150);
+	checkGetrf<row_major>(150, 120);
+	checkGeqrf<column_major>(120, 150);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+#define BOOST_TEST_MODULE aBLAS_fixed
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/fixed_matrix.hpp>
+#include <aBLAS/fixed_vector.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + i - 0.5*j;
+		}
+	}
+}
+
+//we test using the textbook definition.
+template<class Arg1, class Arg2, class Result>
+void checkMatrixMatrixMultiply(Arg1 const& arg1, Arg2 const& arg2, Result const& result, double factor, double init = 0){
+	BOOST_REQUIRE_EQUAL(arg1.size1(), result.size1());
+	BOOST_REQUIRE_EQUAL(arg2.size2(), result.size2());
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			double test_result = init;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += factor * arg1(i,k)*arg2(k,j);
+			}
+			BOOST_CHECK_CLOSE(result(i,j), test_result,1.e-10);
+		}
+	}
+}
+
+template<class O1, class O2, class O3>
+void checkFixedGemm(){
+	fixed_matrix<double,4,3,O1> A;
+	fixed_matrix<double,3,5,O2> B;
+	fillMatrix(A,1.0);
+	fillMatrix(B,-2.0);
+	fixed_matrix<double,4,5,O3> C(std::numeric_limits<double>::quiet_NaN());
+	kernels::gemm(A,B,C,2.0,0.0);
+	checkMatrixMatrixMultiply(A,B,C,2.0);
+	fixed_matrix<double,4,5,O3> D(1.5);
+	kernels::gemm(A,B,D,-1.0,3.0);
+	checkMatrixMatrixMultiply(A,B,D,-1.0,4.5);
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_fixed)
+
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_layout ){
+	fixed_matrix<double,3,4> Arm;
+	fixed_matrix<double,3,4,column_major> Acm;
+	BOOST_CHECK_EQUAL(Arm.stride1(), 4);
+	BOOST_CHECK_EQUAL(Arm.stride2(), 1);
+	BOOST_CHECK_EQUAL(Acm.stride1(), 1);
+	BOOST_CHECK_EQUAL(Acm.stride2(), 3);
+	//the storage is inline, there is no allocation
+	BOOST_CHECK_EQUAL(sizeof(Arm), 12*sizeof(double));
+	fixed_vector<float,3> v;
+	BOOST_CHECK_EQUAL(sizeof(v), 3*sizeof(float));
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_EQUAL(v(i), 0.0f);
+		for(std::size_t j = 0; j != 4; ++j){
+			BOOST_CHECK_EQUAL(Arm(i,j), 0.0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_gemm ){
+	checkFixedGemm<row_major,row_major,row_major>();
+	checkFixedGemm<row_major,row_major,column_major>();
+	checkFixedGemm<row_major,column_major,row_major>();
+	checkFixedGemm<row_major,column_major,column_major>();
+	checkFixedGemm<column_major,row_major,row_major>();
+	checkFixedGemm<column_major,row_major,column_major>();
+	checkFixedGemm<column_major,column_major,row_major>();
+	checkFixedGemm<column_major,column_major,column_major>();
+
+	//prod returns the result directly
+	fixed_matrix<double,4,4> A;
+	fixed_matrix<double,4,4,column_major> B;
+	fillMatrix(A,0.5);
+	fillMatrix(B,2.0);
+	fixed_matrix<double,4,4> C = prod(A,B);
+	checkMatrixMatrixMultiply(A,B,C,1.0);
+	//aliasing is safe as the product is computed before it is assigned
+	fixed_matrix<double,4,4> D = A;
+	D = prod(D,B);
+	checkMatrixMatrixMultiply(A,B,D,1.0);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_gemv_dot ){
+	fixed_matrix<double,3,4> A;
+	fixed_matrix<double,3,4,column_major> Acm;
+	fillMatrix(A,1.0);
+	fillMatrix(Acm,1.0);
+	fixed_vector<double,4> x{1.0,-2.0,0.5,3.0};
+	fixed_vector<double,3> y(std::numeric_limits<double>::quiet_NaN());
+	kernels::gemv(A,x,y,2.0,0.0);
+	fixed_vector<double,3> z = prod(Acm,x);
+	for(std::size_t i = 0; i != 3; ++i){
+		double result = 0;
+		for(std::size_t j = 0; j != 4; ++j){
+			result += A(i,j)*x(j);
+		}
+		BOOST_CHECK_CLOSE(y(i), 2*result, 1.e-10);
+		BOOST_CHECK_CLOSE(z(i), result, 1.e-10);
+	}
+	fixed_vector<double,4> w(2.0);
+	BOOST_CHECK_CLOSE(inner_prod(x,w), 5.0, 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_assign ){
+	fixed_matrix<double,3,3> A;
+	fixed_matrix<double,3,3,column_major> B;
+	fillMatrix(A,1.0);
+	fillMatrix(B,2.0);
+	fixed_matrix<double,3,3> C = B;
+	C += A;
+	C *= 2.0;
+	C -= 1.0;
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			BOOST_CHECK_CLOSE(C(i,j), 2*(A(i,j)+B(i,j))-1, 1.e-10);
+		}
+	}
+	noalias(C) = A;
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			BOOST_CHECK_EQUAL(C(i,j), A(i,j));
+		}
+	}
+	fixed_vector<double,3> v{1.0,2.0,3.0};
+	v /= 2.0;
+	v += fixed_vector<double,3>(1.0);
+	BOOST_CHECK_EQUAL(v(0), 1.5);
+	BOOST_CHECK_EQUAL(v(1), 2.0);
+	BOOST_CHECK_EQUAL(v(2), 2.5);
+}
+
+//fixed size containers can be mixed with dynamic ones.
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_mixed ){
+	matrix<double> A(4,3);
+	fillMatrix(A,1.0);
+	fixed_matrix<double,3,3> B;
+	fillMatrix(B,-1.0);
+	//fixed argument in an asynchronous product
+	matrix<double> C(4,3);
+	noalias(C) = prod(A,B);
+	C.wait();
+	checkMatrixMatrixMultiply(A,B,C,1.0);
+
+	//dynamic expression assigned to a fixed matrix is waited for
+	fixed_matrix<double,4,3> D = prod(A,B);
+	checkMatrixMatrixMultiply(A,B,D,1.0);
+	fixed_matrix<double,3,4,column_major> E = trans(A);
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 4; ++j){
+			BOOST_CHECK_EQUAL(E(i,j), A(j,i));
+		}
+	}
+
+	vector<double> x(3,1.0);
+	fixed_vector<double,4> y = prod(A,x);
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_CLOSE(y(i), A(i,0)+A(i,1)+A(i,2), 1.e-10);
+	}
+
+	//writes through proxies are computed by the scheduler
+	fixed_matrix<double,4,3> F;
+	noalias(row(F,2)) = row(A,1);
+	F.wait();
+	for(std::size_t j = 0; j != 3; ++j){
+		BOOST_CHECK_EQUAL(F(2,j), A(1,j));
+		BOOST_CHECK_EQUAL(F(1,j), 0.0);
+	}
+}
+
+//fixed size containers only wait for the kernels writing to them
+BOOST_AUTO_TEST_CASE( aBLAS_fixed_proxy_write_pending ){
+	matrix<double> A(4,3);
+	fillMatrix(A,1.0);
+	vector<double> x(4);
+	for(std::size_t i = 0; i != 4; ++i){
+		x(i) = 1.0 + i;
+	}
+	A.wait();
+	x.wait();
+	//the right hand side is still pending when the proxy write is issued
+	std::atomic<bool> released(false);
+	system::scheduler().spawn([&](){
+		while(!released)
+			std::this_thread::yield();
+	},A.dependencies());
+	std::thread releaser([&](){
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		released = true;
+	});
+	{
+		fixed_matrix<double,4,3> F(0.0);
+		noalias(row(F,2)) = row(A,1);
+		noalias(row(F,1)) = prod(trans(A),x);
+		//the writes are done when the statements return, F can be read and destroyed directly
+		BOOST_CHECK(F.is_ready());
+		fixed_matrix<double,4,3> G = F;
+		for(std::size_t j = 0; j != 3; ++j){
+			double test_result = 0;
+			for(std::size_t i = 0; i != 4; ++i){
+				test_result += A(i,j) * x(i);
+			}
+			BOOST_CHECK_EQUAL(G(0,j), 0.0);
+			BOOST_CHECK_CLOSE(G(1,j), test_result, 1.e-10);
+			BOOST_CHECK_EQUAL(G(2,j), A(1,j));
+			BOOST_CHECK_EQUAL(G(3,j), 0.0);
+		}
+	}
+	BOOST_CHECK(released);
+	releaser.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
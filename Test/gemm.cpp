@@ -5,6 +5,8 @@
 #include <aBLAS/matrix.hpp>
 #include <aBLAS/kernels/gemm.hpp>
 
+#include <limits>
+
 using namespace aBLAS;
 
 //we test using the textbook definition.
@@ -99,4 +101,58 @@ BOOST_AUTO_TEST_CASE( aBLAS_gemm_dense_dense ){
 	}
 }
 
+//C=beta*C+alpha*AB. For beta=0 the old values of C must not be read
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_beta ){
+	std::size_t rows = 50;
+	std::size_t columns = 80;
+	std::size_t middle = 33;
+	matrix<double,row_major> arg1rm(rows,middle);
+	matrix<double,column_major> arg1cm(rows,middle);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != middle; ++j){
+			arg1rm(i,j) = arg1cm(i,j) = i*middle+0.2*j;
+		}
+	}
+	matrix<double,row_major> arg2rm(middle,columns);
+	matrix<double,column_major> arg2cm(middle,columns);
+	for(std::size_t i = 0; i != middle; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			arg2rm(i,j) = arg2cm(i,j) = i*columns+1.5*j;
+		}
+	}
+	double alpha=-2.0;
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	std::cout<<"\nchecking gemm with beta"<<std::endl;
+	{
+		matrix<double,row_major> result(rows,columns,nan);
+		kernels::gemm(arg1rm,arg2rm,result,alpha,0.0);
+		checkMatrixMatrixMultiply(arg1rm,arg2rm,result,alpha,0.0);
+	}
+	{
+		matrix<double,row_major> result(rows,columns,nan);
+		kernels::gemm(arg1cm,arg2rm,result,alpha,0.0);
+		checkMatrixMatrixMultiply(arg1cm,arg2rm,result,alpha,0.0);
+	}
+	{
+		matrix<double,row_major> result(rows,columns,nan);
+		kernels::gemm(arg1rm,arg2cm,result,alpha,0.0);
+		checkMatrixMatrixMultiply(arg1rm,arg2cm,result,alpha,0.0);
+	}
+	{
+		matrix<double,column_major> result(rows,columns,nan);
+		kernels::gemm(arg1rm,arg2cm,result,alpha,0.0);
+		checkMatrixMatrixMultiply(arg1rm,arg2cm,result,alpha,0.0);
+	}
+	{
+		matrix<double,row_major> result(rows,columns,1.5);
+		kernels::gemm(arg1rm,arg2cm,result,alpha,0.5);
+		checkMatrixMatrixMultiply(arg1rm,arg2cm,result,alpha,0.75);
+	}
+	{
+		matrix<double,column_major> result(rows,columns,1.5);
+		kernels::gemm(arg1cm,arg2rm,result,alpha,0.5);
+		checkMatrixMatrixMultiply(arg1cm,arg2rm,result,alpha,0.75);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,169 @@
+#define BOOST_TEST_MODULE aBLAS_gemm_batched
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix_stack.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <limits>
+#include <vector>
+
+using namespace aBLAS;
+
+//we test using the textbook definition.
+template<class Arg1, class Arg2, class Result>
+void checkMatrixMatrixMultiply(Arg1 const& arg1, Arg2 const& arg2, Result const& result, double factor, double init = 0){
+	BOOST_REQUIRE_EQUAL(arg1.size1(), result.size1());
+	BOOST_REQUIRE_EQUAL(arg2.size2(), result.size2());
+
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			double test_result = init;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += factor * arg1(i,k)*arg2(k,j);
+			}
+			BOOST_CHECK_CLOSE(result(i,j), test_result,1.e-10);
+		}
+	}
+}
+
+template<class Stack>
+void fillStack(Stack& stack, double offset){
+	for(std::size_t k = 0; k != stack.size(); ++k){
+		for(std::size_t i = 0; i != stack.size1(); ++i){
+			for(std::size_t j = 0; j != stack.size2(); ++j){
+				stack(k,i,j) = offset + k - 0.5*i + 0.25*j;
+			}
+		}
+	}
+}
+
+template<class OA, class OB, class OC>
+void checkStackProduct(std::size_t rows, std::size_t columns, std::size_t middle){
+	std::size_t batch = 37;
+	matrix_stack<double,OA> A(batch,rows,middle);
+	matrix_stack<double,OB> B(batch,middle,columns);
+	fillStack(A,1.0);
+	fillStack(B,-2.0);
+
+	//beta=0 must overwrite uninitialized values
+	matrix_stack<double,OC> C(batch,rows,columns,std::numeric_limits<double>::quiet_NaN());
+	gemm_batched(A,B,C,2.0);
+	C.wait();
+	for(std::size_t k = 0; k != batch; ++k){
+		checkMatrixMatrixMultiply(A[k],B[k],C[k],2.0);
+	}
+
+	matrix_stack<double,OC> D(batch,rows,columns,1.5);
+	gemm_batched(A,B,D,-1.0,3.0);
+	D.wait();
+	for(std::size_t k = 0; k != batch; ++k){
+		checkMatrixMatrixMultiply(A[k],B[k],D[k],-1.0,4.5);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_gemm_batched)
+
+BOOST_AUTO_TEST_CASE( aBLAS_matrix_stack_layout ){
+	matrix_stack<double,row_major> rm(4,3,2);
+	matrix_stack<double,column_major> cm(4,3,2);
+	BOOST_CHECK_EQUAL(rm.size(), 4u);
+	BOOST_CHECK_EQUAL(rm.stacked_matrix().size1(), 12u);
+	BOOST_CHECK_EQUAL(rm.stacked_matrix().size2(), 2u);
+	BOOST_CHECK_EQUAL(cm.stacked_matrix().size1(), 3u);
+	BOOST_CHECK_EQUAL(cm.stacked_matrix().size2(), 8u);
+	fillStack(rm,0.0);
+	fillStack(cm,0.0);
+	for(std::size_t k = 0; k != 4; ++k){
+		BOOST_CHECK_EQUAL(rm[k].size1(), 3u);
+		BOOST_CHECK_EQUAL(rm[k].size2(), 2u);
+		BOOST_CHECK_EQUAL(cm[k].size1(), 3u);
+		BOOST_CHECK_EQUAL(cm[k].size2(), 2u);
+		for(std::size_t i = 0; i != 3; ++i){
+			for(std::size_t j = 0; j != 2; ++j){
+				BOOST_CHECK_EQUAL(rm[k](i,j), k - 0.5*i + 0.25*j);
+				BOOST_CHECK_EQUAL(cm[k](i,j), k - 0.5*i + 0.25*j);
+			}
+		}
+	}
+}
+
+template<class OA, class OB, class OC>
+void checkStackProducts(){
+	checkStackProduct<OA,OB,OC>(5,7,3);
+	//full 4x8 register blocks of the default kernel together with remaining rows and columns
+	checkStackProduct<OA,OB,OC>(9,19,13);
+	checkStackProduct<OA,OB,OC>(8,16,1);
+}
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_batched_stack ){
+	checkStackProducts<row_major,row_major,row_major>();
+	checkStackProducts<row_major,row_major,column_major>();
+	checkStackProducts<row_major,column_major,row_major>();
+	checkStackProducts<row_major,column_major,column_major>();
+	checkStackProducts<column_major,row_major,row_major>();
+	checkStackProducts<column_major,row_major,column_major>();
+	checkStackProducts<column_major,column_major,row_major>();
+	checkStackProducts<column_major,column_major,column_major>();
+}
+
+//products of the batch wait for the kernels writing their arguments and later kernels wait for the whole batch
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_batched_dependencies ){
+	std::size_t batch = 20;
+	matrix_stack<double> A(batch,4,4);
+	matrix_stack<double> B(batch,4,4);
+	fillStack(A,0.0);
+	fillStack(B,1.0);
+	matrix_stack<double> C(batch,4,4);
+	matrix_stack<double> D(batch,4,4);
+	gemm_batched(A,B,C);
+	gemm_batched(C,B,D);
+	D.wait();
+	for(std::size_t k = 0; k != batch; ++k){
+		matrix<double> AB(4,4,0.0);
+		kernels::gemm(A[k],B[k],AB,1.0);
+		checkMatrixMatrixMultiply(AB,B[k],D[k],1.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_batched_array ){
+	std::size_t batch = 25;
+	std::vector<matrix<double> > A;
+	std::vector<matrix<double,column_major> > B;
+	std::vector<matrix<double> > C;
+	for(std::size_t k = 0; k != batch; ++k){
+		//every product has a different size
+		std::size_t rows = 1 + k % 4;
+		std::size_t columns = 2 + k % 5;
+		std::size_t middle = 1 + k % 3;
+		A.push_back(matrix<double>(rows,middle));
+		B.push_back(matrix<double,column_major>(middle,columns));
+		C.push_back(matrix<double>(rows,columns,1.0));
+		for(std::size_t i = 0; i != rows; ++i)
+			for(std::size_t l = 0; l != middle; ++l)
+				A[k](i,l) = k + i - 0.5*l;
+		for(std::size_t l = 0; l != middle; ++l)
+			for(std::size_t j = 0; j != columns; ++j)
+				B[k](l,j) = 0.25*k*l - j;
+	}
+	gemm_batched(A,B,C,2.0,-1.0);
+	for(std::size_t k = 0; k != batch; ++k){
+		C[k].wait();
+		checkMatrixMatrixMultiply(A[k],B[k],C[k],2.0,-1.0);
+	}
+
+	//the same matrix can be used by all products of the batch
+	matrix<double> shared(3,3);
+	for(std::size_t i = 0; i != 3; ++i)
+		for(std::size_t j = 0; j != 3; ++j)
+			shared(i,j) = i - 2.0*j;
+	std::vector<matrix<double>::closure_type> sharedA(batch,shared);
+	std::vector<matrix<double> > sharedB(batch,shared);
+	std::vector<matrix<double> > result(batch,matrix<double>(3,3));
+	gemm_batched(sharedA,sharedB,result);
+	for(std::size_t k = 0; k != batch; ++k){
+		result[k].wait();
+		checkMatrixMatrixMultiply(shared,shared,result[k],1.0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#define BOOST_TEST_MODULE aBLAS_gemm_epilogue
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = 0.1*(offset + double((i*7+j*3)%11) - 0.5*double(j%5));
+		}
+	}
+}
+
+template<class Arg1, class Arg2>
+double productElement(Arg1 const& arg1, Arg2 const& arg2, std::size_t i, std::size_t j){
+	double result = 0;
+	for(std::size_t k = 0; k != arg1.size2(); ++k){
+		 result += arg1(i,k)*arg2(k,j);
+	}
+	return result;
+}
+
+//computes tanh(XW+bias) with tiles smaller than the result
+template<class OX, class OW, class OY>
+void checkLayer(){
+	std::size_t tile_size = kernels::tuning().gemm_epilogue_tile_size;
+	kernels::tuning().gemm_epilogue_tile_size = 16;
+	std::size_t rows = 37;
+	std::size_t columns = 45;
+	std::size_t middle = 20;
+	matrix<double,OX> X(rows,middle);
+	matrix<double,OW> W(middle,columns);
+	fillMatrix(X,-1.0);
+	fillMatrix(W,0.5);
+	vector<double> bias(columns);
+	for(std::size_t j = 0; j != columns; ++j)
+		bias(j) = 0.25*j - 3;
+
+	matrix<double,OY> Y(rows,columns,std::numeric_limits<double>::quiet_NaN());
+	noalias(Y) = transform_elements(add_to_rows(prod(X,W),bias), scalar_tanh<double>());
+	Y.wait();
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_CLOSE(Y(i,j), std::tanh(productElement(X,W,i,j)+bias(j)), 1.e-10);
+		}
+	}
+	kernels::tuning().gemm_epilogue_tile_size = tile_size;
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_gemm_epilogue)
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_epilogue_layer ){
+	checkLayer<row_major,row_major,row_major>();
+	checkLayer<row_major,column_major,column_major>();
+	checkLayer<column_major,row_major,row_major>();
+	checkLayer<column_major,column_major,column_major>();
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_epilogue_compose ){
+	std::size_t rows = 9;
+	std::size_t columns = 12;
+	std::size_t middle = 5;
+	matrix<double> A(rows,middle);
+	matrix<double,column_major> B(middle,columns);
+	fillMatrix(A,1.0);
+	fillMatrix(B,-2.0);
+	vector<double> row_bias(columns);
+	vector<double> column_bias(rows);
+	for(std::size_t j = 0; j != columns; ++j)
+		row_bias(j) = 0.5*j;
+	for(std::size_t i = 0; i != rows; ++i)
+		column_bias(i) = -1.0*i;
+
+	//rectifier of the product with both biases, scaled by the assignment
+	matrix<double> C(rows,columns);
+	noalias(C) = 2.0*transform_elements(
+		add_to_columns(add_to_rows(prod(A,B),row_bias),column_bias),
+		scalar_max<double,double>(0.0)
+	);
+	//the epilogue is applied before the product is added to the result
+	matrix<double> D(rows,columns,1.0);
+	D += transform_elements(prod(A,B), scalar_sqr<double>());
+	D.wait();
+	C.wait();
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			double p = productElement(A,B,i,j);
+			BOOST_CHECK_CLOSE(C(i,j)+1, 2*std::max(p+row_bias(j)+column_bias(i),0.0)+1, 1.e-10);
+			BOOST_CHECK_CLOSE(D(i,j), 1+p*p, 1.e-10);
+		}
+	}
+
+	//kernel with beta != 0
+	matrix<double> E(rows,columns,3.0);
+	kernels::gemm(A,B,E,-1.0,0.5, transform_epilogue<identity_epilogue,scalar_abs<double> >(identity_epilogue(),scalar_abs<double>()));
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_CLOSE(E(i,j), 1.5-std::abs(productElement(A,B,i,j)), 1.e-10);
+		}
+	}
+}
+
+//the bias is computed by an earlier kernel, the product waits for it
+BOOST_AUTO_TEST_CASE( aBLAS_gemm_epilogue_dependencies ){
+	matrix<double> A(6,4);
+	matrix<double> B(4,5);
+	fillMatrix(A,0.0);
+	fillMatrix(B,1.0);
+	vector<double> x(4,1.0);
+	vector<double> bias(6);
+	noalias(bias) = prod(A,x);
+	matrix<double> C(6,5);
+	noalias(C) = add_to_columns(prod(A,B),bias);
+	C.wait();
+	for(std::size_t i = 0; i != 6; ++i){
+		double sum = A(i,0)+A(i,1)+A(i,2)+A(i,3);
+		for(std::size_t j = 0; j != 5; ++j){
+			BOOST_CHECK_CLOSE(C(i,j), productElement(A,B,i,j)+sum, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
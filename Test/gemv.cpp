@@ -6,6 +6,8 @@
 #include <aBLAS/vector.hpp>
 #include <aBLAS/kernels/gemv.hpp>
 
+#include <limits>
+
 using namespace aBLAS;
 
 //we test using the textbook definition.
@@ -59,4 +61,44 @@ BOOST_AUTO_TEST_CASE( aBLAS_gemv_dense_dense ){
 	}
 }
 
+//y=beta*y+alpha*Ax. For beta=0 the old values of y must not be read
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_beta ){
+	std::size_t rows = 50;
+	std::size_t columns = 80;
+	matrix<double,row_major> arg1rm(rows,columns);
+	matrix<double,column_major> arg1cm(rows,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			arg1rm(i,j) = arg1cm(i,j) = i*columns+0.2*j;
+		}
+	}
+	vector<double> arg2(columns);
+	for(std::size_t j = 0; j != columns; ++j){
+		arg2(j)  = 1.5*j+2;
+	}
+	double alpha = -2.0;
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	std::cout<<"\nchecking gemv with beta"<<std::endl;
+	{
+		vector<double> result(rows,nan);
+		kernels::gemv(arg1rm,arg2,result,alpha,0.0);
+		checkMatrixVectorMultiply(arg1rm,arg2,result,alpha,0.0);
+	}
+	{
+		vector<double> result(rows,nan);
+		kernels::gemv(arg1cm,arg2,result,alpha,0.0);
+		checkMatrixVectorMultiply(arg1cm,arg2,result,alpha,0.0);
+	}
+	{
+		vector<double> result(rows,1.5);
+		kernels::gemv(arg1rm,arg2,result,alpha,0.5);
+		checkMatrixVectorMultiply(arg1rm,arg2,result,alpha,0.75);
+	}
+	{
+		vector<double> result(rows,1.5);
+		kernels::gemv(arg1cm,arg2,result,alpha,0.5);
+		checkMatrixVectorMultiply(arg1cm,arg2,result,alpha,0.75);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
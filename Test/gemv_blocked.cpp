@@ -0,0 +1,209 @@
+#define BOOST_TEST_MODULE aBLAS_gemv_blocked
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <limits>
+#include <vector>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = typename M::value_type(offset + 0.01*(i % 13) - 0.02*(j % 7));
+		}
+	}
+}
+
+template<class V>
+void fillVector(V& v, double offset){
+	for(std::size_t i = 0; i != v.size(); ++i){
+		v(i) = typename V::value_type(offset - 0.03*(i % 11));
+	}
+}
+
+//sizes around the number of lines per pass, the register blocks, the panels and the L1 blocks
+std::size_t const sizes[] = {0, 1, 3, 4, 5, 17, 63, 64, 65, 130};
+std::size_t const long_sizes[] = {1023, 1024, 1025, 2049, 4100};
+
+//true if the value is the initial value of the result, which may be NaN
+template<class T>
+bool untouched(T value, T init){
+	return value == init || (value != value && init != init);
+}
+
+//checks y = beta*y + alpha*A*x computed by the pointer kernels against a direct computation
+template<class T>
+void checkKernels(std::size_t m, std::size_t n){
+	std::ptrdiff_t lda_row = n + 3;
+	std::ptrdiff_t lda_col = m + 5;
+	std::vector<T> A_row(m * lda_row);
+	std::vector<T> A_col(n * lda_col + m);
+	std::vector<T> x(2 * n + 1);
+	for(std::size_t j = 0; j != x.size(); ++j){
+		x[j] = T(0.5) - T(0.01) * (j % 23);
+	}
+	std::vector<double> reference(m, 0.0);
+	for(std::size_t i = 0; i != m; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			T a = T(0.1) * (i % 5) - T(0.02) * (j % 17);
+			A_row[i * lda_row + j] = a;
+			A_col[j * lda_col + i] = a;
+			reference[i] += double(a) * x[j];
+		}
+	}
+	T tol = std::is_same<T,float>::value? T(1.e-3): T(1.e-10);
+	T nan = std::numeric_limits<T>::quiet_NaN();
+	for(T beta : {T(0), T(1), T(-0.5)}){
+		T init = beta == T(0)? nan: T(2);
+		std::vector<T> y_row(2 * m + 1, init);
+		std::vector<T> y_col(m + 1, init);
+		bindings::gemv_row_major(m, n, T(2), A_row.data(), lda_row, x.data(), beta, y_row.data(), 2);
+		bindings::gemv_column_major(m, n, T(2), A_col.data(), lda_col, x.data(), 1, beta, y_col.data());
+		//strided x for the column major kernel
+		std::vector<T> x_strided(2 * n + 1, nan);
+		for(std::size_t j = 0; j != n; ++j){
+			x_strided[2 * j] = x[j];
+		}
+		std::vector<T> y_strided(m, init);
+		bindings::gemv_column_major(m, n, T(2), A_col.data(), lda_col, x_strided.data(), 2, beta, y_strided.data());
+		for(std::size_t i = 0; i != m; ++i){
+			double expected = 2 * reference[i] + (beta == T(0)? 0.0: double(beta) * 2);
+			BOOST_REQUIRE_SMALL(double(y_row[2 * i] - expected), double(tol));
+			BOOST_REQUIRE_SMALL(double(y_col[i] - expected), double(tol));
+			BOOST_REQUIRE_SMALL(double(y_strided[i] - expected), double(tol));
+			//elements between the strided result are not written
+			BOOST_REQUIRE(untouched(y_row[2 * i + 1], init));
+		}
+		BOOST_CHECK(untouched(y_col[m], init));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_gemv_blocked)
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_blocked_kernels ){
+	for(std::size_t m : sizes){
+		for(std::size_t n : sizes){
+			checkKernels<float>(m, n);
+			checkKernels<double>(m, n);
+		}
+	}
+	for(std::size_t n : long_sizes){
+		checkKernels<float>(9, n);
+		checkKernels<double>(n, 9);
+	}
+	checkKernels<double>(130, 2049);
+}
+
+template<class T, class Orientation>
+void checkProduct(std::size_t m, std::size_t n){
+	matrix<T,Orientation> A(m,n);
+	fillMatrix(A,0.5);
+	vector<T> x(n);
+	fillVector(x,1.0);
+	vector<T> y(m, std::numeric_limits<T>::quiet_NaN());
+	noalias(y) = prod(A,x);
+	vector<T> z(m, T(1));
+	noalias(z) += 3 * prod(A,x);
+	//transposed products use the kernel of the other orientation
+	vector<T> u(n, T(-2));
+	noalias(u) += prod(trans(A),y);
+	z.wait();
+	u.wait();
+	T tol = std::is_same<T,float>::value? T(1.e-2): T(1.e-8);
+	for(std::size_t i = 0; i != m; ++i){
+		T expected = 0;
+		for(std::size_t j = 0; j != n; ++j){
+			expected += A(i,j) * x(j);
+		}
+		BOOST_CHECK_CLOSE(y(i), expected, tol);
+		BOOST_CHECK_CLOSE(z(i), 1 + 3 * expected, tol);
+	}
+	for(std::size_t j = 0; j != n; ++j){
+		T expected = -2;
+		for(std::size_t i = 0; i != m; ++i){
+			expected += A(i,j) * y(i);
+		}
+		BOOST_CHECK_CLOSE(u(j), expected, tol);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_blocked_product ){
+	checkProduct<float,row_major>(67,1030);
+	checkProduct<float,column_major>(1030,67);
+	checkProduct<double,row_major>(129,70);
+	checkProduct<double,column_major>(70,129);
+}
+
+//strided arguments are computed by the default kernel
+template<class Orientation>
+void checkStrided(){
+	matrix<double,Orientation> A(40,30);
+	fillMatrix(A,1.0);
+	matrix<double,Orientation> X(3,30);
+	fillMatrix(X,-1.0);
+	matrix<double,Orientation> Y(40,4,-1.0);
+	noalias(column(Y,2)) = prod(A,row(X,1));
+	Y.wait();
+	for(std::size_t i = 0; i != 40; ++i){
+		double expected = 0;
+		for(std::size_t j = 0; j != 30; ++j){
+			expected += A(i,j) * X(1,j);
+		}
+		BOOST_CHECK_CLOSE(Y(i,2), expected, 1.e-10);
+		BOOST_CHECK_EQUAL(Y(i,1), -1.0);
+		BOOST_CHECK_EQUAL(Y(i,3), -1.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_blocked_strided ){
+	checkStrided<row_major>();
+	checkStrided<column_major>();
+}
+
+//the range kernel only writes the elements in the range
+template<class Orientation>
+void checkRangeKernel(){
+	std::size_t rows = 150;
+	std::size_t columns = 37;
+	matrix<double,Orientation> A(rows,columns);
+	fillMatrix(A,0.25);
+	vector<double> x(columns);
+	fillVector(x,0.5);
+	vector<double> y(rows,-1.0);
+	kernels::gemv(A, x, y, 2.0, 0.0, 10, 77);
+	kernels::gemv(A, x, y, 1.0, 1.0, 70, 150);
+	for(std::size_t i = 0; i != rows; ++i){
+		double Ax = 0;
+		for(std::size_t j = 0; j != columns; ++j){
+			Ax += A(i,j) * x(j);
+		}
+		double expected = (i >= 10 && i < 77)? 2 * Ax: -1.0;
+		if(i >= 70)
+			expected += Ax;
+		BOOST_CHECK_CLOSE(y(i), expected, 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_blocked_range_kernels ){
+	checkRangeKernel<row_major>();
+	checkRangeKernel<column_major>();
+}
+
+//products above the grain size are split into ranges of rows
+BOOST_AUTO_TEST_CASE( aBLAS_gemv_blocked_parallel ){
+	std::size_t grain = kernels::tuning().parallel_assign_grain_size;
+	kernels::tuning().parallel_assign_grain_size = 256;
+	checkProduct<double,row_major>(300,200);
+	checkProduct<double,column_major>(300,200);
+	kernels::tuning().parallel_assign_grain_size = grain;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
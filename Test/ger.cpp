@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE aBLAS_ger
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/kernels/ger.hpp>
+#include <aBLAS/kernels/dot.hpp>
+
+using namespace aBLAS;
+
+template<class V1, class V2, class M>
+void checkRankOneUpdate(V1 const& x, V2 const& y, M const& result, double factor, double init){
+	BOOST_REQUIRE_EQUAL(x.size(), result.size1());
+	BOOST_REQUIRE_EQUAL(y.size(), result.size2());
+	for(std::size_t i = 0; i != result.size1(); ++i){
+		for(std::size_t j = 0; j != result.size2(); ++j){
+			BOOST_CHECK_CLOSE(result(i,j), init + factor*x(i)*y(j), 1.e-10);
+		}
+	}
+}
+
+template<class Orientation>
+void checkGer(){
+	std::size_t rows = 30;
+	std::size_t columns = 20;
+	vector<double> x(rows);
+	vector<double> y(columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		x(i) = 0.5*i - 3;
+	}
+	for(std::size_t j = 0; j != columns; ++j){
+		y(j) = 2.0 - 0.25*j;
+	}
+	matrix<double,Orientation> result(rows,columns,1.5);
+	kernels::ger(x,y,result,-2.0);
+	checkRankOneUpdate(x,y,result,-2.0,1.5);
+
+	//strided arguments: a row and a column of a row major matrix
+	matrix<double,row_major> args(rows,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			args(i,j) = i - 0.5*j;
+		}
+	}
+	matrix_column<matrix<double,row_major> const> xs(args,3);
+	matrix_row<matrix<double,row_major> const> ys(args,7);
+	matrix<double,Orientation> result2(rows,columns,0.0);
+	kernels::ger(xs,ys,result2,3.0);
+	checkRankOneUpdate(xs,ys,result2,3.0,0.0);
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_ger)
+
+BOOST_AUTO_TEST_CASE( aBLAS_ger_dense ){
+	checkGer<row_major>();
+	checkGer<column_major>();
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_dot_dense ){
+	std::size_t size = 40;
+	matrix<double,row_major> args(size,3);
+	vector<double> x(size);
+	for(std::size_t i = 0; i != size; ++i){
+		args(i,0) = 1.5*i;
+		args(i,2) = 2.0 - i;
+		x(i) = 0.5 + i;
+	}
+	matrix_column<matrix<double,row_major> const> a(args,0);
+	matrix_column<matrix<double,row_major> const> b(args,2);
+	double result = 0;
+	double result_strided = 0;
+	kernels::dot(x,b,result);
+	kernels::dot(a,b,result_strided);
+	double test_result = 0;
+	double test_result_strided = 0;
+	for(std::size_t i = 0; i != size; ++i){
+		test_result += x(i)*args(i,2);
+		test_result_strided += args(i,0)*args(i,2);
+	}
+	BOOST_CHECK_CLOSE(result, test_result, 1.e-10);
+	BOOST_CHECK_CLOSE(result_strided, test_result_strided, 1.e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+#define BOOST_TEST_MODULE aBLAS_mixed_precision
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/half.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/vector_expression.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+#include <cmath>
+#include <limits>
+
+using namespace aBLAS;
+
+//values which are exactly representable in half and aBLAS::bfloat16
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = float(offset + double((i*7+j*3)%11) - 0.5*double(j%5));
+		}
+	}
+}
+
+//we test using the textbook definition.
+template<class Arg1, class Arg2, class Result>
+void checkMatrixMatrixMultiply(Arg1 const& arg1, Arg2 const& arg2, Result const& result, double factor, double init){
+	BOOST_REQUIRE_EQUAL(arg1.size1(), result.size1());
+	BOOST_REQUIRE_EQUAL(arg2.size2(), result.size2());
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			double test_result = init;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += factor * double(arg1(i,k))*double(arg2(k,j));
+			}
+			BOOST_CHECK_CLOSE(double(result(i,j)), test_result,1.e-4);
+		}
+	}
+}
+
+template<class T, class OA, class OB, class OC, class R>
+void checkMixedGemm(std::size_t size1, std::size_t size2, std::size_t size_k){
+	matrix<T,OA> A(size1,size_k);
+	matrix<T,OB> B(size_k,size2);
+	fillMatrix(A,-2.0);
+	fillMatrix(B,1.0);
+	matrix<R,OC> C(size1,size2,std::numeric_limits<R>::quiet_NaN());
+	kernels::gemm(A,B,C,R(2),R(0));
+	checkMatrixMatrixMultiply(A,B,C,2.0,0.0);
+	matrix<R,OC> D(size1,size2,R(1.5));
+	kernels::gemm(A,B,D,R(-1),R(3));
+	checkMatrixMatrixMultiply(A,B,D,-1.0,4.5);
+}
+
+template<class T, class R>
+void checkMixedGemmOrientations(){
+	checkMixedGemm<T,row_major,row_major,row_major,R>(13,300,270);
+	checkMixedGemm<T,row_major,column_major,row_major,R>(5,7,9);
+	checkMixedGemm<T,column_major,row_major,column_major,R>(9,31,17);
+	checkMixedGemm<T,column_major,column_major,column_major,R>(6,5,140);
+}
+
+template<class T, class R, class O>
+void checkMixedGemv(std::size_t size1, std::size_t size2){
+	matrix<T,O> A(size1,size2);
+	fillMatrix(A,0.5);
+	vector<T> x(size2);
+	for(std::size_t j = 0; j != size2; ++j)
+		x(j) = float(j%7) - 3.0f;
+	vector<R> y(size1,std::numeric_limits<R>::quiet_NaN());
+	kernels::gemv(A,x,y,R(2),R(0));
+	vector<R> z(size1,R(1));
+	kernels::gemv(A,x,z,R(1),R(-1));
+	for(std::size_t i = 0; i != size1; ++i){
+		double result = 0;
+		for(std::size_t j = 0; j != size2; ++j)
+			result += double(A(i,j))*double(x(j));
+		BOOST_CHECK_CLOSE(double(y(i)), 2*result, 1.e-4);
+		BOOST_CHECK_CLOSE(double(z(i)), result-1, 1.e-4);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_mixed_precision)
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_conversion ){
+	BOOST_CHECK_EQUAL(sizeof(half), 2u);
+	BOOST_CHECK_EQUAL(sizeof(aBLAS::bfloat16), 2u);
+	//exactly representable values
+	float values[] = {0.0f, -0.0f, 1.0f, -2.5f, 0.099975586f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f};
+	for(float value: values){
+		BOOST_CHECK_EQUAL(float(half(value)), value);
+	}
+	BOOST_CHECK_EQUAL(half(1.0f).bits(), 0x3c00);
+	BOOST_CHECK_EQUAL(half(-2.0f).bits(), 0xc000);
+	BOOST_CHECK_EQUAL(half(65504.0f).bits(), 0x7bff);
+	BOOST_CHECK_EQUAL(half(5.9604645e-08f).bits(), 0x0001);
+	//ties are rounded to even: 1+2^-11 lies between 1 and 1+2^-10
+	BOOST_CHECK_EQUAL(half(1.0f + std::ldexp(1.0f,-11)).bits(), 0x3c00);
+	BOOST_CHECK_EQUAL(half(1.0f + 3*std::ldexp(1.0f,-11)).bits(), 0x3c02);
+	//overflow, infinity and nan
+	BOOST_CHECK_EQUAL(half(65520.0f).bits(), 0x7c00);
+	BOOST_CHECK_EQUAL(half(-std::numeric_limits<float>::infinity()).bits(), 0xfc00);
+	BOOST_CHECK(std::isinf(float(half::from_bits(0x7c00))));
+	BOOST_CHECK(std::isnan(float(half(std::numeric_limits<float>::quiet_NaN()))));
+	//all half values survive a roundtrip through float
+	for(unsigned bits = 0; bits != 0x10000; ++bits){
+		half h = half::from_bits(std::uint16_t(bits));
+		if(std::isnan(float(h))) continue;
+		BOOST_CHECK_EQUAL(half(float(h)).bits(), bits);
+	}
+
+	BOOST_CHECK_EQUAL(aBLAS::bfloat16(1.0f).bits(), 0x3f80);
+	BOOST_CHECK_EQUAL(float(aBLAS::bfloat16(-3.0f)), -3.0f);
+	BOOST_CHECK_EQUAL(float(aBLAS::bfloat16(1e30f)), float(aBLAS::bfloat16::from_bits(aBLAS::bfloat16(1e30f).bits())));
+	BOOST_CHECK_EQUAL(aBLAS::bfloat16(1.0f + std::ldexp(1.0f,-8)).bits(), 0x3f80);
+	BOOST_CHECK_EQUAL(aBLAS::bfloat16(1.0f + 3*std::ldexp(1.0f,-8)).bits(), 0x3f82);
+	BOOST_CHECK(std::isnan(float(aBLAS::bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+	//arithmetic is done in float
+	half h(1.5f);
+	h += 2.0f;
+	h *= 2.0f;
+	BOOST_CHECK_EQUAL(float(h), 7.0f);
+	BOOST_CHECK_EQUAL(half(3.0f) * aBLAS::bfloat16(0.5f), 1.5f);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_promote_traits ){
+	BOOST_CHECK((boost::is_same<promote_traits<half,half>::promote_type, float>::value));
+	BOOST_CHECK((boost::is_same<promote_traits<aBLAS::bfloat16,aBLAS::bfloat16>::promote_type, float>::value));
+	BOOST_CHECK((boost::is_same<promote_traits<half,aBLAS::bfloat16>::promote_type, float>::value));
+	BOOST_CHECK((boost::is_same<promote_traits<half,float>::promote_type, float>::value));
+	BOOST_CHECK((boost::is_same<promote_traits<double,aBLAS::bfloat16>::promote_type, double>::value));
+	typedef matrix_matrix_prod<matrix<half>,matrix<half> > prod_type;
+	BOOST_CHECK((boost::is_same<prod_type::value_type, float>::value));
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_assign ){
+	matrix<float> A(17,23);
+	fillMatrix(A,0.25);
+	matrix<half> Ah = A;
+	matrix<aBLAS::bfloat16,column_major> Ab = A;
+	matrix<float> B = Ah;
+	matrix<float,column_major> C = Ab;
+	B.wait();
+	C.wait();
+	for(std::size_t i = 0; i != 17; ++i){
+		for(std::size_t j = 0; j != 23; ++j){
+			BOOST_CHECK_EQUAL(float(Ah(i,j)), A(i,j));
+			BOOST_CHECK_EQUAL(float(Ab(i,j)), A(i,j));
+			BOOST_CHECK_EQUAL(B(i,j), A(i,j));
+			BOOST_CHECK_EQUAL(C(i,j), A(i,j));
+		}
+	}
+	//values are rounded to nearest
+	vector<float> x(37);
+	for(std::size_t i = 0; i != 37; ++i)
+		x(i) = 1.0f/(i+1);
+	vector<half> xh(37);
+	noalias(xh) = x;
+	vector<double> xd(37);
+	noalias(xd) = xh;
+	xh.wait();
+	xd.wait();
+	for(std::size_t i = 0; i != 37; ++i){
+		BOOST_CHECK_EQUAL(xh(i).bits(), half(x(i)).bits());
+		BOOST_CHECK_EQUAL(xd(i), double(float(half(x(i)))));
+	}
+	//strided vectors and scaled assignment
+	vector<aBLAS::bfloat16> column_b(17);
+	noalias(column_b) = 2.0 * column(A,3);
+	column_b.wait();
+	for(std::size_t i = 0; i != 17; ++i)
+		BOOST_CHECK_EQUAL(float(column_b(i)), 2*A(i,3));
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_gemm ){
+	checkMixedGemmOrientations<half,float>();
+	checkMixedGemmOrientations<aBLAS::bfloat16,float>();
+	checkMixedGemmOrientations<half,double>();
+	checkMixedGemmOrientations<float,double>();
+	//results stored in half are accumulated in float
+	checkMixedGemm<half,row_major,row_major,row_major,half>(4,5,6);
+
+	//prod of half matrices is a float matrix
+	matrix<half> A(20,30);
+	matrix<half,column_major> B(30,10);
+	fillMatrix(A,0.5);
+	fillMatrix(B,-1.0);
+	matrix<float> C = prod(A,B);
+	C.wait();
+	checkMatrixMatrixMultiply(A,B,C,1.0,0.0);
+	matrix<double> D(20,10,1.0);
+	D += prod(A,B);
+	D.wait();
+	checkMatrixMatrixMultiply(A,B,D,1.0,1.0);
+}
+
+//the sum over the whole inner dimension is rounded to half only once. The first 300 products cancel with
+//the next 300 exactly in float, rounding partial sums to half would leave an error much larger than the result
+template<class OA, class OB, class OC>
+void checkHalfResultRounding(){
+	std::size_t size_k = 601;
+	matrix<half,OA> A(3,size_k);
+	matrix<half,OB> B(size_k,4);
+	for(std::size_t k = 0; k != size_k; ++k){
+		for(std::size_t i = 0; i != 3; ++i){
+			A(i,k) = half(float(i+1));
+		}
+		for(std::size_t j = 0; j != 4; ++j){
+			float value = k < 300? 1.0f/3: -1.0f/3;
+			B(k,j) = k < 600? half(value): half(float(j+1)/1024);
+		}
+	}
+	matrix<half,OC> C(3,4);
+	kernels::gemm(A,B,C,half(1.0f),half(0.0f));
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 4; ++j){
+			BOOST_CHECK_EQUAL(float(C(i,j)), float((i+1)*(j+1))/1024);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_gemm_rounding ){
+	checkHalfResultRounding<row_major,row_major,row_major>();
+	checkHalfResultRounding<column_major,row_major,column_major>();
+	checkHalfResultRounding<row_major,column_major,column_major>();
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_half_gemv ){
+	checkMixedGemv<half,float,row_major>(20,1500);
+	checkMixedGemv<half,float,column_major>(1500,20);
+	checkMixedGemv<aBLAS::bfloat16,double,row_major>(7,13);
+	checkMixedGemv<aBLAS::bfloat16,float,column_major>(13,7);
+	checkMixedGemv<float,double,row_major>(9,9);
+
+	matrix<aBLAS::bfloat16> A(8,12);
+	fillMatrix(A,1.0);
+	vector<aBLAS::bfloat16> x(12,aBLAS::bfloat16(0.5f));
+	vector<float> y = prod(A,x);
+	y.wait();
+	for(std::size_t i = 0; i != 8; ++i){
+		double result = 0;
+		for(std::size_t j = 0; j != 12; ++j)
+			result += 0.5*double(A(i,j));
+		BOOST_CHECK_CLOSE(double(y(i)), result, 1.e-4);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
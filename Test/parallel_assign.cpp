@@ -0,0 +1,177 @@
+#define BOOST_TEST_MODULE aBLAS_parallel_assign
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <cmath>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + 0.1*i - 0.05*j;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_parallel_assign)
+
+BOOST_AUTO_TEST_CASE( aBLAS_parallel_assign_ranges ){
+	std::size_t grain = kernels::tuning().parallel_assign_grain_size;
+	kernels::tuning().parallel_assign_grain_size = 1024;
+	//128 doubles per range, at most one range per worker
+	std::vector<std::size_t> bounds = detail::parallel_assign_ranges(1000, sizeof(double), 4);
+	BOOST_REQUIRE_EQUAL(bounds.size(), 5u);
+	BOOST_CHECK_EQUAL(bounds[0], 0u);
+	BOOST_CHECK_EQUAL(bounds[1], 250u);
+	BOOST_CHECK_EQUAL(bounds[2], 500u);
+	BOOST_CHECK_EQUAL(bounds[3], 750u);
+	BOOST_CHECK_EQUAL(bounds[4], 1000u);
+	//too small to be split
+	BOOST_CHECK_EQUAL(detail::parallel_assign_ranges(200, sizeof(double), 4).size(), 2u);
+	BOOST_CHECK_EQUAL(detail::parallel_assign_ranges(100000, sizeof(double), 1).size(), 2u);
+	BOOST_CHECK_EQUAL(detail::parallel_assign_ranges(0, sizeof(double), 4).size(), 2u);
+	//lines larger than the grain size are split line by line
+	BOOST_CHECK_EQUAL(detail::parallel_assign_ranges(3, 100000, 8).size(), 4u);
+	//the ranges cover all elements and are not smaller than the grain
+	for(std::size_t size = 256; size < 100000; size = 3*size+7){
+		bounds = detail::parallel_assign_ranges(size, sizeof(float), 7);
+		BOOST_CHECK_EQUAL(bounds.front(), 0u);
+		BOOST_CHECK_EQUAL(bounds.back(), size);
+		BOOST_CHECK(bounds.size() <= 8u);
+		for(std::size_t i = 0; i + 1 != bounds.size(); ++i){
+			BOOST_CHECK(bounds[i+1] - bounds[i] >= 256u);
+		}
+	}
+	kernels::tuning().parallel_assign_grain_size = grain;
+}
+
+//the range kernels only write the elements in the range
+BOOST_AUTO_TEST_CASE( aBLAS_parallel_assign_vector_range_kernels ){
+	std::size_t size = 301;
+	vector<double> x(size);
+	vector<double> y(size);
+	vector<float> z(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 0.5 + 0.01*i;
+		y(i) = 2.0 - 0.02*i;
+		z(i) = float(0.25*i);
+	}
+	vector<double> r(size,-1.0);
+	kernels::assign<scalar_assign>(r, 2*x+y, 1.0, 10, 150);
+	vector<double> s(size,1.0);
+	kernels::assign<scalar_plus_assign>(s, exp(x), 3.0, 33, 299);
+	vector<half> h(size,half(7.0f));
+	kernels::assign<scalar_assign>(h, z, 1.0f, 64, 200);
+	vector<double> c(size,-1.0);
+	kernels::assign<scalar_assign>(c, y, 2.0, 100, 300);
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_CLOSE(r(i), (i >= 10 && i < 150)? 2*x(i)+y(i) : -1.0, 1.e-10);
+		BOOST_CHECK_CLOSE(s(i), (i >= 33 && i < 299)? 1+3*std::exp(x(i)) : 1.0, 1.e-10);
+		BOOST_CHECK_EQUAL(float(h(i)), (i >= 64 && i < 200)? float(half(z(i))) : 7.0f);
+		BOOST_CHECK_EQUAL(c(i), (i >= 100 && i < 300)? 2*y(i) : -1.0);
+	}
+}
+
+template<class OrientationA, class OrientationB>
+void checkMatrixRangeKernel(){
+	std::size_t rows = 23;
+	std::size_t columns = 17;
+	matrix<double,OrientationA> A(rows,columns,-1.0);
+	matrix<double,OrientationB> B(rows,columns);
+	fillMatrix(B,1.0);
+	//major lines of A
+	std::size_t start = 5;
+	std::size_t end = 13;
+	kernels::assign<scalar_assign>(A, B, 2.0, start, end);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			std::size_t line = OrientationA::index_M(i,j);
+			BOOST_CHECK_EQUAL(A(i,j), (line >= start && line < end)? 2*B(i,j) : -1.0);
+		}
+	}
+	matrix<double,OrientationA> E(rows,columns,0.0);
+	kernels::assign<scalar_plus_assign>(E, tanh(B), 1.0, 0, 4);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			std::size_t line = OrientationA::index_M(i,j);
+			BOOST_CHECK_CLOSE(E(i,j), line < 4? std::tanh(B(i,j)) : 0.0, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_parallel_assign_matrix_range_kernels ){
+	checkMatrixRangeKernel<row_major,row_major>();
+	checkMatrixRangeKernel<row_major,column_major>();
+	checkMatrixRangeKernel<column_major,row_major>();
+	checkMatrixRangeKernel<column_major,column_major>();
+}
+
+//kernels of a group are computed in any order, later kernels wait for all of them
+BOOST_AUTO_TEST_CASE( aBLAS_parallel_assign_group ){
+	std::size_t size = 10000;
+	vector<double> x(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 0.001*i;
+	}
+	vector<double> y(size);
+	noalias(y) = 3*x;
+	std::vector<std::size_t> bounds;
+	for(std::size_t r = 0; r <= 8; ++r)
+		bounds.push_back(r * size / 8);
+	vector<double>::closure_type y_closure(y);
+	vector<double>::const_closure_type x_closure(x);
+	detail::spawn_parallel_assign(bounds, [y_closure,x_closure](std::size_t start, std::size_t end)mutable{
+		kernels::assign<scalar_plus_assign>(y_closure,x_closure,2.0,start,end);
+	},y.dependencies(),x.dependencies());
+	vector<double> z(size);
+	noalias(z) = y + x;
+	z.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_CLOSE(z(i), 6*x(i), 1.e-10);
+	}
+}
+
+//assignments above the grain size give the same results
+BOOST_AUTO_TEST_CASE( aBLAS_parallel_assign_expressions ){
+	std::size_t grain = kernels::tuning().parallel_assign_grain_size;
+	kernels::tuning().parallel_assign_grain_size = 512;
+	std::size_t size = 5000;
+	vector<double> x(size);
+	vector<double> y(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 0.001*i;
+		y(i) = 1.0 - 0.002*i;
+	}
+	vector<double> r(size);
+	noalias(r) = 2*x + y;
+	noalias(r) += sigmoid(y);
+	matrix<double> A(100,70);
+	matrix<double,column_major> B(100,70);
+	fillMatrix(A,1.0);
+	fillMatrix(B,-1.0);
+	matrix<double> C(100,70);
+	noalias(C) = 2*A + B;
+	matrix<double,column_major> D = A;
+	D += B;
+	r.wait();
+	D.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_CLOSE(r(i), 2*x(i) + y(i) + 1/(1+std::exp(-y(i))), 1.e-10);
+	}
+	for(std::size_t i = 0; i != 100; ++i){
+		for(std::size_t j = 0; j != 70; ++j){
+			BOOST_CHECK_CLOSE(C(i,j), 2*A(i,j) + B(i,j), 1.e-10);
+			BOOST_CHECK_CLOSE(D(i,j), A(i,j) + B(i,j), 1.e-10);
+		}
+	}
+	kernels::tuning().parallel_assign_grain_size = grain;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
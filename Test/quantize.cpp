@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE aBLAS_quantize
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/kernels/quantize.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+#include <cstdint>
+#include <cmath>
+
+using namespace aBLAS;
+
+//covers the full range of the 8 bit types
+template<class M>
+void fillMatrix(M& m, int offset){
+	typedef typename M::value_type value_type;
+	int low = std::numeric_limits<value_type>::lowest();
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = value_type(low + int((offset + i*37 + j*101) % 256));
+		}
+	}
+}
+
+//we test using the textbook definition, which is exact for the integer products
+template<class Arg1, class Arg2, class Result>
+void checkIntegerProduct(Arg1 const& arg1, Arg2 const& arg2, Result const& result, long alpha, long init){
+	BOOST_REQUIRE_EQUAL(arg1.size1(), result.size1());
+	BOOST_REQUIRE_EQUAL(arg2.size2(), result.size2());
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			long test_result = 0;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += long(arg1(i,k))*long(arg2(k,j));
+			}
+			BOOST_CHECK_EQUAL(long(result(i,j)), alpha*test_result + init);
+		}
+	}
+}
+
+template<class TA, class TB, class OA, class OB, class OC>
+void checkInt8Gemm(std::size_t size1, std::size_t size2, std::size_t size_k){
+	matrix<TA,OA> A(size1,size_k);
+	matrix<TB,OB> B(size_k,size2);
+	fillMatrix(A,3);
+	fillMatrix(B,17);
+	matrix<std::int32_t,OC> C(size1,size2,-12345);
+	kernels::gemm(A,B,C,1,0);
+	checkIntegerProduct(A,B,C,1,0);
+	matrix<double,OC> D(size1,size2,2.0);
+	kernels::gemm(A,B,D,-2.0,0.5);
+	checkIntegerProduct(A,B,D,-2,1);
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_quantize)
+
+BOOST_AUTO_TEST_CASE( aBLAS_int8_gemm ){
+	//odd inner dimensions, several panels and column counts which are no multiple of the vector size
+	checkInt8Gemm<std::int8_t,std::int8_t,row_major,row_major,row_major>(7,77,33);
+	checkInt8Gemm<std::int8_t,std::int8_t,row_major,row_major,row_major>(5,300,1030);
+	checkInt8Gemm<std::uint8_t,std::int8_t,row_major,column_major,row_major>(9,40,17);
+	checkInt8Gemm<std::int8_t,std::uint8_t,column_major,row_major,column_major>(11,9,600);
+	checkInt8Gemm<std::uint8_t,std::uint8_t,column_major,column_major,row_major>(3,65,1);
+	checkInt8Gemm<std::int8_t,std::int8_t,row_major,row_major,row_major>(4,6,0);
+}
+
+//float results are rounded once from the exact 32 bit sums, although the sums of uint8 products exceed 2^24
+//already for a part of the inner dimension
+BOOST_AUTO_TEST_CASE( aBLAS_int8_gemm_exact ){
+	std::size_t size_k = 1537;
+	matrix<std::uint8_t> A(4,size_k);
+	matrix<std::uint8_t,column_major> B(size_k,5);
+	for(std::size_t k = 0; k != size_k; ++k){
+		for(std::size_t i = 0; i != 4; ++i){
+			A(i,k) = std::uint8_t(255 - (k % 7 == i? 1: 0));
+		}
+		for(std::size_t j = 0; j != 5; ++j){
+			B(k,j) = std::uint8_t(255 - ((k + j) % 5 == 0? 3: 0));
+		}
+	}
+	matrix<float> C(4,5);
+	kernels::gemm(A,B,C,1.0f,0.0f);
+	for(std::size_t i = 0; i != 4; ++i){
+		for(std::size_t j = 0; j != 5; ++j){
+			long sum = 0;
+			for(std::size_t k = 0; k != size_k; ++k){
+				sum += long(A(i,k)) * long(B(k,j));
+			}
+			BOOST_CHECK_EQUAL(C(i,j), float(sum));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_int8_prod ){
+	typedef matrix_matrix_prod<matrix<std::int8_t>,matrix<std::int8_t> > prod_type;
+	BOOST_CHECK((boost::is_same<prod_type::value_type, int>::value));
+	matrix<std::int8_t> A(10,50);
+	matrix<std::int8_t,column_major> B(50,20);
+	fillMatrix(A,0);
+	fillMatrix(B,5);
+	matrix<std::int32_t> C = prod(A,B);
+	C.wait();
+	checkIntegerProduct(A,B,C,1,0);
+	matrix<float> D(10,20,1.0f);
+	D += 2*prod(A,B);
+	D.wait();
+	checkIntegerProduct(A,B,D,2,1);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_quantize_dequantize ){
+	std::size_t size1 = 6;
+	std::size_t size2 = 9;
+	matrix<float> X(size1,size2);
+	for(std::size_t i = 0; i != size1; ++i)
+		for(std::size_t j = 0; j != size2; ++j)
+			X(i,j) = std::sin(float(i*size2 + j)) * (i+1);
+
+	//rounding to nearest and saturation
+	vector<float> ones(size1,1.0f);
+	matrix<float> Y(size1,size2);
+	for(std::size_t i = 0; i != size1; ++i)
+		for(std::size_t j = 0; j != size2; ++j)
+			Y(i,j) = 100.0f * i - 250.5f + j;
+	matrix<std::int8_t> Yq(size1,size2);
+	kernels::quantize_rows(Y,ones,Yq);
+	for(std::size_t i = 0; i != size1; ++i){
+		for(std::size_t j = 0; j != size2; ++j){
+			float rounded = std::max(-128.0f,std::min(127.0f,std::nearbyint(Y(i,j))));
+			BOOST_CHECK_EQUAL(int(Yq(i,j)), int(rounded));
+		}
+	}
+
+	//per row scales: each row uses the full range
+	vector<float> row_scales(size1);
+	for(std::size_t i = 0; i != size1; ++i){
+		float max_abs = 0;
+		for(std::size_t j = 0; j != size2; ++j)
+			max_abs = std::max(max_abs, std::abs(X(i,j)));
+		row_scales(i) = max_abs / 127;
+	}
+	matrix<std::int8_t> Xq(size1,size2);
+	kernels::quantize_rows(X,row_scales,Xq);
+	matrix<float,column_major> Xd(size1,size2);
+	kernels::dequantize_rows(Xq,row_scales,Xd);
+	for(std::size_t i = 0; i != size1; ++i){
+		for(std::size_t j = 0; j != size2; ++j){
+			BOOST_CHECK(std::abs(Xd(i,j) - X(i,j)) <= 0.5f * row_scales(i) * 1.0001f);
+		}
+	}
+
+	//per column scales
+	vector<float> column_scales(size2, 0.01f);
+	matrix<std::int8_t,column_major> Xc(size1,size2);
+	kernels::quantize_columns(X,column_scales,Xc);
+	matrix<double> Xcd(size1,size2);
+	kernels::dequantize_columns(Xc,column_scales,Xcd);
+	for(std::size_t i = 0; i != size1; ++i){
+		for(std::size_t j = 0; j != size2; ++j){
+			double saturated = std::max(-1.28,std::min(1.27,double(X(i,j))));
+			BOOST_CHECK_SMALL(Xcd(i,j) - saturated, 0.0051);
+		}
+	}
+}
+
+//A quantized by rows and B by columns: the int32 product dequantizes to an approximation of A*B
+BOOST_AUTO_TEST_CASE( aBLAS_quantized_gemm ){
+	std::size_t size1 = 5;
+	std::size_t size2 = 7;
+	std::size_t size_k = 40;
+	matrix<float> A(size1,size_k);
+	matrix<float> B(size_k,size2);
+	for(std::size_t i = 0; i != size1; ++i)
+		for(std::size_t k = 0; k != size_k; ++k)
+			A(i,k) = std::cos(float(i + 3*k));
+	for(std::size_t k = 0; k != size_k; ++k)
+		for(std::size_t j = 0; j != size2; ++j)
+			B(k,j) = std::sin(float(2*k + j));
+	vector<float> scalesA(size1, 1.0f/127);
+	vector<float> scalesB(size2, 1.0f/127);
+	matrix<std::int8_t> Aq(size1,size_k);
+	matrix<std::int8_t> Bq(size_k,size2);
+	kernels::quantize_rows(A,scalesA,Aq);
+	kernels::quantize_columns(B,scalesB,Bq);
+	matrix<std::int32_t> Cq(size1,size2);
+	noalias(Cq) = prod(Aq,Bq);
+	Cq.wait();
+	matrix<float> C(size1,size2);
+	kernels::dequantize(Cq,scalesA,scalesB,C);
+	for(std::size_t i = 0; i != size1; ++i){
+		for(std::size_t j = 0; j != size2; ++j){
+			double result = 0;
+			for(std::size_t k = 0; k != size_k; ++k)
+				result += A(i,k)*B(k,j);
+			BOOST_CHECK_SMALL(C(i,j) - result, 0.2);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
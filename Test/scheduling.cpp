@@ -0,0 +1,68 @@
+#define BOOST_TEST_MODULE aBLAS_scheduling
+#include <boost/test/unit_test.hpp>
+
+#include <aBLAS/scheduling/scheduling.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace aBLAS;
+
+namespace{
+void sleep_ms(int milliseconds){
+	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_scheduling)
+
+//all readers of a variable wait for the last writer, not only the first one
+BOOST_AUTO_TEST_CASE( aBLAS_scheduling_readers_wait_for_writer ){
+	scheduling::dependency_node x;
+	scheduling::dependency_node y1;
+	scheduling::dependency_node y2;
+	std::atomic<int> written(0);
+	std::atomic<int> read_before_write(0);
+	system::scheduler().spawn([&](){sleep_ms(20); written = 1;}, x);
+	system::scheduler().spawn([&](){if(!written) ++read_before_write;}, y1, x);
+	system::scheduler().spawn([&](){if(!written) ++read_before_write;}, y2, x);
+	y1.wait();
+	y2.wait();
+	BOOST_CHECK_EQUAL(written.load(), 1);
+	BOOST_CHECK_EQUAL(read_before_write.load(), 0);
+	BOOST_CHECK(x.is_ready());
+}
+
+//a writer waits for all readers since the last write
+BOOST_AUTO_TEST_CASE( aBLAS_scheduling_writer_waits_for_readers ){
+	scheduling::dependency_node x;
+	scheduling::dependency_node y;
+	std::atomic<int> read(0);
+	std::atomic<int> written_before_read(0);
+	system::scheduler().spawn([&](){sleep_ms(20); read = 1;}, y, x);
+	system::scheduler().spawn([&](){if(!read) ++written_before_read;}, x);
+	x.wait();
+	BOOST_CHECK_EQUAL(read.load(), 1);
+	BOOST_CHECK_EQUAL(written_before_read.load(), 0);
+	y.wait();
+}
+
+//a variable which is read and written by the same work item, e.g. x = x + y, can be destroyed as soon as it is ready.
+//the scheduler must not access it after its last dependency is removed. This is checked by the address sanitizer.
+BOOST_AUTO_TEST_CASE( aBLAS_scheduling_read_write_destruction ){
+	for(std::size_t iter = 0; iter != 1000; ++iter){
+		std::unique_ptr<scheduling::dependency_node> x(new scheduling::dependency_node());
+		scheduling::dependency_node y;
+		system::scheduler().spawn([](){}, *x, *x);
+		system::scheduler().spawn([](){}, *x, *x, y);
+		system::scheduler().spawn([](){}, {x.get(), &y}, {x.get(), &y});
+		x->wait();
+		x.reset();
+		y.wait();
+	}
+	system::scheduler().wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
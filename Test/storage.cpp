@@ -0,0 +1,91 @@
+#define BOOST_TEST_MODULE aBLAS_storage
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+//every major row starts on a cache line boundary
+#define ABLAS_PAD_LEADING_DIMENSION
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/kernels/gemm.hpp>
+
+#include <cstdint>
+
+using namespace aBLAS;
+
+template<class M>
+void checkRowAlignment(M const& m){
+	std::size_t major = M::orientation::index_M(m.size1(),m.size2());
+	for(std::size_t i = 0; i != major; ++i){
+		double const* row = m.storage().data() + i * m.leading_dimension();
+		BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(row) % detail::storage_alignment, 0u);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_storage)
+
+BOOST_AUTO_TEST_CASE( aBLAS_storage_alignment ){
+	matrix<double,row_major> Arm(13,21);
+	matrix<double,column_major> Acm(13,21);
+	BOOST_CHECK_EQUAL(Arm.leading_dimension(), 24u);
+	BOOST_CHECK_EQUAL(Arm.stride1(), 24);
+	BOOST_CHECK_EQUAL(Arm.stride2(), 1);
+	BOOST_CHECK_EQUAL(Acm.leading_dimension(), 16u);
+	BOOST_CHECK_EQUAL(Acm.stride1(), 1);
+	BOOST_CHECK_EQUAL(Acm.stride2(), 16);
+	checkRowAlignment(Arm);
+	checkRowAlignment(Acm);
+
+	//512 doubles are exactly 4096 bytes, so an additional cache line is added
+	matrix<double> B(4,512);
+	BOOST_CHECK_EQUAL(B.leading_dimension(), 520u);
+	checkRowAlignment(B);
+
+	//resizing recomputes the padding
+	B.resize(3,7);
+	BOOST_CHECK_EQUAL(B.leading_dimension(), 8u);
+	BOOST_CHECK_EQUAL(B.storage().size(), 24u);
+	checkRowAlignment(B);
+
+	vector<double> v(17);
+	BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(v.storage().data()) % detail::storage_alignment, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_storage_padded_gemm ){
+	std::size_t rows = 13;
+	std::size_t columns = 21;
+	std::size_t middle = 7;
+	matrix<double,row_major> arg1(rows,middle);
+	matrix<double,column_major> arg2(middle,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t k = 0; k != middle; ++k){
+			arg1(i,k) = i+0.5*k;
+		}
+	}
+	for(std::size_t k = 0; k != middle; ++k){
+		for(std::size_t j = 0; j != columns; ++j){
+			arg2(k,j) = 0.25*k-j;
+		}
+	}
+	matrix<double,row_major> result(rows,columns,1.5);
+	kernels::gemm(arg1,arg2,result,2.0);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			double test_result = 1.5;
+			for(std::size_t k = 0; k != middle; ++k){
+				test_result += 2.0*arg1(i,k)*arg2(k,j);
+			}
+			BOOST_CHECK_CLOSE(result(i,j), test_result, 1.e-10);
+		}
+	}
+
+	//copies keep the layout
+	matrix<double,row_major> copy(result);
+	BOOST_CHECK_EQUAL(copy.leading_dimension(), result.leading_dimension());
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_EQUAL(copy(i,j), result(i,j));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
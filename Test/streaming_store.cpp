@@ -0,0 +1,205 @@
+#define BOOST_TEST_MODULE aBLAS_streaming_store
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <vector>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + 0.1*i - 0.05*j;
+		}
+	}
+}
+
+//sets the tuning parameters for the lifetime of the object
+struct scoped_tuning{
+	scoped_tuning(std::size_t streaming_store_min_size, std::size_t parallel_assign_grain_size)
+	:m_parameters(kernels::tuning()){
+		kernels::tuning().streaming_store_min_size = streaming_store_min_size;
+		kernels::tuning().parallel_assign_grain_size = parallel_assign_grain_size;
+	}
+	~scoped_tuning(){
+		kernels::tuning() = m_parameters;
+	}
+	kernels::tuning_parameters m_parameters;
+};
+
+//all offsets are tried, so that the stores start at every alignment
+template<class T>
+void checkStreamingKernels(){
+	std::size_t size = 103;
+	std::vector<T> x(size + 16);
+	for(std::size_t i = 0; i != x.size(); ++i){
+		x[i] = T(i % 17);
+	}
+	for(std::size_t offset = 0; offset != 8; ++offset){
+		for(std::size_t n : {std::size_t(0), std::size_t(1), std::size_t(5), std::size_t(16), size}){
+			std::vector<T> y(size + 16, T(-1));
+			bindings::stream_fill(n, T(3), y.data() + offset);
+			for(std::size_t i = 0; i != y.size(); ++i){
+				BOOST_REQUIRE_EQUAL(y[i], (i >= offset && i < offset + n)? T(3): T(-1));
+			}
+			std::vector<T> z(size + 16, T(-1));
+			bindings::stream_copy(n, T(1), x.data() + 3, z.data() + offset);
+			std::vector<T> w(size + 16, T(-1));
+			bindings::stream_copy(n, T(2), x.data(), w.data() + offset);
+			for(std::size_t i = 0; i != z.size(); ++i){
+				bool inside = i >= offset && i < offset + n;
+				BOOST_REQUIRE_EQUAL(z[i], inside? x[i - offset + 3]: T(-1));
+				BOOST_REQUIRE_EQUAL(w[i], inside? 2 * x[i - offset]: T(-1));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_streaming_store)
+
+BOOST_AUTO_TEST_CASE( aBLAS_streaming_store_kernels ){
+	checkStreamingKernels<float>();
+	checkStreamingKernels<double>();
+	//types without non-temporal stores use ordinary stores
+	checkStreamingKernels<int>();
+}
+
+//with a threshold of 0 all fills and copies use non-temporal stores
+BOOST_AUTO_TEST_CASE( aBLAS_streaming_store_vector ){
+	scoped_tuning tuning(0, kernels::tuning().parallel_assign_grain_size);
+	std::size_t size = 1001;
+	vector<double> x(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = 0.5 + 0.01*i;
+	}
+	vector<double> y = x;
+	vector<double> z(size);
+	noalias(z) = 3*x;
+	//rows of a column major matrix are strided and use ordinary stores
+	matrix<double> R(3, size, 1.0);
+	matrix<double,column_major> S(3, size, 1.0);
+	noalias(row(R,1)) = x;
+	noalias(row(S,2)) = x;
+	vector<float> c(size, 2.0f);
+	c.clear();
+	vector<double> f(size);
+	kernels::assign<scalar_assign>(f, 4.0);
+	y.wait();
+	z.wait();
+	R.wait();
+	S.wait();
+	c.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_EQUAL(y(i), x(i));
+		BOOST_CHECK_CLOSE(z(i), 3*x(i), 1.e-12);
+		BOOST_CHECK_EQUAL(R(1,i), x(i));
+		BOOST_CHECK_EQUAL(R(0,i), 1.0);
+		BOOST_CHECK_EQUAL(S(2,i), x(i));
+		BOOST_CHECK_EQUAL(S(1,i), 1.0);
+		BOOST_CHECK_EQUAL(c(i), 0.0f);
+		BOOST_CHECK_EQUAL(f(i), 4.0);
+	}
+}
+
+template<class Orientation>
+void checkStreamingMatrix(){
+	scoped_tuning tuning(0, kernels::tuning().parallel_assign_grain_size);
+	std::size_t rows = 37;
+	std::size_t columns = 23;
+	matrix<double,Orientation> A(rows,columns);
+	fillMatrix(A,1.0);
+	matrix<double,Orientation> B = A;
+	matrix<double,Orientation> C(rows,columns);
+	noalias(C) = 2*A;
+	//proxies are not contiguous and are copied line by line
+	matrix<double,Orientation> D(rows+2,columns+3,-1.0);
+	noalias(subrange(D,1,rows+1,2,columns+2)) = A;
+	matrix<float,Orientation> E(rows,columns,1.0f);
+	E.clear();
+	matrix<double,Orientation> F(rows+2,columns+3,-1.0);
+	subrange(F,1,rows+1,2,columns+2).clear();
+	B.wait();
+	C.wait();
+	D.wait();
+	E.wait();
+	F.wait();
+	for(std::size_t i = 0; i != rows+2; ++i){
+		for(std::size_t j = 0; j != columns+3; ++j){
+			bool inside = i >= 1 && i < rows+1 && j >= 2 && j < columns+2;
+			BOOST_CHECK_EQUAL(D(i,j), inside? A(i-1,j-2): -1.0);
+			BOOST_CHECK_EQUAL(F(i,j), inside? 0.0: -1.0);
+		}
+	}
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_EQUAL(B(i,j), A(i,j));
+			BOOST_CHECK_CLOSE(C(i,j), 2*A(i,j), 1.e-12);
+			BOOST_CHECK_EQUAL(E(i,j), 0.0f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_streaming_store_matrix ){
+	checkStreamingMatrix<row_major>();
+	checkStreamingMatrix<column_major>();
+}
+
+//the range kernels of constant assignments only write the elements in the range
+BOOST_AUTO_TEST_CASE( aBLAS_streaming_store_range_kernels ){
+	for(std::size_t threshold : {std::size_t(0), std::size_t(-1)}){
+		scoped_tuning tuning(threshold, kernels::tuning().parallel_assign_grain_size);
+		vector<double> x(100, 1.0);
+		kernels::assign<scalar_assign>(x, 5.0, 10, 60);
+		kernels::assign<scalar_plus_assign>(x, 2.0, 50, 100);
+		for(std::size_t i = 0; i != 100; ++i){
+			double expected = (i >= 10 && i < 60)? 5.0: 1.0;
+			if(i >= 50)
+				expected += 2.0;
+			BOOST_CHECK_EQUAL(x(i), expected);
+		}
+		matrix<double,column_major> A(20,30,1.0);
+		kernels::assign<scalar_assign>(A, 3.0, 4, 17);
+		for(std::size_t i = 0; i != 20; ++i){
+			for(std::size_t j = 0; j != 30; ++j){
+				BOOST_CHECK_EQUAL(A(i,j), (j >= 4 && j < 17)? 3.0: 1.0);
+			}
+		}
+	}
+}
+
+//large clears are split in parallel kernels
+BOOST_AUTO_TEST_CASE( aBLAS_streaming_store_parallel_clear ){
+	scoped_tuning tuning(std::size_t(-1), 1024);
+	std::size_t size = 10000;
+	vector<double> x(size, 1.0);
+	vector<double> y(size);
+	noalias(y) = 2*x;
+	x.clear();
+	noalias(y) += x;
+	matrix<double> A(200,150,1.0);
+	matrix<double,column_major> B(200,150);
+	noalias(B) = 2*A;
+	A.clear();
+	noalias(B) += A;
+	y.wait();
+	B.wait();
+	for(std::size_t i = 0; i != size; ++i){
+		BOOST_CHECK_EQUAL(x(i), 0.0);
+		BOOST_CHECK_EQUAL(y(i), 2.0);
+	}
+	for(std::size_t i = 0; i != 200; ++i){
+		for(std::size_t j = 0; j != 150; ++j){
+			BOOST_CHECK_EQUAL(A(i,j), 0.0);
+			BOOST_CHECK_EQUAL(B(i,j), 2.0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+#define BOOST_TEST_MODULE aBLAS_synchronous
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+//all kernels are computed directly in the calling thread
+#define ABLAS_SYNCHRONOUS
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+using namespace aBLAS;
+
+BOOST_AUTO_TEST_SUITE (aBLAS_synchronous)
+
+BOOST_AUTO_TEST_CASE( aBLAS_synchronous_expressions ){
+	std::size_t rows = 20;
+	std::size_t columns = 30;
+	std::size_t middle = 10;
+	matrix<double> A(rows,middle);
+	matrix<double> B(middle,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t k = 0; k != middle; ++k){
+			A(i,k) = i+0.5*k;
+		}
+	}
+	for(std::size_t k = 0; k != middle; ++k){
+		for(std::size_t j = 0; j != columns; ++j){
+			B(k,j) = 0.25*k-j;
+		}
+	}
+
+	//no kernel is in flight after the statements, so results can be checked without waiting
+	std::cout<<"testing C=AB"<<std::endl;
+	matrix<double> C(rows,columns,1.0);
+	noalias(C) = prod(A,B);
+	BOOST_CHECK(C.is_ready());
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			double result = 0;
+			for(std::size_t k = 0; k != middle; ++k){
+				result += A(i,k)*B(k,j);
+			}
+			BOOST_CHECK_CLOSE(C(i,j), result, 1.e-10);
+		}
+	}
+
+	std::cout<<"testing y=Ax"<<std::endl;
+	vector<double> x(middle);
+	for(std::size_t k = 0; k != middle; ++k){
+		x(k) = 1.0-0.5*k;
+	}
+	vector<double> y(rows,1.0);
+	noalias(y) = prod(A,x);
+	BOOST_CHECK(y.is_ready());
+	for(std::size_t i = 0; i != rows; ++i){
+		double result = 0;
+		for(std::size_t k = 0; k != middle; ++k){
+			result += A(i,k)*x(k);
+		}
+		BOOST_CHECK_CLOSE(y(i), result, 1.e-10);
+	}
+
+	std::cout<<"testing C+=2*D+1"<<std::endl;
+	matrix<double> D(rows,columns,3.0);
+	matrix<double> CPrev(C);
+	noalias(C) += 2*D+1;
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			BOOST_CHECK_CLOSE(C(i,j), CPrev(i,j)+7.0, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
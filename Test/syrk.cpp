@@ -0,0 +1,142 @@
+#define BOOST_TEST_MODULE aBLAS_syrk
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <limits>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = typename M::value_type(offset + 0.1*(i % 7) - 0.05*(j % 11));
+		}
+	}
+}
+
+//checks M = beta*M0 + alpha*E*E^T for a non symmetric M0
+template<class M, class M0, class E>
+void checkResult(M const& m, M0 const& m0, E const& e, double alpha, double beta){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			double expected = 0;
+			for(std::size_t k = 0; k != e.size2(); ++k){
+				expected += e(i,k) * e(j,k);
+			}
+			expected *= alpha;
+			if(beta != 0)
+				expected += beta * m0(i,j);
+			BOOST_REQUIRE_SMALL(m(i,j) - expected, 1.e-10);
+		}
+	}
+}
+
+template<class OrientationE, class OrientationM>
+void checkKernel(std::size_t n, std::size_t k){
+	matrix<double,OrientationE> E(n,k);
+	fillMatrix(E,0.5);
+	matrix<double,OrientationM> M0(n,n);
+	fillMatrix(M0,-1.0);
+	matrix<double,OrientationM> M(n,n,std::numeric_limits<double>::quiet_NaN());
+	kernels::syrk(E, M, 2.0, 0.0);
+	checkResult(M, M0, E, 2.0, 0.0);
+	matrix<double,OrientationM> N = M0;
+	N.wait();
+	kernels::syrk(E, N, 0.5, -1.5);
+	checkResult(N, M0, E, 0.5, -1.5);
+	//the transpose of a k x n matrix
+	matrix<double,OrientationE> F(k,n);
+	fillMatrix(F,0.25);
+	kernels::syrk(trans(F), M, 1.0, 0.0);
+	checkResult(M, M0, trans(F), 1.0, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_syrk)
+
+BOOST_AUTO_TEST_CASE( aBLAS_syrk_kernel ){
+	std::size_t block_size = kernels::tuning().syrk_block_size;
+	//sizes around multiples of the block size
+	kernels::tuning().syrk_block_size = 8;
+	std::size_t const sizes[] = {0, 1, 7, 8, 9, 17, 33};
+	for(std::size_t n : sizes){
+		for(std::size_t k : {std::size_t(0), std::size_t(1), std::size_t(13)}){
+			checkKernel<row_major,row_major>(n,k);
+			checkKernel<row_major,column_major>(n,k);
+			checkKernel<column_major,row_major>(n,k);
+			checkKernel<column_major,column_major>(n,k);
+		}
+	}
+	kernels::tuning().syrk_block_size = block_size;
+	checkKernel<row_major,row_major>(150,40);
+	checkKernel<column_major,row_major>(130,70);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_syrk_is_transpose_of ){
+	matrix<double> A(10,6);
+	matrix<double> B(10,6);
+	matrix<double,column_major> C(6,10);
+	matrix<double> S(6,6);
+	BOOST_CHECK(kernels::is_transpose_of(A,trans(A)));
+	BOOST_CHECK(kernels::is_transpose_of(trans(A),A));
+	BOOST_CHECK(kernels::is_transpose_of(subrange(A,2,5,1,4),trans(subrange(A,2,5,1,4))));
+	BOOST_CHECK(!kernels::is_transpose_of(A,trans(B)));
+	BOOST_CHECK(!kernels::is_transpose_of(subrange(A,2,5,1,4),trans(subrange(A,3,6,1,4))));
+	//same storage, but the elements are not transposed
+	BOOST_CHECK(!kernels::is_transpose_of(S,S));
+	BOOST_CHECK(kernels::is_transpose_of(C,trans(C)));
+	BOOST_CHECK(!kernels::is_transpose_of(A,C));
+}
+
+template<class Orientation>
+void checkProduct(){
+	std::size_t n = 37;
+	std::size_t k = 23;
+	matrix<double,Orientation> A(n,k);
+	fillMatrix(A,1.0);
+	matrix<double> M0(n,n);
+	fillMatrix(M0,2.0);
+	matrix<double> P = prod(A,trans(A));
+	matrix<double,column_major> Q(k,k);
+	noalias(Q) = prod(trans(A),A);
+	matrix<double> R = M0;
+	noalias(R) += 3*prod(A,trans(A));
+	//subranges of the same matrix
+	matrix<double> S(10,10,0.0);
+	noalias(S) = prod(subrange(A,0,10,5,20),trans(subrange(A,0,10,5,20)));
+	//different matrices are computed by gemm
+	matrix<double,Orientation> B = A;
+	B(3,4) = 7;
+	matrix<double> T = prod(A,trans(B));
+	P.wait();
+	Q.wait();
+	R.wait();
+	S.wait();
+	T.wait();
+	checkResult(P, M0, A, 1.0, 0.0);
+	checkResult(Q, M0, trans(A), 1.0, 0.0);
+	checkResult(R, M0, A, 3.0, 1.0);
+	matrix<double> Asub = subrange(A,0,10,5,20);
+	Asub.wait();
+	checkResult(S, M0, Asub, 1.0, 0.0);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			double expected = 0;
+			for(std::size_t l = 0; l != k; ++l){
+				expected += A(i,l) * B(j,l);
+			}
+			BOOST_CHECK_SMALL(T(i,j) - expected, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_syrk_product ){
+	checkProduct<row_major>();
+	checkProduct<column_major>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
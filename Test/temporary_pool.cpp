@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE aBLAS_temporary_pool
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+using namespace aBLAS;
+
+BOOST_AUTO_TEST_SUITE (aBLAS_temporary_pool)
+
+BOOST_AUTO_TEST_CASE( aBLAS_temporary_pool_size_class ){
+	typedef detail::temporary_pool pool;
+	BOOST_CHECK_EQUAL(pool::size_class(0), 64u);
+	BOOST_CHECK_EQUAL(pool::size_class(1), 64u);
+	BOOST_CHECK_EQUAL(pool::size_class(64), 64u);
+	BOOST_CHECK_EQUAL(pool::size_class(65), 128u);
+	BOOST_CHECK_EQUAL(pool::size_class(1024), 1024u);
+	BOOST_CHECK_EQUAL(pool::size_class(1025), 1152u);
+	//the waste is bounded by 1/8 of the request
+	for(std::size_t bytes = 1; bytes < 1000000; bytes = bytes*3+1){
+		BOOST_CHECK(pool::size_class(bytes) >= bytes);
+		BOOST_CHECK(pool::size_class(bytes) <= bytes + bytes/8 + 64);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_temporary_pool_reuse ){
+	detail::temporary_pool& pool = detail::temporary_pool::instance();
+	pool.release();
+	void* block = pool.allocate(10000);
+	pool.deallocate(block, 10000);
+	BOOST_CHECK_EQUAL(pool.cached_bytes(), detail::temporary_pool::size_class(10000));
+	//a request of the same size class gets the same block back
+	void* block2 = pool.allocate(9990);
+	BOOST_CHECK_EQUAL(block, block2);
+	BOOST_CHECK_EQUAL(pool.cached_bytes(), 0u);
+	pool.deallocate(block2, 9990);
+
+	//blocks beyond the limit are freed
+	pool.release();
+	std::size_t max_bytes = pool.max_cached_bytes();
+	pool.set_max_cached_bytes(0);
+	block = pool.allocate(10000);
+	pool.deallocate(block, 10000);
+	BOOST_CHECK_EQUAL(pool.cached_bytes(), 0u);
+	pool.set_max_cached_bytes(max_bytes);
+}
+
+//C+=AB creates a temporary for the product in every iteration.
+//after the first iteration all temporaries are taken from the pool
+BOOST_AUTO_TEST_CASE( aBLAS_temporary_pool_steady_state ){
+	std::size_t rows = 40;
+	std::size_t columns = 30;
+	std::size_t middle = 20;
+	matrix<double> A(rows,middle);
+	matrix<double> B(middle,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t k = 0; k != middle; ++k){
+			A(i,k) = i+0.5*k;
+		}
+	}
+	for(std::size_t k = 0; k != middle; ++k){
+		for(std::size_t j = 0; j != columns; ++j){
+			B(k,j) = 0.25*k-j;
+		}
+	}
+	detail::temporary_pool& pool = detail::temporary_pool::instance();
+	pool.release();
+	matrix<double> C(rows,columns,0.0);
+	C += prod(A,B);
+	C.wait();
+	system::scheduler().wait();
+	std::size_t cached = pool.cached_bytes();
+	BOOST_CHECK(cached > 0);
+	for(std::size_t iter = 0; iter != 5; ++iter){
+		C += prod(A,B);
+		C.wait();
+		system::scheduler().wait();
+		BOOST_CHECK_EQUAL(pool.cached_bytes(), cached);
+	}
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			double result = 0;
+			for(std::size_t k = 0; k != middle; ++k){
+				result += A(i,k)*B(k,j);
+			}
+			BOOST_CHECK_CLOSE(C(i,j), 6*result, 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,191 @@
+#define BOOST_TEST_MODULE aBLAS_transpose
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <vector>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = typename M::value_type(offset + 3*i + 0.5*j);
+		}
+	}
+}
+
+//sizes around the tile and register block sizes
+std::size_t const sizes[] = {1, 3, 4, 7, 8, 9, 31, 32, 33, 64, 65, 100, 129};
+
+template<class T>
+void checkTransposeKernel(std::size_t rows, std::size_t cols){
+	std::ptrdiff_t lda = cols + 3;
+	std::ptrdiff_t ldb = rows + 5;
+	std::vector<T> A(rows * lda);
+	for(std::size_t i = 0; i != A.size(); ++i){
+		A[i] = T(i % 1000);
+	}
+	std::vector<T> B(cols * ldb, T(-1));
+	bindings::transpose(rows, cols, A.data(), lda, B.data(), ldb);
+	for(std::size_t j = 0; j != cols; ++j){
+		for(std::size_t i = 0; i != std::size_t(ldb); ++i){
+			//the padding is not written
+			T expected = i < rows? A[i * lda + j] : T(-1);
+			BOOST_REQUIRE_EQUAL(B[j * ldb + i], expected);
+		}
+	}
+}
+
+template<class T>
+void checkTransposeInplaceKernel(std::size_t n){
+	std::ptrdiff_t lda = n + 2;
+	std::vector<T> A(n * lda);
+	for(std::size_t i = 0; i != A.size(); ++i){
+		A[i] = T(i % 1000);
+	}
+	std::vector<T> B = A;
+	bindings::transpose_inplace(n, B.data(), lda);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != std::size_t(lda); ++j){
+			T expected = j < n? A[j * lda + i] : A[i * lda + j];
+			BOOST_REQUIRE_EQUAL(B[i * lda + j], expected);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_transpose)
+
+BOOST_AUTO_TEST_CASE( aBLAS_transpose_kernel ){
+	for(std::size_t rows : sizes){
+		for(std::size_t cols : sizes){
+			checkTransposeKernel<float>(rows, cols);
+			checkTransposeKernel<double>(rows, cols);
+			checkTransposeKernel<int>(rows, cols);
+		}
+	}
+	checkTransposeKernel<float>(300, 517);
+	checkTransposeKernel<double>(517, 300);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_transpose_inplace_kernel ){
+	for(std::size_t n : sizes){
+		checkTransposeInplaceKernel<float>(n);
+		checkTransposeInplaceKernel<double>(n);
+		checkTransposeInplaceKernel<int>(n);
+	}
+	checkTransposeInplaceKernel<float>(300);
+	checkTransposeInplaceKernel<double>(257);
+}
+
+//assignments between different orientations use the transpose kernel
+template<class T, class OrientationA, class OrientationB>
+void checkTransposedAssign(std::size_t rows, std::size_t cols){
+	matrix<T,OrientationB> B(rows,cols);
+	fillMatrix(B,1.0);
+	matrix<T,OrientationA> A = B;
+	matrix<T,OrientationA> C(rows,cols,T(1));
+	noalias(C) += 2*B;
+	//proxies with a leading dimension larger than the size
+	matrix<T,OrientationA> D(rows+4,cols+3,T(-1));
+	noalias(subrange(D,2,rows+2,1,cols+1)) = subrange(trans(trans(B)),0,rows,0,cols);
+	A.wait();
+	C.wait();
+	D.wait();
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != cols; ++j){
+			BOOST_REQUIRE_EQUAL(A(i,j), B(i,j));
+			BOOST_REQUIRE_EQUAL(C(i,j), T(1) + 2*B(i,j));
+			BOOST_REQUIRE_EQUAL(D(i+2,j+1), B(i,j));
+		}
+	}
+	for(std::size_t i = 0; i != rows+4; ++i){
+		BOOST_CHECK_EQUAL(D(i,0), T(-1));
+		BOOST_CHECK_EQUAL(D(i,cols+1), T(-1));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_transpose_assign ){
+	for(std::size_t rows : sizes){
+		for(std::size_t cols : sizes){
+			checkTransposedAssign<float,row_major,column_major>(rows,cols);
+			checkTransposedAssign<double,column_major,row_major>(rows,cols);
+		}
+	}
+	checkTransposedAssign<int,row_major,column_major>(70,45);
+	//the range kernels only write their major lines
+	matrix<double,column_major> B(50,40);
+	fillMatrix(B,-2.0);
+	matrix<double> A(50,40,0.0);
+	kernels::assign<scalar_assign>(A, B, 1.0, 10, 45);
+	kernels::assign<scalar_plus_assign>(A, B, 3.0, 0, 20);
+	for(std::size_t i = 0; i != 50; ++i){
+		for(std::size_t j = 0; j != 40; ++j){
+			double expected = (i >= 10 && i < 45)? B(i,j): 0.0;
+			if(i < 20)
+				expected += 3*B(i,j);
+			BOOST_CHECK_EQUAL(A(i,j), expected);
+		}
+	}
+}
+
+template<class T, class Orientation>
+void checkTransposeInplace(std::size_t n){
+	matrix<T,Orientation> A(n,n);
+	fillMatrix(A,0.0);
+	matrix<T,Orientation> B = A;
+	transpose_inplace(B);
+	//a block of a larger matrix has a larger leading dimension
+	matrix<T,Orientation> C(n+3,n+5,T(-1));
+	noalias(subrange(C,1,n+1,2,n+2)) = A;
+	transpose_inplace(subrange(C,1,n+1,2,n+2));
+	B.wait();
+	C.wait();
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			BOOST_REQUIRE_EQUAL(B(i,j), A(j,i));
+			BOOST_REQUIRE_EQUAL(C(i+1,j+2), A(j,i));
+		}
+	}
+	BOOST_CHECK_EQUAL(C(0,0), T(-1));
+	BOOST_CHECK_EQUAL(C(n+2,n+4), T(-1));
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_transpose_inplace ){
+	for(std::size_t n : sizes){
+		checkTransposeInplace<float,row_major>(n);
+		checkTransposeInplace<double,column_major>(n);
+	}
+	//the transposed storage is the matrix in the other orientation
+	matrix<double> A(70,70);
+	fillMatrix(A,1.0);
+	matrix<double> B = A;
+	transpose_inplace(B);
+	B.wait();
+	matrix<double,column_major> C = trans(B);
+	C.wait();
+	for(std::size_t i = 0; i != 70; ++i){
+		for(std::size_t j = 0; j != 70; ++j){
+			BOOST_CHECK_EQUAL(C(i,j), A(i,j));
+		}
+	}
+	//transposing twice gives the original matrix
+	matrix<double> D(9,9);
+	fillMatrix(D,0.0);
+	matrix<double> E = D;
+	E.wait();
+	kernels::transpose_inplace(E);
+	kernels::transpose_inplace(E);
+	for(std::size_t i = 0; i != 9; ++i){
+		for(std::size_t j = 0; j != 9; ++j){
+			BOOST_CHECK_EQUAL(E(i,j), D(i,j));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,291 @@
+#define BOOST_TEST_MODULE aBLAS_triangular_matrix
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/triangular_matrix.hpp>
+
+using namespace aBLAS;
+
+template<class M>
+void fillMatrix(M& m, double offset){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = offset + 0.1*i - 0.05*j + 0.01*((i*7+j*3)%11);
+		}
+	}
+}
+
+//sets the block size of the default kernels for the lifetime of the object
+struct scoped_tuning{
+	scoped_tuning(std::size_t triangular_block_size)
+	:m_parameters(kernels::tuning()){
+		kernels::tuning().triangular_block_size = triangular_block_size;
+	}
+	~scoped_tuning(){
+		kernels::tuning() = m_parameters;
+	}
+	kernels::tuning_parameters m_parameters;
+};
+
+//dense reference of a triangular or symmetric matrix whose elements are stored in the triangle of A
+template<class TriangularType, class M>
+matrix<double> denseReference(M const& A, triangular_tag){
+	std::size_t n = A.size1();
+	matrix<double> R(n,n,0.0);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			if(TriangularType::is_unit && i == j)
+				R(i,j) = 1;
+			else if(TriangularType::is_upper? j >= i: i >= j)
+				R(i,j) = A(i,j);
+		}
+	}
+	return R;
+}
+template<class TriangularType, class M>
+matrix<double> denseReference(M const& A, symmetric_tag){
+	std::size_t n = A.size1();
+	matrix<double> R(n,n);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			bool stored = TriangularType::is_upper? j >= i: i >= j;
+			R(i,j) = stored? A(i,j): A(j,i);
+		}
+	}
+	return R;
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_triangular_matrix)
+
+//the rows (columns) of the triangle are stored one after another
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_packed_layout ){
+	std::size_t n = 5;
+	matrix<double> A(n,n);
+	fillMatrix(A,1.0);
+	triangular_matrix<double,row_major,lower> L = A;
+	triangular_matrix<double,column_major,upper> U = A;
+	symmetric_matrix<double,column_major,lower> S = A;
+	L.wait();
+	U.wait();
+	S.wait();
+	BOOST_REQUIRE_EQUAL(L.storage().size(), 15u);
+	std::size_t k = 0;
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j <= i; ++j, ++k){
+			BOOST_CHECK_EQUAL(L.storage()[k], A(i,j));
+			BOOST_CHECK_EQUAL(U.storage()[k], A(j,i));
+		}
+	}
+	k = 0;
+	for(std::size_t j = 0; j != n; ++j){
+		for(std::size_t i = j; i != n; ++i, ++k){
+			BOOST_CHECK_EQUAL(S.storage()[k], A(i,j));
+		}
+	}
+	//element access
+	triangular_matrix<double,row_major,lower> const& Lc = L;
+	triangular_matrix<double,column_major,upper> const& Uc = U;
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			BOOST_CHECK_EQUAL(Lc(i,j), j <= i? A(i,j): 0.0);
+			BOOST_CHECK_EQUAL(Uc(i,j), j >= i? A(i,j): 0.0);
+			BOOST_CHECK_EQUAL(S(i,j), j <= i? A(i,j): A(j,i));
+		}
+	}
+	S(1,3) = 7.0;
+	BOOST_CHECK_EQUAL(S(3,1), 7.0);
+	L(4,2) = -2.0;
+	BOOST_CHECK_EQUAL(L(4,2), -2.0);
+	BOOST_CHECK_EQUAL(L.storage()[12], -2.0);
+}
+
+template<class TriangularType, class Structure, class P, class M>
+void checkDense(P const& packed, M const& A){
+	std::size_t n = A.size1();
+	matrix<double> R = denseReference<TriangularType>(A, Structure());
+	matrix<double> D = packed;
+	matrix<double,column_major> E(n,n,1.0);
+	noalias(E) += 2.0*packed;
+	matrix<double> V = matrix_structured_view<M, TriangularType, Structure>(A);
+	D.wait();
+	E.wait();
+	V.wait();
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			BOOST_CHECK_EQUAL(D(i,j), R(i,j));
+			BOOST_CHECK_EQUAL(E(i,j), 1+2*R(i,j));
+			BOOST_CHECK_EQUAL(V(i,j), R(i,j));
+		}
+	}
+}
+
+//assigning a triangular or symmetric matrix to a dense matrix writes the full matrix
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_assign_dense ){
+	std::size_t n = 9;
+	matrix<double> A(n,n);
+	fillMatrix(A,-0.5);
+	checkDense<lower,triangular_tag>(triangular_matrix<double,row_major,lower>(A),A);
+	checkDense<unit_upper,triangular_tag>(triangular_matrix<double,column_major,unit_upper>(A),A);
+	checkDense<upper,symmetric_tag>(symmetric_matrix<double,row_major,upper>(A),A);
+	checkDense<lower,symmetric_tag>(symmetric_matrix<double,column_major,lower>(A),A);
+	//packed matrices can be constructed from blockwise expressions
+	matrix<double> B(n,n);
+	fillMatrix(B,1.0);
+	symmetric_matrix<double> S = prod(A,B);
+	matrix<double> AB = prod(A,B);
+	S.wait();
+	AB.wait();
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j <= i; ++j){
+			BOOST_CHECK_CLOSE(S(i,j), AB(i,j), 1.e-8);
+			BOOST_CHECK_CLOSE(S(j,i), AB(i,j), 1.e-8);
+		}
+	}
+}
+
+//products with the views and the packed matrices against the product of the dense reference
+template<class TriangularType, class Structure, class OrientationA, class OrientationB>
+void checkProducts(std::size_t n, std::size_t m){
+	//the other triangle contains values which must not be read
+	matrix<double,OrientationA> A(n,n);
+	fillMatrix(A,0.5);
+	packed_matrix<double,Structure,OrientationA,TriangularType> P = A;
+	matrix<double> R = denseReference<TriangularType>(A, Structure());
+	vector<double> x(n);
+	for(std::size_t i = 0; i != n; ++i){
+		x(i) = 1.0 - 0.03*i;
+	}
+	matrix<double,OrientationB> B(n,m);
+	fillMatrix(B,-1.0);
+
+	matrix_structured_view<matrix<double,OrientationA>, TriangularType, Structure> view(A);
+	vector<double> y1 = prod(view,x);
+	vector<double> y2 = prod(P,x);
+	vector<double> y3(n,1.0);
+	noalias(y3) += 2.0*prod(view,x);
+	vector<double> y4 = prod(P,2.0*x);
+	matrix<double,OrientationB> C1 = prod(view,B);
+	matrix<double> C2 = prod(P,B);
+	matrix<double,column_major> C3(n,m,1.0);
+	noalias(C3) += 3.0*prod(P,B);
+	matrix<double,OrientationB> C4 = prod(view,2.0*B);
+	y1.wait();y2.wait();y3.wait();y4.wait();
+	C1.wait();C2.wait();C3.wait();C4.wait();
+
+	for(std::size_t i = 0; i != n; ++i){
+		double Rx = 0;
+		for(std::size_t k = 0; k != n; ++k){
+			Rx += R(i,k) * x(k);
+		}
+		BOOST_CHECK_CLOSE(y1(i), Rx, 1.e-8);
+		BOOST_CHECK_CLOSE(y2(i), Rx, 1.e-8);
+		BOOST_CHECK_CLOSE(y3(i), 1+2*Rx, 1.e-8);
+		BOOST_CHECK_CLOSE(y4(i), 2*Rx, 1.e-8);
+		for(std::size_t j = 0; j != m; ++j){
+			double RB = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				RB += R(i,k) * B(k,j);
+			}
+			BOOST_CHECK_CLOSE(C1(i,j), RB, 1.e-8);
+			BOOST_CHECK_CLOSE(C2(i,j), RB, 1.e-8);
+			BOOST_CHECK_CLOSE(C3(i,j), 1+3*RB, 1.e-8);
+			BOOST_CHECK_CLOSE(C4(i,j), 2*RB, 1.e-8);
+		}
+	}
+}
+
+template<class Structure, class OrientationA, class OrientationB>
+void checkAllTriangles(std::size_t n, std::size_t m){
+	checkProducts<lower,Structure,OrientationA,OrientationB>(n,m);
+	checkProducts<upper,Structure,OrientationA,OrientationB>(n,m);
+}
+
+//sizes cross the block size of the default kernels
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_triangular_prod ){
+	scoped_tuning tuning(8);
+	for(std::size_t n : {1, 5, 8, 21, 40}){
+		checkAllTriangles<triangular_tag,row_major,row_major>(n,7);
+		checkAllTriangles<triangular_tag,column_major,row_major>(n,3);
+		checkAllTriangles<triangular_tag,row_major,column_major>(n,9);
+		checkAllTriangles<triangular_tag,column_major,column_major>(n,1);
+		checkProducts<unit_lower,triangular_tag,row_major,column_major>(n,4);
+		checkProducts<unit_upper,triangular_tag,column_major,row_major>(n,6);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_symmetric_prod ){
+	scoped_tuning tuning(8);
+	for(std::size_t n : {1, 5, 8, 21, 40}){
+		checkAllTriangles<symmetric_tag,row_major,row_major>(n,7);
+		checkAllTriangles<symmetric_tag,column_major,row_major>(n,3);
+		checkAllTriangles<symmetric_tag,row_major,column_major>(n,9);
+		checkAllTriangles<symmetric_tag,column_major,column_major>(n,1);
+	}
+}
+
+//with the default tuning the products use the optimized kernels if available
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_large ){
+	checkProducts<lower,triangular_tag,row_major,column_major>(150,40);
+	checkProducts<unit_upper,triangular_tag,column_major,row_major>(150,40);
+	checkProducts<upper,symmetric_tag,row_major,row_major>(150,40);
+	checkProducts<lower,symmetric_tag,column_major,column_major>(150,40);
+}
+
+//the kernels on single precision and a proxy of a larger matrix
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_matrix_kernels ){
+	scoped_tuning tuning(4);
+	std::size_t n = 13;
+	matrix<float> A(n+3,n+2);
+	fillMatrix(A,0.25);
+	matrix<float> B(n,5);
+	fillMatrix(B,1.0);
+	vector<float> x(n);
+	for(std::size_t i = 0; i != n; ++i){
+		x(i) = 0.5f + 0.1f*i;
+	}
+	A.wait();
+	matrix_range<matrix<float> > M = subrange(A,2,n+2,1,n+1);
+	matrix<float> R = denseReference<lower>(M, triangular_tag());
+	matrix<float> Q = denseReference<upper>(M, symmetric_tag());
+	matrix<float> T = B;
+	vector<float> y = x;
+	matrix<float> S(n,5,1.0f);
+	vector<float> z(n,1.0f);
+	R.wait();
+	Q.wait();
+	T.wait();
+	y.wait();
+	S.wait();
+	z.wait();
+	kernels::trmm(triangular<lower>(M), T);
+	kernels::trmv(triangular<lower>(M), y);
+	kernels::symm(symmetric<upper>(M), B, S, 2.0f, 0.5f);
+	kernels::symv(symmetric<upper>(M), x, z, 2.0f, 0.5f);
+	for(std::size_t i = 0; i != n; ++i){
+		float Rx = 0;
+		float Qx = 0;
+		for(std::size_t k = 0; k != n; ++k){
+			Rx += R(i,k) * x(k);
+			Qx += Q(i,k) * x(k);
+		}
+		BOOST_CHECK_CLOSE(y(i), Rx, 1.e-3f);
+		BOOST_CHECK_CLOSE(z(i), 0.5f+2*Qx, 1.e-3f);
+		for(std::size_t j = 0; j != 5; ++j){
+			float RB = 0;
+			float QB = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				RB += R(i,k) * B(k,j);
+				QB += Q(i,k) * B(k,j);
+			}
+			BOOST_CHECK_CLOSE(T(i,j), RB, 1.e-3f);
+			BOOST_CHECK_CLOSE(S(i,j), 0.5f+2*QB, 1.e-3f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#define BOOST_TEST_MODULE aBLAS_triangular_solve
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/matrix_proxy.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+#include <aBLAS/triangular_matrix.hpp>
+
+using namespace aBLAS;
+
+//a well conditioned matrix: the diagonal dominates the triangles
+template<class M>
+void fillMatrix(M& m){
+	for(std::size_t i = 0; i != m.size1(); ++i){
+		for(std::size_t j = 0; j != m.size2(); ++j){
+			m(i,j) = (i == j)? 2.0 + 0.01*i : 0.3/(1.0 + i + j) - 0.02*((i*7+j*3)%5);
+		}
+	}
+}
+
+//sets the tuning parameters for the lifetime of the object
+struct scoped_tuning{
+	scoped_tuning(std::size_t triangular_block_size, std::size_t parallel_assign_grain_size)
+	:m_parameters(kernels::tuning()){
+		kernels::tuning().triangular_block_size = triangular_block_size;
+		kernels::tuning().parallel_assign_grain_size = parallel_assign_grain_size;
+	}
+	~scoped_tuning(){
+		kernels::tuning() = m_parameters;
+	}
+	kernels::tuning_parameters m_parameters;
+};
+
+//element (i,j) of the triangular matrix stored in the triangle of A
+template<class TriangularType, class M>
+double triangularElement(M const& A, std::size_t i, std::size_t j){
+	if(TriangularType::is_unit && i == j)
+		return 1;
+	bool stored = TriangularType::is_upper? j >= i: i >= j;
+	return stored? A(i,j): 0.0;
+}
+
+//the solutions are multiplied with the triangular matrix and compared with the right hand side
+template<class TriangularType, class OrientationA, class OrientationB>
+void checkSolve(std::size_t n, std::size_t m){
+	//the other triangle contains values which must not be read
+	matrix<double,OrientationA> A(n,n);
+	fillMatrix(A);
+	triangular_matrix<double,OrientationA,TriangularType> P = A;
+	vector<double> b(n);
+	for(std::size_t i = 0; i != n; ++i){
+		b(i) = 1.0 - 0.03*i;
+	}
+	matrix<double,OrientationB> B(n,m);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != m; ++j){
+			B(i,j) = 0.5 + 0.1*i - 0.07*j;
+		}
+	}
+
+	vector<double> x1 = solve(triangular<TriangularType>(A),b);
+	vector<double> x2 = solve(P,2.0*b);
+	vector<double> x3(n,1.0);
+	noalias(x3) += 3.0*solve(P,b);
+	matrix<double,OrientationB> X1 = solve(triangular<TriangularType>(A),B);
+	matrix<double> X2 = solve(P,B);
+	matrix<double,column_major> X3(n,m,1.0);
+	noalias(X3) += 2.0*solve(triangular<TriangularType>(A),B);
+	matrix<double,OrientationB> X4 = solve(triangular<TriangularType>(A),2.0*B);
+	x1.wait();x2.wait();x3.wait();
+	X1.wait();X2.wait();X3.wait();X4.wait();
+
+	for(std::size_t i = 0; i != n; ++i){
+		double Ax1 = 0;
+		double Ax2 = 0;
+		double Ax3 = 0;
+		for(std::size_t k = 0; k != n; ++k){
+			double a = triangularElement<TriangularType>(A,i,k);
+			Ax1 += a * x1(k);
+			Ax2 += a * x2(k);
+			Ax3 += a * (x3(k) - 1)/3;
+		}
+		BOOST_CHECK_SMALL(Ax1 - b(i), 1.e-10);
+		BOOST_CHECK_SMALL(Ax2 - 2*b(i), 1.e-10);
+		BOOST_CHECK_SMALL(Ax3 - b(i), 1.e-10);
+		for(std::size_t j = 0; j != m; ++j){
+			double AX1 = 0;
+			double AX2 = 0;
+			double AX3 = 0;
+			double AX4 = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				double a = triangularElement<TriangularType>(A,i,k);
+				AX1 += a * X1(k,j);
+				AX2 += a * X2(k,j);
+				AX3 += a * (X3(k,j) - 1)/2;
+				AX4 += a * X4(k,j);
+			}
+			BOOST_CHECK_SMALL(AX1 - B(i,j), 1.e-10);
+			BOOST_CHECK_SMALL(AX2 - B(i,j), 1.e-10);
+			BOOST_CHECK_SMALL(AX3 - B(i,j), 1.e-10);
+			BOOST_CHECK_SMALL(AX4 - 2*B(i,j), 1.e-10);
+		}
+	}
+}
+
+template<class OrientationA, class OrientationB>
+void checkAllTriangles(std::size_t n, std::size_t m){
+	checkSolve<lower,OrientationA,OrientationB>(n,m);
+	checkSolve<upper,OrientationA,OrientationB>(n,m);
+	checkSolve<unit_lower,OrientationA,OrientationB>(n,m);
+	checkSolve<unit_upper,OrientationA,OrientationB>(n,m);
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_triangular_solve)
+
+//sizes cross the block size of the default kernels
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_solve_blocked ){
+	scoped_tuning tuning(8, kernels::tuning().parallel_assign_grain_size);
+	for(std::size_t n : {1, 5, 8, 21, 40}){
+		checkAllTriangles<row_major,row_major>(n,7);
+		checkAllTriangles<column_major,row_major>(n,3);
+		checkAllTriangles<row_major,column_major>(n,9);
+		checkAllTriangles<column_major,column_major>(n,1);
+	}
+}
+
+//with a small grain size the right hand sides are split into ranges of columns
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_solve_split ){
+	scoped_tuning tuning(16, 256);
+	checkAllTriangles<row_major,row_major>(50,37);
+	checkAllTriangles<column_major,column_major>(33,64);
+	checkAllTriangles<row_major,column_major>(70,20);
+}
+
+//with the default tuning the solutions use the optimized kernels if available
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_solve_large ){
+	checkSolve<lower,row_major,column_major>(150,40);
+	checkSolve<unit_upper,column_major,row_major>(150,40);
+	checkSolve<upper,row_major,row_major>(150,40);
+}
+
+//the kernels on single precision and a proxy of a larger matrix
+BOOST_AUTO_TEST_CASE( aBLAS_triangular_solve_kernels ){
+	scoped_tuning tuning(4, kernels::tuning().parallel_assign_grain_size);
+	std::size_t n = 13;
+	matrix<float> A(n+3,n+2);
+	fillMatrix(A);
+	matrix<float,column_major> B(n,5);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != 5; ++j){
+			B(i,j) = 1.0f - 0.1f*i + 0.2f*j;
+		}
+	}
+	matrix<float,column_major> X = B;
+	vector<float> x = column(B,2);
+	X.wait();
+	x.wait();
+	matrix_range<matrix<float> > M = subrange(A,2,n+2,2,n+2);
+	kernels::trsm(triangular<upper>(M), X);
+	kernels::trsv(triangular<lower>(M), x);
+	for(std::size_t i = 0; i != n; ++i){
+		float Lx = 0;
+		for(std::size_t k = 0; k != n; ++k){
+			Lx += triangularElement<lower>(M,i,k) * x(k);
+		}
+		BOOST_CHECK_SMALL(Lx - B(i,2), 1.e-4f);
+		for(std::size_t j = 0; j != 5; ++j){
+			float UX = 0;
+			for(std::size_t k = 0; k != n; ++k){
+				UX += triangularElement<upper>(M,i,k) * X(k,j);
+			}
+			BOOST_CHECK_SMALL(UX - B(i,j), 1.e-4f);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#define BOOST_TEST_MODULE aBLAS_tuning
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/autotune.hpp>
+
+#include <cstdio>
+
+using namespace aBLAS;
+
+template<class Arg1, class Arg2, class Result>
+void checkMatrixMatrixMultiply(Arg1 const& arg1, Arg2 const& arg2, Result const& result, double factor){
+	for(std::size_t i = 0; i != arg1.size1(); ++i){
+		for(std::size_t j = 0; j != arg2.size2(); ++j){
+			double test_result = 0;
+			for(std::size_t k = 0; k != arg1.size2(); ++k){
+				 test_result += factor * arg1(i,k)*arg2(k,j);
+			}
+			BOOST_CHECK_CLOSE(result(i,j), test_result,1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_tuning)
+
+BOOST_AUTO_TEST_CASE( aBLAS_tuning_file ){
+	kernels::tuning_parameters parameters;
+	parameters.gemm_block_size = 40;
+	parameters.assign_block_size = 8;
+	parameters.gemm_binding_min_size = 1000;
+	parameters.gemm_thin_inner_binding_min_size = 2000;
+	parameters.gemm_thin_outer_binding_min_size = 3000;
+	parameters.gemv_binding_min_size = 100;
+	parameters.gemv_tall_binding_min_size = 200;
+	parameters.gemv_wide_binding_min_size = 300;
+	parameters.vector_binding_min_size = 10;
+	parameters.gemm_epilogue_tile_size = 64;
+	parameters.parallel_assign_grain_size = 4096;
+	parameters.streaming_store_min_size = 12345;
+	parameters.syrk_block_size = 33;
+	parameters.triangular_block_size = 17;
+	parameters.factorization_tile_size = 99;
+	std::string filename = "aBLAS_tuning_test.txt";
+	BOOST_REQUIRE(parameters.save(filename));
+
+	kernels::tuning_parameters loaded;
+	BOOST_REQUIRE(loaded.load(filename));
+	BOOST_CHECK_EQUAL(loaded.gemm_block_size, 40u);
+	BOOST_CHECK_EQUAL(loaded.assign_block_size, 8u);
+	BOOST_CHECK_EQUAL(loaded.gemm_binding_min_size, 1000u);
+	BOOST_CHECK_EQUAL(loaded.gemm_thin_inner_binding_min_size, 2000u);
+	BOOST_CHECK_EQUAL(loaded.gemm_thin_outer_binding_min_size, 3000u);
+	BOOST_CHECK_EQUAL(loaded.gemv_binding_min_size, 100u);
+	BOOST_CHECK_EQUAL(loaded.gemv_tall_binding_min_size, 200u);
+	BOOST_CHECK_EQUAL(loaded.gemv_wide_binding_min_size, 300u);
+	BOOST_CHECK_EQUAL(loaded.vector_binding_min_size, 10u);
+	BOOST_CHECK_EQUAL(loaded.gemm_epilogue_tile_size, 64u);
+	BOOST_CHECK_EQUAL(loaded.parallel_assign_grain_size, 4096u);
+	BOOST_CHECK_EQUAL(loaded.streaming_store_min_size, 12345u);
+	BOOST_CHECK_EQUAL(loaded.syrk_block_size, 33u);
+	BOOST_CHECK_EQUAL(loaded.triangular_block_size, 17u);
+	BOOST_CHECK_EQUAL(loaded.factorization_tile_size, 99u);
+	std::remove(filename.c_str());
+
+	BOOST_CHECK(!loaded.load("aBLAS_tuning_does_not_exist.txt"));
+	BOOST_CHECK_EQUAL(loaded.gemm_block_size, 40u);
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_tuning_shape_classes ){
+	kernels::tuning_parameters parameters;
+	parameters.gemm_binding_min_size = 1000;
+	parameters.gemm_thin_inner_binding_min_size = 2000;
+	parameters.gemm_thin_outer_binding_min_size = 3000;
+	parameters.gemv_binding_min_size = 100;
+	parameters.gemv_tall_binding_min_size = 200;
+	parameters.gemv_wide_binding_min_size = 300;
+	
+	//gemm: m, n, k
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(10,10,10), 1000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(40,10,20), 1000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(100,100,10), 2000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(41,30,10), 2000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(10,100,100), 3000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(100,10,100), 3000u);
+	BOOST_CHECK_EQUAL(parameters.gemm_binding_min_size_for(1,1000,1), 2000u);
+	//gemv: m, n
+	BOOST_CHECK_EQUAL(parameters.gemv_binding_min_size_for(10,10), 100u);
+	BOOST_CHECK_EQUAL(parameters.gemv_binding_min_size_for(40,10), 100u);
+	BOOST_CHECK_EQUAL(parameters.gemv_binding_min_size_for(10,40), 100u);
+	BOOST_CHECK_EQUAL(parameters.gemv_binding_min_size_for(41,10), 200u);
+	BOOST_CHECK_EQUAL(parameters.gemv_binding_min_size_for(10,41), 300u);
+}
+
+//the kernels give the same results for all parameters
+BOOST_AUTO_TEST_CASE( aBLAS_tuning_kernels ){
+	std::size_t rows = 37;
+	std::size_t columns = 29;
+	std::size_t middle = 41;
+	matrix<double,column_major> A(rows,middle);
+	matrix<double,column_major> B(middle,columns);
+	for(std::size_t i = 0; i != rows; ++i)
+		for(std::size_t k = 0; k != middle; ++k)
+			A(i,k) = i - 0.5*k;
+	for(std::size_t k = 0; k != middle; ++k)
+		for(std::size_t j = 0; j != columns; ++j)
+			B(k,j) = 0.25*k + j;
+
+	kernels::tuning_parameters previous = kernels::tuning();
+	std::size_t const block_sizes[] = {1,7,16,64};
+	for(std::size_t block_size: block_sizes){
+		kernels::tuning().gemm_block_size = block_size;
+		kernels::tuning().assign_block_size = block_size;
+		//all products either use or skip the bindings
+		std::size_t binding_min_size = block_size == 7? 0: std::size_t(-1);
+		kernels::tuning().gemm_binding_min_size = binding_min_size;
+		kernels::tuning().gemm_thin_inner_binding_min_size = binding_min_size;
+		kernels::tuning().gemm_thin_outer_binding_min_size = binding_min_size;
+		kernels::tuning().gemv_binding_min_size = binding_min_size;
+		kernels::tuning().gemv_tall_binding_min_size = binding_min_size;
+		kernels::tuning().gemv_wide_binding_min_size = binding_min_size;
+		kernels::tuning().vector_binding_min_size = binding_min_size;
+
+		matrix<double,row_major> C(rows,columns,0.0);
+		kernels::gemm(A,B,C,2.0,0.0);
+		checkMatrixMatrixMultiply(A,B,C,2.0);
+
+		matrix<double,row_major> D(rows,middle,0.0);
+		kernels::assign<scalar_assign>(D,A,1.0);
+		for(std::size_t i = 0; i != rows; ++i)
+			for(std::size_t k = 0; k != middle; ++k)
+				BOOST_CHECK_EQUAL(D(i,k), A(i,k));
+	}
+	kernels::tuning() = previous;
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_tuning_autotune ){
+	kernels::tuning_parameters previous = kernels::tuning();
+	kernels::tuning_parameters parameters = autotune();
+	BOOST_CHECK(parameters.gemm_block_size >= 8 && parameters.gemm_block_size <= 64);
+	BOOST_CHECK(parameters.assign_block_size >= 4 && parameters.assign_block_size <= 32);
+	BOOST_CHECK(parameters.gemm_binding_min_size > 0);
+	BOOST_CHECK(parameters.gemm_thin_inner_binding_min_size > 0);
+	BOOST_CHECK(parameters.gemm_thin_outer_binding_min_size > 0);
+	BOOST_CHECK(parameters.gemv_binding_min_size > 0);
+	BOOST_CHECK(parameters.gemv_tall_binding_min_size > 0);
+	BOOST_CHECK(parameters.gemv_wide_binding_min_size > 0);
+	//the parameters in use are not changed
+	BOOST_CHECK_EQUAL(kernels::tuning().gemm_block_size, previous.gemm_block_size);
+	BOOST_CHECK_EQUAL(kernels::tuning().assign_block_size, previous.assign_block_size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+#define BOOST_TEST_MODULE aBLAS_vector_math
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <aBLAS/vector.hpp>
+#include <aBLAS/matrix.hpp>
+#include <aBLAS/vector_expression.hpp>
+#include <aBLAS/matrix_expression.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace aBLAS;
+
+//distance of the result to the reference in units of the last place of the reference
+template<class T>
+double ulp_error(T result, long double reference){
+	int exponent;
+	std::frexp(static_cast<T>(reference), &exponent);
+	int min_exponent = std::numeric_limits<T>::min_exponent;
+	long double ulp = std::ldexp(1.0l, std::max(exponent, min_exponent) - std::numeric_limits<T>::digits);
+	return double(std::abs(result - reference) / ulp);
+}
+
+long double sigmoid_reference(long double x){
+	return 1/(1+std::exp(-x));
+}
+
+template<class T, class Function, class Reference>
+void checkUlp(Function f, Reference reference, T start, T end, double max_ulp){
+	std::size_t steps = 20000;
+	double max_error = 0;
+	for(std::size_t i = 0; i != steps; ++i){
+		T x = start + (end - start) * T(i) / T(steps);
+		max_error = std::max(max_error, ulp_error(f(x), reference(x)));
+	}
+	BOOST_CHECK_LE(max_error, max_ulp);
+}
+
+//pow for bases over the whole range of positive numbers, with all results which are finite and not zero
+template<class T>
+void checkPow(){
+	long double min_base = std::numeric_limits<T>::denorm_min();
+	long double max_base = std::numeric_limits<T>::max();
+	long double min_result = std::numeric_limits<T>::denorm_min();
+	long double max_result = std::numeric_limits<T>::max();
+#ifdef ABLAS_FAST_MATH
+	min_base = std::numeric_limits<T>::min();
+	min_result = std::numeric_limits<T>::min();
+	max_result /= 4;
+#endif
+	std::size_t steps = 20000;
+	for(T y: {T(-150), T(-3.7), T(-1), T(0.01), T(0.5), T(2.5), T(7.3), T(30)}){
+		double max_error = 0;
+		for(std::size_t i = 0; i != steps; ++i){
+			long double t = (long double)(i) / steps;
+			T x = T(std::exp(std::log(min_base) + t * (std::log(max_base) - std::log(min_base))));
+			long double reference = std::pow((long double)x, (long double)y);
+			if(reference < min_result || reference > max_result)
+				continue;
+			double error = ulp_error(detail::approx_pow<T>(x, y), reference);
+#ifdef ABLAS_FAST_MATH
+			error /= 1 + 2 * std::abs(y * std::log(double(x)));
+#endif
+			max_error = std::max(max_error, error);
+		}
+		BOOST_CHECK_LE(max_error, 1);
+	}
+}
+
+template<class T>
+void checkAccuracy(){
+#ifdef ABLAS_FAST_MATH
+	double tanh_ulp = 1000;//the error of tanh is absolute
+	//exp(-x) must be a normal number
+	T sigmoid_min = std::is_same<T,float>::value? T(-87): T(-708);
+	T exp_min = sigmoid_min;
+#else
+	double tanh_ulp = 3;
+	//the results are denormal below about -87 and -708
+	T sigmoid_min = std::is_same<T,float>::value? T(-110): T(-760);
+	T exp_min = std::is_same<T,float>::value? T(-103): T(-745);
+#endif
+	T exp_max = std::is_same<T,float>::value? T(88): T(709);
+	checkUlp<T>(detail::approx_exp<T>, [](long double x){return std::exp(x);}, exp_min, exp_max, 1);
+	checkUlp<T>(detail::approx_log<T>, [](long double x){return std::log(x);}, T(1.e-3), 1000, 1);
+	checkUlp<T>(detail::approx_tanh<T>, [](long double x){return std::tanh(x);}, -10, 10, tanh_ulp);
+	checkUlp<T>(detail::approx_sigmoid<T>, sigmoid_reference, sigmoid_min, 40, 3);
+	checkUlp<T>(detail::approx_erf<T>, [](long double x){return std::erf(x);}, -5, 5, 1);
+	checkPow<T>();
+}
+
+template<class T>
+void checkSpecialValues(){
+	T inf = std::numeric_limits<T>::infinity();
+	T nan = std::numeric_limits<T>::quiet_NaN();
+	BOOST_CHECK_EQUAL(detail::approx_exp<T>(-inf), T(0));
+	BOOST_CHECK_EQUAL(detail::approx_exp<T>(inf), inf);
+	BOOST_CHECK_EQUAL(detail::approx_exp<T>(1000), inf);
+	BOOST_CHECK_EQUAL(detail::approx_exp<T>(-1000), T(0));
+	BOOST_CHECK(std::isnan(detail::approx_exp<T>(nan)));
+	//results in the denormal range
+	T tiny = std::numeric_limits<T>::min();
+	T x = std::log(tiny) - 3;
+	BOOST_CHECK_LE(ulp_error(detail::approx_exp<T>(x), std::exp((long double)x)), 1);
+
+	BOOST_CHECK_EQUAL(detail::approx_log<T>(T(1)), T(0));
+	BOOST_CHECK_EQUAL(detail::approx_log<T>(T(0)), -inf);
+	BOOST_CHECK_EQUAL(detail::approx_log<T>(inf), inf);
+	BOOST_CHECK(std::isnan(detail::approx_log<T>(T(-1))));
+	BOOST_CHECK(std::isnan(detail::approx_log<T>(nan)));
+	BOOST_CHECK_LE(ulp_error(detail::approx_log<T>(tiny/8), std::log((long double)(tiny/8))), 1);
+
+	BOOST_CHECK_EQUAL(detail::approx_tanh<T>(inf), T(1));
+	BOOST_CHECK_EQUAL(detail::approx_tanh<T>(-inf), T(-1));
+	BOOST_CHECK_EQUAL(detail::approx_sigmoid<T>(-inf), T(0));
+	BOOST_CHECK_EQUAL(detail::approx_sigmoid<T>(inf), T(1));
+	BOOST_CHECK_EQUAL(detail::approx_erf<T>(inf), T(1));
+	BOOST_CHECK_EQUAL(detail::approx_erf<T>(-inf), T(-1));
+
+	BOOST_CHECK_EQUAL(detail::approx_pow<T>(T(0), T(2)), T(0));
+	BOOST_CHECK_EQUAL(detail::approx_pow<T>(T(0), T(-1)), inf);
+	BOOST_CHECK_CLOSE(detail::approx_pow<T>(T(-2), T(3)), T(-8), 1.e-4);
+	BOOST_CHECK_EQUAL(detail::approx_pow<T>(T(nan), T(0)), T(1));
+	BOOST_CHECK(std::isnan(detail::approx_pow<T>(T(-2), T(0.5))));
+}
+
+BOOST_AUTO_TEST_SUITE (aBLAS_vector_math)
+
+BOOST_AUTO_TEST_CASE( aBLAS_vector_math_accuracy ){
+	checkAccuracy<float>();
+	checkAccuracy<double>();
+}
+
+#ifndef ABLAS_FAST_MATH
+BOOST_AUTO_TEST_CASE( aBLAS_vector_math_special_values ){
+	checkSpecialValues<float>();
+	checkSpecialValues<double>();
+}
+#endif
+
+//the elementwise kernels use the vectorized functions. Sizes are chosen to have partial chunks.
+template<class T>
+void checkVectorKernels(){
+	std::size_t size = 203;
+	vector<T> x(size);
+	for(std::size_t i = 0; i != size; ++i){
+		x(i) = T(-3) + T(0.03) * i;
+	}
+	vector<T> r1 = exp(x);
+	vector<T> r2 = log(abs(x));
+	vector<T> r3 = tanh(x);
+	vector<T> r4 = sigmoid(x);
+	vector<T> r5 = erf(x);
+	vector<T> r6 = pow(abs(x),T(1.5));
+	vector<T> r7(size,T(1));
+	noalias(r7) += 2*exp(x);
+	r7.wait();
+	T tol = std::is_same<T,float>::value? T(1.e-4): T(1.e-10);
+	for(std::size_t i = 0; i != size; ++i){
+		T xi = x(i);
+		BOOST_CHECK_CLOSE(r1(i), std::exp(xi), tol);
+		if(xi != 0){
+			BOOST_CHECK_CLOSE(r2(i), std::log(std::abs(xi)), tol);
+		}
+		BOOST_CHECK_SMALL(r3(i) - std::tanh(xi), tol);
+		BOOST_CHECK_CLOSE(r4(i), 1/(1+std::exp(-xi)), tol);
+		BOOST_CHECK_SMALL(r5(i) - std::erf(xi), tol);
+		BOOST_CHECK_CLOSE(r6(i), std::pow(std::abs(xi),T(1.5)), tol);
+		BOOST_CHECK_CLOSE(r7(i), 1+2*std::exp(xi), tol);
+	}
+}
+
+template<class T, class Orientation>
+void checkMatrixKernels(){
+	std::size_t rows = 37;
+	std::size_t columns = 71;
+	matrix<T,Orientation> A(rows,columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			A(i,j) = T(0.1)*i - T(0.05)*j;
+		}
+	}
+	matrix<T,Orientation> E = exp(A);
+	matrix<T,Orientation> S = sigmoid(A);
+	matrix<T,Orientation> P = pow(A,2);
+	matrix<T,Orientation> L(rows,columns,T(1));
+	noalias(L) += T(-1)*log(A+T(4));
+	L.wait();
+	T tol = std::is_same<T,float>::value? T(1.e-4): T(1.e-10);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			T a = A(i,j);
+			BOOST_CHECK_CLOSE(E(i,j), std::exp(a), tol);
+			BOOST_CHECK_CLOSE(S(i,j), 1/(1+std::exp(-a)), tol);
+			BOOST_CHECK_CLOSE(P(i,j), a*a, tol);
+			BOOST_CHECK_CLOSE(L(i,j), 1-std::log(a+4), tol);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_vector_math_vector_kernels ){
+	checkVectorKernels<float>();
+	checkVectorKernels<double>();
+}
+
+BOOST_AUTO_TEST_CASE( aBLAS_vector_math_matrix_kernels ){
+	checkMatrixKernels<float,row_major>();
+	checkMatrixKernels<float,column_major>();
+	checkMatrixKernels<double,row_major>();
+	checkMatrixKernels<double,column_major>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
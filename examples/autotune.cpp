@@ -0,0 +1,23 @@
+#include <aBLAS/autotune.hpp>
+#include <iostream>
+
+//measures the tuning parameters of this machine and writes them to a tuning file.
+//programs using aBLAS load it when ABLAS_TUNING_FILE is set to its name.
+int main(int argc, char** argv){
+	std::string filename = argc > 1? argv[1]: "ablas_tuning.txt";
+	aBLAS::kernels::tuning_parameters parameters = aBLAS::autotune();
+	std::cout<<"gemm block size: "<<parameters.gemm_block_size<<std::endl;
+	std::cout<<"assign block size: "<<parameters.assign_block_size<<std::endl;
+	std::cout<<"gemm binding from m*n*k = "<<parameters.gemm_binding_min_size<<std::endl;
+	std::cout<<"gemm binding, thin inner dimension, from m*n*k = "<<parameters.gemm_thin_inner_binding_min_size<<std::endl;
+	std::cout<<"gemm binding, thin outer dimension, from m*n*k = "<<parameters.gemm_thin_outer_binding_min_size<<std::endl;
+	std::cout<<"gemv binding from m*n = "<<parameters.gemv_binding_min_size<<std::endl;
+	std::cout<<"gemv binding, tall matrices, from m*n = "<<parameters.gemv_tall_binding_min_size<<std::endl;
+	std::cout<<"gemv binding, wide matrices, from m*n = "<<parameters.gemv_wide_binding_min_size<<std::endl;
+	std::cout<<"vector binding from n = "<<parameters.vector_binding_min_size<<std::endl;
+	if(!parameters.save(filename)){
+		std::cout<<"could not write "<<filename<<std::endl;
+		return 1;
+	}
+	std::cout<<"written to "<<filename<<std::endl;
+}
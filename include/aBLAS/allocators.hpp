@@ -0,0 +1,264 @@
+/*!
+ *
+ *
+ * \brief       Allocators for the storage of dense vectors and matrices
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_ALLOCATORS_HPP
+#define ABLAS_ALLOCATORS_HPP
+
+#include "detail/alignment.hpp"
+
+#include <boost/align/aligned_alloc.hpp>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#ifdef ABLAS_USE_NUMA
+#include <numa.h>
+#endif
+
+namespace aBLAS{
+
+/// \brief Allocator which backs large allocations by transparent huge pages.
+///
+/// Allocations of at least one huge page are aligned to and rounded up to the huge page size
+/// and the kernel is advised via madvise(MADV_HUGEPAGE) to back them with huge pages. This reduces
+/// TLB misses when streaming through large matrices. Smaller allocations are only aligned to a cache line.
+/// On systems without transparent huge pages this is equivalent to the default allocator.
+template<class T>
+class hugepage_allocator{
+public:
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	template<class U>
+	struct rebind{
+		typedef hugepage_allocator<U> other;
+	};
+
+	///\brief Size of a transparent huge page on x86-64.
+	static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+	hugepage_allocator(){}
+	template<class U>
+	hugepage_allocator(hugepage_allocator<U> const&){}
+
+	T* allocate(std::size_t n){
+		std::size_t bytes = n * sizeof(T);
+		void* p = 0;
+		if(bytes < huge_page_size){
+			p = boost::alignment::aligned_alloc(detail::storage_alignment, bytes);
+		}else{
+			bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+			p = boost::alignment::aligned_alloc(huge_page_size, bytes);
+#ifdef MADV_HUGEPAGE
+			if(p)
+				madvise(p, bytes, MADV_HUGEPAGE);//only a hint, failure is not an error
+#endif
+		}
+		if(!p)
+			throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, std::size_t){
+		boost::alignment::aligned_free(p);
+	}
+};
+
+template<class T, class U>
+bool operator==(hugepage_allocator<T> const&, hugepage_allocator<U> const&){
+	return true;
+}
+template<class T, class U>
+bool operator!=(hugepage_allocator<T> const&, hugepage_allocator<U> const&){
+	return false;
+}
+
+#ifdef ABLAS_USE_NUMA
+/// \brief Allocator which binds the memory to a NUMA node.
+///
+/// Memory is allocated page-wise via libnuma on the given node, which keeps the pages local to the threads
+/// working on that node regardless of which thread touches them first. If NUMA is not available on the system,
+/// the memory is allocated as with the default allocator. Requires linking with -lnuma.
+template<class T>
+class numa_allocator{
+public:
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	template<class U>
+	struct rebind{
+		typedef numa_allocator<U> other;
+	};
+
+	/// \brief Creates an allocator for the node on which the calling thread prefers to allocate.
+	numa_allocator():m_node(numa_available() < 0? 0 : numa_preferred()){}
+	/// \brief Creates an allocator for the given node.
+	explicit numa_allocator(int node):m_node(node){}
+	template<class U>
+	numa_allocator(numa_allocator<U> const& other):m_node(other.node()){}
+
+	///\brief Returns the node on which the memory is allocated.
+	int node()const{
+		return m_node;
+	}
+
+	T* allocate(std::size_t n){
+		std::size_t bytes = n * sizeof(T);
+		void* p = 0;
+		if(numa_available() < 0)
+			p = boost::alignment::aligned_alloc(detail::storage_alignment, bytes);
+		else
+			p = numa_alloc_onnode(bytes, m_node);
+		if(!p)
+			throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, std::size_t n){
+		if(numa_available() < 0)
+			boost::alignment::aligned_free(p);
+		else
+			numa_free(p, n * sizeof(T));
+	}
+private:
+	int m_node;
+};
+
+template<class T, class U>
+bool operator==(numa_allocator<T> const& a, numa_allocator<U> const& b){
+	return a.node() == b.node();
+}
+template<class T, class U>
+bool operator!=(numa_allocator<T> const& a, numa_allocator<U> const& b){
+	return a.node() != b.node();
+}
+#endif
+
+/// \brief A fixed block of memory from which allocations are served by incrementing a pointer.
+///
+/// Memory is never given back individually. Instead reset() frees all allocations at once.
+/// This makes it suitable for short lived containers of known total size, e.g. the
+/// intermediate results of one iteration of an algorithm. Allocation is thread safe.
+///
+/// The arena must outlive all containers using it, including the kernels in flight on them.
+/// reset() must only be called when no container allocated from the arena is alive anymore.
+class memory_arena{
+public:
+	/// \brief Allocates an arena with the given capacity in bytes.
+	explicit memory_arena(std::size_t capacity)
+	: m_memory(static_cast<char*>(boost::alignment::aligned_alloc(detail::storage_alignment, capacity)))
+	, m_capacity(capacity), m_used(0){
+		if(!m_memory)
+			throw std::bad_alloc();
+	}
+	~memory_arena(){
+		boost::alignment::aligned_free(m_memory);
+	}
+
+	memory_arena(memory_arena const&) = delete;
+	memory_arena& operator=(memory_arena const&) = delete;
+
+	/// \brief Returns a block of the given number of bytes aligned to a cache line.
+	///
+	/// Throws std::bad_alloc if the arena is exhausted.
+	void* allocate(std::size_t bytes){
+		bytes = (bytes + detail::storage_alignment - 1) / detail::storage_alignment * detail::storage_alignment;
+		//m_used only grows if the block fits, so that a failed request never lets a concurrent one fail
+		std::size_t start = m_used.load();
+		do{
+			if(bytes > m_capacity - start)
+				throw std::bad_alloc();
+		}while(!m_used.compare_exchange_weak(start, start + bytes));
+		return m_memory + start;
+	}
+
+	///\brief Frees all allocations at once.
+	void reset(){
+		m_used = 0;
+	}
+
+	///\brief Returns the number of bytes currently allocated, including alignment.
+	std::size_t used()const{
+		return m_used;
+	}
+	///\brief Returns the total number of bytes of the arena.
+	std::size_t capacity()const{
+		return m_capacity;
+	}
+private:
+	char* m_memory;
+	std::size_t m_capacity;
+	std::atomic<std::size_t> m_used;
+};
+
+/// \brief Allocator serving the allocations from a memory_arena.
+///
+/// Deallocation is a no-op, memory is given back by memory_arena::reset().
+template<class T>
+class arena_allocator{
+public:
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	template<class U>
+	struct rebind{
+		typedef arena_allocator<U> other;
+	};
+
+	explicit arena_allocator(memory_arena& arena):m_arena(&arena){}
+	template<class U>
+	arena_allocator(arena_allocator<U> const& other):m_arena(&other.arena()){}
+
+	///\brief Returns the arena from which the memory is allocated.
+	memory_arena& arena()const{
+		return *m_arena;
+	}
+
+	T* allocate(std::size_t n){
+		return static_cast<T*>(m_arena->allocate(n * sizeof(T)));
+	}
+	void deallocate(T*, std::size_t){}
+private:
+	memory_arena* m_arena;
+};
+
+template<class T, class U>
+bool operator==(arena_allocator<T> const& a, arena_allocator<U> const& b){
+	return &a.arena() == &b.arena();
+}
+template<class T, class U>
+bool operator!=(arena_allocator<T> const& a, arena_allocator<U> const& b){
+	return &a.arena() != &b.arena();
+}
+
+}
+#endif
@@ -68,24 +68,145 @@ std::vector<scheduling::dependency_node*> gather_dependencies(
 ){
 	return std::vector<scheduling::dependency_node*>({&dep1,&dep2});
 }
+namespace detail{
+	//splits the size elements or major lines of an assignment, each writing the given number of bytes,
+	//into ranges computed by parallel kernels. Every range writes at least tuning().parallel_assign_grain_size bytes
+	//and there are at most as many ranges as workers. Returns the boundaries of the ranges
+	inline std::vector<std::size_t> parallel_assign_ranges(std::size_t size, std::size_t bytes, std::size_t workers){
+		std::size_t grain = std::max<std::size_t>(kernels::tuning().parallel_assign_grain_size / std::max<std::size_t>(bytes,1), 1);
+		std::size_t num_ranges = std::min<std::size_t>(size / grain, workers);
+		num_ranges = std::max<std::size_t>(num_ranges, 1);
+		std::vector<std::size_t> bounds(1,0);
+		for(std::size_t r = 1; r <= num_ranges; ++r)
+			bounds.push_back(r * size / num_ranges);
+		return bounds;
+	}
+	
+	//spawns the kernels computing the ranges of a split assignment as a group writing to the target.
+	//kernels spawned later wait for the whole group.
+	template<class Kernel, class ReadVariables>
+	void spawn_parallel_assign(
+		std::vector<std::size_t> const& bounds,
+		Kernel kernel,
+		scheduling::dependency_node& write_variable,
+		ReadVariables&& read_variables
+	){
+		std::vector<std::function<void()> > work;
+		for(std::size_t i = 0; i + 1 < bounds.size(); ++i){
+			std::size_t start = bounds[i];
+			std::size_t end = bounds[i+1];
+			work.push_back([kernel, start, end]()mutable{
+				kernel(start,end);
+			});
+		}
+		system::scheduler().spawn_parallel(
+			std::move(work), write_variable,
+			gather_dependencies(std::vector<scheduling::dependency_node*>(), read_variables)
+		);
+	}
+}
+
+namespace detail{
+	//x=t for all elements of x, split into element ranges computed in parallel if x is large enough.
+	//Running via the scheduler is a lot of overhead for a simple operation, so if x is not split
+	//and no kernels are in flight, the kernel is called directly.
+	template<class VecX>
+	void spawn_fill(vector_expression<VecX, cpu_tag>& x, typename VecX::value_type t){
+		typename VecX::closure_type x_closure(x());
+		std::vector<std::size_t> bounds = parallel_assign_ranges(
+			x().size(), sizeof(typename VecX::value_type), system::scheduler().concurrency()
+		);
+		if(bounds.size() == 2 && x().dependencies().is_ready()){
+			kernels::assign<scalar_assign>(x_closure,t);
+			return;
+		}
+		spawn_parallel_assign(bounds, [t, x_closure](std::size_t start, std::size_t end)mutable{
+			kernels::assign<scalar_assign>(x_closure,t,start,end);
+		},x().dependencies(),std::vector<scheduling::dependency_node*>());
+	}
+	
+	//A=t for all elements of A, split into ranges of major lines computed in parallel if A is large enough.
+	template<class MatA>
+	void spawn_fill(matrix_expression<MatA, cpu_tag>& A, typename MatA::value_type t){
+		typedef typename MatA::orientation orientation;
+		typename MatA::closure_type A_closure(A());
+		std::size_t size_m = orientation::index_m(A().size1(),A().size2());
+		std::vector<std::size_t> bounds = parallel_assign_ranges(
+			orientation::index_M(A().size1(),A().size2()),
+			size_m * sizeof(typename MatA::value_type),
+			system::scheduler().concurrency()
+		);
+		if(bounds.size() == 2 && A().dependencies().is_ready()){
+			kernels::assign<scalar_assign>(A_closure,t);
+			return;
+		}
+		spawn_parallel_assign(bounds, [t, A_closure](std::size_t start, std::size_t end)mutable{
+			kernels::assign<scalar_assign>(A_closure,t,start,end);
+		},A().dependencies(),std::vector<scheduling::dependency_node*>());
+	}
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 ////// Vector Assign
 ////////////////////////////////////////////////////////////////////////////////////
 	
 namespace detail{
-	template<class VecX, class VecV>
-	void assign(
+	//x=f(x,alpha*v) for dense x and v is split into element ranges computed in parallel if it is large enough.
+	template<template <class, class> class F, class VecX, class VecV>
+	void spawn_assign(
 		vector_expression<VecX, cpu_tag>& x,
 		vector_expression<VecV, cpu_tag> const& v,
 		typename VecX::value_type alpha,
-		elementwise_tag
+		dense_random_access_iterator_tag, dense_random_access_iterator_tag
+	){
+		typename VecX::closure_type x_closure(x());
+		typename VecV::const_closure_type v_closure(v());
+		std::vector<std::size_t> bounds = parallel_assign_ranges(
+			x().size(), sizeof(typename VecX::value_type), system::scheduler().concurrency()
+		);
+		if(bounds.size() > 2){
+			spawn_parallel_assign(bounds, [alpha, x_closure, v_closure](std::size_t start, std::size_t end)mutable{
+				kernels::assign<F>(x_closure,v_closure,alpha,start,end);
+			},x().dependencies(),v().dependencies());
+			return;
+		}
+		system::scheduler().spawn([alpha, x_closure, v_closure]()mutable{
+			kernels::assign<F>(x_closure,v_closure,alpha);
+		},x().dependencies(),v().dependencies());
+	}
+	template<template <class, class> class F, class VecX, class VecV, class TagX, class TagV>
+	void spawn_assign(
+		vector_expression<VecX, cpu_tag>& x,
+		vector_expression<VecV, cpu_tag> const& v,
+		typename VecX::value_type alpha,
+		TagX, TagV
 	){
 		typename VecX::closure_type x_closure(x());
 		typename VecV::const_closure_type v_closure(v());
 		system::scheduler().spawn([alpha, x_closure, v_closure]()mutable{
-			kernels::assign<scalar_assign>(x_closure,v_closure,alpha);
+			kernels::assign<F>(x_closure,v_closure,alpha);
 		},x().dependencies(),v().dependencies());
 	}
+	template<template <class, class> class F, class VecX, class VecV>
+	void spawn_assign(
+		vector_expression<VecX, cpu_tag>& x,
+		vector_expression<VecV, cpu_tag> const& v,
+		typename VecX::value_type alpha
+	){
+		typedef typename VecX::const_iterator::iterator_category CategoryX;
+		typedef typename VecV::const_iterator::iterator_category CategoryV;
+		spawn_assign<F>(x,v,alpha,CategoryX(),CategoryV());
+	}
+
+	template<class VecX, class VecV>
+	void assign(
+		vector_expression<VecX, cpu_tag>& x,
+		vector_expression<VecV, cpu_tag> const& v,
+		typename VecX::value_type alpha,
+		elementwise_tag
+	){
+		spawn_assign<scalar_assign>(x,v,alpha);
+	}
 	template<class VecX, class VecV, class Device>
 	void assign(
 		vector_expression<VecX, Device>& x,
@@ -102,11 +223,7 @@ namespace detail{
 		typename VecX::value_type alpha,
 		elementwise_tag
 	){
-		typename VecX::closure_type x_closure(x());
-		typename VecV::const_closure_type v_closure(v());
-		system::scheduler().spawn([alpha, x_closure, v_closure]()mutable{
-			kernels::assign<scalar_plus_assign>(x_closure,v_closure,alpha);
-		},x().dependencies(),v().dependencies());
+		spawn_assign<scalar_plus_assign>(x,v,alpha);
 	}
 	template<class VecX, class VecV, class Device>
 	void plus_assign(
@@ -149,19 +266,65 @@ void plus_assign(
 ////////////////////////////////////////////////////////////////////////////////////
 	
 namespace detail{
-	template<class MatA, class MatB>
-	void assign(
+	//A=f(A,alpha*B) for dense A and B is split into ranges of rows or columns computed in parallel if it is large enough.
+	template<template <class, class> class F, class MatA, class MatB>
+	void spawn_assign(
 		matrix_expression<MatA, cpu_tag>& A,
 		matrix_expression<MatB, cpu_tag> const& B,
-		typename MatA::value_type const& alpha,
-		elementwise_tag
+		typename MatA::value_type alpha,
+		dense_random_access_iterator_tag, dense_random_access_iterator_tag
+	){
+		typedef typename MatA::orientation orientation;
+		typename MatA::closure_type A_closure(A());
+		typename MatB::const_closure_type B_closure(B());
+		std::size_t size_M = orientation::index_M(A().size1(),A().size2());
+		std::size_t size_m = orientation::index_m(A().size1(),A().size2());
+		std::vector<std::size_t> bounds = parallel_assign_ranges(
+			size_M, size_m * sizeof(typename MatA::value_type), system::scheduler().concurrency()
+		);
+		if(bounds.size() > 2){
+			spawn_parallel_assign(bounds, [alpha, A_closure, B_closure](std::size_t start, std::size_t end)mutable{
+				kernels::assign<F>(A_closure,B_closure,alpha,start,end);
+			},A().dependencies(),B().dependencies());
+			return;
+		}
+		system::scheduler().spawn([alpha, A_closure, B_closure]()mutable{
+			kernels::assign<F>(A_closure,B_closure,alpha);
+		},A().dependencies(),B().dependencies());
+	}
+	template<template <class, class> class F, class MatA, class MatB, class TagA, class TagB>
+	void spawn_assign(
+		matrix_expression<MatA, cpu_tag>& A,
+		matrix_expression<MatB, cpu_tag> const& B,
+		typename MatA::value_type alpha,
+		TagA, TagB
 	){
 		typename MatA::closure_type A_closure(A());
 		typename MatB::const_closure_type B_closure(B());
 		system::scheduler().spawn([alpha, A_closure, B_closure]()mutable{
-			kernels::assign<scalar_assign>(A_closure,B_closure,alpha);
+			kernels::assign<F>(A_closure,B_closure,alpha);
 		},A().dependencies(),B().dependencies());
 	}
+	template<template <class, class> class F, class MatA, class MatB>
+	void spawn_assign(
+		matrix_expression<MatA, cpu_tag>& A,
+		matrix_expression<MatB, cpu_tag> const& B,
+		typename MatA::value_type alpha
+	){
+		typedef typename major_iterator<MatA>::type::iterator_category CategoryA;
+		typedef typename major_iterator<MatB>::type::iterator_category CategoryB;
+		spawn_assign<F>(A,B,alpha,CategoryA(),CategoryB());
+	}
+
+	template<class MatA, class MatB>
+	void assign(
+		matrix_expression<MatA, cpu_tag>& A,
+		matrix_expression<MatB, cpu_tag> const& B,
+		typename MatA::value_type const& alpha,
+		elementwise_tag
+	){
+		spawn_assign<scalar_assign>(A,B,alpha);
+	}
 	template<class MatA, class MatB, class Device>
 	void assign(
 		matrix_expression<MatA, Device>& A,
@@ -178,11 +341,7 @@ namespace detail{
 		typename MatA::value_type const& alpha,
 		elementwise_tag
 	){
-		typename MatA::closure_type A_closure(A());
-		typename MatB::const_closure_type B_closure(B());
-		system::scheduler().spawn([alpha, A_closure, B_closure]()mutable{
-			kernels::assign<scalar_plus_assign>(A_closure,B_closure,alpha);
-		},A().dependencies(),B().dependencies());
+		spawn_assign<scalar_plus_assign>(A,B,alpha);
 	}
 	template<class MatA, class MatB, class Device>
 	void plus_assign(
@@ -235,7 +394,7 @@ VecX& operator += (vector_expression<VecX, Device>& x, vector_expression<VecV, D
 	ABLAS_SIZE_CHECK(x().size() == v().size());
 	typedef typename vector_temporary<VecX>::type Temporary;
 	system::scheduler().create_closure(
-		Temporary(v.size()),
+		Temporary(v().size(), uninitialized_tag()),
 		[&x, &v](Temporary& temporary){
 			assign(temporary,v);
 			plus_assign(x,temporary);
@@ -255,7 +414,7 @@ VecX& operator-=(vector_expression<VecX, Device>& x, vector_expression<VecV, Dev
 	ABLAS_SIZE_CHECK(x().size() == v().size());
 	typedef typename vector_temporary<VecX>::type Temporary;
 	system::scheduler().create_closure(
-		Temporary(v.size()),
+		Temporary(v().size(), uninitialized_tag()),
 		[&x, &v](Temporary& temporary){
 			assign(temporary,v);
 			plus_assign(x,temporary,typename VecX::value_type(-1));
@@ -333,7 +492,7 @@ MatA& operator+=(
 	ABLAS_SIZE_CHECK(A().size2() == B().size2());
 	typedef typename matrix_temporary<MatA>::type Temporary;
 	system::scheduler().create_closure(
-		Temporary(A.size1(),A.size2()),
+		Temporary(A().size1(),A().size2(), uninitialized_tag()),
 		[&A, &B](Temporary& temporary){
 			assign(temporary,B);
 			plus_assign(A,temporary);
@@ -357,7 +516,7 @@ MatA& operator-=(
 	ABLAS_SIZE_CHECK(A().size2() == B().size2());
 	typedef typename matrix_temporary<MatA>::type Temporary;
 	system::scheduler().create_closure(
-		Temporary(A.size1(),A.size2()),
+		Temporary(A().size1(),A().size2(), uninitialized_tag()),
 		[&A, &B](Temporary& temporary){
 			assign(temporary,B);
 			plus_assign(A,temporary, typename MatA::value_type(-1));
@@ -413,6 +572,20 @@ MatA& operator /=(matrix_expression<MatA, cpu_tag>& A, typename MatA::value_type
 	},A().dependencies());
 	return A();
 }
+
+/// \brief  Transposes the square matrix in place
+///
+/// Performs the operation A = trans(A). Together with trans(A) this converts a matrix
+/// between row_major and column_major storage without allocating a second matrix.
+template<class MatA>
+MatA& transpose_inplace(matrix_expression<MatA, cpu_tag>& A){
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	typename MatA::closure_type A_closure(A());
+	system::scheduler().spawn([A_closure]()mutable{
+		kernels::transpose_inplace(A_closure);
+	},A().dependencies());
+	return A();
+}
 //////////////////////////////////////////////////////////////////////////////////////
 ///// Temporary Proxy Operators
 /////////////////////////////////////////////////////////////////////////////////////
@@ -437,6 +610,11 @@ temporary_proxy<T> operator/=(temporary_proxy<T> x, U const& arg){
 	static_cast<T&>(x) /= arg;
 	return x;
 }
+template<class T>
+temporary_proxy<T> transpose_inplace(temporary_proxy<T> x){
+	transpose_inplace(static_cast<T&>(x));
+	return x;
+}
 
 
 
@@ -0,0 +1,233 @@
+/*!
+ * 
+ *
+ * \brief       Calibration run measuring the tuning parameters of the kernels
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_AUTOTUNE_HPP
+#define ABLAS_AUTOTUNE_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "kernels/tuning.hpp"
+#include "kernels/gemm.hpp"
+#include "kernels/gemv.hpp"
+#include "kernels/vector_assign.hpp"
+#include "kernels/matrix_assign.hpp"
+
+#include <boost/mpl/bool.hpp>
+#include <chrono>
+#include <cstddef>
+
+namespace aBLAS{
+namespace detail{
+
+//returns the time in seconds per call of f, measured over at least 2ms.
+template<class F>
+double time_per_call(F f){
+	typedef std::chrono::steady_clock clock;
+	f();//warm up caches
+	std::size_t calls = 0;
+	double elapsed = 0;
+	clock::time_point start = clock::now();
+	do{
+		f();
+		++calls;
+		elapsed = std::chrono::duration<double>(clock::now() - start).count();
+	}while(elapsed < 0.002);
+	return elapsed / calls;
+}
+
+//returns the smallest of the sizes from which on the binding is faster than the default kernel.
+//faster(n) returns true if the binding is faster for size n.
+template<std::size_t Count, class Faster>
+std::size_t binding_crossover(std::size_t const (&sizes)[Count], Faster faster){
+	std::size_t crossover = 2 * sizes[Count-1];
+	for(std::size_t i = Count; i != 0 && faster(sizes[i-1]); --i){
+		crossover = sizes[i-1];
+	}
+	return crossover;
+}
+
+//crossover of gemm for products of a (m*d) x (k*d) and a (k*d) x (n*d) matrix over the sizes d. Returns the size m*n*k*d^3.
+template<class T, std::size_t Count>
+std::size_t gemm_crossover(std::size_t const (&sizes)[Count], std::size_t m, std::size_t n, std::size_t k){
+	std::size_t d = binding_crossover(sizes, [=](std::size_t d){
+		matrix<T> A(m * d, k * d, T(1));
+		matrix<T,column_major> B(k * d, n * d, T(1));
+		matrix<T> C(m * d, n * d, T(0));
+		double time_default = time_per_call([&]{bindings::gemm(A,B,C,T(1),T(0),boost::mpl::false_());});
+		double time_binding = time_per_call([&]{bindings::gemm(A,B,C,T(1),T(0),boost::mpl::true_());});
+		return time_binding < time_default;
+	});
+	return m * n * k * d * d * d;
+}
+
+//crossover of gemv for (m*d) x (n*d) matrices over the sizes d. Returns the size m*n*d^2.
+template<class T, std::size_t Count>
+std::size_t gemv_crossover(std::size_t const (&sizes)[Count], std::size_t m, std::size_t n){
+	std::size_t d = binding_crossover(sizes, [=](std::size_t d){
+		matrix<T> A(m * d, n * d, T(1));
+		vector<T> x(n * d, T(1));
+		vector<T> y(m * d, T(0));
+		double time_default = time_per_call([&]{bindings::gemv(A,x,y,T(1),T(0),boost::mpl::false_());});
+		double time_binding = time_per_call([&]{bindings::gemv(A,x,y,T(1),T(0),boost::mpl::true_());});
+		return time_binding < time_default;
+	});
+	return m * n * d * d;
+}
+
+//without bindings the crossover points are irrelevant and the defaults are kept
+template<class T>
+void tune_gemm_binding(kernels::tuning_parameters&, boost::mpl::false_){}
+//every shape class is measured with an aspect ratio of 8 between its small and large dimensions
+template<class T>
+void tune_gemm_binding(kernels::tuning_parameters& parameters, boost::mpl::true_){
+	std::size_t const sizes[] = {2,3,4,6,8,12,16,24,32,48,64};
+	std::size_t const thin_sizes[] = {1,2,3,4,6,8,12,16,24,32};
+	parameters.gemm_binding_min_size = gemm_crossover<T>(sizes, 1, 1, 1);
+	parameters.gemm_thin_inner_binding_min_size = gemm_crossover<T>(thin_sizes, 8, 8, 1);
+	parameters.gemm_thin_outer_binding_min_size = gemm_crossover<T>(thin_sizes, 1, 8, 8);
+}
+
+template<class T>
+void tune_gemv_binding(kernels::tuning_parameters&, boost::mpl::false_){}
+template<class T>
+void tune_gemv_binding(kernels::tuning_parameters& parameters, boost::mpl::true_){
+	std::size_t const sizes[] = {2,4,8,16,32,64,128,256};
+	std::size_t const thin_sizes[] = {1,2,4,8,16,32,64};
+	parameters.gemv_binding_min_size = gemv_crossover<T>(sizes, 1, 1);
+	parameters.gemv_tall_binding_min_size = gemv_crossover<T>(thin_sizes, 8, 1);
+	parameters.gemv_wide_binding_min_size = gemv_crossover<T>(thin_sizes, 1, 8);
+}
+
+template<class T>
+std::size_t tune_vector_binding(boost::mpl::false_){
+	return kernels::tuning_parameters().vector_binding_min_size;
+}
+template<class T>
+std::size_t tune_vector_binding(boost::mpl::true_){
+	std::size_t const sizes[] = {4,8,16,32,64,128,256,512,1024,2048,4096};
+	return binding_crossover(sizes, [](std::size_t n){
+		vector<T> x(n,T(1));
+		vector<T> y(n,T(0));
+		double time_default = time_per_call([&]{bindings::vector_assign<scalar_plus_assign>(y,x,T(1),boost::mpl::false_());});
+		double time_binding = time_per_call([&]{bindings::vector_assign<scalar_plus_assign>(y,x,T(1),boost::mpl::true_());});
+		return time_binding < time_default;
+	});
+}
+
+//block size of the default gemm with column major arguments and row major result
+template<class T>
+std::size_t tune_gemm_block_size(){
+	std::size_t const n = 192;
+	std::size_t const candidates[] = {8,16,24,32,48,64};
+	matrix<T,column_major> A(n,n,T(1));
+	matrix<T,column_major> B(n,n,T(1));
+	matrix<T,row_major> C(n,n,T(0));
+	kernels::tuning_parameters& tuning = kernels::tuning();
+	std::size_t previous = tuning.gemm_block_size;
+	std::size_t best = previous;
+	double best_time = 0;
+	for(std::size_t block_size: candidates){
+		tuning.gemm_block_size = block_size;
+		double time = time_per_call([&]{bindings::gemm(A,B,C,T(1),T(0),boost::mpl::false_());});
+		if(best_time == 0 || time < best_time){
+			best_time = time;
+			best = block_size;
+		}
+	}
+	tuning.gemm_block_size = previous;
+	return best;
+}
+
+//block size of the assignment of a column major to a row major matrix
+template<class T>
+std::size_t tune_assign_block_size(){
+	std::size_t const n = 512;
+	std::size_t const candidates[] = {4,8,16,32};
+	matrix<T,column_major> A(n,n,T(1));
+	matrix<T,row_major> B(n,n,T(0));
+	kernels::tuning_parameters& tuning = kernels::tuning();
+	std::size_t previous = tuning.assign_block_size;
+	std::size_t best = previous;
+	double best_time = 0;
+	for(std::size_t block_size: candidates){
+		tuning.assign_block_size = block_size;
+		double time = time_per_call([&]{kernels::assign<scalar_assign>(B,A,T(1));});
+		if(best_time == 0 || time < best_time){
+			best_time = time;
+			best = block_size;
+		}
+	}
+	tuning.assign_block_size = previous;
+	return best;
+}
+}
+
+/// \brief Measures the tuning parameters of the kernels on this machine.
+///
+/// For every shape class the default kernels are timed against the bindings to find the sizes from which on
+/// the bindings are faster, and the block sizes of the default kernels are chosen from a set of candidates.
+/// The shape classes of gemm are square products and products which are thin in the inner or in an outer dimension,
+/// those of gemv are square, tall and wide matrices, see kernels::tuning_parameters.
+/// Without bindings the crossover points keep their defaults. The calibration runs in the calling thread
+/// and takes about a second. It should run while the machine is otherwise idle.
+///
+/// The result is returned and not applied. A typical calibration run is
+/// \code
+/// aBLAS::kernels::tuning_parameters parameters = aBLAS::autotune();
+/// parameters.save("ablas_tuning.txt");
+/// \endcode
+/// Programs load the file at startup by setting ABLAS_TUNING_FILE=ablas_tuning.txt, or assign the parameters to kernels::tuning().
+///
+/// \tparam T the value type for which the parameters are measured.
+template<class T>
+kernels::tuning_parameters autotune(){
+	typedef matrix<T> Mat;
+	typedef vector<T> Vec;
+	kernels::tuning_parameters parameters = kernels::tuning();
+	detail::tune_gemm_binding<T>(
+		parameters, typename bindings::has_optimized_gemm<Mat,Mat,matrix<T,column_major> >::type()
+	);
+	detail::tune_gemv_binding<T>(
+		parameters, typename bindings::has_optimized_gemv<Vec,Mat,Vec>::type()
+	);
+	parameters.vector_binding_min_size = detail::tune_vector_binding<T>(
+		typename bindings::has_optimized_vector_assign<scalar_plus_assign,Vec,Vec>::type()
+	);
+	parameters.gemm_block_size = detail::tune_gemm_block_size<T>();
+	parameters.assign_block_size = detail::tune_assign_block_size<T>();
+	return parameters;
+}
+
+/// \brief Measures the tuning parameters of the kernels for double precision.
+inline kernels::tuning_parameters autotune(){
+	return autotune<double>();
+}
+
+}
+#endif
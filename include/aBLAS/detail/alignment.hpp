@@ -0,0 +1,120 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Alignment and padding of the storage of dense containers
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_DETAIL_ALIGNMENT_HPP
+#define ABLAS_DETAIL_ALIGNMENT_HPP
+
+#include <cstddef>
+#include <new>
+#include <boost/align/aligned_alloc.hpp>
+
+namespace aBLAS {namespace detail{
+
+///\brief Alignment in bytes of the first element of dense vectors and matrices.
+///
+/// This is the size of a cache line and a multiple of the width of all SIMD registers.
+static const std::size_t storage_alignment = 64;
+
+///\brief Byte distance between two rows that map to the same cache sets.
+static const std::size_t critical_stride = 4096;
+
+///\brief Allocator returning memory aligned to storage_alignment.
+///
+/// Unlike boost::alignment::aligned_allocator it does not define construct(), so that containers
+/// can leave elements uninitialized via boost::container::default_init.
+template<class T>
+class aligned_allocator{
+public:
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	template<class U>
+	struct rebind{
+		typedef aligned_allocator<U> other;
+	};
+
+	aligned_allocator(){}
+	template<class U>
+	aligned_allocator(aligned_allocator<U> const&){}
+
+	T* allocate(std::size_t n){
+		void* p = boost::alignment::aligned_alloc(storage_alignment, n * sizeof(T));
+		if(!p)
+			throw std::bad_alloc();
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, std::size_t){
+		boost::alignment::aligned_free(p);
+	}
+};
+
+template<class T, class U>
+bool operator==(aligned_allocator<T> const&, aligned_allocator<U> const&){
+	return true;
+}
+template<class T, class U>
+bool operator!=(aligned_allocator<T> const&, aligned_allocator<U> const&){
+	return false;
+}
+
+///\brief Allocator used by the dense vector and matrix containers when no allocator is specified.
+template<class T>
+struct default_allocator{
+	typedef aligned_allocator<T> type;
+};
+
+
+///\brief Returns the distance in memory between two consecutive major rows of a dense matrix.
+///
+/// By default rows are stored without any gaps. When ABLAS_PAD_LEADING_DIMENSION is defined,
+/// the leading dimension is rounded up to a multiple of storage_alignment so that every row
+/// starts at an aligned address. If the row length in bytes is then a multiple of the critical stride,
+/// e.g. for 1024x1024 matrices, another cache line is added. Otherwise all elements of a column
+/// map to the same cache sets.
+template<class T>
+std::size_t padded_leading_dimension(std::size_t minor_size){
+#ifdef ABLAS_PAD_LEADING_DIMENSION
+	std::size_t const line = storage_alignment / sizeof(T);
+	if(minor_size == 0 || line == 0 || line * sizeof(T) != storage_alignment)
+		return minor_size;
+	std::size_t leading_dimension = (minor_size + line - 1) / line * line;
+	if((leading_dimension * sizeof(T)) % critical_stride == 0)
+		leading_dimension += line;
+	return leading_dimension;
+#else
+	return minor_size;
+#endif
+}
+
+}}
+
+#endif
@@ -35,6 +35,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/special_functions/atanh.hpp>
 #include <boost/type_traits/remove_reference.hpp> 
+#include <cmath>
 #include "traits.hpp"
 #include "exception.hpp"
 
@@ -348,6 +349,9 @@ struct scalar_pow{
 		using std::pow;
 		return pow(x,m_exponent);
 	}
+	U exponent()const{
+		return m_exponent;
+	}
 private:
 	U m_exponent;
 };
@@ -364,6 +368,30 @@ struct scalar_tanh{
 	}
 };
 
+template<class T>
+struct scalar_sigmoid{
+	typedef T argument_type;
+	typedef argument_type result_type;
+	static const bool zero_identity = false;
+
+	result_type operator()(argument_type x)const {
+		using std::exp;
+		return T(1)/(T(1)+exp(-x));
+	}
+};
+
+template<class T>
+struct scalar_erf{
+	typedef T argument_type;
+	typedef argument_type result_type;
+	static const bool zero_identity = true;
+
+	result_type operator()(argument_type x)const {
+		using std::erf;
+		return erf(x);
+	}
+};
+
 template<class T>
 struct scalar_atanh{
 	typedef T argument_type;
@@ -391,7 +419,7 @@ private:
 
 template<class T, class ScalarType>
 struct scalar_less_equal_than{
-	typedef ScalarType argument_type;
+	typedef T argument_type;
 	typedef int result_type;
 	static const bool zero_identity = false;
 
@@ -425,7 +453,7 @@ struct scalar_bigger_equal_than{
 
 	scalar_bigger_equal_than(ScalarType comparator):m_comparator(comparator) {}
 	result_type operator()(argument_type x)const {
-		return x > m_comparator;
+		return x >= m_comparator;
 	}
 private:
 	ScalarType m_comparator;
@@ -37,6 +37,7 @@
 #include <boost/type_traits/is_const.hpp> 
 #include <boost/mpl/if.hpp> 
 #include <limits> 
+#include <iterator>
 
 #include "tags.hpp"
 #include "structure.hpp"
@@ -208,14 +209,14 @@ template<class RandomAccessIterator>
 class dense_storage_iterator:
 	public random_access_iterator_base<
 		dense_storage_iterator<RandomAccessIterator>,
-		typename RandomAccessIterator::value_type,
+		typename std::iterator_traits<RandomAccessIterator>::value_type,
 		dense_random_access_iterator_tag
 	> {
 public:
 	typedef std::size_t size_type;
 	typedef std::ptrdiff_t difference_type;
-	typedef typename RandomAccessIterator::value_type value_type;
-	typedef typename RandomAccessIterator::reference reference;
+	typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+	typedef typename std::iterator_traits<RandomAccessIterator>::reference reference;
 
 	// Construction and destruction
 	dense_storage_iterator(){}
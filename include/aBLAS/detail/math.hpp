@@ -0,0 +1,480 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Branch free approximations of exp, log, tanh, sigmoid, erf and pow
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_DETAIL_MATH_HPP
+#define ABLAS_DETAIL_MATH_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace aBLAS{namespace detail{
+
+// Approximations of exp, log, tanh, sigmoid, erf and pow used by the elementwise assignment kernels,
+// see kernels/default/elementwise_math.hpp.
+//
+// The functions work in place on blocks of N values. The range reduction works on the bit patterns and
+// the special cases are handled by selects, so there are no branches and no calls. Each block function is
+// split into loops which either only compute or only select: compilers do not if-convert selects between
+// floating point computations, as these could raise exceptions, and the loops would not be vectorized.
+// The approx_* functions compute a single value with the same code.
+//
+// Maximum errors measured against a higher precision reference, for all finite arguments:
+//
+//            float        double
+// exp        1 ulp        1 ulp
+// log        1 ulp        1 ulp
+// tanh       3 ulp        3 ulp
+// sigmoid    3 ulp        3 ulp
+// erf        1 ulp        1 ulp
+// pow        1 ulp        1 ulp
+//
+// Float erf and pow are computed in double precision. Double pow calls std::pow, as exp(y log(x)) amplifies
+// the error of log(x) to up to (1 + 2|y log(x)|) ulp.
+//
+// Defining ABLAS_FAST_MATH relaxes the accuracy: the handling of NaN, infinities and results or arguments
+// outside of the range of normal numbers is removed, tanh is computed directly from exp,
+// which gives an absolute error of 2 ulp(1) instead of a relative error, and pow is computed as exp(y log(x))
+// in the precision of the arguments with an error of up to (1 + 2|y log(x)|) ulp. pow(0,y) is 0 for all y != 0.
+
+inline std::uint32_t float_bits(float f){
+	std::uint32_t bits;
+	std::memcpy(&bits,&f,sizeof(float));
+	return bits;
+}
+inline float bits_float(std::uint32_t bits){
+	float f;
+	std::memcpy(&f,&bits,sizeof(float));
+	return f;
+}
+inline std::uint64_t double_bits(double d){
+	std::uint64_t bits;
+	std::memcpy(&bits,&d,sizeof(double));
+	return bits;
+}
+inline double bits_double(std::uint64_t bits){
+	double d;
+	std::memcpy(&d,&bits,sizeof(double));
+	return d;
+}
+
+//////////////////////EXP/////////////////////////////
+
+// x = k*ln(2) + r with |r| <= ln(2)/2, returns expm1(r).
+// k is rounded by adding 1.5*2^52, the integer can then be read from the low bits
+inline double exp_reduce(double x, std::int64_t& k){
+	double const shifter = 6755399441055744.0;
+	double const ln2_hi = 6.93147180369123816490e-01;
+	double const ln2_lo = 1.90821492927058770002e-10;
+	double t = x * 1.44269504088896338700 + shifter;
+	double n = t - shifter;
+	k = std::int64_t(double_bits(t) - double_bits(shifter));
+	double r = (x - n * ln2_hi) - n * ln2_lo;
+	//taylor series up to r^13, the truncation error is below 2^-60
+	double p = 1.0/6227020800;
+	p = p * r + 1.0/479001600;
+	p = p * r + 1.0/39916800;
+	p = p * r + 1.0/3628800;
+	p = p * r + 1.0/362880;
+	p = p * r + 1.0/40320;
+	p = p * r + 1.0/5040;
+	p = p * r + 1.0/720;
+	p = p * r + 1.0/120;
+	p = p * r + 1.0/24;
+	p = p * r + 1.0/6;
+	p = p * r + 0.5;
+	return r + r * r * p;
+}
+inline float exp_reduce(float x, std::int32_t& k){
+	float const shifter = 12582912.0f;
+	float const ln2_hi = 0.693359375f;
+	float const ln2_lo = -2.12194440e-4f;
+	float t = x * 1.44269504f + shifter;
+	float n = t - shifter;
+	k = std::int32_t(float_bits(t) - float_bits(shifter));
+	float r = (x - n * ln2_hi) - n * ln2_lo;
+	//taylor series up to r^7
+	float p = 1.0f/5040;
+	p = p * r + 1.0f/720;
+	p = p * r + 1.0f/120;
+	p = p * r + 1.0f/24;
+	p = p * r + 1.0f/6;
+	p = p * r + 0.5f;
+	return r + r * r * p;
+}
+
+//2^k for k in the range of normal numbers
+inline double exp2_int(std::int64_t k){
+	return bits_double(std::uint64_t(k + 1023) << 52);
+}
+inline float exp2_int(std::int32_t k){
+	return bits_float(std::uint32_t(k + 127) << 23);
+}
+
+// exp(x) for arguments with a normal result
+template<class T>
+inline T exp_normal(T x){
+	typename std::conditional<sizeof(T) == 8, std::int64_t, std::int32_t>::type k;
+	T q = exp_reduce(x,k);
+	return (T(1) + q) * exp2_int(k);
+}
+
+// exp(x) for arguments for which the exponent k fits in twice the range of normal numbers.
+// 2^k is split in two factors, so that denormal results and overflow are handled by the multiplication
+template<class T>
+inline T exp_split(T x){
+	typedef typename std::conditional<sizeof(T) == 8, std::int64_t, std::int32_t>::type int_type;
+	typedef typename std::conditional<sizeof(T) == 8, std::uint64_t, std::uint32_t>::type uint_type;
+	int_type const bias = std::numeric_limits<T>::max_exponent;
+	int_type k;
+	T q = exp_reduce(x,k);
+	int_type k1 = int_type(uint_type(k + 2 * bias) >> 1) - bias;
+	return (T(1) + q) * exp2_int(k1) * exp2_int(int_type(k - k1));
+}
+
+///\brief Computes exp(x) for N values in place.
+template<std::size_t N, class T>
+void exp_block(T* x){
+#ifdef ABLAS_FAST_MATH
+	for(std::size_t i = 0; i != N; ++i){
+		x[i] = exp_normal(x[i]);
+	}
+#else
+	//outside of this range the result is 0 or infinity. NaN is passed through
+	T const max_arg = sizeof(T) == 8 ? T(710) : T(89);
+	T const min_arg = sizeof(T) == 8 ? T(-746) : T(-104);
+	for(std::size_t i = 0; i != N; ++i){
+		T xc = x[i] > max_arg ? max_arg : x[i];
+		x[i] = xc < min_arg ? min_arg : xc;
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		x[i] = exp_split(x[i]);
+	}
+#endif
+}
+
+//////////////////////LOG/////////////////////////////
+
+// log(x) for positive normal x, where the exponent of x is k+k_offset.
+// x is written as x=2^k(1+f) with sqrt(2)/2 <= 1+f < sqrt(2) and log(1+f) is computed
+// using the polynomial of fdlibm in s=f/(2+f).
+inline double log_normal(double x, double k_offset){
+	double const ln2_hi = 6.93147180369123816490e-01;
+	double const ln2_lo = 1.90821492927058770002e-10;
+	std::uint64_t const sqrt_half = 0x3fe6a09e667f3bcdull;
+	std::uint64_t bits = double_bits(x) + (0x3ff0000000000000ull - sqrt_half);
+	//the exponent is computed without integer to floating point conversion
+	double k = bits_double(0x4330000000000000ull | (bits >> 52)) - 4503599627370496.0 - k_offset;
+	double f = bits_double((bits & 0x000fffffffffffffull) + sqrt_half) - 1.0;
+	double hfsq = 0.5 * f * f;
+	double s = f / (2.0 + f);
+	double z = s * s;
+	double w = z * z;
+	double t1 = w * (3.999999999940941908e-01 + w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+	double t2 = z * (6.666666666666735130e-01 + w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+	return s * (hfsq + t1 + t2) + k * ln2_lo - hfsq + f + k * ln2_hi;
+}
+inline float log_normal(float x, float k_offset){
+	float const ln2_hi = 6.9313812256e-01f;
+	float const ln2_lo = 9.0580006145e-06f;
+	std::uint32_t const sqrt_half = 0x3f3504f3u;
+	std::uint32_t bits = float_bits(x) + (0x3f800000u - sqrt_half);
+	float k = float(std::int32_t(bits >> 23)) - k_offset;
+	float f = bits_float((bits & 0x007fffffu) + sqrt_half) - 1.0f;
+	float hfsq = 0.5f * f * f;
+	float s = f / (2.0f + f);
+	float z = s * s;
+	float w = z * z;
+	float t1 = w * (0.40000972152f + w * 0.24279078841f);
+	float t2 = z * (0.66666662693f + w * 0.28498786688f);
+	return s * (hfsq + t1 + t2) + k * ln2_lo - hfsq + f + k * ln2_hi;
+}
+
+///\brief Computes log(x) for N values in place.
+template<std::size_t N, class T>
+void log_block(T* x){
+	T const bias = T(std::numeric_limits<T>::max_exponent - 1);
+#ifdef ABLAS_FAST_MATH
+	for(std::size_t i = 0; i != N; ++i){
+		x[i] = log_normal(x[i], bias);
+	}
+#else
+	T const inf = std::numeric_limits<T>::infinity();
+	//denormal arguments are scaled into the normal range by 2^(digits+1)
+	int const shift = std::numeric_limits<T>::digits + 1;
+	T const denormal_scale = T(std::uint64_t(1) << shift);
+	T scale[N];
+	T offset[N];
+	for(std::size_t i = 0; i != N; ++i){
+		bool denormal = x[i] < std::numeric_limits<T>::min();
+		scale[i] = denormal ? denormal_scale : T(1);
+		offset[i] = denormal ? bias + T(shift) : bias;
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		scale[i] = log_normal(x[i] * scale[i], offset[i]);
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		T special = x[i] == T(0) ? -inf : std::numeric_limits<T>::quiet_NaN();
+		x[i] = x[i] > T(0) ? (x[i] < inf ? scale[i] : x[i]) : special;
+	}
+#endif
+}
+
+//////////////////////TANH and SIGMOID/////////////////////////////
+
+// tanh(x) for 0 <= x <= 20
+template<class T>
+inline T tanh_positive(T x){
+#ifdef ABLAS_FAST_MATH
+	return T(1) - T(2) / (exp_normal(T(2) * x) + T(1));
+#else
+	// tanh(x) = expm1(2x)/(expm1(2x)+2), expm1 is computed from the reduced argument without cancellation
+	typename std::conditional<sizeof(T) == 8, std::int64_t, std::int32_t>::type k;
+	T q = exp_reduce(T(2) * x,k);
+	T scale = exp2_int(k);
+	T t = scale * q + (scale - T(1));
+	return t / (t + T(2));
+#endif
+}
+
+///\brief Computes tanh(x) for N values in place.
+template<std::size_t N, class T>
+void tanh_block(T* x){
+	T a[N];
+	//beyond 20 the result is rounded to 1
+	for(std::size_t i = 0; i != N; ++i){
+		T ax = x[i] < T(0) ? -x[i] : x[i];
+		a[i] = ax > T(20) ? T(20) : ax;
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		a[i] = tanh_positive(a[i]);
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		x[i] = x[i] < T(0) ? -a[i] : a[i];
+	}
+}
+
+///\brief Computes the logistic function 1/(1+exp(-x)) for N values in place.
+///
+/// With e=exp(-|x|) the result is 1/(1+e) for positive x and e/(1+e) for negative x, so that
+/// the result does not underflow to 0 for large negative x as long as it is representable.
+template<std::size_t N, class T>
+void sigmoid_block(T* x){
+	T e[N];
+	for(std::size_t i = 0; i != N; ++i){
+		e[i] = x[i] < T(0) ? x[i] : -x[i];
+	}
+#ifdef ABLAS_FAST_MATH
+	//keep exp(-|x|) in the range of normal numbers
+	T const limit = sizeof(T) == 8 ? T(-708) : T(-87);
+	for(std::size_t i = 0; i != N; ++i){
+		e[i] = e[i] < limit ? limit : e[i];
+	}
+#endif
+	exp_block<N>(e);
+	for(std::size_t i = 0; i != N; ++i){
+		T r = T(1) / (T(1) + e[i]);
+		x[i] = x[i] < T(0) ? e[i] * r : r;
+	}
+}
+
+//////////////////////ERF/////////////////////////////
+
+///\brief Computes erf(x) for N values in place using the rational approximations of fdlibm.
+template<std::size_t N>
+void erf_block(double* x){
+	double ax[N];
+	double at[N];
+	double small[N];
+	double medium[N];
+	double near[N];
+	double far[N];
+	for(std::size_t i = 0; i != N; ++i){
+		ax[i] = x[i] < 0.0 ? -x[i] : x[i];
+		at[i] = ax[i] > 6.0 ? 6.0 : ax[i];
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		//|x| < 0.84375
+		double z = ax[i] * ax[i];
+		double r = 1.28379167095512558561e-01 + z * (-3.25042107247001499370e-01 + z * (-2.84817495755985104766e-02
+			+ z * (-5.77027029648944159157e-03 + z * -2.37630166566501626084e-05)));
+		double s = 1.0 + z * (3.97917223959155352819e-01 + z * (6.50222499887672944485e-02
+			+ z * (5.08130628187576562776e-03 + z * (1.32494738004321644526e-04 + z * -3.96022827877536812320e-06))));
+		small[i] = ax[i] + ax[i] * (r / s);
+
+		//0.84375 <= |x| < 1.25
+		s = ax[i] - 1.0;
+		double P = -2.36211856075265944077e-03 + s * (4.14856118683748331666e-01 + s * (-3.72207876035701323847e-01
+			+ s * (3.18346619901161753674e-01 + s * (-1.10894694282396677476e-01 + s * (3.54783043256182359371e-02
+			+ s * -2.16637559486879084300e-03)))));
+		double Q = 1.0 + s * (1.06420880400844228286e-01 + s * (5.40397917702171048937e-01 + s * (7.18286544141962662868e-02
+			+ s * (1.26171219808761642112e-01 + s * (1.36370839120290507362e-02 + s * 1.19844998467991074170e-02)))));
+		medium[i] = 8.45062911510467529297e-01 + P / Q;
+	}
+	//1.25 <= |x| < 6, the coefficients depend on whether |x| < 1/0.35
+	for(std::size_t i = 0; i != N; ++i){
+		double s = 1.0 / (at[i] * at[i]);
+		double R = -9.86494403484714822705e-03 + s * (-6.93858572707181764372e-01 + s * (-1.05586262253232909814e+01
+			+ s * (-6.23753324503260060396e+01 + s * (-1.62396669462573470355e+02 + s * (-1.84605092906711035994e+02
+			+ s * (-8.12874355063065934246e+01 + s * -9.81432934416914548592e+00))))));
+		double S = 1.0 + s * (1.96512716674392571292e+01 + s * (1.37657754143519042600e+02 + s * (4.34565877475229228821e+02
+			+ s * (6.45387271733267880336e+02 + s * (4.29008140027567833386e+02 + s * (1.08635005541779435134e+02
+			+ s * (6.57024977031928170135e+00 + s * -6.04244152148580987438e-02)))))));
+		near[i] = R / S;
+		R = -9.86494292470009928597e-03 + s * (-7.99283237680523006574e-01 + s * (-1.77579549177547519889e+01
+			+ s * (-1.60636384855821916062e+02 + s * (-6.37566443368389627722e+02 + s * (-1.02509513161107724954e+03
+			+ s * -4.83519191608651397019e+02)))));
+		S = 1.0 + s * (3.03380607434824582924e+01 + s * (3.25792512996573918826e+02 + s * (1.53672958608443695994e+03
+			+ s * (3.19985821950859553908e+03 + s * (2.55305040643316442583e+03 + s * (4.74528541206955367215e+02
+			+ s * -2.24409524465858183362e+01))))));
+		far[i] = R / S;
+	}
+	for(std::size_t i = 0; i != N; ++i){
+		near[i] = at[i] < 1.0/0.35 ? near[i] : far[i];
+	}
+	//exp(-x^2) is computed as exp(-z^2)exp((z-x)(z+x)) where z has the lower bits of x cleared, so that z^2 is exact
+	for(std::size_t i = 0; i != N; ++i){
+		double z = bits_double(double_bits(at[i]) & 0xffffffff00000000ull);
+		far[i] = 1.0 - exp_normal(-z * z - 0.5625) * exp_normal((z - at[i]) * (z + at[i]) + near[i]) / at[i];
+	}
+	//NaN fails all comparisons and is passed through small
+	for(std::size_t i = 0; i != N; ++i){
+		double r = ax[i] >= 6.0 ? 1.0 : (ax[i] >= 1.25 ? far[i] : (ax[i] >= 0.84375 ? medium[i] : small[i]));
+		x[i] = x[i] < 0.0 ? -r : r;
+	}
+}
+///\brief Computes erf(x) for N values in place, the result is computed in double precision.
+template<std::size_t N>
+void erf_block(float* x){
+	double values[N];
+	for(std::size_t i = 0; i != N; ++i){
+		values[i] = x[i];
+	}
+	erf_block<N>(values);
+	for(std::size_t i = 0; i != N; ++i){
+		x[i] = float(values[i]);
+	}
+}
+
+//////////////////////POW/////////////////////////////
+
+///\brief Computes pow(x,y)=exp(y log(x)) for N values x in place.
+///
+/// In single precision, the product is computed in double precision unless ABLAS_FAST_MATH is defined.
+/// In double precision, the error of log(x) is amplified by exp, thus std::pow is used unless ABLAS_FAST_MATH is defined.
+template<std::size_t N, class T>
+void pow_block(T* x, T y){
+#ifdef ABLAS_FAST_MATH
+	typedef T compute_type;
+#else
+	typedef double compute_type;
+	if(sizeof(T) == 8){
+		for(std::size_t i = 0; i != N; ++i){
+			x[i] = std::pow(x[i], y);
+		}
+		return;
+	}
+#endif
+	if(y == T(0)){
+		for(std::size_t i = 0; i != N; ++i){
+			x[i] = T(1);
+		}
+		return;
+	}
+	compute_type values[N];
+	for(std::size_t i = 0; i != N; ++i){
+		values[i] = x[i] < T(0) ? -x[i] : x[i];
+	}
+	log_block<N>(values);
+	for(std::size_t i = 0; i != N; ++i){
+		values[i] *= compute_type(y);
+	}
+	exp_block<N>(values);
+	//negative bases are only defined for integer exponents
+	bool integer = std::floor(y) == y;
+	T sign = (integer && std::fmod(std::abs(y), T(2)) == T(1)) ? T(-1) : T(1);
+	T negative = integer ? sign : std::numeric_limits<T>::quiet_NaN();
+	for(std::size_t i = 0; i != N; ++i){
+#ifdef ABLAS_FAST_MATH
+		//log(0) is not handled, zero bases are mapped to zero instead
+		T factor = x[i] < T(0) ? negative : (x[i] > T(0) ? T(1) : T(0));
+#else
+		T factor = x[i] < T(0) ? negative : T(1);
+#endif
+		x[i] = factor * T(values[i]);
+	}
+}
+
+//////////////////////SINGLE VALUES/////////////////////////////
+
+///\brief Computes exp(x).
+template<class T>
+T approx_exp(T x){
+	exp_block<1>(&x);
+	return x;
+}
+///\brief Computes log(x).
+template<class T>
+T approx_log(T x){
+	log_block<1>(&x);
+	return x;
+}
+///\brief Computes tanh(x).
+template<class T>
+T approx_tanh(T x){
+	tanh_block<1>(&x);
+	return x;
+}
+///\brief Computes 1/(1+exp(-x)).
+template<class T>
+T approx_sigmoid(T x){
+	sigmoid_block<1>(&x);
+	return x;
+}
+///\brief Computes erf(x).
+template<class T>
+T approx_erf(T x){
+	erf_block<1>(&x);
+	return x;
+}
+///\brief Computes pow(x,y).
+template<class T>
+T approx_pow(T x, T y){
+	pow_block<1>(&x,y);
+	return x;
+}
+
+}}
+#endif
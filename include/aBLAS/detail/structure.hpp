@@ -133,6 +133,14 @@ struct row_major:public linear_structure{
 	static size_type  triangular_index(size_type i, size_type j, size_type size,upper){
 		return (i*(2*size-i+1))/2+j-i; 
 	}
+	
+	//the diagonal of unit triangular matrices is stored as well
+	static size_type  triangular_index(size_type i, size_type j, size_type size,unit_lower){
+		return triangular_index(i,j,size,lower()); 
+	}
+	static size_type  triangular_index(size_type i, size_type j, size_type size,unit_upper){
+		return triangular_index(i,j,size,upper()); 
+	}
 };
 
 // This traits class defines storage layout and it's properties
@@ -193,6 +201,13 @@ struct column_major:public linear_structure{
 	static size_type  triangular_index(size_type i, size_type j, size_type size,upper){
 		return transposed_orientation::triangular_index(j,i,size,lower()); 
 	}
+	
+	static size_type  triangular_index(size_type i, size_type j, size_type size,unit_lower){
+		return triangular_index(i,j,size,lower()); 
+	}
+	static size_type  triangular_index(size_type i, size_type j, size_type size,unit_upper){
+		return triangular_index(i,j,size,upper()); 
+	}
 };
 struct unknown_orientation:public linear_structure
 {typedef unknown_orientation transposed_orientation;};
@@ -77,6 +77,18 @@ struct evaluation_restrict_traits: public detail::evaluation_restrict_traits<
 	typename E2::evaluation_category
 >{};
 	
+//structure tags
+// triangular_tag -> only the elements in one triangle of a square matrix are non-zero
+// symmetric_tag -> the elements in one triangle of a square matrix are stored, the other triangle is its transpose
+struct triangular_tag{};
+struct symmetric_tag{};
+	
+//construction tags
+// uninitialized_tag -> the elements of a dense container are not initialized on construction.
+// Only to be used when every element is written before it is read, e.g. for temporaries
+// which are assigned the result of an expression.
+struct uninitialized_tag{};
+	
 // Iterator tags -- hierarchical definition of storage characteristics
 struct sparse_bidirectional_iterator_tag: public std::bidirectional_iterator_tag{};
 struct packed_random_access_iterator_tag: public std::random_access_iterator_tag{};
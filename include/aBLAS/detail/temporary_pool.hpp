@@ -0,0 +1,196 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Recycling memory pool for the temporaries of expression evaluation
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_DETAIL_TEMPORARY_POOL_HPP
+#define ABLAS_DETAIL_TEMPORARY_POOL_HPP
+
+#include "alignment.hpp"
+
+#include <boost/align/aligned_alloc.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <new>
+
+namespace aBLAS {namespace detail{
+
+/// \brief Pool of memory blocks which are handed out again instead of being freed.
+///
+/// Expressions which need temporaries, e.g. prod() inside a larger expression or aliasing operator+=,
+/// allocate them every time they are evaluated and the cleanup kernel of the scheduler frees them again.
+/// In a loop these are the same sizes in every iteration. The pool keeps the freed blocks in free lists
+/// and returns them on the next request of the same size class, so that in steady state no large allocation
+/// or page fault happens.
+///
+/// Requests are rounded up to size classes which are at most 1/8 larger than the request.
+/// The pool is thread safe as blocks are returned by the cleanup kernels in the threads of the scheduler.
+/// At most max_cached_bytes() bytes are kept in the free lists, blocks returned beyond that are freed.
+class temporary_pool{
+public:
+	///\brief Returns the pool shared by all temporaries.
+	static temporary_pool& instance(){
+		//never destroyed, as cleanup kernels might still return blocks during static destruction
+		static temporary_pool* pool = new temporary_pool();
+		return *pool;
+	}
+
+	///\brief Returns a block of at least the given size, aligned to storage_alignment.
+	void* allocate(std::size_t bytes){
+		std::size_t size = size_class(bytes);
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			std::vector<void*>& free_list = m_free_lists[size];
+			if(!free_list.empty()){
+				void* block = free_list.back();
+				free_list.pop_back();
+				m_cached_bytes -= size;
+				return block;
+			}
+		}
+		void* block = boost::alignment::aligned_alloc(storage_alignment, size);
+		if(!block)
+			throw std::bad_alloc();
+		return block;
+	}
+
+	///\brief Gives a block back to the pool. bytes must be the size the block was requested with.
+	void deallocate(void* block, std::size_t bytes){
+		std::size_t size = size_class(bytes);
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			if(m_cached_bytes + size <= m_max_cached_bytes){
+				m_free_lists[size].push_back(block);
+				m_cached_bytes += size;
+				return;
+			}
+		}
+		boost::alignment::aligned_free(block);
+	}
+
+	///\brief Frees all blocks currently held in the pool.
+	void release(){
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		for(auto& free_list: m_free_lists){
+			for(void* block: free_list.second)
+				boost::alignment::aligned_free(block);
+		}
+		m_free_lists.clear();
+		m_cached_bytes = 0;
+	}
+
+	///\brief Returns the number of bytes currently held in the pool.
+	std::size_t cached_bytes(){
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		return m_cached_bytes;
+	}
+
+	///\brief Returns the maximum number of bytes held in the pool.
+	std::size_t max_cached_bytes(){
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		return m_max_cached_bytes;
+	}
+	///\brief Sets the maximum number of bytes held in the pool. Blocks already in the pool are not freed.
+	void set_max_cached_bytes(std::size_t bytes){
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		m_max_cached_bytes = bytes;
+	}
+
+	///\brief Rounds a request up to its size class.
+	///
+	/// Small requests are rounded to a multiple of storage_alignment. Larger ones to a multiple of
+	/// 1/8 of the largest power of two not larger than the request.
+	static std::size_t size_class(std::size_t bytes){
+		if(bytes == 0)
+			bytes = 1;
+		std::size_t granularity = storage_alignment;
+		while(granularity * 16 <= bytes)
+			granularity *= 2;
+		return (bytes + granularity - 1) / granularity * granularity;
+	}
+private:
+	temporary_pool():m_cached_bytes(0),m_max_cached_bytes(std::size_t(1) << 30){}
+
+	boost::mutex m_mutex;
+	std::map<std::size_t, std::vector<void*> > m_free_lists;
+	std::size_t m_cached_bytes;
+	std::size_t m_max_cached_bytes;
+};
+
+///\brief Allocator drawing from the temporary_pool.
+template<class T>
+class pool_allocator{
+public:
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	template<class U>
+	struct rebind{
+		typedef pool_allocator<U> other;
+	};
+
+	pool_allocator(){}
+	template<class U>
+	pool_allocator(pool_allocator<U> const&){}
+
+	T* allocate(std::size_t n){
+		return static_cast<T*>(temporary_pool::instance().allocate(n * sizeof(T)));
+	}
+	void deallocate(T* p, std::size_t n){
+		temporary_pool::instance().deallocate(p, n * sizeof(T));
+	}
+};
+
+template<class T, class U>
+bool operator==(pool_allocator<T> const&, pool_allocator<U> const&){
+	return true;
+}
+template<class T, class U>
+bool operator!=(pool_allocator<T> const&, pool_allocator<U> const&){
+	return false;
+}
+
+///\brief Allocator used by the dense temporaries which are created during expression evaluation.
+///
+/// Temporaries are drawn from the temporary_pool unless ABLAS_NO_TEMPORARY_POOL is defined.
+template<class T>
+struct temporary_allocator{
+#ifdef ABLAS_NO_TEMPORARY_POOL
+	typedef typename default_allocator<T>::type type;
+#else
+	typedef pool_allocator<T> type;
+#endif
+};
+
+}}
+
+#endif
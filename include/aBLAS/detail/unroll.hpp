@@ -0,0 +1,63 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Compile time unrolling of loops with constant trip count
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_DETAIL_UNROLL_HPP
+#define ABLAS_DETAIL_UNROLL_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace aBLAS{namespace detail{
+
+/// \brief Calls f(i) for i=0,...,N-1 where i is a std::integral_constant.
+///
+/// The calls are generated by template recursion, so the loop is unrolled completely
+/// and every index is a compile time constant, regardless of whether the compiler
+/// would unroll a loop of this length. Nested unrolls generate code for every combination
+/// of indices and are meant for small sizes only.
+template<std::size_t N>
+struct unroll{
+	template<class F>
+	static void apply(F&& f){
+		unroll<N-1>::apply(f);
+		f(std::integral_constant<std::size_t,N-1>());
+	}
+};
+
+template<>
+struct unroll<0>{
+	template<class F>
+	static void apply(F&&){}
+};
+
+}}
+#endif
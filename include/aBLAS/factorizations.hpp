@@ -0,0 +1,453 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Factorizations, eigen and singular value decompositions of dense matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_FACTORIZATIONS_HPP
+#define ABLAS_FACTORIZATIONS_HPP
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "matrix_proxy.hpp"
+#include "triangular_matrix.hpp"
+#include "kernels/matrix_assign.hpp"
+#include "kernels/gemm.hpp"
+#include "kernels/syrk.hpp"
+#include "kernels/trsm.hpp"
+#include "kernels/potrf.hpp"
+#include "kernels/getrf.hpp"
+#include "kernels/geqrf.hpp"
+#include "kernels/syevd.hpp"
+#include "kernels/gesdd.hpp"
+
+namespace aBLAS{
+
+namespace detail{
+
+/// \brief Dependency nodes of the tiles of a matrix factorized by a tile algorithm.
+///
+/// The matrix is split into square tiles of size tuning().factorization_tile_size and every kernel of the algorithm is a work item
+/// writing the tiles it changes and reading the tiles it needs. This way, the kernels of later steps of the algorithm
+/// start as soon as their tiles are computed, instead of waiting for the whole previous step.
+/// The nodes are a closure variable of the scheduler, see create_closure, so that they outlive all tile kernels.
+class tile_dependencies{
+public:
+	tile_dependencies(std::size_t size1, std::size_t size2, std::size_t tile_size)
+	: m_tile_size(tile_size)
+	, m_tiles1((size1 + tile_size - 1) / tile_size)
+	, m_tiles2((size2 + tile_size - 1) / tile_size)
+	, m_nodes(m_tiles1 * m_tiles2){}
+	
+	tile_dependencies(tile_dependencies&& other)
+	: m_tile_size(other.m_tile_size)
+	, m_tiles1(other.m_tiles1)
+	, m_tiles2(other.m_tiles2)
+	, m_nodes(std::move(other.m_nodes)){}
+	
+	///\brief Number of tiles along the rows
+	std::size_t tiles1()const{
+		return m_tiles1;
+	}
+	///\brief Number of tiles along the columns
+	std::size_t tiles2()const{
+		return m_tiles2;
+	}
+	///\brief First index of tile k
+	std::size_t start(std::size_t k)const{
+		return k * m_tile_size;
+	}
+	///\brief Index after the last index of tile k of a dimension of the given size
+	std::size_t end(std::size_t k, std::size_t size)const{
+		return std::min(size, (k + 1) * m_tile_size);
+	}
+	
+	scheduling::dependency_node& operator()(std::size_t i, std::size_t j){
+		return m_nodes[i * m_tiles2 + j];
+	}
+	///\brief Returns the nodes of the tiles (i,j) with i=start,...,tiles1()-1 in the column j.
+	std::vector<scheduling::dependency_node*> column(std::size_t start, std::size_t j){
+		std::vector<scheduling::dependency_node*> nodes;
+		for(std::size_t i = start; i < m_tiles1; ++i)
+			nodes.push_back(&(*this)(i, j));
+		return nodes;
+	}
+	std::vector<scheduling::dependency_node*> all(){
+		std::vector<scheduling::dependency_node*> nodes;
+		for(scheduling::dependency_node& node: m_nodes)
+			nodes.push_back(&node);
+		return nodes;
+	}
+	
+	scheduling::dependency_node& dependencies(){
+		return m_dependencies;
+	}
+private:
+	std::size_t m_tile_size;
+	std::size_t m_tiles1;
+	std::size_t m_tiles2;
+	std::vector<scheduling::dependency_node> m_nodes;
+	scheduling::dependency_node m_dependencies;
+};
+
+//the first work item waits for all kernels using the factorized variables and the tile kernels wait for it.
+//The last one waits for all tile kernels and kernels using the variables afterwards wait for it.
+inline void spawn_tiles_begin(tile_dependencies& tiles, std::vector<scheduling::dependency_node*> variables){
+	std::vector<scheduling::dependency_node*> nodes = tiles.all();
+	nodes.insert(nodes.end(), variables.begin(), variables.end());
+	system::scheduler().spawn([](){}, nodes, std::vector<scheduling::dependency_node*>());
+}
+inline void spawn_tiles_end(tile_dependencies& tiles, std::vector<scheduling::dependency_node*> const& variables){
+	std::vector<scheduling::dependency_node*> nodes = tiles.all();
+	nodes.push_back(&tiles.dependencies());
+	system::scheduler().spawn([](){}, variables, nodes);
+}
+
+//Cholesky decomposition A=LL^T of the lower triangle. In step k the tile (k,k) is decomposed, the tiles below it
+//are solved by trsm and the tiles of the remaining lower triangle are updated by syrk and gemm.
+//The tiles above the diagonal are cleared.
+template<class MatA>
+void spawn_potrf_tiles(MatA A, scheduling::dependency_node& variable){
+	typedef typename MatA::value_type value_type;
+	std::size_t n = A.size1();
+	std::size_t tile_size = std::max<std::size_t>(1, kernels::tuning().factorization_tile_size);
+	//if the diagonal is not positive, the tile is filled with NaNs which spread to the tiles computed from it
+	auto potrf_tile = [](MatA& A, std::size_t start, std::size_t end){
+		matrix_range<MatA> tile = subrange(A, start, end, start, end);
+		if(kernels::potrf<lower>(tile) != 0)
+			kernels::assign<scalar_assign>(tile, std::numeric_limits<value_type>::quiet_NaN());
+	};
+	//a matrix of a single tile is decomposed by a single kernel
+	if(n <= tile_size){
+		system::scheduler().spawn([A, n, potrf_tile]()mutable{
+			potrf_tile(A, 0, n);
+		},variable);
+		return;
+	}
+	system::scheduler().create_closure(tile_dependencies(n, n, tile_size), [&A, &variable, n, potrf_tile](tile_dependencies& tiles){
+		spawn_tiles_begin(tiles, {&variable});
+		std::size_t num_tiles = tiles.tiles1();
+		for(std::size_t i = 0; i != num_tiles; ++i){
+			for(std::size_t j = i + 1; j != num_tiles; ++j){
+				std::size_t i0 = tiles.start(i), i1 = tiles.end(i, n);
+				std::size_t j0 = tiles.start(j), j1 = tiles.end(j, n);
+				system::scheduler().spawn([A, i0, i1, j0, j1]()mutable{
+					matrix_range<MatA> tile = subrange(A, i0, i1, j0, j1);
+					kernels::assign<scalar_assign>(tile, value_type());
+				},tiles(i, j));
+			}
+		}
+		for(std::size_t k = 0; k != num_tiles; ++k){
+			std::size_t k0 = tiles.start(k), k1 = tiles.end(k, n);
+			system::scheduler().spawn([A, k0, k1, potrf_tile]()mutable{
+				potrf_tile(A, k0, k1);
+			},tiles(k, k));
+			//L_ik = A_ik L_kk^-T, computed as L_kk L_ik^T = A_ik^T
+			for(std::size_t i = k + 1; i != num_tiles; ++i){
+				std::size_t i0 = tiles.start(i), i1 = tiles.end(i, n);
+				system::scheduler().spawn([A, i0, i1, k0, k1]()mutable{
+					matrix_range<MatA> tile = subrange(A, i0, i1, k0, k1);
+					matrix_transpose<matrix_range<MatA> > tile_trans(tile);
+					kernels::trsm(triangular<lower>(subrange(A, k0, k1, k0, k1)), tile_trans);
+				},tiles(i, k), tiles(k, k));
+			}
+			//A_ij -= L_ik L_jk^T
+			for(std::size_t i = k + 1; i != num_tiles; ++i){
+				std::size_t i0 = tiles.start(i), i1 = tiles.end(i, n);
+				system::scheduler().spawn([A, i0, i1, k0, k1]()mutable{
+					matrix_range<MatA> tile = subrange(A, i0, i1, i0, i1);
+					kernels::syrk(subrange(A, i0, i1, k0, k1), tile, value_type(-1), value_type(1));
+				},tiles(i, i), tiles(i, k));
+				for(std::size_t j = k + 1; j != i; ++j){
+					std::size_t j0 = tiles.start(j), j1 = tiles.end(j, n);
+					system::scheduler().spawn([A, i0, i1, j0, j1, k0, k1]()mutable{
+						matrix_range<MatA> tile = subrange(A, i0, i1, j0, j1);
+						kernels::gemm(
+							subrange(A, i0, i1, k0, k1), trans(subrange(A, j0, j1, k0, k1)),
+							tile, value_type(-1), value_type(1)
+						);
+					},tiles(i, j), tiles(i, k), tiles(j, k));
+				}
+			}
+		}
+		spawn_tiles_end(tiles, {&variable});
+	});
+}
+
+template<class MatA>
+void spawn_potrf(matrix_expression<MatA, cpu_tag>& A, lower){
+	spawn_potrf_tiles(typename MatA::closure_type(A()), A().dependencies());
+}
+//A=U^TU is the decomposition of the transpose
+template<class MatA>
+void spawn_potrf(matrix_expression<MatA, cpu_tag>& A, upper){
+	typedef matrix_transpose<typename MatA::closure_type> Transpose;
+	spawn_potrf_tiles(Transpose(typename MatA::closure_type(A())), A().dependencies());
+}
+
+//LU decomposition with partial pivoting. In step k the column of tiles k is decomposed by getrf. Its row swaps are applied
+//to all other columns of tiles, the tiles right of the diagonal are solved by trsm and the remaining tiles are updated by gemm.
+//The pivoting searches the whole column, thus the tiles of a column are decomposed by a single kernel.
+template<class MatA, class VecP>
+void spawn_getrf_tiles(MatA A, VecP P, scheduling::dependency_node& variableA, scheduling::dependency_node& variableP){
+	typedef typename MatA::value_type value_type;
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	std::size_t tile_size = std::max<std::size_t>(1, kernels::tuning().factorization_tile_size);
+	//the pivots of the column are relative to its first row
+	auto getrf_column = [](MatA& A, VecP& P, std::size_t start, std::size_t end){
+		matrix_range<MatA> column = subrange(A, start, A.size1(), start, end);
+		vector<std::size_t> pivots(std::min(column.size1(), column.size2()), uninitialized_tag());
+		kernels::getrf(column, pivots);
+		for(std::size_t i = 0; i != pivots.size(); ++i)
+			P(start + i) = start + pivots(i);
+	};
+	if(m <= tile_size && n <= tile_size){
+		system::scheduler().spawn([A, P, n, getrf_column]()mutable{
+			getrf_column(A, P, 0, n);
+		},{&variableA, &variableP},std::vector<scheduling::dependency_node*>());
+		return;
+	}
+	system::scheduler().create_closure(tile_dependencies(m, n, tile_size), [&A, &P, &variableA, &variableP, m, n, getrf_column](tile_dependencies& tiles){
+		spawn_tiles_begin(tiles, {&variableA, &variableP});
+		std::size_t steps = std::min(tiles.tiles1(), tiles.tiles2());
+		for(std::size_t k = 0; k != steps; ++k){
+			std::size_t k0 = tiles.start(k), k1 = tiles.end(k, n);
+			//number of pivots of the step
+			std::size_t pivots = std::min(m, k1) - k0;
+			system::scheduler().spawn([A, P, k0, k1, getrf_column]()mutable{
+				getrf_column(A, P, k0, k1);
+			},tiles.column(k, k), std::vector<scheduling::dependency_node*>());
+			for(std::size_t j = 0; j != tiles.tiles2(); ++j){
+				if(j == k)
+					continue;
+				std::size_t j0 = tiles.start(j), j1 = tiles.end(j, n);
+				system::scheduler().spawn([A, P, k0, j0, j1, j, k, pivots]()mutable{
+					matrix_range<MatA> column = subrange(A, 0, A.size1(), j0, j1);
+					kernels::laswp(P, column, k0, k0 + pivots);
+					if(j < k)
+						return;
+					//U_kj = L_kk^-1 A_kj
+					matrix_range<MatA> tile = subrange(A, k0, k0 + pivots, j0, j1);
+					kernels::trsm(triangular<unit_lower>(subrange(A, k0, k0 + pivots, k0, k0 + pivots)), tile);
+				},tiles.column(k, j), tiles.column(k, k));
+				if(j < k)
+					continue;
+				//A_ij -= L_ik U_kj
+				for(std::size_t i = k + 1; i < tiles.tiles1(); ++i){
+					std::size_t i0 = tiles.start(i), i1 = tiles.end(i, m);
+					system::scheduler().spawn([A, i0, i1, j0, j1, k0, pivots]()mutable{
+						matrix_range<MatA> tile = subrange(A, i0, i1, j0, j1);
+						kernels::gemm(
+							subrange(A, i0, i1, k0, k0 + pivots), subrange(A, k0, k0 + pivots, j0, j1),
+							tile, value_type(-1), value_type(1)
+						);
+					},tiles(i, j), tiles(i, k), tiles(k, j));
+				}
+			}
+		}
+		spawn_tiles_end(tiles, {&variableA, &variableP});
+	});
+}
+
+//QR decomposition. In step k the column of tiles k is decomposed by geqrf and the triangular factor of its reflections is
+//computed. The reflections are applied to every column of tiles right of it by larfb.
+//As for getrf, every column is computed by a single kernel, as the reflections span the whole column.
+template<class MatA, class VecTau>
+void spawn_geqrf_tiles(MatA A, VecTau tau, scheduling::dependency_node& variableA, scheduling::dependency_node& variableTau){
+	typedef typename MatA::value_type value_type;
+	typedef matrix<value_type> Factor;
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	std::size_t tile_size = std::max<std::size_t>(1, kernels::tuning().factorization_tile_size);
+	//the reflections of the column start at its first row
+	auto geqrf_column = [](MatA& A, VecTau& tau, std::size_t start, std::size_t end, Factor* T){
+		matrix_range<MatA> column = subrange(A, start, A.size1(), start, end);
+		vector<value_type> tau_column(std::min(column.size1(), column.size2()), uninitialized_tag());
+		kernels::geqrf(column, tau_column);
+		for(std::size_t i = 0; i != tau_column.size(); ++i)
+			tau(start + i) = tau_column(i);
+		if(T)
+			kernels::larft(subrange(A, start, A.size1(), start, start + tau_column.size()), tau_column, *T);
+	};
+	if(m <= tile_size && n <= tile_size){
+		system::scheduler().spawn([A, tau, n, geqrf_column]()mutable{
+			geqrf_column(A, tau, 0, n, nullptr);
+		},{&variableA, &variableTau},std::vector<scheduling::dependency_node*>());
+		return;
+	}
+	system::scheduler().create_closure(tile_dependencies(m, n, tile_size), [&A, &tau, &variableA, &variableTau, m, n, geqrf_column](tile_dependencies& tiles){
+		spawn_tiles_begin(tiles, {&variableA, &variableTau});
+		std::size_t steps = std::min(tiles.tiles1(), tiles.tiles2());
+		//the triangular factors of the steps are shared by the kernels using them
+		std::shared_ptr<std::vector<Factor> > factors(new std::vector<Factor>());
+		for(std::size_t k = 0; k != steps; ++k){
+			std::size_t k0 = tiles.start(k), k1 = tiles.end(k, n);
+			std::size_t reflections = std::min(m, k1) - k0;
+			factors->push_back(Factor(reflections, reflections, uninitialized_tag()));
+		}
+		for(std::size_t k = 0; k != steps; ++k){
+			std::size_t k0 = tiles.start(k), k1 = tiles.end(k, n);
+			std::size_t reflections = std::min(m, k1) - k0;
+			bool last = k1 == n;
+			system::scheduler().spawn([A, tau, k0, k1, k, last, factors, geqrf_column]()mutable{
+				geqrf_column(A, tau, k0, k1, last? nullptr: &(*factors)[k]);
+			},tiles.column(k, k), std::vector<scheduling::dependency_node*>());
+			for(std::size_t j = k + 1; j != tiles.tiles2(); ++j){
+				std::size_t j0 = tiles.start(j), j1 = tiles.end(j, n);
+				system::scheduler().spawn([A, k0, j0, j1, k, reflections, factors]()mutable{
+					matrix_range<MatA> column = subrange(A, k0, A.size1(), j0, j1);
+					kernels::larfb(subrange(A, k0, A.size1(), k0, k0 + reflections), (*factors)[k], column);
+				},tiles.column(k, j), tiles.column(k, k));
+			}
+		}
+		spawn_tiles_end(tiles, {&variableA, &variableTau});
+	});
+}
+}
+
+/// \brief Computes the Cholesky decomposition A=LL^T or A=U^TU of a symmetric positive definite matrix in place.
+///
+/// TriangularType is lower or upper. Only the triangle TriangularType of A is read. It is overwritten by the factor
+/// and the other triangle is cleared, so that e.g. A=prod(L,trans(L)) holds for the result L of potrf<lower>(L).
+/// The decomposition is computed by a tile algorithm: the matrix is split into tiles of size kernels::tuning().factorization_tile_size
+/// and every tile kernel is a work item of its own, so that large matrices are decomposed by all threads of the scheduler.
+/// If A is not positive definite, the factor contains NaNs.
+template<class TriangularType, class MatA>
+MatA& potrf(matrix_expression<MatA, cpu_tag>& A){
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	detail::spawn_potrf(A, TriangularType());
+	return A();
+}
+template<class TriangularType, class T>
+temporary_proxy<T> potrf(temporary_proxy<T> A){
+	potrf<TriangularType>(static_cast<T&>(A));
+	return A;
+}
+
+/// \brief Computes the LU decomposition PA=LU with partial pivoting in place.
+///
+/// The result is stored as described in kernels::getrf: L is unit lower triangular and stored below the diagonal, U on and above it.
+/// P has min(m,n) elements, row i of A was swapped with row P(i) for i=0,1,..., in this order.
+/// As for potrf, the decomposition is computed by a tile algorithm. For singular A the decomposition is completed
+/// and U has a zero on the diagonal.
+template<class MatA, class VecP>
+MatA& getrf(matrix_expression<MatA, cpu_tag>& A, vector_expression<VecP, cpu_tag>& P){
+	ABLAS_SIZE_CHECK(P().size() == std::min(A().size1(), A().size2()));
+	detail::spawn_getrf_tiles(
+		typename MatA::closure_type(A()), typename VecP::closure_type(P()),
+		A().dependencies(), P().dependencies()
+	);
+	return A();
+}
+template<class T, class VecP>
+temporary_proxy<T> getrf(temporary_proxy<T> A, vector_expression<VecP, cpu_tag>& P){
+	getrf(static_cast<T&>(A), P);
+	return A;
+}
+
+/// \brief Computes the QR decomposition A=QR by Householder reflections in place.
+///
+/// The result is stored as described in kernels::geqrf: R on and above the diagonal, the reflections of Q below it and in tau,
+/// which has min(m,n) elements. As for potrf, the decomposition is computed by a tile algorithm.
+template<class MatA, class VecTau>
+MatA& geqrf(matrix_expression<MatA, cpu_tag>& A, vector_expression<VecTau, cpu_tag>& tau){
+	ABLAS_SIZE_CHECK(tau().size() == std::min(A().size1(), A().size2()));
+	detail::spawn_geqrf_tiles(
+		typename MatA::closure_type(A()), typename VecTau::closure_type(tau()),
+		A().dependencies(), tau().dependencies()
+	);
+	return A();
+}
+template<class T, class VecTau>
+temporary_proxy<T> geqrf(temporary_proxy<T> A, vector_expression<VecTau, cpu_tag>& tau){
+	geqrf(static_cast<T&>(A), tau);
+	return A;
+}
+
+
+/// \brief Computes the eigen decomposition A = V diag(w) V^T of a symmetric matrix in place.
+///
+/// Only the lower triangle of A is read. A is overwritten by the orthogonal matrix V, which stores the eigenvectors
+/// in its columns, and the eigenvalues are stored in w in ascending order.
+/// The decomposition is a single work item. If the algorithm does not converge, w contains NaNs.
+template<class MatA, class VecW>
+MatA& syevd(matrix_expression<MatA, cpu_tag>& A, vector_expression<VecW, cpu_tag>& w){
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(w().size() == A().size1());
+	typedef typename VecW::value_type value_type;
+	typename MatA::closure_type A_closure(A());
+	typename VecW::closure_type w_closure(w());
+	system::scheduler().spawn([A_closure, w_closure]()mutable{
+		if(kernels::syevd(A_closure, w_closure) != 0)
+			kernels::assign<scalar_assign>(w_closure, std::numeric_limits<value_type>::quiet_NaN());
+	},{&A().dependencies(), &w().dependencies()}, std::vector<scheduling::dependency_node*>());
+	return A();
+}
+template<class T, class VecW>
+temporary_proxy<T> syevd(temporary_proxy<T> A, vector_expression<VecW, cpu_tag>& w){
+	syevd(static_cast<T&>(A), w);
+	return A;
+}
+
+/// \brief Computes the thin singular value decomposition A = U diag(s) VT.
+///
+/// For an m x n matrix A and k=min(m,n), U is m x k and VT is k x n, both with orthonormal rows or columns,
+/// and the k singular values are stored in s in descending order. The contents of A are destroyed.
+/// The decomposition is a single work item. If the algorithm does not converge, s contains NaNs.
+template<class MatA, class VecS, class MatU, class MatV>
+void gesdd(
+	matrix_expression<MatA, cpu_tag>& A,
+	vector_expression<VecS, cpu_tag>& s,
+	matrix_expression<MatU, cpu_tag>& U,
+	matrix_expression<MatV, cpu_tag>& VT
+){
+	std::size_t k = std::min(A().size1(), A().size2());
+	ABLAS_SIZE_CHECK(s().size() == k);
+	ABLAS_SIZE_CHECK(U().size1() == A().size1());
+	ABLAS_SIZE_CHECK(U().size2() == k);
+	ABLAS_SIZE_CHECK(VT().size1() == k);
+	ABLAS_SIZE_CHECK(VT().size2() == A().size2());
+	typedef typename VecS::value_type value_type;
+	typename MatA::closure_type A_closure(A());
+	typename VecS::closure_type s_closure(s());
+	typename MatU::closure_type U_closure(U());
+	typename MatV::closure_type VT_closure(VT());
+	system::scheduler().spawn([A_closure, s_closure, U_closure, VT_closure]()mutable{
+		if(kernels::gesdd(A_closure, s_closure, U_closure, VT_closure) != 0)
+			kernels::assign<scalar_assign>(s_closure, std::numeric_limits<value_type>::quiet_NaN());
+	},{&A().dependencies(), &s().dependencies(), &U().dependencies(), &VT().dependencies()}, std::vector<scheduling::dependency_node*>());
+}
+}
+
+#endif
@@ -0,0 +1,456 @@
+/*!
+ * 
+ *
+ * \brief       Implements the fixed size matrix container class.
+ * 
+ * 
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_FIXED_MATRIX_HPP
+#define ABLAS_FIXED_MATRIX_HPP
+
+#include "matrix.hpp"
+#include "matrix_expression.hpp"
+#include "fixed_vector.hpp"
+#include "kernels/fixed/assign.hpp"
+#include "kernels/fixed/gemv.hpp"
+#include "kernels/fixed/gemm.hpp"
+
+#include <boost/type_traits/is_same.hpp>
+#include <array>
+
+namespace aBLAS{
+
+namespace detail{
+//computes m=f(m,alpha*e) in the calling thread.
+//if both are fixed size, the unrolled kernel is called directly
+template<template <class, class> class F, class T, class U, std::size_t M, std::size_t N, class O1, class O2>
+void assign_fixed(
+	fixed_matrix<T,M,N,O1>& m,
+	fixed_matrix<U,M,N,O2> const& e,
+	typename fixed_matrix<T,M,N,O1>::value_type alpha
+){
+	kernels::assign<F>(m,e,alpha);
+}
+template<template <class, class> class F, class T, std::size_t M, std::size_t N, class O, class E>
+void assign_fixed(
+	fixed_matrix<T,M,N,O>& m,
+	fixed_matrix_closure<E> const& e,
+	typename fixed_matrix<T,M,N,O>::value_type alpha
+){
+	kernels::assign<F>(m,e.expression(),alpha);
+}
+//otherwise the expression might depend on kernels in flight and is evaluated by the scheduler first
+template<template <class, class> class F, class T, std::size_t M, std::size_t N, class O, class E>
+void assign_fixed(
+	fixed_matrix<T,M,N,O>& m,
+	matrix_expression<E,cpu_tag> const& e,
+	typename fixed_matrix<T,M,N,O>::value_type alpha
+){
+	typename matrix_temporary<E>::type temporary(e);
+	temporary.wait();
+	kernels::assign<F>(m,temporary,alpha);
+}
+}
+
+/// \brief Closure of a fixed_matrix.
+///
+/// The closure of a non-const fixed_matrix refers to the matrix, the const closure stores a copy of it.
+template<class FM>
+class fixed_matrix_closure:public matrix_expression<fixed_matrix_closure<FM>, cpu_tag >{
+	typedef typename boost::remove_const<FM>::type matrix_type;
+public:
+	typedef typename matrix_type::size_type size_type;
+	typedef typename matrix_type::difference_type difference_type;
+	typedef typename matrix_type::value_type value_type;
+	typedef typename matrix_type::const_reference const_reference;
+	typedef typename aBLAS::reference<FM>::type reference;
+	typedef typename matrix_type::index_type index_type;
+	typedef typename matrix_type::const_storage_type const_storage_type;
+	typedef typename aBLAS::storage<FM>::type storage_type;
+
+	typedef fixed_matrix_closure closure_type;
+	typedef fixed_matrix_closure<matrix_type const> const_closure_type;
+	typedef dense_tag storage_category;
+	typedef elementwise_tag evaluation_category;
+	typedef typename matrix_type::orientation orientation;
+	typedef cpu_tag device_category;
+
+	fixed_matrix_closure(FM& m):m_holder(m){}
+
+	//conversion closure->const_closure
+	template<class E>
+	fixed_matrix_closure(fixed_matrix_closure<E> const& other):m_holder(other.expression()){}
+
+	FM& expression()const{
+		return m_holder.get();
+	}
+
+	size_type size1()const{
+		return expression().size1();
+	}
+	size_type size2()const{
+		return expression().size2();
+	}
+	storage_type& storage()const{
+		return expression().storage();
+	}
+	difference_type stride1()const{
+		return expression().stride1();
+	}
+	difference_type stride2()const{
+		return expression().stride2();
+	}
+	size_type leading_dimension()const{
+		return expression().leading_dimension();
+	}
+	difference_type offset()const{
+		return 0;
+	}
+
+	bool is_ready()const{
+		return expression().is_ready();
+	}
+	void wait(){
+		dependencies().wait();
+	}
+	scheduling::dependency_node& dependencies() const{
+		return expression().dependencies();
+	}
+
+	reference operator()(index_type i, index_type j)const{
+		return expression()(i,j);
+	}
+
+	typedef typename boost::mpl::if_<
+		boost::is_const<FM>,
+		typename matrix_type::const_row_iterator,
+		typename matrix_type::row_iterator
+	>::type row_iterator;
+	typedef typename boost::mpl::if_<
+		boost::is_const<FM>,
+		typename matrix_type::const_column_iterator,
+		typename matrix_type::column_iterator
+	>::type column_iterator;
+	typedef typename matrix_type::const_row_iterator const_row_iterator;
+	typedef typename matrix_type::const_column_iterator const_column_iterator;
+
+	row_iterator row_begin(index_type i) const {
+		return expression().row_begin(i);
+	}
+	row_iterator row_end(index_type i) const {
+		return expression().row_end(i);
+	}
+	column_iterator column_begin(index_type j) const {
+		return expression().column_begin(j);
+	}
+	column_iterator column_end(index_type j) const {
+		return expression().column_end(j);
+	}
+private:
+	detail::fixed_closure_holder<FM> m_holder;
+};
+
+/// \brief A dense matrix of compile time size MxN with the elements stored inside the object.
+///
+/// fixed_matrix is meant for small matrices, e.g. 3x3 and 4x4 transformations or 8x8 blocks. It does not allocate and
+/// has no dependency_node of its own. All operations with fixed size vectors and matrices as arguments
+/// are computed synchronously in the calling thread by the unrolled kernels in kernels/fixed/, independent
+/// of the scheduler. In particular prod() of fixed size arguments returns the result instead of an expression.
+/// Expressions involving dynamic containers are evaluated by the scheduler and waited for
+/// before they are assigned to a fixed_matrix.
+///
+/// A fixed_matrix can be used as argument in all expressions. Kernels in flight read a copy of it.
+/// Writes through proxies, e.g. row(A,0) = v, wait for the right hand side and are computed in the calling thread
+/// as well, so the matrix can be read or destroyed directly afterwards.
+///
+/// \tparam T the type of object stored in the matrix (like double, float, complex, etc...)
+/// \tparam M the number of rows
+/// \tparam N the number of columns
+/// \tparam O the storage organization. It can be either \c row_major or \c column_major. Default is \c row_major
+template<class T, std::size_t M, std::size_t N, class O = row_major>
+class fixed_matrix:public matrix_expression<fixed_matrix<T,M,N,O>, cpu_tag >{
+	static_assert(M > 0 && N > 0, "fixed_matrix must have at least one element");
+public:
+	typedef std::array<T,M*N> storage_type;
+	typedef storage_type const const_storage_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef T value_type;
+	typedef T const& const_reference;
+	typedef T& reference;
+	typedef std::size_t index_type;
+
+	typedef fixed_matrix_closure<fixed_matrix> closure_type;
+	typedef fixed_matrix_closure<fixed_matrix const> const_closure_type;
+	typedef dense_tag storage_category;
+	typedef elementwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+	typedef O orientation;
+
+	static const size_type static_size1 = M;
+	static const size_type static_size2 = N;
+
+	// Construction
+
+	/// \brief Constructs a matrix with all elements set to zero
+	fixed_matrix():m_storage(){}
+
+	/// \brief Constructs a matrix whose elements are not initialized
+	explicit fixed_matrix(uninitialized_tag){}
+
+	/// \brief Constructs a matrix with all elements initialized to an initial value
+	explicit fixed_matrix(value_type init){
+		m_storage.fill(init);
+	}
+
+	/// \brief Creates a matrix from a matrix_expression
+	template<class E>
+	fixed_matrix(matrix_expression<E, cpu_tag> const& e){
+		ABLAS_SIZE_CHECK(e().size1() == M);
+		ABLAS_SIZE_CHECK(e().size2() == N);
+		detail::assign_fixed<scalar_assign>(*this,e,value_type(1));
+	}
+
+	///\brief Returns the number of rows of the matrix.
+	size_type size1()const{
+		return M;
+	}
+	///\brief Returns the number of columns of the matrix.
+	size_type size2()const{
+		return N;
+	}
+	bool empty()const{
+		return false;
+	}
+
+	// ---------
+	// Dense low level interface
+	// ---------
+
+	///\brief Returns the internal matrix storage
+	storage_type& storage(){
+		return m_storage;
+	}
+	///\brief Returns the internal matrix storage
+	const_storage_type& storage()const{
+		return m_storage;
+	}
+	///\brief Returns the stride in memory between two rows.
+	difference_type stride1()const{
+		return boost::is_same<O,row_major>::value? N: 1;
+	}
+	///\brief Returns the stride in memory between two columns.
+	difference_type stride2()const{
+		return boost::is_same<O,row_major>::value? 1: M;
+	}
+	///\brief Returns the distance in memory between the starts of two consecutive major rows.
+	size_type leading_dimension()const{
+		return boost::is_same<O,row_major>::value? N: M;
+	}
+	///\brief Returns the offset from the start of storage(), which is always 0
+	difference_type offset()const{
+		return 0;
+	}
+
+	// ---------
+	// Async Interface
+	// ---------
+
+	/// \brief Returns true, as no kernel in flight writes to a fixed size container.
+	bool is_ready()const{
+		return dependencies().is_ready();
+	}
+
+	/// \brief Returns directly, as no kernel in flight writes to a fixed size container.
+	void wait(){
+		dependencies().wait();
+	}
+
+	///\brief Returns the dependencies shared by all fixed size containers.
+	scheduling::dependency_node& dependencies() const{
+		return detail::fixed_size_dependencies();
+	}
+
+	// --------------
+	// Element access
+	// --------------
+
+	/// \brief Returns element (i,j) of the matrix
+	const_reference operator()(index_type i, index_type j) const {
+		ABLAS_SIZE_CHECK(i < M);
+		ABLAS_SIZE_CHECK(j < N);
+		return m_storage[i*stride1()+j*stride2()];
+	}
+	/// \brief Returns element (i,j) of the matrix
+	reference operator()(index_type i, index_type j) {
+		ABLAS_SIZE_CHECK(i < M);
+		ABLAS_SIZE_CHECK(j < N);
+		return m_storage[i*stride1()+j*stride2()];
+	}
+
+	// -------------------
+	// Assignment operators
+	// -------------------
+
+	/// \brief Assigns the result of a matrix_expression, computed in the calling thread
+	template<class E>
+	fixed_matrix& operator = (matrix_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size1() == M);
+		ABLAS_SIZE_CHECK(e().size2() == N);
+		detail::assign_fixed<scalar_assign>(*this,e,value_type(1));
+		return *this;
+	}
+	template<class E>
+	fixed_matrix& operator += (matrix_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size1() == M);
+		ABLAS_SIZE_CHECK(e().size2() == N);
+		detail::assign_fixed<scalar_plus_assign>(*this,e,value_type(1));
+		return *this;
+	}
+	template<class E>
+	fixed_matrix& operator -= (matrix_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size1() == M);
+		ABLAS_SIZE_CHECK(e().size2() == N);
+		detail::assign_fixed<scalar_plus_assign>(*this,e,value_type(-1));
+		return *this;
+	}
+	fixed_matrix& operator += (value_type t) {
+		kernels::assign<scalar_plus_assign>(*this,t);
+		return *this;
+	}
+	fixed_matrix& operator -= (value_type t) {
+		kernels::assign<scalar_minus_assign>(*this,t);
+		return *this;
+	}
+	fixed_matrix& operator *= (value_type t) {
+		kernels::assign<scalar_multiply_assign>(*this,t);
+		return *this;
+	}
+	fixed_matrix& operator /= (value_type t) {
+		kernels::assign<scalar_divide_assign>(*this,t);
+		return *this;
+	}
+
+	/// \brief Sets all elements to zero
+	void clear(){
+		m_storage.fill(value_type());
+	}
+
+	// Iterator types
+	typedef dense_storage_iterator<typename storage_type::iterator> row_iterator;
+	typedef dense_storage_iterator<typename storage_type::iterator> column_iterator;
+	typedef dense_storage_iterator<typename storage_type::const_iterator> const_row_iterator;
+	typedef dense_storage_iterator<typename storage_type::const_iterator> const_column_iterator;
+
+	const_row_iterator row_begin(index_type i) const {
+		return const_row_iterator(m_storage.begin() + i*stride1(),0,stride2());
+	}
+	const_row_iterator row_end(index_type i) const {
+		return const_row_iterator(m_storage.begin() + i*stride1()+stride2()*N,N,stride2());
+	}
+	row_iterator row_begin(index_type i){
+		return row_iterator(m_storage.begin() + i*stride1(),0,stride2());
+	}
+	row_iterator row_end(index_type i){
+		return row_iterator(m_storage.begin() + i*stride1()+stride2()*N,N,stride2());
+	}
+	const_column_iterator column_begin(index_type j) const {
+		return const_column_iterator(m_storage.begin()+j*stride2(),0,stride1());
+	}
+	const_column_iterator column_end(index_type j) const {
+		return const_column_iterator(m_storage.begin()+j*stride2()+ stride1()*M,M,stride1());
+	}
+	column_iterator column_begin(index_type j){
+		return column_iterator(m_storage.begin()+j*stride2(),0,stride1());
+	}
+	column_iterator column_end(index_type j){
+		return column_iterator(m_storage.begin()+j*stride2()+ stride1()*M,M,stride1());
+	}
+private:
+	storage_type m_storage;
+};
+
+/// \brief Computes A=alpha*B in the calling thread
+template<class T, std::size_t M, std::size_t N, class O, class E>
+void assign(
+	fixed_matrix<T,M,N,O>& A,
+	matrix_expression<E, cpu_tag> const& B,
+	typename fixed_matrix<T,M,N,O>::value_type alpha = T(1)
+){
+	ABLAS_SIZE_CHECK(B().size1() == M);
+	ABLAS_SIZE_CHECK(B().size2() == N);
+	detail::assign_fixed<scalar_assign>(A,B,alpha);
+}
+
+/// \brief Computes A+=alpha*B in the calling thread
+template<class T, std::size_t M, std::size_t N, class O, class E>
+void plus_assign(
+	fixed_matrix<T,M,N,O>& A,
+	matrix_expression<E, cpu_tag> const& B,
+	typename fixed_matrix<T,M,N,O>::value_type alpha = T(1)
+){
+	ABLAS_SIZE_CHECK(B().size1() == M);
+	ABLAS_SIZE_CHECK(B().size2() == N);
+	detail::assign_fixed<scalar_plus_assign>(A,B,alpha);
+}
+
+//closures of fixed size matrices, e.g. in noalias(A)=B, are assigned in the calling thread as well
+template<class T, std::size_t M, std::size_t N, class O, class E>
+void assign(
+	fixed_matrix_closure<fixed_matrix<T,M,N,O> >& A,
+	matrix_expression<E, cpu_tag> const& B,
+	typename fixed_matrix<T,M,N,O>::value_type alpha = T(1)
+){
+	assign(A.expression(),B,alpha);
+}
+template<class T, std::size_t M, std::size_t N, class O, class E>
+void plus_assign(
+	fixed_matrix_closure<fixed_matrix<T,M,N,O> >& A,
+	matrix_expression<E, cpu_tag> const& B,
+	typename fixed_matrix<T,M,N,O>::value_type alpha = T(1)
+){
+	plus_assign(A.expression(),B,alpha);
+}
+
+/// \brief Computes the matrix-vector product Av of fixed size arguments in the calling thread
+template<class T, std::size_t M, std::size_t N, class O>
+fixed_vector<T,M> prod(fixed_matrix<T,M,N,O> const& A, fixed_vector<T,N> const& v){
+	fixed_vector<T,M> result((uninitialized_tag()));
+	kernels::gemv(A,v,result,T(1),T());
+	return result;
+}
+
+/// \brief Computes the matrix-matrix product AB of fixed size arguments in the calling thread
+template<class T, std::size_t M, std::size_t K, std::size_t N, class O1, class O2>
+fixed_matrix<T,M,N> prod(fixed_matrix<T,M,K,O1> const& A, fixed_matrix<T,K,N,O2> const& B){
+	fixed_matrix<T,M,N> result((uninitialized_tag()));
+	kernels::gemm(A,B,result,T(1),T());
+	return result;
+}
+
+}
+#endif
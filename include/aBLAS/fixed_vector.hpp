@@ -0,0 +1,436 @@
+/*!
+ * 
+ *
+ * \brief       Implements the fixed size vector container class.
+ * 
+ * 
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_FIXED_VECTOR_HPP
+#define ABLAS_FIXED_VECTOR_HPP
+
+#include "vector.hpp"
+#include "kernels/fixed/assign.hpp"
+#include "kernels/fixed/dot.hpp"
+
+#include <array>
+#include <initializer_list>
+#include <algorithm>
+
+namespace aBLAS{
+
+namespace detail{
+//closures of non-const fixed size containers refer to the container
+template<class F>
+struct fixed_closure_holder{
+	fixed_closure_holder(F& f):m_object(&f){}
+	F& get()const{
+		return *m_object;
+	}
+private:
+	F* m_object;
+};
+//const closures store a copy, so that kernels in flight never refer to containers on the stack
+template<class F>
+struct fixed_closure_holder<F const>{
+	fixed_closure_holder(F const& f):m_object(f){}
+	F const& get()const{
+		return m_object;
+	}
+private:
+	F m_object;
+};
+
+///\brief Dependency node shared by all fixed size containers.
+///
+/// Fixed size containers are values which are computed in the calling thread and have no storage
+/// that could be kept alive for kernels in flight. The node is synchronous: writes through proxies,
+/// e.g. row(A,i) = v, wait for their arguments and are computed in the calling thread before the statement
+/// returns. Kernels in flight which read a fixed size container capture a copy, so reads are not tracked.
+/// Thus the node is always ready and containers never wait for each other.
+inline scheduling::dependency_node& fixed_size_dependencies(){
+	static scheduling::dependency_node node((scheduling::synchronous_tag()));
+	return node;
+}
+
+//computes v=f(v,alpha*e) in the calling thread.
+//if both are fixed size, the unrolled kernel is called directly
+template<template <class, class> class F, class T, class U, std::size_t N>
+void assign_fixed(
+	fixed_vector<T,N>& v,
+	fixed_vector<U,N> const& e,
+	typename fixed_vector<T,N>::value_type alpha
+){
+	kernels::assign<F>(v,e,alpha);
+}
+template<template <class, class> class F, class T, std::size_t N, class V>
+void assign_fixed(
+	fixed_vector<T,N>& v,
+	fixed_vector_closure<V> const& e,
+	typename fixed_vector<T,N>::value_type alpha
+){
+	kernels::assign<F>(v,e.expression(),alpha);
+}
+//otherwise the expression might depend on kernels in flight and is evaluated by the scheduler first
+template<template <class, class> class F, class T, std::size_t N, class E>
+void assign_fixed(
+	fixed_vector<T,N>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename fixed_vector<T,N>::value_type alpha
+){
+	typename vector_temporary<E>::type temporary(e);
+	temporary.wait();
+	kernels::assign<F>(v,temporary,alpha);
+}
+}
+
+/// \brief Closure of a fixed_vector.
+///
+/// The closure of a non-const fixed_vector refers to the vector, the const closure stores a copy of it.
+template<class V>
+class fixed_vector_closure:public vector_expression<fixed_vector_closure<V>, cpu_tag >{
+	typedef typename boost::remove_const<V>::type vector_type;
+public:
+	typedef typename vector_type::size_type size_type;
+	typedef typename vector_type::difference_type difference_type;
+	typedef typename vector_type::value_type value_type;
+	typedef typename vector_type::const_reference const_reference;
+	typedef typename aBLAS::reference<V>::type reference;
+	typedef typename vector_type::index_type index_type;
+	typedef typename vector_type::const_storage_type const_storage_type;
+	typedef typename aBLAS::storage<V>::type storage_type;
+
+	typedef fixed_vector_closure closure_type;
+	typedef fixed_vector_closure<vector_type const> const_closure_type;
+	typedef dense_tag storage_category;
+	typedef elementwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+
+	fixed_vector_closure(V& v):m_holder(v){}
+
+	//conversion closure->const_closure
+	template<class E>
+	fixed_vector_closure(fixed_vector_closure<E> const& other):m_holder(other.expression()){}
+
+	V& expression()const{
+		return m_holder.get();
+	}
+
+	size_type size()const{
+		return expression().size();
+	}
+	storage_type& storage()const{
+		return expression().storage();
+	}
+	difference_type stride()const{
+		return 1;
+	}
+	difference_type offset()const{
+		return 0;
+	}
+
+	bool is_ready()const{
+		return expression().is_ready();
+	}
+	void wait(){
+		dependencies().wait();
+	}
+	scheduling::dependency_node& dependencies() const{
+		return expression().dependencies();
+	}
+
+	reference operator()(index_type i)const{
+		return expression()(i);
+	}
+	reference operator[](index_type i)const{
+		return expression()(i);
+	}
+
+	typedef typename boost::mpl::if_<
+		boost::is_const<V>,
+		typename vector_type::const_iterator,
+		typename vector_type::iterator
+	>::type iterator;
+	typedef typename vector_type::const_iterator const_iterator;
+
+	iterator begin()const{
+		return expression().begin();
+	}
+	iterator end()const{
+		return expression().end();
+	}
+private:
+	detail::fixed_closure_holder<V> m_holder;
+};
+
+/// \brief A dense vector of compile time size N with the elements stored inside the object.
+///
+/// fixed_vector is meant for small vectors, e.g. points and directions in 3D. It does not allocate and
+/// has no dependency_node of its own. All operations with fixed size vectors and matrices as arguments
+/// are computed synchronously in the calling thread by the unrolled kernels in kernels/fixed/, independent
+/// of the scheduler. Expressions involving dynamic containers are evaluated by the scheduler and waited for
+/// before they are assigned to a fixed_vector.
+///
+/// A fixed_vector can be used as argument in all expressions. Kernels in flight read a copy of it.
+/// Writes through proxies, e.g. subrange(v,0,2) = w, wait for the right hand side and are computed in the calling thread
+/// as well, so the vector can be read or destroyed directly afterwards.
+///
+/// \tparam T type of the objects stored in the vector (like int, double, complex,...)
+/// \tparam N the number of elements
+template<class T, std::size_t N>
+class fixed_vector:public vector_expression<fixed_vector<T,N>, cpu_tag >{
+	static_assert(N > 0, "fixed_vector must have at least one element");
+public:
+	typedef std::array<T,N> storage_type;
+	typedef storage_type const const_storage_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef T value_type;
+	typedef T const& const_reference;
+	typedef T& reference;
+	typedef std::size_t index_type;
+
+	typedef fixed_vector_closure<fixed_vector> closure_type;
+	typedef fixed_vector_closure<fixed_vector const> const_closure_type;
+	typedef dense_tag storage_category;
+	typedef elementwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+
+	static const size_type static_size = N;
+
+	// Construction
+
+	/// \brief Constructs a vector with all elements set to zero
+	fixed_vector():m_storage(){}
+
+	/// \brief Constructs a vector whose elements are not initialized
+	explicit fixed_vector(uninitialized_tag){}
+
+	/// \brief Constructs a vector with all elements initialized to an initial value
+	explicit fixed_vector(value_type init){
+		m_storage.fill(init);
+	}
+
+	/// \brief Constructs a vector from a list of exactly N values
+	fixed_vector(std::initializer_list<value_type> values){
+		ABLAS_SIZE_CHECK(values.size() == N);
+		std::copy(values.begin(),values.end(),m_storage.begin());
+	}
+
+	/// \brief Creates a vector from a vector_expression
+	template<class E>
+	fixed_vector(vector_expression<E, cpu_tag> const& e){
+		ABLAS_SIZE_CHECK(e().size() == N);
+		detail::assign_fixed<scalar_assign>(*this,e,value_type(1));
+	}
+
+	///\brief Returns the size of the vector
+	size_type size()const{
+		return N;
+	}
+	bool empty()const{
+		return false;
+	}
+
+	// ---------
+	// Dense low level interface
+	// ---------
+	///\brief Returns the internal vector storage
+	storage_type& storage(){
+		return m_storage;
+	}
+	///\brief Returns the internal vector storage
+	const_storage_type& storage()const{
+		return m_storage;
+	}
+	///\brief Returns the stride between the elements in storage(), which is always 1
+	difference_type stride()const{
+		return 1;
+	}
+	///\brief Returns the offset from the start of storage(), which is always 0
+	difference_type offset()const{
+		return 0;
+	}
+
+	// ---------
+	// Async Interface
+	// ---------
+
+	/// \brief Returns true, as no kernel in flight writes to a fixed size container.
+	bool is_ready()const{
+		return dependencies().is_ready();
+	}
+
+	/// \brief Returns directly, as no kernel in flight writes to a fixed size container.
+	void wait(){
+		dependencies().wait();
+	}
+
+	///\brief Returns the dependencies shared by all fixed size containers.
+	scheduling::dependency_node& dependencies() const{
+		return detail::fixed_size_dependencies();
+	}
+
+	// --------------
+	// Element access
+	// --------------
+
+	const_reference operator()(index_type i) const {
+		ABLAS_SIZE_CHECK(i < N);
+		return m_storage[i];
+	}
+	reference operator()(index_type i) {
+		ABLAS_SIZE_CHECK(i < N);
+		return m_storage[i];
+	}
+	const_reference operator [](index_type i) const {
+		return (*this)(i);
+	}
+	reference operator [](index_type i) {
+		return (*this)(i);
+	}
+
+	// -------------------
+	// Assignment operators
+	// -------------------
+
+	/// \brief Assigns the result of a vector_expression, computed in the calling thread
+	template<class E>
+	fixed_vector& operator = (vector_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size() == N);
+		detail::assign_fixed<scalar_assign>(*this,e,value_type(1));
+		return *this;
+	}
+	template<class E>
+	fixed_vector& operator += (vector_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size() == N);
+		detail::assign_fixed<scalar_plus_assign>(*this,e,value_type(1));
+		return *this;
+	}
+	template<class E>
+	fixed_vector& operator -= (vector_expression<E, cpu_tag> const& e) {
+		ABLAS_SIZE_CHECK(e().size() == N);
+		detail::assign_fixed<scalar_plus_assign>(*this,e,value_type(-1));
+		return *this;
+	}
+	fixed_vector& operator += (value_type t) {
+		kernels::assign<scalar_plus_assign>(*this,t);
+		return *this;
+	}
+	fixed_vector& operator -= (value_type t) {
+		kernels::assign<scalar_minus_assign>(*this,t);
+		return *this;
+	}
+	fixed_vector& operator *= (value_type t) {
+		kernels::assign<scalar_multiply_assign>(*this,t);
+		return *this;
+	}
+	fixed_vector& operator /= (value_type t) {
+		kernels::assign<scalar_divide_assign>(*this,t);
+		return *this;
+	}
+
+	/// \brief Sets all elements to zero
+	void clear(){
+		m_storage.fill(value_type());
+	}
+
+	// Iterator types
+	typedef dense_storage_iterator<typename storage_type::iterator> iterator;
+	typedef dense_storage_iterator<typename storage_type::const_iterator> const_iterator;
+
+	const_iterator cbegin() const {
+		return const_iterator(m_storage.begin(),0);
+	}
+	const_iterator cend() const {
+		return const_iterator(m_storage.begin(),N);
+	}
+	const_iterator begin() const {
+		return cbegin();
+	}
+	const_iterator end() const {
+		return cend();
+	}
+	iterator begin(){
+		return iterator(m_storage.begin(),0);
+	}
+	iterator end(){
+		return iterator(m_storage.begin(),N);
+	}
+private:
+	storage_type m_storage;
+};
+
+/// \brief Computes x=alpha*v in the calling thread
+template<class T, std::size_t N, class E>
+void assign(
+	fixed_vector<T,N>& x,
+	vector_expression<E, cpu_tag> const& v,
+	typename fixed_vector<T,N>::value_type alpha = T(1)
+){
+	ABLAS_SIZE_CHECK(v().size() == N);
+	detail::assign_fixed<scalar_assign>(x,v,alpha);
+}
+
+/// \brief Computes x+=alpha*v in the calling thread
+template<class T, std::size_t N, class E>
+void plus_assign(
+	fixed_vector<T,N>& x,
+	vector_expression<E, cpu_tag> const& v,
+	typename fixed_vector<T,N>::value_type alpha = T(1)
+){
+	ABLAS_SIZE_CHECK(v().size() == N);
+	detail::assign_fixed<scalar_plus_assign>(x,v,alpha);
+}
+
+//closures of fixed size vectors, e.g. in noalias(x)=v, are assigned in the calling thread as well
+template<class T, std::size_t N, class E>
+void assign(
+	fixed_vector_closure<fixed_vector<T,N> >& x,
+	vector_expression<E, cpu_tag> const& v,
+	typename fixed_vector<T,N>::value_type alpha = T(1)
+){
+	assign(x.expression(),v,alpha);
+}
+template<class T, std::size_t N, class E>
+void plus_assign(
+	fixed_vector_closure<fixed_vector<T,N> >& x,
+	vector_expression<E, cpu_tag> const& v,
+	typename fixed_vector<T,N>::value_type alpha = T(1)
+){
+	plus_assign(x.expression(),v,alpha);
+}
+
+/// \brief Computes the inner product of two fixed size vectors in the calling thread
+template<class T, class U, std::size_t N>
+typename promote_traits<T,U>::promote_type inner_prod(fixed_vector<T,N> const& v1, fixed_vector<U,N> const& v2){
+	typename promote_traits<T,U>::promote_type result;
+	kernels::dot(v1,v2,result);
+	return result;
+}
+
+}
+#endif
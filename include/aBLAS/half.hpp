@@ -0,0 +1,218 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       16 bit floating point element types for low precision storage
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_HALF_HPP
+#define ABLAS_HALF_HPP
+
+#include "detail/traits.hpp"
+#include "detail/math.hpp"
+#include <boost/mpl/bool.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace aBLAS{
+
+namespace detail{
+
+///\brief Converts a float to IEEE 754 binary16 with rounding to nearest even.
+inline std::uint16_t float_to_half_bits(float value){
+	std::uint32_t const f32_infinity = 255u << 23;
+	std::uint32_t const f16_overflow = (127u + 16) << 23;
+	std::uint32_t const denorm_magic = ((127u - 15) + (23 - 10) + 1) << 23;
+	std::uint32_t x = float_bits(value);
+	std::uint32_t sign = x & 0x80000000u;
+	x ^= sign;
+	std::uint32_t result;
+	if(x >= f16_overflow){//inf, nan or too large
+		result = x > f32_infinity ? 0x7e00 : 0x7c00;
+	}else if(x < (113u << 23)){//subnormal or zero: let the float adder do the rounding
+		result = float_bits(bits_float(x) + bits_float(denorm_magic)) - denorm_magic;
+	}else{
+		std::uint32_t mantissa_odd = (x >> 13) & 1;
+		x += (std::uint32_t(15 - 127) << 23) + 0xfff + mantissa_odd;
+		result = x >> 13;
+	}
+	return std::uint16_t(result | (sign >> 16));
+}
+
+///\brief Converts IEEE 754 binary16 to float. The conversion is exact.
+inline float half_bits_to_float(std::uint16_t bits){
+	std::uint32_t const shifted_exponent = 0x7c00u << 13;
+	std::uint32_t x = (bits & 0x7fffu) << 13;
+	std::uint32_t exponent = x & shifted_exponent;
+	x += (127u - 15) << 23;
+	if(exponent == shifted_exponent){//inf or nan
+		x += (128u - 16) << 23;
+	}else if(exponent == 0){//subnormal or zero: renormalize
+		x += 1u << 23;
+		x = float_bits(bits_float(x) - bits_float(113u << 23));
+	}
+	return bits_float(x | (std::uint32_t(bits & 0x8000u) << 16));
+}
+
+///\brief Converts a float to bfloat16 with rounding to nearest even.
+inline std::uint16_t float_to_bfloat16_bits(float value){
+	std::uint32_t x = float_bits(value);
+	if((x & 0x7fffffffu) > 0x7f800000u)//keep nans quiet
+		return std::uint16_t((x >> 16) | 0x40);
+	return std::uint16_t((x + 0x7fffu + ((x >> 16) & 1)) >> 16);
+}
+
+///\brief Converts bfloat16 to float. The conversion is exact.
+inline float bfloat16_bits_to_float(std::uint16_t bits){
+	return bits_float(std::uint32_t(bits) << 16);
+}
+}
+
+///\brief IEEE 754 half precision floating point number used as storage type.
+///
+/// half only stores values, all arithmetic is performed after conversion to float.
+/// Thus expressions like h1*h2 are of type float and the products of matrices of
+/// half are computed and returned in float. Assigning a float rounds to the nearest
+/// representable value. The default constructor does not initialize the value,
+/// so that containers of half can be created uninitialized.
+class half{
+public:
+	half() = default;
+	half(float value):m_bits(detail::float_to_half_bits(value)){}
+
+	operator float()const{
+		return detail::half_bits_to_float(m_bits);
+	}
+
+	half& operator+=(float value){
+		return *this = half(float(*this) + value);
+	}
+	half& operator-=(float value){
+		return *this = half(float(*this) - value);
+	}
+	half& operator*=(float value){
+		return *this = half(float(*this) * value);
+	}
+	half& operator/=(float value){
+		return *this = half(float(*this) / value);
+	}
+
+	///\brief Returns the binary16 representation.
+	std::uint16_t bits()const{
+		return m_bits;
+	}
+	///\brief Creates a half from its binary16 representation.
+	static half from_bits(std::uint16_t bits){
+		half h;
+		h.m_bits = bits;
+		return h;
+	}
+private:
+	std::uint16_t m_bits;
+};
+
+///\brief bfloat16 floating point number used as storage type.
+///
+/// bfloat16 is a float with the lower 16 bits of the mantissa removed. It has the range of
+/// float with about 3 significant decimal digits. As half, it only stores values and all arithmetic is
+/// performed in float.
+/// Some cblas.h headers declare a global bfloat16 type, so code using both should write aBLAS::bfloat16.
+class bfloat16{
+public:
+	bfloat16() = default;
+	bfloat16(float value):m_bits(detail::float_to_bfloat16_bits(value)){}
+
+	operator float()const{
+		return detail::bfloat16_bits_to_float(m_bits);
+	}
+
+	bfloat16& operator+=(float value){
+		return *this = bfloat16(float(*this) + value);
+	}
+	bfloat16& operator-=(float value){
+		return *this = bfloat16(float(*this) - value);
+	}
+	bfloat16& operator*=(float value){
+		return *this = bfloat16(float(*this) * value);
+	}
+	bfloat16& operator/=(float value){
+		return *this = bfloat16(float(*this) / value);
+	}
+
+	///\brief Returns the bit representation.
+	std::uint16_t bits()const{
+		return m_bits;
+	}
+	///\brief Creates a bfloat16 from its bit representation.
+	static bfloat16 from_bits(std::uint16_t bits){
+		bfloat16 b;
+		b.m_bits = bits;
+		return b;
+	}
+private:
+	std::uint16_t m_bits;
+};
+
+//the arithmetic of the 16 bit types is float arithmetic, mixing with double is done in double
+template<>
+struct promote_traits<half,half>{
+	typedef float promote_type;
+};
+template<>
+struct promote_traits<bfloat16,bfloat16>{
+	typedef float promote_type;
+};
+template<>
+struct promote_traits<half,bfloat16>{
+	typedef float promote_type;
+};
+template<>
+struct promote_traits<bfloat16,half>{
+	typedef float promote_type;
+};
+template<class T>
+struct promote_traits<half,T>: public promote_traits<float,T>{};
+template<class T>
+struct promote_traits<T,half>: public promote_traits<T,float>{};
+template<class T>
+struct promote_traits<bfloat16,T>: public promote_traits<float,T>{};
+template<class T>
+struct promote_traits<T,bfloat16>: public promote_traits<T,float>{};
+
+///\brief True for the 16 bit storage types half and bfloat16.
+template<class T>
+struct is_low_precision: public boost::mpl::false_{};
+template<>
+struct is_low_precision<half>: public boost::mpl::true_{};
+template<>
+struct is_low_precision<bfloat16>: public boost::mpl::true_{};
+template<class T>
+struct is_low_precision<T const>: public is_low_precision<T>{};
+
+}
+#endif
@@ -77,12 +77,56 @@ extern "C" {
 //so we prevent multiple includes in all atlas using functions
 //which should decrease compile time a small bit
 #include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include "../traits.hpp"
 
 namespace aBLAS {
 namespace bindings {
 
+///\brief Integer type of the sizes, strides and leading dimensions passed to cblas.
+///
+/// With ABLAS_CBLAS_ILP64 defined a 64 bit integer is used. This requires a BLAS built with the ILP64
+/// interface, e.g. OpenBLAS with INTERFACE64=1 or the ilp64 interface of MKL.
+/// Otherwise sizes are 32 bit and the bindings split products whose sizes do not fit into sub-products.
+#ifdef ABLAS_CBLAS_ILP64
+typedef std::int64_t cblas_int;
+#else
+typedef int cblas_int;
+#endif
+
+///\brief Largest size, stride or leading dimension passed to cblas.
+///
+/// ABLAS_CBLAS_MAX_INDEX can be defined to a smaller value to test the splitting of products.
+inline std::size_t cblas_max_size(){
+#ifdef ABLAS_CBLAS_MAX_INDEX
+	return ABLAS_CBLAS_MAX_INDEX;
+#else
+	return std::numeric_limits<cblas_int>::max();
+#endif
+}
+
+///\brief Returns true if a stride or leading dimension can be passed to cblas.
+///
+/// In contrast to sizes, they can not be reduced by splitting an operation.
+inline bool cblas_fits(std::ptrdiff_t value){
+	std::size_t magnitude = value < 0? std::size_t(-value): std::size_t(value);
+	return magnitude <= cblas_max_size();
+}
+
+///\brief Offset of element (i,j) of op(A) for A stored in the given order with leading dimension ld.
+inline std::size_t cblas_offset(
+	CBLAS_ORDER order, CBLAS_TRANSPOSE trans,
+	std::size_t i, std::size_t j, std::size_t ld
+){
+	bool row_major = (order == CblasRowMajor) == (trans == CblasNoTrans);
+	return row_major? i * ld + j: i + j * ld;
+}
+
 template <typename Ord> struct storage_order {};
 template<> struct storage_order<row_major> {
 	enum ename { value = CblasRowMajor };
@@ -91,6 +135,40 @@ template<> struct storage_order<column_major> {
 	enum ename { value = CblasColMajor };
 };
 
+///\brief True for the value types supported by cblas: float, double and their complex counterparts.
+template<class T>
+struct cblas_value_type: public boost::mpl::false_{};
+template<> struct cblas_value_type<float>: public boost::mpl::true_{};
+template<> struct cblas_value_type<double>: public boost::mpl::true_{};
+template<> struct cblas_value_type<std::complex<float> >: public boost::mpl::true_{};
+template<> struct cblas_value_type<std::complex<double> >: public boost::mpl::true_{};
+
+///\brief True for float and double. The routines of triangular and symmetric matrices are only bound for real value types.
+template<class T>
+struct cblas_real_type: public boost::mpl::false_{};
+template<> struct cblas_real_type<float>: public boost::mpl::true_{};
+template<> struct cblas_real_type<double>: public boost::mpl::true_{};
+
+///\brief The stored triangle of a triangular or symmetric matrix. It flips if the matrix is passed to cblas transposed.
+template<class TriangularType>
+CBLAS_UPLO cblas_uplo(bool transposed = false){
+	return (TriangularType::is_upper != transposed)? CblasUpper: CblasLower;
+}
+///\brief Whether the diagonal of a triangular matrix is assumed to be one.
+template<class TriangularType>
+CBLAS_DIAG cblas_diag(){
+	return TriangularType::is_unit? CblasUnit: CblasNonUnit;
+}
+
+///\brief True if two dense expressions have the same value type which is supported by cblas.
+template<class E1, class E2>
+struct cblas_dense_pair: public boost::mpl::and_<
+	boost::is_same<typename E1::storage_category, dense_tag>,
+	boost::is_same<typename E2::storage_category, dense_tag>,
+	boost::is_same<typename E1::value_type, typename E2::value_type>,
+	cblas_value_type<typename E1::value_type>
+>{};
+
 }}
 
 
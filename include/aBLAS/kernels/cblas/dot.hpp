@@ -0,0 +1,123 @@
+/*!
+ * 
+ *
+ * \brief       cblas binding for the DOT routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_CBLAS_DOT_HPP
+#define ABLAS_KERNELS_CBLAS_DOT_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/dot.hpp"
+#include <algorithm>
+
+namespace aBLAS {namespace bindings {
+
+inline void dot(cblas_int const N,
+	float const* x, cblas_int const incx,
+	float const* y, cblas_int const incy,
+	float& result
+){
+	result = cblas_sdot(N, x, incx, y, incy);
+}
+
+inline void dot(cblas_int const N,
+	double const* x, cblas_int const incx,
+	double const* y, cblas_int const incy,
+	double& result
+){
+	result = cblas_ddot(N, x, incx, y, incy);
+}
+
+inline void dot(cblas_int const N,
+	std::complex<float> const* x, cblas_int const incx,
+	std::complex<float> const* y, cblas_int const incy,
+	std::complex<float>& result
+){
+	cblas_cdotu_sub(N,
+		static_cast<cblas_float_complex_type const* >(x), incx,
+		static_cast<cblas_float_complex_type const* >(y), incy,
+		static_cast<cblas_float_complex_type* >(&result)
+	);
+}
+
+inline void dot(cblas_int const N,
+	std::complex<double> const* x, cblas_int const incx,
+	std::complex<double> const* y, cblas_int const incy,
+	std::complex<double>& result
+){
+	cblas_zdotu_sub(N,
+		static_cast<cblas_double_complex_type const* >(x), incx,
+		static_cast<cblas_double_complex_type const* >(y), incy,
+		static_cast<cblas_double_complex_type* >(&result)
+	);
+}
+
+// longer vectors are split and the partial results summed
+template<class T>
+void dot_split(std::size_t N,
+	T const* x, std::ptrdiff_t incx,
+	T const* y, std::ptrdiff_t incy,
+	T& result
+){
+	std::size_t const max_size = cblas_max_size();
+	result = T();
+	for(std::size_t i = 0; i < N; i += max_size){
+		T partial;
+		dot((cblas_int)std::min(N - i, max_size), x + std::ptrdiff_t(i) * incx, (cblas_int)incx, y + std::ptrdiff_t(i) * incy, (cblas_int)incy, partial);
+		result += partial;
+	}
+}
+
+// result = x^Ty
+template<class E1, class E2, class result_type>
+void dot(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	result_type& result,
+	boost::mpl::true_
+){
+	ABLAS_SIZE_CHECK(x().size() == y().size());
+	//strides which do not fit into cblas_int can not be split, the default kernel is used.
+	if(!cblas_fits(traits::stride(x)) || !cblas_fits(traits::stride(y))){
+		dot(x,y,result,boost::mpl::false_());
+		return;
+	}
+	dot_split(x().size(),
+		traits::storage(x), traits::stride(x),
+		traits::storage(y), traits::stride(y),
+		result
+	);
+}
+
+template<class E1, class E2, class result_type>
+struct has_optimized_dot: public boost::mpl::and_<
+	cblas_dense_pair<E1,E2>,
+	boost::is_same<typename E1::value_type, result_type>
+>{};
+
+}}
+#endif
@@ -31,15 +31,17 @@
 #define ABLAS_KERNELS_CBLAS_GEMM_HPP
 
 #include "cblas_inc.hpp"
+#include "../default/gemm.hpp"
+#include <algorithm>
 
 namespace aBLAS { namespace bindings {
 
 inline void gemm(
 	CBLAS_ORDER const Order, CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB,
-	int M, int N, int K,
-	float alpha, float const *A, int lda,
-	float const *B, int ldb,
-	float beta, float *C, int ldc
+	cblas_int M, cblas_int N, cblas_int K,
+	float alpha, float const *A, cblas_int lda,
+	float const *B, cblas_int ldb,
+	float beta, float *C, cblas_int ldc
 ){
 	cblas_sgemm(
 		Order, TransA, TransB,
@@ -52,10 +54,10 @@ inline void gemm(
 
 inline void gemm(
 	CBLAS_ORDER const Order, CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB,
-	int M, int N, int K,
-	double alpha, double const *A, int lda,
-	double const *B, int ldb,
-	double beta, double *C, int ldc
+	cblas_int M, cblas_int N, cblas_int K,
+	double alpha, double const *A, cblas_int lda,
+	double const *B, cblas_int ldb,
+	double beta, double *C, cblas_int ldc
 ){
 	cblas_dgemm(
 		Order, TransA, TransB,
@@ -70,12 +72,12 @@ inline void gemm(
 
 inline void gemm(
 	CBLAS_ORDER const Order, CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB,
-	int M, int N, int K,
+	cblas_int M, cblas_int N, cblas_int K,
 	float alpha,
-	std::complex<float> const *A, int lda,
-	std::complex<float> const *B, int ldb,
+	std::complex<float> const *A, cblas_int lda,
+	std::complex<float> const *B, cblas_int ldb,
 	float beta,
-	std::complex<float>* C, int ldc
+	std::complex<float>* C, cblas_int ldc
 ) {
 	std::complex<float> alphaArg(alpha,0);
 	std::complex<float> betaArg(beta,0);
@@ -92,12 +94,12 @@ inline void gemm(
 
 inline void gemm(
 	CBLAS_ORDER const Order, CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB,
-	int M, int N, int K,
+	cblas_int M, cblas_int N, cblas_int K,
 	double alpha,
-	std::complex<double> const *A, int lda,
-	std::complex<double> const *B, int ldb,
+	std::complex<double> const *A, cblas_int lda,
+	std::complex<double> const *B, cblas_int ldb,
 	double beta,
-	std::complex<double>* C, int ldc
+	std::complex<double>* C, cblas_int ldc
 ) {
 	std::complex<double> alphaArg(alpha,0);
 	std::complex<double> betaArg(beta,0);
@@ -112,6 +114,38 @@ inline void gemm(
 	);
 }
 
+// computes the product as a sequence of sub-products whose sizes fit into cblas_int.
+// sub-products along k accumulate into C.
+template<class T, class Scalar>
+void gemm_split(
+	CBLAS_ORDER const Order, CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB,
+	std::size_t M, std::size_t N, std::size_t K,
+	Scalar alpha, T const* A, std::size_t lda,
+	T const* B, std::size_t ldb,
+	Scalar beta, T* C, std::size_t ldc
+){
+	std::size_t const max_size = cblas_max_size();
+	for(std::size_t i = 0; i < M; i += max_size){
+		std::size_t rows = std::min(M - i, max_size);
+		for(std::size_t j = 0; j < N; j += max_size){
+			std::size_t columns = std::min(N - j, max_size);
+			//K == 0 still scales C by beta
+			std::size_t l = 0;
+			do{
+				std::size_t middle = std::min(K - l, max_size);
+				gemm(
+					Order, TransA, TransB,
+					(cblas_int)rows, (cblas_int)columns, (cblas_int)middle,
+					alpha, A + cblas_offset(Order, TransA, i, l, lda), (cblas_int)lda,
+					B + cblas_offset(Order, TransB, l, j, ldb), (cblas_int)ldb,
+					l == 0? beta: Scalar(1), C + cblas_offset(Order, CblasNoTrans, i, j, ldc), (cblas_int)ldc
+				);
+				l += max_size;
+			}while(l < K);
+		}
+	}
+}
+
 // C <- alpha * A * B + beta * C
 template <typename MatrA, typename MatrB, typename MatrC>
 void gemm(
@@ -119,30 +153,60 @@ void gemm(
 	matrix_expression<MatrB,cpu_tag> const &matB,
 	matrix_expression<MatrC,cpu_tag>& matC, 
 	typename MatrC::value_type alpha,
+	typename MatrC::value_type beta,
 	boost::mpl::true_
 ) {
 	ABLAS_SIZE_CHECK(matA().size1() == matC().size1());
 	ABLAS_SIZE_CHECK(matB().size2() == matC().size2());
 	ABLAS_SIZE_CHECK(matA().size2()== matB().size1());
 	
-	CBLAS_TRANSPOSE transA = traits::same_orientation(matA,matC)?CblasNoTrans:CblasTrans;
-	CBLAS_TRANSPOSE transB = traits::same_orientation(matB,matC)?CblasNoTrans:CblasTrans;
 	std::size_t m = matC().size1();
 	std::size_t n = matC().size2();
 	std::size_t k = matA().size2();
+	
+	//leading dimensions which do not fit into cblas_int can not be split, the default kernel is used.
+	if(
+		!cblas_fits(traits::leading_dimension(matA))
+		|| !cblas_fits(traits::leading_dimension(matB))
+		|| !cblas_fits(traits::leading_dimension(matC))
+	){
+		gemm(matA,matB,matC,alpha,beta,boost::mpl::false_());
+		return;
+	}
+
+	CBLAS_TRANSPOSE transA = traits::same_orientation(matA,matC)?CblasNoTrans:CblasTrans;
+	CBLAS_TRANSPOSE transB = traits::same_orientation(matB,matC)?CblasNoTrans:CblasTrans;
 	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatrC::orientation >::value;
 
-	gemm(stor_ord, transA, transB, (int)m, (int)n, (int)k, alpha,
+	gemm_split(stor_ord, transA, transB, m, n, k, alpha,
 		traits::storage(matA()),
 		traits::leading_dimension(matA()),
 		traits::storage(matB()),
 		traits::leading_dimension(matB()),
-		typename MatrC::value_type(1),
+		beta,
 		traits::storage(matC()),
 		traits::leading_dimension(matC())
 	);
 }
 
+// C[k] <- alpha * A[k] * B[k] + beta * C[k] for k=start,...,end-1
+template <class StackA, class StackB, class StackC, class T>
+void gemm_batched(
+	StackA const& A,
+	StackB const& B,
+	StackC& C,
+	T alpha, T beta,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+){
+	for(std::size_t k = start; k != end; ++k){
+		auto a = A[k];
+		auto b = B[k];
+		auto c = C[k];
+		gemm(a,b,c,alpha,beta,boost::mpl::true_());
+	}
+}
+
 
 template<class Storage1, class Storage2, class Storage3, class T1, class T2, class T3>
 struct optimized_gemm_detail{
@@ -31,14 +31,16 @@
 #define ABLAS_KERNELS_CBLAS_GEMV_HPP
 
 #include "cblas_inc.hpp"
+#include "../default/gemv.hpp"
+#include <algorithm>
 
 namespace aBLAS {namespace bindings {
 
 inline void gemv(CBLAS_ORDER const Order,
-        CBLAS_TRANSPOSE const TransA, int const M, int const N,
-        double alpha, float const *A, int const lda,
-        float const *X, int const incX,
-        double beta, float *Y, int const incY
+        CBLAS_TRANSPOSE const TransA, cblas_int const M, cblas_int const N,
+        double alpha, float const *A, cblas_int const lda,
+        float const *X, cblas_int const incX,
+        double beta, float *Y, cblas_int const incY
 ) {
 	cblas_sgemv(Order, TransA, M, N, alpha, A, lda,
 	        X, incX,
@@ -46,10 +48,10 @@ inline void gemv(CBLAS_ORDER const Order,
 }
 
 inline void gemv(CBLAS_ORDER const Order,
-        CBLAS_TRANSPOSE const TransA, int const M, int const N,
-        double alpha, double const *A, int const lda,
-        double const *X, int const incX,
-        double beta, double *Y, int const incY
+        CBLAS_TRANSPOSE const TransA, cblas_int const M, cblas_int const N,
+        double alpha, double const *A, cblas_int const lda,
+        double const *X, cblas_int const incX,
+        double beta, double *Y, cblas_int const incY
 ) {
 	cblas_dgemv(Order, TransA, M, N, alpha, A, lda,
 	        X, incX,
@@ -57,12 +59,12 @@ inline void gemv(CBLAS_ORDER const Order,
 }
 
 inline void gemv(CBLAS_ORDER const Order,
-        CBLAS_TRANSPOSE const TransA, int const M, int const N,
+        CBLAS_TRANSPOSE const TransA, cblas_int const M, cblas_int const N,
         double alpha,
-        std::complex<float> const *A, int const lda,
-        std::complex<float> const *X, int const incX,
+        std::complex<float> const *A, cblas_int const lda,
+        std::complex<float> const *X, cblas_int const incX,
         double beta,
-        std::complex<float> *Y, int const incY
+        std::complex<float> *Y, cblas_int const incY
 ) {
 	std::complex<float> alphaArg(alpha,0);
 	std::complex<float> betaArg(beta,0);
@@ -75,12 +77,12 @@ inline void gemv(CBLAS_ORDER const Order,
 }
 
 inline void gemv(CBLAS_ORDER const Order,
-        CBLAS_TRANSPOSE const TransA, int const M, int const N,
+        CBLAS_TRANSPOSE const TransA, cblas_int const M, cblas_int const N,
          double alpha,
-        std::complex<double> const *A, int const lda,
-        std::complex<double> const *X, int const incX,
+        std::complex<double> const *A, cblas_int const lda,
+        std::complex<double> const *X, cblas_int const incX,
         double beta,
-        std::complex<double> *Y, int const incY
+        std::complex<double> *Y, cblas_int const incY
 ) {
 	std::complex<double> alphaArg(alpha,0);
 	std::complex<double> betaArg(beta,0);
@@ -93,6 +95,31 @@ inline void gemv(CBLAS_ORDER const Order,
 }
 
 
+// computes the product as a sequence of sub-products whose sizes fit into cblas_int.
+// sub-products along N accumulate into y.
+template<class T, class Scalar>
+void gemv_split(CBLAS_ORDER const Order, std::size_t M, std::size_t N,
+	Scalar alpha, T const* A, std::size_t lda,
+	T const* X, std::ptrdiff_t incX,
+	Scalar beta, T* Y, std::ptrdiff_t incY
+){
+	std::size_t const max_size = cblas_max_size();
+	for(std::size_t i = 0; i < M; i += max_size){
+		std::size_t rows = std::min(M - i, max_size);
+		//N == 0 still scales y by beta
+		std::size_t j = 0;
+		do{
+			std::size_t columns = std::min(N - j, max_size);
+			gemv(Order, CblasNoTrans, (cblas_int)rows, (cblas_int)columns,
+				alpha, A + cblas_offset(Order, CblasNoTrans, i, j, lda), (cblas_int)lda,
+				X + std::ptrdiff_t(j) * incX, (cblas_int)incX,
+				j == 0? beta: Scalar(1), Y + std::ptrdiff_t(i) * incY, (cblas_int)incY
+			);
+			j += max_size;
+		}while(j < N);
+	}
+}
+
 // y <- alpha * op (A) * x + beta * y
 // op (A) == A || A^T || A^H
 template <typename MatrA, typename VectorX, typename VectorY>
@@ -101,6 +128,7 @@ void gemv(
 	vector_expression<VectorX,cpu_tag> const &x,
         vector_expression<VectorY,cpu_tag> &y,
 	typename VectorY::value_type alpha,
+	typename VectorY::value_type beta,
 	boost::mpl::true_
 ){
 	std::size_t m = A().size1();
@@ -109,13 +137,23 @@ void gemv(
 	ABLAS_SIZE_CHECK(x().size() == A().size2());
 	ABLAS_SIZE_CHECK(y().size() == A().size1());
 
+	//strides which do not fit into cblas_int can not be split, the default kernel is used.
+	if(
+		!cblas_fits(traits::leading_dimension(A))
+		|| !cblas_fits(traits::stride(x))
+		|| !cblas_fits(traits::stride(y))
+	){
+		gemv(A,x,y,alpha,beta,boost::mpl::false_());
+		return;
+	}
+
 	CBLAS_ORDER const stor_ord= (CBLAS_ORDER)storage_order<typename MatrA::orientation>::value;
-	gemv(stor_ord, CblasNoTrans, (int)m, (int)n, alpha,
+	gemv_split(stor_ord, m, n, alpha,
 	        traits::storage(A),
 		traits::leading_dimension(A),
 	        traits::storage(x),
 	        traits::stride(x),
-	        typename VectorY::value_type(1),
+	        beta,
 	        traits::storage(y),
 	        traits::stride(y)
 	);
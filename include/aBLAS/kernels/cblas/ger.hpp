@@ -0,0 +1,142 @@
+/*!
+ * 
+ *
+ * \brief       cblas binding for the GER routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_CBLAS_GER_HPP
+#define ABLAS_KERNELS_CBLAS_GER_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/ger.hpp"
+#include <algorithm>
+
+namespace aBLAS {namespace bindings {
+
+inline void ger(CBLAS_ORDER const Order, cblas_int const M, cblas_int const N,
+	float alpha,
+	float const* x, cblas_int const incx,
+	float const* y, cblas_int const incy,
+	float* A, cblas_int const lda
+){
+	cblas_sger(Order, M, N, alpha, x, incx, y, incy, A, lda);
+}
+
+inline void ger(CBLAS_ORDER const Order, cblas_int const M, cblas_int const N,
+	double alpha,
+	double const* x, cblas_int const incx,
+	double const* y, cblas_int const incy,
+	double* A, cblas_int const lda
+){
+	cblas_dger(Order, M, N, alpha, x, incx, y, incy, A, lda);
+}
+
+inline void ger(CBLAS_ORDER const Order, cblas_int const M, cblas_int const N,
+	std::complex<float> alpha,
+	std::complex<float> const* x, cblas_int const incx,
+	std::complex<float> const* y, cblas_int const incy,
+	std::complex<float>* A, cblas_int const lda
+){
+	cblas_cgeru(Order, M, N,
+		static_cast<cblas_float_complex_type const* >(&alpha),
+		static_cast<cblas_float_complex_type const* >(x), incx,
+		static_cast<cblas_float_complex_type const* >(y), incy,
+		static_cast<cblas_float_complex_type* >(A), lda
+	);
+}
+
+inline void ger(CBLAS_ORDER const Order, cblas_int const M, cblas_int const N,
+	std::complex<double> alpha,
+	std::complex<double> const* x, cblas_int const incx,
+	std::complex<double> const* y, cblas_int const incy,
+	std::complex<double>* A, cblas_int const lda
+){
+	cblas_zgeru(Order, M, N,
+		static_cast<cblas_double_complex_type const* >(&alpha),
+		static_cast<cblas_double_complex_type const* >(x), incx,
+		static_cast<cblas_double_complex_type const* >(y), incy,
+		static_cast<cblas_double_complex_type* >(A), lda
+	);
+}
+
+// splits updates whose sizes do not fit into cblas_int
+template<class T>
+void ger_split(CBLAS_ORDER const Order, std::size_t M, std::size_t N,
+	T alpha,
+	T const* x, std::ptrdiff_t incx,
+	T const* y, std::ptrdiff_t incy,
+	T* A, std::size_t lda
+){
+	std::size_t const max_size = cblas_max_size();
+	for(std::size_t i = 0; i < M; i += max_size){
+		for(std::size_t j = 0; j < N; j += max_size){
+			ger(Order, (cblas_int)std::min(M - i, max_size), (cblas_int)std::min(N - j, max_size), alpha,
+				x + std::ptrdiff_t(i) * incx, (cblas_int)incx,
+				y + std::ptrdiff_t(j) * incy, (cblas_int)incy,
+				A + cblas_offset(Order, CblasNoTrans, i, j, lda), (cblas_int)lda
+			);
+		}
+	}
+}
+
+// A <- A + alpha * x * y^T
+template <class M, class E1, class E2>
+void ger(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	matrix_expression<M,cpu_tag>& A,
+	typename M::value_type alpha,
+	boost::mpl::true_
+){
+	ABLAS_SIZE_CHECK(x().size() == A().size1());
+	ABLAS_SIZE_CHECK(y().size() == A().size2());
+
+	//strides which do not fit into cblas_int can not be split, the default kernel is used.
+	if(
+		!cblas_fits(traits::leading_dimension(A))
+		|| !cblas_fits(traits::stride(x))
+		|| !cblas_fits(traits::stride(y))
+	){
+		ger(x,y,A,alpha,boost::mpl::false_());
+		return;
+	}
+
+	CBLAS_ORDER const stor_ord= (CBLAS_ORDER)storage_order<typename M::orientation>::value;
+	ger_split(stor_ord, A().size1(), A().size2(), alpha,
+		traits::storage(x), traits::stride(x),
+		traits::storage(y), traits::stride(y),
+		traits::storage(A), traits::leading_dimension(A)
+	);
+}
+
+template<class M, class E1, class E2>
+struct has_optimized_ger: public boost::mpl::and_<
+	cblas_dense_pair<M,E1>,
+	cblas_dense_pair<M,E2>
+>{};
+
+}}
+#endif
@@ -0,0 +1,104 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Contains the cblas bindings for the SYMM routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_CBLAS_SYMM_HPP
+#define ABLAS_KERNELS_CBLAS_SYMM_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/symm.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace aBLAS { namespace bindings {
+
+inline void symm(
+	CBLAS_ORDER const Order, CBLAS_SIDE const Side, CBLAS_UPLO const Uplo,
+	cblas_int M, cblas_int N, float alpha, float const* A, cblas_int lda,
+	float const* B, cblas_int ldb, float beta, float* C, cblas_int ldc
+){
+	cblas_ssymm(Order, Side, Uplo, M, N, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+inline void symm(
+	CBLAS_ORDER const Order, CBLAS_SIDE const Side, CBLAS_UPLO const Uplo,
+	cblas_int M, cblas_int N, double alpha, double const* A, cblas_int lda,
+	double const* B, cblas_int ldb, double beta, double* C, cblas_int ldc
+){
+	cblas_dsymm(Order, Side, Uplo, M, N, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+// C = beta * C + alpha * A * B
+//
+// A is passed in the storage order of C. If its orientation differs, cblas sees its transpose which is the
+// same matrix stored in the other triangle. B must have the orientation of C, otherwise the default kernel is used.
+// The default kernel is also used for empty arguments and sizes or leading dimensions which do not fit into cblas_int.
+template<class MatA, class MatB, class MatC>
+void symm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag> const& B,
+	matrix_expression<MatC,cpu_tag>& C,
+	typename MatC::value_type alpha,
+	typename MatC::value_type beta,
+	boost::mpl::true_
+){
+	typedef typename MatA::triangular_type Triangular;
+	std::size_t n = C().size1();
+	std::size_t m = C().size2();
+	if(
+		n == 0 || m == 0 || n > cblas_max_size() || m > cblas_max_size()
+		|| !traits::same_orientation(B, C)
+		|| !cblas_fits(traits::leading_dimension(A().expression()))
+		|| !cblas_fits(traits::leading_dimension(B))
+		|| !cblas_fits(traits::leading_dimension(C))
+	){
+		symm(A, B, C, alpha, beta, boost::mpl::false_());
+		return;
+	}
+	bool transposed = !traits::same_orientation(A().expression(), C);
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatC::orientation >::value;
+	symm(stor_ord, CblasLeft, cblas_uplo<Triangular>(transposed), (cblas_int)n, (cblas_int)m,
+		alpha, traits::storage(A().expression()), (cblas_int)traits::leading_dimension(A().expression()),
+		traits::storage(B), (cblas_int)traits::leading_dimension(B),
+		beta, traits::storage(C), (cblas_int)traits::leading_dimension(C)
+	);
+}
+
+//packed matrices have no symm routine, they are multiplied column by column by spmv in the default kernel
+template<class MatA, class MatB, class MatC>
+struct has_optimized_symm: public boost::mpl::and_<
+	cblas_dense_pair<MatB,MatC>,
+	boost::is_same<typename MatA::storage_category, dense_tag>,
+	boost::is_same<typename MatA::value_type, typename MatC::value_type>,
+	cblas_real_type<typename MatC::value_type>
+>{};
+
+}}
+#endif
@@ -0,0 +1,142 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Contains the cblas bindings for the SYMV and SPMV routines
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_CBLAS_SYMV_HPP
+#define ABLAS_KERNELS_CBLAS_SYMV_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/symv.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace aBLAS { namespace bindings {
+
+inline void symv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, cblas_int N,
+	float alpha, float const* A, cblas_int lda, float const* X, cblas_int incX,
+	float beta, float* Y, cblas_int incY
+){
+	cblas_ssymv(Order, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+inline void symv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, cblas_int N,
+	double alpha, double const* A, cblas_int lda, double const* X, cblas_int incX,
+	double beta, double* Y, cblas_int incY
+){
+	cblas_dsymv(Order, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+inline void spmv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, cblas_int N,
+	float alpha, float const* Ap, float const* X, cblas_int incX,
+	float beta, float* Y, cblas_int incY
+){
+	cblas_sspmv(Order, Uplo, N, alpha, Ap, X, incX, beta, Y, incY);
+}
+
+inline void spmv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, cblas_int N,
+	double alpha, double const* Ap, double const* X, cblas_int incX,
+	double beta, double* Y, cblas_int incY
+){
+	cblas_dspmv(Order, Uplo, N, alpha, Ap, X, incX, beta, Y, incY);
+}
+
+//symmetric views of dense matrices are passed with their leading dimension
+template<class MatA, class V, class ResultV>
+bool symv_binding(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	if(!cblas_fits(traits::leading_dimension(A().expression())))
+		return false;
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatA::orientation >::value;
+	symv(stor_ord, cblas_uplo<Triangular>(), (cblas_int)A().size1(),
+		alpha, traits::storage(A().expression()), (cblas_int)traits::leading_dimension(A().expression()),
+		traits::storage(x), (cblas_int)traits::stride(x),
+		beta, traits::storage(y), (cblas_int)traits::stride(y)
+	);
+	return true;
+}
+
+template<class MatA, class V, class ResultV>
+bool symv_binding(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	packed_tag
+){
+	typedef typename MatA::orientation::triangular_type Triangular;
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatA::orientation::orientation >::value;
+	spmv(stor_ord, cblas_uplo<Triangular>(), (cblas_int)A().size1(),
+		alpha, traits::storage(A), traits::storage(x), (cblas_int)traits::stride(x),
+		beta, traits::storage(y), (cblas_int)traits::stride(y)
+	);
+	return true;
+}
+
+// y = beta * y + alpha * A * x
+// Empty arguments and sizes or strides which do not fit into cblas_int are passed to the default kernel.
+template<class MatA, class V, class ResultV>
+void symv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	boost::mpl::true_
+){
+	std::size_t n = A().size1();
+	if(n == 0 || n > cblas_max_size() || !cblas_fits(traits::stride(x)) || !cblas_fits(traits::stride(y))
+	|| !symv_binding(A, x, y, alpha, beta, typename MatA::storage_category())){
+		symv(A, x, y, alpha, beta, boost::mpl::false_());
+	}
+}
+
+template<class MatA, class V, class ResultV>
+struct has_optimized_symv: public boost::mpl::and_<
+	boost::is_same<typename V::storage_category, dense_tag>,
+	boost::is_same<typename ResultV::storage_category, dense_tag>,
+	boost::is_same<typename MatA::value_type, typename ResultV::value_type>,
+	boost::is_same<typename V::value_type, typename ResultV::value_type>,
+	cblas_real_type<typename ResultV::value_type>
+>{};
+
+}}
+#endif
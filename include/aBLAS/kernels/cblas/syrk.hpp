@@ -0,0 +1,128 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Contains the cblas bindings for the SYRK routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_CBLAS_SYRK_HPP
+#define ABLAS_KERNELS_CBLAS_SYRK_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/syrk.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline void syrk(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const Trans,
+	cblas_int N, cblas_int K,
+	float alpha, float const* A, cblas_int lda,
+	float beta, float* C, cblas_int ldc
+){
+	cblas_ssyrk(Order, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc);
+}
+
+inline void syrk(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const Trans,
+	cblas_int N, cblas_int K,
+	double alpha, double const* A, cblas_int lda,
+	double beta, double* C, cblas_int ldc
+){
+	cblas_dsyrk(Order, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc);
+}
+
+inline void syrk(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const Trans,
+	cblas_int N, cblas_int K,
+	std::complex<float> alpha, std::complex<float> const* A, cblas_int lda,
+	std::complex<float> beta, std::complex<float>* C, cblas_int ldc
+){
+	cblas_csyrk(Order, Uplo, Trans, N, K,
+		static_cast<cblas_float_complex_type const* >(&alpha),
+		static_cast<cblas_float_complex_type const* >(A), lda,
+		static_cast<cblas_float_complex_type const* >(&beta),
+		static_cast<cblas_float_complex_type* >(C), ldc
+	);
+}
+
+inline void syrk(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const Trans,
+	cblas_int N, cblas_int K,
+	std::complex<double> alpha, std::complex<double> const* A, cblas_int lda,
+	std::complex<double> beta, std::complex<double>* C, cblas_int ldc
+){
+	cblas_zsyrk(Order, Uplo, Trans, N, K,
+		static_cast<cblas_double_complex_type const* >(&alpha),
+		static_cast<cblas_double_complex_type const* >(A), lda,
+		static_cast<cblas_double_complex_type const* >(&beta),
+		static_cast<cblas_double_complex_type* >(C), ldc
+	);
+}
+
+// m = alpha * e * e^T
+//
+// cblas only updates one triangle of m. As m is not required to be symmetric, products with beta != 0 are computed
+// by the default kernel which updates both triangles, its block products still use the gemm binding.
+// Empty arguments are passed to the default kernel as well, as cblas rejects their leading dimensions.
+template <class M, class E>
+void syrk(
+	matrix_expression<E,cpu_tag> const& e,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	boost::mpl::true_
+) {
+	ABLAS_SIZE_CHECK(m().size1() == e().size1());
+	ABLAS_SIZE_CHECK(m().size2() == e().size1());
+	typedef typename M::value_type value_type;
+	
+	std::size_t n = m().size1();
+	std::size_t k = e().size2();
+	if(
+		beta != value_type() || n == 0 || k == 0
+		|| n > cblas_max_size() || k > cblas_max_size()
+		|| !cblas_fits(traits::leading_dimension(e))
+		|| !cblas_fits(traits::leading_dimension(m))
+	){
+		syrk(e, m, alpha, beta, boost::mpl::false_());
+		return;
+	}
+	
+	CBLAS_TRANSPOSE trans = traits::same_orientation(e,m)? CblasNoTrans: CblasTrans;
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename M::orientation >::value;
+	syrk(stor_ord, CblasLower, trans, (cblas_int)n, (cblas_int)k,
+		alpha, traits::storage(e), (cblas_int)traits::leading_dimension(e),
+		value_type(), traits::storage(m), (cblas_int)traits::leading_dimension(m)
+	);
+	mirror_lower_triangle(m);
+}
+
+template<class M, class E>
+struct has_optimized_syrk: public cblas_dense_pair<M,E>{};
+
+}}
+#endif
@@ -0,0 +1,100 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Contains the cblas bindings for the TRMM routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_CBLAS_TRMM_HPP
+#define ABLAS_KERNELS_CBLAS_TRMM_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/trmm.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace aBLAS { namespace bindings {
+
+inline void trmm(
+	CBLAS_ORDER const Order, CBLAS_SIDE const Side, CBLAS_UPLO const Uplo,
+	CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int M, cblas_int N, float alpha, float const* A, cblas_int lda, float* B, cblas_int ldb
+){
+	cblas_strmm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb);
+}
+
+inline void trmm(
+	CBLAS_ORDER const Order, CBLAS_SIDE const Side, CBLAS_UPLO const Uplo,
+	CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int M, cblas_int N, double alpha, double const* A, cblas_int lda, double* B, cblas_int ldb
+){
+	cblas_dtrmm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb);
+}
+
+// B = A * B
+//
+// A is passed in the storage order of B. If its orientation differs, cblas sees the transpose of A,
+// which is stored in the other triangle.
+// Empty arguments and sizes or leading dimensions which do not fit into cblas_int are passed to the default kernel.
+template<class MatA, class MatB>
+void trmm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag>& B,
+	boost::mpl::true_
+){
+	typedef typename MatA::triangular_type Triangular;
+	typedef typename MatB::value_type value_type;
+	std::size_t n = B().size1();
+	std::size_t m = B().size2();
+	if(
+		n == 0 || m == 0 || n > cblas_max_size() || m > cblas_max_size()
+		|| !cblas_fits(traits::leading_dimension(A().expression()))
+		|| !cblas_fits(traits::leading_dimension(B))
+	){
+		trmm(A, B, boost::mpl::false_());
+		return;
+	}
+	bool transposed = !traits::same_orientation(A().expression(), B);
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatB::orientation >::value;
+	trmm(stor_ord, CblasLeft, cblas_uplo<Triangular>(transposed), transposed? CblasTrans: CblasNoTrans,
+		cblas_diag<Triangular>(), (cblas_int)n, (cblas_int)m, value_type(1),
+		traits::storage(A().expression()), (cblas_int)traits::leading_dimension(A().expression()),
+		traits::storage(B), (cblas_int)traits::leading_dimension(B)
+	);
+}
+
+//packed matrices have no trmm routine, they are multiplied column by column by tpmv in the default kernel
+template<class MatA, class MatB>
+struct has_optimized_trmm: public boost::mpl::and_<
+	boost::is_same<typename MatA::storage_category, dense_tag>,
+	boost::is_same<typename MatB::storage_category, dense_tag>,
+	boost::is_same<typename MatA::value_type, typename MatB::value_type>,
+	cblas_real_type<typename MatB::value_type>
+>{};
+
+}}
+#endif
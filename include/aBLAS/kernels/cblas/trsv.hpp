@@ -0,0 +1,126 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Contains the cblas bindings for the TRSV and TPSV routines
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_CBLAS_TRSV_HPP
+#define ABLAS_KERNELS_CBLAS_TRSV_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/trsv.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace aBLAS { namespace bindings {
+
+inline void trsv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int N, float const* A, cblas_int lda, float* X, cblas_int incX
+){
+	cblas_strsv(Order, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+inline void trsv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int N, double const* A, cblas_int lda, double* X, cblas_int incX
+){
+	cblas_dtrsv(Order, Uplo, TransA, Diag, N, A, lda, X, incX);
+}
+
+inline void tpsv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int N, float const* Ap, float* X, cblas_int incX
+){
+	cblas_stpsv(Order, Uplo, TransA, Diag, N, Ap, X, incX);
+}
+
+inline void tpsv(
+	CBLAS_ORDER const Order, CBLAS_UPLO const Uplo, CBLAS_TRANSPOSE const TransA, CBLAS_DIAG const Diag,
+	cblas_int N, double const* Ap, double* X, cblas_int incX
+){
+	cblas_dtpsv(Order, Uplo, TransA, Diag, N, Ap, X, incX);
+}
+
+//triangular views of dense matrices are passed with their leading dimension
+template<class MatA, class V>
+bool trsv_binding(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	if(!cblas_fits(traits::leading_dimension(A().expression())))
+		return false;
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatA::orientation >::value;
+	trsv(stor_ord, cblas_uplo<Triangular>(), CblasNoTrans, cblas_diag<Triangular>(),
+		(cblas_int)A().size1(),
+		traits::storage(A().expression()), (cblas_int)traits::leading_dimension(A().expression()),
+		traits::storage(x), (cblas_int)traits::stride(x)
+	);
+	return true;
+}
+
+template<class MatA, class V>
+bool trsv_binding(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	packed_tag
+){
+	typedef typename MatA::orientation::triangular_type Triangular;
+	CBLAS_ORDER stor_ord = (CBLAS_ORDER) storage_order<typename MatA::orientation::orientation >::value;
+	tpsv(stor_ord, cblas_uplo<Triangular>(), CblasNoTrans, cblas_diag<Triangular>(),
+		(cblas_int)A().size1(), traits::storage(A), traits::storage(x), (cblas_int)traits::stride(x)
+	);
+	return true;
+}
+
+// x = A^-1 * x
+// Empty arguments and sizes or strides which do not fit into cblas_int are passed to the default kernel.
+template<class MatA, class V>
+void trsv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	boost::mpl::true_
+){
+	std::size_t n = A().size1();
+	if(n == 0 || n > cblas_max_size() || !cblas_fits(traits::stride(x))
+	|| !trsv_binding(A, x, typename MatA::storage_category())){
+		trsv(A, x, boost::mpl::false_());
+	}
+}
+
+template<class MatA, class V>
+struct has_optimized_trsv: public boost::mpl::and_<
+	boost::is_same<typename V::storage_category, dense_tag>,
+	boost::is_same<typename MatA::value_type, typename V::value_type>,
+	cblas_real_type<typename V::value_type>
+>{};
+
+}}
+#endif
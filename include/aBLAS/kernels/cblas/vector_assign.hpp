@@ -0,0 +1,182 @@
+/*!
+ * 
+ *
+ * \brief       cblas bindings for vector assignment using the COPY, AXPY and SCAL routines
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_CBLAS_VECTOR_ASSIGN_HPP
+#define ABLAS_KERNELS_CBLAS_VECTOR_ASSIGN_HPP
+
+#include "cblas_inc.hpp"
+#include "../default/vector_assign.hpp"
+#include "../../detail/functional.hpp"
+#include <algorithm>
+
+namespace aBLAS {namespace bindings {
+
+inline void copy(cblas_int const N, float const* x, cblas_int const incx, float* y, cblas_int const incy){
+	cblas_scopy(N, x, incx, y, incy);
+}
+inline void copy(cblas_int const N, double const* x, cblas_int const incx, double* y, cblas_int const incy){
+	cblas_dcopy(N, x, incx, y, incy);
+}
+inline void copy(cblas_int const N, std::complex<float> const* x, cblas_int const incx, std::complex<float>* y, cblas_int const incy){
+	cblas_ccopy(N,
+		static_cast<cblas_float_complex_type const* >(x), incx,
+		static_cast<cblas_float_complex_type* >(y), incy
+	);
+}
+inline void copy(cblas_int const N, std::complex<double> const* x, cblas_int const incx, std::complex<double>* y, cblas_int const incy){
+	cblas_zcopy(N,
+		static_cast<cblas_double_complex_type const* >(x), incx,
+		static_cast<cblas_double_complex_type* >(y), incy
+	);
+}
+
+inline void axpy(cblas_int const N, float alpha, float const* x, cblas_int const incx, float* y, cblas_int const incy){
+	cblas_saxpy(N, alpha, x, incx, y, incy);
+}
+inline void axpy(cblas_int const N, double alpha, double const* x, cblas_int const incx, double* y, cblas_int const incy){
+	cblas_daxpy(N, alpha, x, incx, y, incy);
+}
+inline void axpy(cblas_int const N, std::complex<float> alpha, std::complex<float> const* x, cblas_int const incx, std::complex<float>* y, cblas_int const incy){
+	cblas_caxpy(N,
+		static_cast<cblas_float_complex_type const* >(&alpha),
+		static_cast<cblas_float_complex_type const* >(x), incx,
+		static_cast<cblas_float_complex_type* >(y), incy
+	);
+}
+inline void axpy(cblas_int const N, std::complex<double> alpha, std::complex<double> const* x, cblas_int const incx, std::complex<double>* y, cblas_int const incy){
+	cblas_zaxpy(N,
+		static_cast<cblas_double_complex_type const* >(&alpha),
+		static_cast<cblas_double_complex_type const* >(x), incx,
+		static_cast<cblas_double_complex_type* >(y), incy
+	);
+}
+
+inline void scal(cblas_int const N, float alpha, float* x, cblas_int const incx){
+	cblas_sscal(N, alpha, x, incx);
+}
+inline void scal(cblas_int const N, double alpha, double* x, cblas_int const incx){
+	cblas_dscal(N, alpha, x, incx);
+}
+inline void scal(cblas_int const N, std::complex<float> alpha, std::complex<float>* x, cblas_int const incx){
+	cblas_cscal(N,
+		static_cast<cblas_float_complex_type const* >(&alpha),
+		static_cast<cblas_float_complex_type* >(x), incx
+	);
+}
+inline void scal(cblas_int const N, std::complex<double> alpha, std::complex<double>* x, cblas_int const incx){
+	cblas_zscal(N,
+		static_cast<cblas_double_complex_type const* >(&alpha),
+		static_cast<cblas_double_complex_type* >(x), incx
+	);
+}
+
+// v = alpha * e is computed by copy and scal, v += alpha * e by axpy, for the elements start,...,end-1
+template<template <class, class> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+){
+	typedef typename V::value_type value_type;
+	//strides which do not fit into cblas_int can not be split, the default kernel is used.
+	if(!cblas_fits(traits::stride(v)) || !cblas_fits(traits::stride(e))){
+		vector_assign<F>(v,e,alpha,start,end,boost::mpl::false_());
+		return;
+	}
+	std::size_t size = end - start;
+	std::ptrdiff_t incx = traits::stride(e);
+	std::ptrdiff_t incy = traits::stride(v);
+	value_type const* x = traits::storage(e) + std::ptrdiff_t(start) * incx;
+	value_type* y = traits::storage(v) + std::ptrdiff_t(start) * incy;
+	//longer vectors are split
+	std::size_t const max_size = cblas_max_size();
+	for(std::size_t i = 0; i < size; i += max_size){
+		cblas_int n = (cblas_int)std::min(size - i, max_size);
+		if(boost::is_same<F<value_type,value_type>, scalar_plus_assign<value_type,value_type> >::value){
+			axpy(n, alpha, x + std::ptrdiff_t(i) * incx, (cblas_int)incx, y + std::ptrdiff_t(i) * incy, (cblas_int)incy);
+		}else{
+			copy(n, x + std::ptrdiff_t(i) * incx, (cblas_int)incx, y + std::ptrdiff_t(i) * incy, (cblas_int)incy);
+			if(alpha != value_type(1))
+				scal(n, alpha, y + std::ptrdiff_t(i) * incy, (cblas_int)incy);
+		}
+	}
+}
+
+template<template <class, class> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	boost::mpl::true_
+){
+	vector_assign<F>(v,e,alpha,0,v().size(),boost::mpl::true_());
+}
+
+// v *= t
+template<template <class, class> class F, class V>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	typename V::value_type t,
+	boost::mpl::true_
+){
+	if(!cblas_fits(traits::stride(v))){
+		vector_assign<F>(v,t,boost::mpl::false_());
+		return;
+	}
+	std::size_t const max_size = cblas_max_size();
+	std::size_t size = v().size();
+	std::ptrdiff_t inc = traits::stride(v);
+	for(std::size_t i = 0; i < size; i += max_size){
+		scal((cblas_int)std::min(size - i, max_size), t, traits::storage(v) + std::ptrdiff_t(i) * inc, (cblas_int)inc);
+	}
+}
+
+template<template <class, class> class F>
+struct optimized_vector_assign_functor: public boost::mpl::false_{};
+template<>
+struct optimized_vector_assign_functor<scalar_assign>: public boost::mpl::true_{};
+template<>
+struct optimized_vector_assign_functor<scalar_plus_assign>: public boost::mpl::true_{};
+
+template<template <class, class> class F, class V, class E>
+struct has_optimized_vector_assign: public boost::mpl::and_<
+	optimized_vector_assign_functor<F>,
+	cblas_dense_pair<V,E>
+>{};
+
+template<template <class, class> class F, class V>
+struct has_optimized_vector_scalar_assign: public boost::mpl::and_<
+	boost::is_same<F<int,int>, scalar_multiply_assign<int,int> >,
+	cblas_dense_pair<V,V>
+>{};
+
+}}
+#endif
@@ -0,0 +1,114 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Conversion between the element types of dense storage
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_CONVERT_HPP
+#define ABLAS_KERNELS_DEFAULT_CONVERT_HPP
+
+#include "../../half.hpp"
+#include "../../detail/functional.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <cstddef>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+namespace aBLAS{namespace bindings{
+
+///\brief Converts n strided values of type S to D: dst[i*inc_dst] = D(src[i*inc_src]).
+template<class S, class D>
+void convert(std::size_t n, S const* src, std::ptrdiff_t inc_src, D* dst, std::ptrdiff_t inc_dst){
+	for(std::size_t i = 0; i != n; ++i){
+		dst[std::ptrdiff_t(i) * inc_dst] = static_cast<D>(src[std::ptrdiff_t(i) * inc_src]);
+	}
+}
+
+//half<->float uses the F16C instructions for contiguous storage if available.
+inline void convert(std::size_t n, half const* src, std::ptrdiff_t inc_src, float* dst, std::ptrdiff_t inc_dst){
+	std::size_t i = 0;
+#ifdef __F16C__
+	if(inc_src == 1 && inc_dst == 1){
+		for(; i + 8 <= n; i += 8){
+			__m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+			_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+		}
+	}
+#endif
+	for(; i != n; ++i){
+		dst[std::ptrdiff_t(i) * inc_dst] = src[std::ptrdiff_t(i) * inc_src];
+	}
+}
+inline void convert(std::size_t n, float const* src, std::ptrdiff_t inc_src, half* dst, std::ptrdiff_t inc_dst){
+	std::size_t i = 0;
+#ifdef __F16C__
+	if(inc_src == 1 && inc_dst == 1){
+		for(; i + 8 <= n; i += 8){
+			__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+		}
+	}
+#endif
+	for(; i != n; ++i){
+		dst[std::ptrdiff_t(i) * inc_dst] = src[std::ptrdiff_t(i) * inc_src];
+	}
+}
+
+//bfloat16 is the upper half of a float. The loops work directly on the bits
+//so that the compiler can vectorize them.
+inline void convert(std::size_t n, bfloat16 const* src, std::ptrdiff_t inc_src, float* dst, std::ptrdiff_t inc_dst){
+	for(std::size_t i = 0; i != n; ++i){
+		std::uint32_t bits = std::uint32_t(src[std::ptrdiff_t(i) * inc_src].bits()) << 16;
+		std::memcpy(dst + std::ptrdiff_t(i) * inc_dst, &bits, sizeof(float));
+	}
+}
+inline void convert(std::size_t n, float const* src, std::ptrdiff_t inc_src, bfloat16* dst, std::ptrdiff_t inc_dst){
+	for(std::size_t i = 0; i != n; ++i){
+		dst[std::ptrdiff_t(i) * inc_dst] = bfloat16::from_bits(detail::float_to_bfloat16_bits(src[std::ptrdiff_t(i) * inc_src]));
+	}
+}
+
+///\brief True if v=e for dense v and e converts from or to a 16 bit type and can be computed by convert().
+template<template <class, class> class F, class V, class E>
+struct has_optimized_conversion: public boost::mpl::and_<
+	boost::is_same<F<int,int>,scalar_assign<int,int> >,
+	boost::is_same<typename V::storage_category, dense_tag>,
+	boost::is_same<typename E::storage_category, dense_tag>,
+	boost::mpl::or_<
+		is_low_precision<typename V::value_type>,
+		is_low_precision<typename E::value_type>
+	>
+>{};
+
+}}
+#endif
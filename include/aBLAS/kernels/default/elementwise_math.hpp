@@ -0,0 +1,143 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Vectorized evaluation of exp, log, tanh, sigmoid, erf and pow in elementwise assignments
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_ELEMENTWISE_MATH_HPP
+#define ABLAS_KERNELS_DEFAULT_ELEMENTWISE_MATH_HPP
+
+#include "../../detail/functional.hpp"
+#include "../../detail/math.hpp"
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <cstddef>
+
+namespace aBLAS{
+template<class E, class F>
+class vector_unary;
+template<class E, class F>
+class matrix_unary;
+
+namespace bindings{
+
+template<class T>
+struct is_vectorized_type: public boost::mpl::or_<
+	boost::is_same<T,float>,
+	boost::is_same<T,double>
+>{};
+
+///\brief True if the functor G has a vectorized implementation in detail/math.hpp.
+///
+/// apply<N>(g,values) replaces the N values by g(values).
+template<class G>
+struct vectorized_function: public boost::mpl::false_{};
+
+template<class T>
+struct vectorized_function<scalar_exp<T> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_exp<T> const&, T* values){
+		detail::exp_block<N>(values);
+	}
+};
+template<class T>
+struct vectorized_function<scalar_log<T> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_log<T> const&, T* values){
+		detail::log_block<N>(values);
+	}
+};
+template<class T>
+struct vectorized_function<scalar_tanh<T> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_tanh<T> const&, T* values){
+		detail::tanh_block<N>(values);
+	}
+};
+template<class T>
+struct vectorized_function<scalar_sigmoid<T> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_sigmoid<T> const&, T* values){
+		detail::sigmoid_block<N>(values);
+	}
+};
+template<class T>
+struct vectorized_function<scalar_erf<T> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_erf<T> const&, T* values){
+		detail::erf_block<N>(values);
+	}
+};
+template<class T, class U>
+struct vectorized_function<scalar_pow<T,U> >: public is_vectorized_type<T>{
+	template<std::size_t N>
+	static void apply(scalar_pow<T,U> const& g, T* values){
+		detail::pow_block<N>(values, T(g.exponent()));
+	}
+};
+
+///\brief True if E applies a vectorized functor to the elements of a single argument.
+template<class E>
+struct has_vectorized_function: public boost::mpl::false_{};
+template<class A, class G>
+struct has_vectorized_function<vector_unary<A,G> >
+: public boost::mpl::bool_<vectorized_function<G>::value>{};
+template<class A, class G>
+struct has_vectorized_function<matrix_unary<A,G> >
+: public boost::mpl::bool_<vectorized_function<G>::value>{};
+
+///\brief Computes f(*out,g(*in)) for n consecutive positions.
+///
+/// The arguments are copied in chunks to a buffer, on which g is evaluated by the vectorized implementation.
+/// The last chunk is padded with ones, which is a valid argument for all functions.
+template<class G, class InputIterator, class OutputIterator, class Function>
+void apply_vectorized(
+	G const& g, Function f,
+	InputIterator in, OutputIterator out, std::size_t n
+){
+	typedef typename G::result_type value_type;
+	static const std::size_t chunk_size = 64;
+	value_type values[chunk_size];
+	for(std::size_t start = 0; start < n; start += chunk_size){
+		std::size_t size = std::min<std::size_t>(chunk_size, n - start);
+		for(std::size_t i = 0; i != size; ++i, ++in){
+			values[i] = *in;
+		}
+		std::fill(values + size, values + chunk_size, value_type(1));
+		vectorized_function<G>::template apply<chunk_size>(g, values);
+		for(std::size_t i = 0; i != size; ++i, ++out){
+			f(*out, values[i]);
+		}
+	}
+}
+
+}}
+#endif
@@ -32,12 +32,25 @@
 #define ABLAS_KERNELS_DEFAULT_GEMM_HPP
 
 #include "../gemv.hpp"
+#include "../tuning.hpp"
 #include "../../matrix_proxy.hpp"
 #include "../../vector.hpp"
+#include "mixed_precision.hpp"
+#include "gemm_int8.hpp"
 #include <boost/mpl/bool.hpp>
 
 namespace aBLAS { namespace bindings {
-	
+
+//computes m=beta*m before a product is accumulated into m.
+//beta=0 overwrites the values, so that uninitialized values do not propagate
+template<class M>
+void scale_result(matrix_expression<M,cpu_tag>& m, typename M::value_type beta){
+	typedef typename M::value_type value_type;
+	if(beta == value_type())
+		kernels::assign<scalar_assign>(m, value_type());
+	else if(beta != value_type(1))
+		kernels::assign<scalar_multiply_assign>(m, beta);
+}
 	
 //general case: result and first argument row_major (2.)
 //=> compute as a sequence of matrix-vector products over the rows of the first argument
@@ -47,12 +60,13 @@ void gemm_impl(
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
 	typename M::value_type alpha,
+	typename M::value_type beta,
 	row_major, row_major, Orientation2, 
 	Tag1, Tag2
 ) {
 	for (std::size_t i = 0; i != e1().size1(); ++i) {
 		matrix_row<M> mat_row(m(),i);
-		kernels::gemv(trans(e2),row(e1,i),mat_row,alpha);
+		kernels::gemv(trans(e2),row(e1,i),mat_row,alpha,beta);
 	}
 }
 
@@ -64,9 +78,11 @@ void gemm_impl(
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
 	typename M::value_type alpha,
+	typename M::value_type beta,
 	row_major, column_major, row_major,
 	packed_random_access_iterator_tag, Tag
 ) {
+	scale_result(m,beta);
 	for (std::size_t k = 0; k != e1().size2(); ++k) {
 		matrix_row<E2> e2_row(e2(),k);
 		
@@ -86,14 +102,15 @@ void gemm_impl(
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
 	typename M::value_type alpha,
+	typename M::value_type beta,
 	row_major r, column_major, column_major, 
 	dense_random_access_iterator_tag t, dense_random_access_iterator_tag
 ) {
 	//compute blockwise and write the transposed block.
-	std::size_t blockSize = 24;
+	std::size_t blockSize = std::max<std::size_t>(1,kernels::tuning().gemm_block_size);
 	typedef typename M::value_type value_type;
 	typedef typename matrix_temporary<M>::type BlockStorage;
-	BlockStorage blockStorage(blockSize,blockSize);
+	BlockStorage blockStorage(blockSize,blockSize,uninitialized_tag());
 	
 	typedef typename M::size_type size_type;
 	size_type size1 = m().size1();
@@ -102,20 +119,24 @@ void gemm_impl(
 		for (size_type j = 0; j < size2; j+= blockSize){
 			std::size_t blockSizei = std::min(blockSize,size1-i);
 			std::size_t blockSizej = std::min(blockSize,size2-j);
-			matrix_range<matrix<value_type> > transBlock=subrange(blockStorage,0,blockSizej,0,blockSizei);
-			kernels::assign<scalar_assign>(transBlock,value_type /* zero */());
+			matrix_range<BlockStorage> transBlock=subrange(blockStorage,0,blockSizej,0,blockSizei);
 			//reduce to all row-major case by using
 			//A_ij=B^iC_j <=> A_ij^T = (C_j)^T (B^i)^T  
 			gemm_impl(
 				trans(columns(e2,j,j+blockSizej)),
 				trans(rows(e1,i,i+blockSizei)),
-				transBlock,alpha,
+				transBlock,alpha,value_type /* zero */(),
 				r,r,r,//all row-major
 				t,t //both targets are dense
 			);
 			//write transposed block to the matrix
 			matrix_range<M> m_block = subrange(m,i,i+blockSizei,j,j+blockSizej);
-			kernels::assign<scalar_plus_assign>(m_block,trans(transBlock),value_type(1));
+			if(beta == value_type()){
+				kernels::assign<scalar_assign>(m_block,trans(transBlock),value_type(1));
+			}else{
+				scale_result(m_block,beta);
+				kernels::assign<scalar_plus_assign>(m_block,trans(transBlock),value_type(1));
+			}
 		}
 	}
 }
@@ -128,23 +149,50 @@ void gemm_impl(
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
 	typename M::value_type alpha,
+	typename M::value_type beta,
 	column_major, Orientation1, Orientation2, 
 	Tag1, Tag2
 ){
 	matrix_transpose<M> transposedM(m());
 	typedef typename Orientation1::transposed_orientation transpO1;
 	typedef typename Orientation2::transposed_orientation transpO2;
-	gemm_impl(trans(e2),trans(e1),transposedM,alpha,row_major(),transpO2(),transpO1(), Tag2(),Tag1());
+	gemm_impl(trans(e2),trans(e1),transposedM,alpha,beta,row_major(),transpO2(),transpO1(), Tag2(),Tag1());
 }
 
-//dispatcher
+//products of 8 bit integers
+template<class M, class E1, class E2, class Mixed>
+void gemm_dispatch(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	boost::mpl::true_, Mixed
+) {
+	gemm_int8(e1, e2, m, alpha, beta);
+}
+
+//products with 16 bit storage or higher precision accumulation
 template<class M, class E1, class E2>
-void gemm(
+void gemm_dispatch(
 	matrix_expression<E1,cpu_tag> const& e1,
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
 	typename M::value_type alpha,
-	boost::mpl::false_
+	typename M::value_type beta,
+	boost::mpl::false_, boost::mpl::true_
+) {
+	gemm_mixed(e1, e2, m, alpha, beta);
+}
+
+template<class M, class E1, class E2>
+void gemm_dispatch(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	boost::mpl::false_, boost::mpl::false_
 ) {
 	typedef typename M::orientation ResultOrientation;
 	typedef typename E1::orientation E1Orientation;
@@ -152,12 +200,27 @@ void gemm(
 	typedef typename major_iterator<E1>::type::iterator_category E1Category;
 	typedef typename major_iterator<E2>::type::iterator_category E2Category;
 	
-	gemm_impl(e1, e2, m,alpha,
+	gemm_impl(e1, e2, m,alpha,beta,
 		ResultOrientation(),E1Orientation(),E2Orientation(),
 		E1Category(),E2Category()
 	);
 }
 
+//dispatcher
+template<class M, class E1, class E2>
+void gemm(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	boost::mpl::false_
+) {
+	typedef typename has_int8_gemm<M,E1,E2>::type int8;
+	typedef typename has_mixed_precision_gemm<M,E1,E2>::type mixed;
+	gemm_dispatch(e1, e2, m, alpha, beta, int8(), mixed());
+}
+
 }}
 
 #endif
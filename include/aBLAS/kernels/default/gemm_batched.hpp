@@ -0,0 +1,238 @@
+/*!
+ * 
+ *
+ * \brief       Default implementation for the batched GEMM routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_DEFAULT_GEMM_BATCHED_HPP
+#define ABLAS_KERNELS_DEFAULT_GEMM_BATCHED_HPP
+
+#include "../gemm.hpp"
+#include "../traits.hpp"
+#include "../../detail/alignment.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <vector>
+
+namespace aBLAS { namespace bindings {
+
+//packing buffers of the batched kernel. They are shared by all products of a batch.
+template<class T>
+struct gemm_batched_workspace{
+	std::vector<T, detail::aligned_allocator<T> > packedA;
+	std::vector<T, detail::aligned_allocator<T> > packedB;
+};
+
+//register block of the batched kernel: C(0:R,0:W) += A(0:R,0:k) B(0:k,0:W).
+//A is packed as A[l*R+r], the R x W block of C is accumulated in registers over the whole
+//inner dimension and added to C once.
+template<std::size_t R, std::size_t W, class T>
+void gemm_batched_micro(
+	std::size_t k,
+	T const* A,
+	T const* B, std::ptrdiff_t strideB1,
+	T* C, std::ptrdiff_t strideC1
+){
+	T acc[R][W];
+	for(std::size_t r = 0; r != R; ++r)
+		for(std::size_t j = 0; j != W; ++j)
+			acc[r][j] = T();
+	for(std::size_t l = 0; l != k; ++l){
+		T const* rowB = B + l * strideB1;
+		for(std::size_t r = 0; r != R; ++r){
+			T a = A[l * R + r];
+			for(std::size_t j = 0; j != W; ++j)
+				acc[r][j] += a * rowB[j];
+		}
+	}
+	for(std::size_t r = 0; r != R; ++r)
+		for(std::size_t j = 0; j != W; ++j)
+			C[r * strideC1 + j] += acc[r][j];
+}
+
+//computes a block of R rows of C. Columns are processed in panels of W, the remaining
+//columns one at a time.
+template<std::size_t R, std::size_t W, class T>
+void gemm_batched_rows(
+	std::size_t n, std::size_t k,
+	T const* A,
+	T const* B, std::ptrdiff_t strideB1,
+	T* C, std::ptrdiff_t strideC1
+){
+	std::size_t j = 0;
+	for(; j + W <= n; j += W)
+		gemm_batched_micro<R,W>(k, A, B + j, strideB1, C + j, strideC1);
+	for(; j != n; ++j)
+		gemm_batched_micro<R,1>(k, A, B + j, strideB1, C + j, strideC1);
+}
+
+//packs alpha*A(i:i+R,0:k) as packedA[l*R+r]
+template<std::size_t R, class T>
+void gemm_batched_pack_rows(
+	std::size_t k, T alpha,
+	T const* A, std::ptrdiff_t strideA1, std::ptrdiff_t strideA2,
+	T* packedA
+){
+	for(std::size_t l = 0; l != k; ++l)
+		for(std::size_t r = 0; r != R; ++r)
+			packedA[l * R + r] = alpha * A[r * strideA1 + l * strideA2];
+}
+
+//C=beta*C+alpha*A*B for row-major C with unit column stride and A and B with arbitrary strides.
+//alpha*A is packed in blocks of 4 rows and every 4x8 block of C is computed in registers,
+//so that every loaded element of B is used 4 times. Rows of B are read contiguously,
+//if B is not row-major, it is packed first. Products in a batch are small, thus
+//there is no cache blocking over the inner dimension.
+template<class T>
+void gemm_batched_block(
+	std::size_t m, std::size_t n, std::size_t k,
+	T alpha,
+	T const* A, std::ptrdiff_t strideA1, std::ptrdiff_t strideA2,
+	T const* B, std::ptrdiff_t strideB1, std::ptrdiff_t strideB2,
+	T beta,
+	T* C, std::ptrdiff_t strideC1,
+	gemm_batched_workspace<T>& workspace
+){
+	static std::size_t const block_rows = 4;
+	static std::size_t const block_columns = 8;
+	
+	for(std::size_t i = 0; i != m; ++i){
+		T* rowC = C + i * strideC1;
+		if(beta == T()){
+			for(std::size_t j = 0; j != n; ++j)
+				rowC[j] = T();
+		}else if(beta != T(1)){
+			for(std::size_t j = 0; j != n; ++j)
+				rowC[j] *= beta;
+		}
+	}
+	if(k == 0)
+		return;
+	
+	if(strideB2 != 1){
+		if(workspace.packedB.size() < n * k)
+			workspace.packedB.resize(n * k);
+		for(std::size_t l = 0; l != k; ++l){
+			for(std::size_t j = 0; j != n; ++j){
+				workspace.packedB[l * n + j] = B[l * strideB1 + j * strideB2];
+			}
+		}
+		B = workspace.packedB.data();
+		strideB1 = n;
+	}
+	
+	//the rows starting at i are packed at packedA[i*k]
+	if(workspace.packedA.size() < m * k)
+		workspace.packedA.resize(m * k);
+	T* packedA = workspace.packedA.data();
+	std::size_t i = 0;
+	for(; i + block_rows <= m; i += block_rows)
+		gemm_batched_pack_rows<block_rows>(k, alpha, A + i * strideA1, strideA1, strideA2, packedA + i * k);
+	for(; i != m; ++i)
+		gemm_batched_pack_rows<1>(k, alpha, A + i * strideA1, strideA1, strideA2, packedA + i * k);
+	
+	i = 0;
+	for(; i + block_rows <= m; i += block_rows)
+		gemm_batched_rows<block_rows,block_columns>(n, k, packedA + i * k, B, strideB1, C + i * strideC1, strideC1);
+	for(; i != m; ++i)
+		gemm_batched_rows<1,block_columns>(n, k, packedA + i * k, B, strideB1, C + i * strideC1, strideC1);
+}
+
+//dense arguments of the same value type: compute directly on the storage
+template<class MatA, class MatB, class MatC>
+void gemm_batched_product(
+	MatA const& A, MatB const& B, MatC& C,
+	typename MatC::value_type alpha, typename MatC::value_type beta,
+	gemm_batched_workspace<typename MatC::value_type>& workspace,
+	boost::mpl::true_
+){
+	if(boost::is_same<typename MatC::orientation, row_major>::value){
+		gemm_batched_block(
+			C.size1(), C.size2(), A.size2(), alpha,
+			traits::storage(A), A.stride1(), A.stride2(),
+			traits::storage(B), B.stride1(), B.stride2(),
+			beta, traits::storage(C), C.stride1(), workspace
+		);
+	}else{
+		//column major result: compute C^T = B^T A^T
+		gemm_batched_block(
+			C.size2(), C.size1(), A.size2(), alpha,
+			traits::storage(B), B.stride2(), B.stride1(),
+			traits::storage(A), A.stride2(), A.stride1(),
+			beta, traits::storage(C), C.stride2(), workspace
+		);
+	}
+}
+
+//all other combinations are computed by the default gemm kernel
+template<class MatA, class MatB, class MatC, class Buffer>
+void gemm_batched_product(
+	MatA const& A, MatB const& B, MatC& C,
+	typename MatC::value_type alpha, typename MatC::value_type beta,
+	Buffer&,
+	boost::mpl::false_
+){
+	kernels::gemm(A,B,C,alpha,beta);
+}
+
+template<class StackA, class StackB, class StackC, class T>
+void gemm_batched(
+	StackA const& A,
+	StackB const& B,
+	StackC& C,
+	T alpha, T beta,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_
+){
+	typedef typename boost::decay<decltype(A[0])>::type MatA;
+	typedef typename boost::decay<decltype(B[0])>::type MatB;
+	typedef typename boost::decay<decltype(C[0])>::type MatC;
+	typedef typename MatC::value_type value_type;
+	typedef typename boost::mpl::and_<
+		boost::is_same<typename MatA::storage_category, dense_tag>,
+		boost::is_same<typename MatB::storage_category, dense_tag>,
+		boost::is_same<typename MatC::storage_category, dense_tag>,
+		boost::is_same<typename MatA::value_type, value_type>,
+		boost::is_same<typename MatB::value_type, value_type>
+	>::type is_dense;
+	
+	gemm_batched_workspace<value_type> workspace;
+	for(std::size_t k = start; k != end; ++k){
+		MatA a = A[k];
+		MatB b = B[k];
+		MatC c = C[k];
+		ABLAS_SIZE_CHECK(c.size1() == a.size1());
+		ABLAS_SIZE_CHECK(c.size2() == b.size2());
+		ABLAS_SIZE_CHECK(a.size2() == b.size1());
+		gemm_batched_product(a,b,c,value_type(alpha),value_type(beta),workspace,is_dense());
+	}
+}
+
+}}
+
+#endif
@@ -0,0 +1,206 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Matrix products of 8 bit integers with 32 bit accumulation
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_GEMM_INT8_HPP
+#define ABLAS_KERNELS_DEFAULT_GEMM_INT8_HPP
+
+#include "../traits.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace aBLAS{namespace bindings{
+
+//types of arguments of 8 bit products
+template<class T>
+struct is_int8: public boost::mpl::or_<
+	boost::is_same<T,std::int8_t>, boost::is_same<T,std::uint8_t>
+>{};
+
+///\brief True if the product of dense A and B has 8 bit integer arguments and a result of type int32, float or double.
+///
+/// These products are computed by gemm_int8 with exact accumulation in 32 bit integers.
+template<class M, class E1, class E2>
+struct has_int8_gemm: public boost::mpl::and_<
+	boost::mpl::and_<
+		boost::is_same<typename M::storage_category, dense_tag>,
+		boost::is_same<typename E1::storage_category, dense_tag>,
+		boost::is_same<typename E2::storage_category, dense_tag>
+	>,
+	is_int8<typename E1::value_type>,
+	is_int8<typename E2::value_type>,
+	boost::mpl::or_<
+		boost::is_same<typename M::value_type,std::int32_t>,
+		boost::is_same<typename M::value_type,float>,
+		boost::is_same<typename M::value_type,double>
+	>
+>{};
+
+//acc[j] += sum_p a[2p]*b[p][j][0]+a[2p+1]*b[p][j][1]
+//a holds pairs of consecutive values of the row of A, b pairs of consecutive rows of B interleaved by column.
+//Both are widened to 16 bit, so that each pair is reduced exactly by a single multiply-add of 16 bit integers.
+inline void gemm_int8_row(
+	std::size_t pairs, std::size_t size_n,
+	std::int16_t const* a, std::int16_t const* b, std::int32_t* acc
+){
+	std::size_t j = 0;
+#ifdef __AVX2__
+	for(; j + 32 <= size_n; j += 32){
+		__m256i sum0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + j));
+		__m256i sum1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + j + 8));
+		__m256i sum2 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + j + 16));
+		__m256i sum3 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + j + 24));
+		for(std::size_t p = 0; p != pairs; ++p){
+			std::int32_t pair;
+			std::memcpy(&pair, a + 2 * p, sizeof(pair));
+			__m256i av = _mm256_set1_epi32(pair);
+			__m256i const* bp = reinterpret_cast<__m256i const*>(b + 2 * (p * size_n + j));
+			sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(av, _mm256_loadu_si256(bp)));
+			sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(av, _mm256_loadu_si256(bp + 1)));
+			sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(av, _mm256_loadu_si256(bp + 2)));
+			sum3 = _mm256_add_epi32(sum3, _mm256_madd_epi16(av, _mm256_loadu_si256(bp + 3)));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j), sum0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j + 8), sum1);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j + 16), sum2);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j + 24), sum3);
+	}
+	for(; j + 8 <= size_n; j += 8){
+		__m256i sum = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + j));
+		for(std::size_t p = 0; p != pairs; ++p){
+			std::int32_t pair;
+			std::memcpy(&pair, a + 2 * p, sizeof(pair));
+			__m256i bv = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + 2 * (p * size_n + j)));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_set1_epi32(pair), bv));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j), sum);
+	}
+#endif
+	for(std::size_t p = 0; p != pairs; ++p){
+		std::int32_t a0 = a[2 * p];
+		std::int32_t a1 = a[2 * p + 1];
+		std::int16_t const* bp = b + 2 * p * size_n;
+		for(std::size_t jj = j; jj < size_n; ++jj)
+			acc[jj] += a0 * bp[2 * jj] + a1 * bp[2 * jj + 1];
+	}
+}
+
+///\brief Computes m = beta * m + alpha * e1 * e2 for dense 8 bit integer arguments.
+///
+/// The products are accumulated exactly in 32 bit integers over the whole inner dimension, the result is scaled
+/// by alpha and beta in the type of m. Panels of e2 are packed with pairs of consecutive rows interleaved and rows of e1
+/// are packed into pairs, both widened to 16 bit. With AVX2 each pair is then reduced by a single vpmaddwd.
+/// The 32 bit sums can overflow for inner dimensions larger than 131071 for int8 x int8, 65792 for int8 x uint8
+/// and 33025 for uint8 x uint8 arguments.
+template<class M, class E1, class E2>
+void gemm_int8(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta
+){
+	typedef typename M::value_type value_type;
+	std::size_t const block_m = 64;
+	std::size_t const block_k = 512;
+	std::size_t const block_n = 256;
+	std::size_t size1 = m().size1();
+	std::size_t size2 = m().size2();
+	std::size_t size_k = e1().size2();
+
+	auto A = traits::storage(e1);
+	auto B = traits::storage(e2);
+	auto C = traits::storage(m);
+	std::ptrdiff_t stride1A = e1().stride1(), stride2A = e1().stride2();
+	std::ptrdiff_t stride1B = e2().stride1(), stride2B = e2().stride2();
+	std::ptrdiff_t stride1C = m().stride1(), stride2C = m().stride2();
+
+	std::size_t max_n = std::min(block_n,size2);
+	std::vector<std::int16_t> panel(block_k * max_n);
+	std::vector<std::int16_t> row(block_k + 1);
+	std::vector<std::int32_t> acc(std::min(block_m,size1) * max_n);
+	for(std::size_t j = 0; j < size2; j += block_n){
+		std::size_t size_n = std::min(block_n, size2 - j);
+		for(std::size_t i = 0; i < size1; i += block_m){
+			std::size_t size_m = std::min(block_m, size1 - i);
+			std::fill(acc.begin(), acc.begin() + size_m * size_n, 0);
+			for(std::size_t l = 0; l < size_k; l += block_k){
+				std::size_t size_l = std::min(block_k, size_k - l);
+				std::size_t pairs = (size_l + 1) / 2;
+				for(std::size_t p = 0; p != pairs; ++p){
+					for(std::size_t ll = 0; ll != 2; ++ll){
+						std::size_t k = 2 * p + ll;
+						std::int16_t* dst = panel.data() + 2 * p * size_n + ll;
+						if(k == size_l){//odd number of rows
+							for(std::size_t jj = 0; jj != size_n; ++jj)
+								dst[2 * jj] = 0;
+							continue;
+						}
+						auto src = B + std::ptrdiff_t(l + k) * stride1B + std::ptrdiff_t(j) * stride2B;
+						for(std::size_t jj = 0; jj != size_n; ++jj)
+							dst[2 * jj] = src[std::ptrdiff_t(jj) * stride2B];
+					}
+				}
+				for(std::size_t ii = 0; ii != size_m; ++ii){
+					auto src = A + std::ptrdiff_t(i + ii) * stride1A + std::ptrdiff_t(l) * stride2A;
+					for(std::size_t k = 0; k != size_l; ++k)
+						row[k] = src[std::ptrdiff_t(k) * stride2A];
+					row[size_l] = 0;
+					gemm_int8_row(pairs, size_n, row.data(), panel.data(), acc.data() + ii * size_n);
+				}
+			}
+			//for size_k = 0 only the scaling by beta remains
+			for(std::size_t ii = 0; ii != size_m; ++ii){
+				value_type* c = C + std::ptrdiff_t(i + ii) * stride1C + std::ptrdiff_t(j) * stride2C;
+				std::int32_t const* acc_row = acc.data() + ii * size_n;
+				for(std::size_t jj = 0; jj != size_n; ++jj){
+					value_type& value = c[std::ptrdiff_t(jj) * stride2C];
+					if(beta == value_type())//beta=0 overwrites the values, so that uninitialized values do not propagate
+						value = alpha * value_type(acc_row[jj]);
+					else
+						value = beta * value + alpha * value_type(acc_row[jj]);
+				}
+			}
+		}
+	}
+}
+
+}}
+#endif
@@ -32,27 +32,62 @@
 
 #include "../../matrix_proxy.hpp"
 #include "../dot.hpp"
+#include "mixed_precision.hpp"
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <algorithm>
 
 namespace aBLAS {namespace bindings {
+
+//computes result=beta*result before a product is accumulated into result.
+//beta=0 overwrites the values, so that uninitialized values do not propagate
+template<class ResultV>
+void scale_result(vector_expression<ResultV,cpu_tag>& result, typename ResultV::value_type beta){
+	typedef typename ResultV::value_type value_type;
+	if(beta == value_type())
+		kernels::assign<scalar_assign>(result, value_type());
+	else if(beta != value_type(1))
+		kernels::assign<scalar_multiply_assign>(result, beta);
+}
 	
-//row major can be further reduced to inner_prod()
+//computes result(i) = beta*result(i) + alpha*<row(A,i),x> for the rows i=start,...,end-1 using inner_prod()
 template<class ResultV, class M, class V>
-void gemv_impl(
+void gemv_rows(
 	matrix_expression<M,cpu_tag> const& A,
 	vector_expression<V,cpu_tag> const& x,
 	vector_expression<ResultV,cpu_tag>& result, 
 	typename ResultV::value_type alpha,
-	row_major
+	typename ResultV::value_type beta,
+	std::size_t start, std::size_t end
 ) {
 	typedef typename ResultV::value_type value_type;
-	for(std::size_t i = 0; i != A().size1();++i){
+	for(std::size_t i = start; i != end;++i){
 		value_type value = 0;
 		kernels::dot(row(A,i),x,value);
-		result()(i) += alpha* value;
+		if(beta == value_type())
+			result()(i) = alpha* value;
+		else
+			result()(i) = beta * result()(i) + alpha* value;
 	}
 }
 
+//row major can be further reduced to inner_prod()
+template<class ResultV, class M, class V>
+void gemv_impl(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result, 
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	row_major
+) {
+	gemv_rows(A, x, result, alpha, beta, 0, A().size1());
+}
+
 //column major is implemented by computing a linear combination of matrix-rows 
 template<class ResultV, class M, class V>
 void gemv_impl(
@@ -60,10 +95,12 @@ void gemv_impl(
 	vector_expression<V,cpu_tag> const& x,
 	vector_expression<ResultV,cpu_tag>& result,
 	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
 	column_major
 ) {
 	typedef typename V::const_iterator iterator;
 	typedef typename ResultV::value_type value_type;
+	scale_result(result, beta);
 	iterator end = x().end();
 	for(iterator it = x().begin(); it != end; ++it) {
 		value_type multiplier = alpha * (*it);
@@ -79,23 +116,298 @@ void gemv_impl(
 	vector_expression<V,cpu_tag> const& x,
 	vector_expression<ResultV,cpu_tag>& result,
 	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
 	unknown_orientation
 ) {
-	gemv_impl(A,x,result,alpha,row_major());
+	gemv_impl(A,x,result,alpha,beta,row_major());
 }
 
-// result += alpha * A * x
+///\brief True if the product of A and x is computed by the blocked kernels gemv_row_major and gemv_column_major.
+///
+/// This is the case for dense arguments of the same arithmetic value type. At runtime the kernels further
+/// require unit stride along the rows of row major A or the columns of column major A, unit stride of x
+/// for row major A and unit stride of the result for column major A.
+template<class ResultV, class M, class V>
+struct has_blocked_gemv: public boost::mpl::and_<
+	boost::mpl::and_<
+		boost::is_same<typename ResultV::storage_category, dense_tag>,
+		boost::is_same<typename M::storage_category, dense_tag>,
+		boost::is_same<typename V::storage_category, dense_tag>
+	>,
+	boost::is_same<typename M::value_type, typename ResultV::value_type>,
+	boost::is_same<typename V::value_type, typename ResultV::value_type>,
+	boost::is_arithmetic<typename ResultV::value_type>,
+	boost::mpl::not_<boost::is_same<typename M::orientation, unknown_orientation> >
+>{};
+
+inline void gemv_prefetch(void const* p){
+#ifdef __GNUC__
+	__builtin_prefetch(p);
+#endif
+}
+
+//sums[r] += <A[r*lda+j],x[j]> for r < R and j < n. The products are accumulated in a cache line
+//wide block of partial sums per row, which is computed in vector registers.
+template<std::size_t R, class T>
+void gemv_dot_rows(std::size_t n, T const* A, std::ptrdiff_t lda, T const* x, T* sums){
+	std::size_t const lanes = 64 / sizeof(T) > 0? 64 / sizeof(T): 1;
+	std::size_t const prefetch_distance = 8 * lanes;
+	T acc[R][lanes] = {};
+	std::size_t j = 0;
+	for(; j + lanes <= n; j += lanes){
+		for(std::size_t r = 0; r != R; ++r){
+			gemv_prefetch(A + r * lda + j + prefetch_distance);
+		}
+		for(std::size_t r = 0; r != R; ++r){
+			T const* a = A + r * lda + j;
+			for(std::size_t l = 0; l != lanes; ++l){
+				acc[r][l] += a[l] * x[j + l];
+			}
+		}
+	}
+	for(std::size_t r = 0; r != R; ++r){
+		T sum = T();
+		for(std::size_t l = 0; l != lanes; ++l){
+			sum += acc[r][l];
+		}
+		for(std::size_t jj = j; jj != n; ++jj){
+			sum += A[r * lda + jj] * x[jj];
+		}
+		sums[r] += sum;
+	}
+}
+
+///\brief Computes y[i*incy] = beta * y[i*incy] + alpha * sum_j A[i*lda+j] * x[j] for i < m, j < n.
+///
+/// The rows are processed in panels whose partial sums are kept on the stack. Every block of x, which fits into
+/// the L1 cache, is reduced with four rows of the panel at a time, so x is read from memory once per panel
+/// instead of once per row. beta=0 overwrites y, so that uninitialized values do not propagate.
+template<class T>
+void gemv_row_major(
+	std::size_t m, std::size_t n, T alpha,
+	T const* A, std::ptrdiff_t lda,
+	T const* x,
+	T beta, T* y, std::ptrdiff_t incy
+){
+	std::size_t const panel = 64;
+	std::size_t const block = std::max<std::size_t>(8192 / sizeof(T), 1);
+	T sums[panel];
+	for(std::size_t i = 0; i < m; i += panel){
+		std::size_t rows = std::min(panel, m - i);
+		std::fill(sums, sums + rows, T());
+		for(std::size_t j = 0; j < n; j += block){
+			std::size_t cols = std::min(block, n - j);
+			T const* A_block = A + std::ptrdiff_t(i) * lda + j;
+			std::size_t r = 0;
+			for(; r + 4 <= rows; r += 4){
+				gemv_dot_rows<4>(cols, A_block + std::ptrdiff_t(r) * lda, lda, x + j, sums + r);
+			}
+			for(; r != rows; ++r){
+				gemv_dot_rows<1>(cols, A_block + std::ptrdiff_t(r) * lda, lda, x + j, sums + r);
+			}
+		}
+		for(std::size_t r = 0; r != rows; ++r){
+			T& yi = y[std::ptrdiff_t(i + r) * incy];
+			if(beta == T())
+				yi = alpha * sums[r];
+			else
+				yi = beta * yi + alpha * sums[r];
+		}
+	}
+}
+
+///\brief Computes y[i] = beta * y[i] + alpha * sum_j A[i+j*lda] * x[j*incx] for i < m, j < n.
+///
+/// The result is processed in blocks which fit into the L1 cache. Four columns of A are added to a block
+/// in each pass, so the block is read and written once per four columns instead of once per column.
+/// beta=0 overwrites y, so that uninitialized values do not propagate.
+template<class T>
+void gemv_column_major(
+	std::size_t m, std::size_t n, T alpha,
+	T const* A, std::ptrdiff_t lda,
+	T const* x, std::ptrdiff_t incx,
+	T beta, T* y
+){
+	std::size_t const block = std::max<std::size_t>(8192 / sizeof(T), 1);
+	for(std::size_t i = 0; i < m; i += block){
+		std::size_t rows = std::min(block, m - i);
+		T* y_block = y + i;
+		if(beta == T())
+			std::fill(y_block, y_block + rows, T());
+		else if(beta != T(1))
+			for(std::size_t ii = 0; ii != rows; ++ii)
+				y_block[ii] *= beta;
+		std::size_t j = 0;
+		for(; j + 4 <= n; j += 4){
+			T const* a0 = A + std::ptrdiff_t(j) * lda + i;
+			T const* a1 = a0 + lda;
+			T const* a2 = a1 + lda;
+			T const* a3 = a2 + lda;
+			T x0 = alpha * x[std::ptrdiff_t(j) * incx];
+			T x1 = alpha * x[std::ptrdiff_t(j + 1) * incx];
+			T x2 = alpha * x[std::ptrdiff_t(j + 2) * incx];
+			T x3 = alpha * x[std::ptrdiff_t(j + 3) * incx];
+			for(std::size_t ii = 0; ii != rows; ++ii){
+				y_block[ii] += x0 * a0[ii] + x1 * a1[ii] + x2 * a2[ii] + x3 * a3[ii];
+			}
+		}
+		for(; j != n; ++j){
+			T const* a = A + std::ptrdiff_t(j) * lda + i;
+			T xj = alpha * x[std::ptrdiff_t(j) * incx];
+			for(std::size_t ii = 0; ii != rows; ++ii){
+				y_block[ii] += xj * a[ii];
+			}
+		}
+	}
+}
+
+///\brief Computes y[i] = beta * y[i] + alpha * sum_j A[i*stride1+j*stride2] * x[j*incx] for i < m, j < n.
+///
+/// Used by kernels which apply gemv to blocks of a larger matrix given by their pointers.
+/// beta=0 overwrites y, so that uninitialized values do not propagate.
+template<class TA, class TX, class T>
+void gemv_strided(
+	std::size_t m, std::size_t n, T alpha,
+	TA const* A, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	TX const* x, std::ptrdiff_t incx,
+	T beta, T* y, std::ptrdiff_t incy
+){
+	for(std::size_t i = 0; i != m; ++i){
+		T sum = T();
+		TA const* row = A + std::ptrdiff_t(i) * stride1;
+		for(std::size_t j = 0; j != n; ++j){
+			sum += row[std::ptrdiff_t(j) * stride2] * x[std::ptrdiff_t(j) * incx];
+		}
+		T& yi = y[std::ptrdiff_t(i) * incy];
+		if(beta == T())
+			yi = alpha * sum;
+		else
+			yi = beta * yi + alpha * sum;
+	}
+}
+
+//arguments of the same arithmetic type use the blocked kernels if the strides allow it
+template<class T>
+typename boost::enable_if<boost::is_arithmetic<T> >::type gemv_strided(
+	std::size_t m, std::size_t n, T alpha,
+	T const* A, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	T const* x, std::ptrdiff_t incx,
+	T beta, T* y, std::ptrdiff_t incy
+){
+	if((stride2 == 1 || n <= 1) && incx == 1)
+		gemv_row_major(m, n, alpha, A, stride1, x, beta, y, incy);
+	else if((stride1 == 1 || m <= 1) && incy == 1)
+		gemv_column_major(m, n, alpha, A, stride2, x, incx, beta, y);
+	else
+		gemv_strided<T, T, T>(m, n, alpha, A, stride1, stride2, x, incx, beta, y, incy);
+}
+
+//rows start,...,end-1 of result = beta * result + alpha * A * x computed by the blocked kernels.
+//Returns false if the strides of the arguments do not allow it.
+template<class ResultV, class M, class V>
+bool gemv_blocked(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+) {
+	std::size_t n = A().size2();
+	std::ptrdiff_t stride1 = traits::stride1(A);
+	std::ptrdiff_t stride2 = traits::stride2(A);
+	if(boost::is_same<typename M::orientation, row_major>::value){
+		if((stride2 != 1 && n > 1) || traits::stride(x) != 1)
+			return false;
+		gemv_row_major(
+			end - start, n, alpha,
+			traits::storage(A) + std::ptrdiff_t(start) * stride1, stride1,
+			traits::storage(x),
+			beta, traits::storage(result) + std::ptrdiff_t(start) * traits::stride(result), traits::stride(result)
+		);
+	}else{
+		if(stride1 != 1 || traits::stride(result) != 1)
+			return false;
+		gemv_column_major(
+			end - start, n, alpha,
+			traits::storage(A) + start, stride2,
+			traits::storage(x), traits::stride(x),
+			beta, traits::storage(result) + start
+		);
+	}
+	return true;
+}
+template<class ResultV, class M, class V>
+bool gemv_blocked(
+	matrix_expression<M,cpu_tag> const&,
+	vector_expression<V,cpu_tag> const&,
+	vector_expression<ResultV,cpu_tag>&,
+	typename ResultV::value_type,
+	typename ResultV::value_type,
+	std::size_t, std::size_t,
+	boost::mpl::false_
+) {
+	return false;
+}
+
+template<class ResultV, class M, class V>
+void gemv_dispatch(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	boost::mpl::true_
+) {
+	gemv_mixed(A, x, result, alpha, beta);
+}
+
+template<class ResultV, class M, class V>
+void gemv_dispatch(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	boost::mpl::false_
+) {
+	typedef typename M::orientation orientation;
+	typedef typename has_blocked_gemv<ResultV,M,V>::type blocked;
+	if(gemv_blocked(A, x, result, alpha, beta, 0, A().size1(), blocked()))
+		return;
+	gemv_impl(A, x, result, alpha, beta, orientation());
+}
+
+// result = beta * result + alpha * A * x
+// products with 16 bit storage or higher precision accumulation are computed by gemv_mixed
 template<class ResultV, class M, class V>
 void gemv(
 	matrix_expression<M,cpu_tag> const& A,
         vector_expression<V,cpu_tag> const& x,
         vector_expression<ResultV,cpu_tag>& result, 
 	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
 	boost::mpl::false_
 ) {
-	typedef typename M::orientation orientation;
+	typedef typename has_mixed_precision_gemv<ResultV,M,V>::type mixed;
+	gemv_dispatch(A, x, result, alpha, beta, mixed());
+}
 
-	gemv_impl(A, x, result, alpha, orientation());
+// rows start,...,end-1 of result = beta * result + alpha * A * x
+template<class ResultV, class M, class V>
+void gemv(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result, 
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	std::size_t start, std::size_t end
+) {
+	typedef typename has_blocked_gemv<ResultV,M,V>::type blocked;
+	if(gemv_blocked(A, x, result, alpha, beta, start, end, blocked()))
+		return;
+	gemv_rows(A, x, result, alpha, beta, start, end);
 }
 
 }}
@@ -0,0 +1,190 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default QR decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_GEQRF_HPP
+#define ABLAS_KERNELS_DEFAULT_GEQRF_HPP
+
+#include "../trmm.hpp"
+#include "../gemm.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include "../../matrix.hpp"
+#include "../../vector.hpp"
+#include "../../matrix_proxy.hpp"
+#include "../../triangular_matrix.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace aBLAS { namespace bindings {
+
+//unblocked QR decomposition of the m x n block a by Householder reflections H_j = I - tau_j v_j v_j^T.
+//v_j is stored below the diagonal of column j with the implicit first element 1, R on and above the diagonal.
+//Every reflection is applied to the remaining columns right away.
+template<class T>
+void geqrf_block(std::size_t m, std::size_t n, T* a, std::ptrdiff_t stride1, std::ptrdiff_t stride2, T* tau){
+	for(std::size_t j = 0; j != std::min(m, n); ++j){
+		T* column_j = a + std::ptrdiff_t(j) * stride2;
+		T alpha = column_j[std::ptrdiff_t(j) * stride1];
+		T norm = 0;
+		for(std::size_t i = j + 1; i != m; ++i){
+			T x = column_j[std::ptrdiff_t(i) * stride1];
+			norm += x * x;
+		}
+		if(norm == T(0)){
+			tau[j] = T(0);
+			continue;
+		}
+		T beta = std::sqrt(alpha * alpha + norm);
+		if(alpha > T(0))
+			beta = -beta;
+		tau[j] = (beta - alpha) / beta;
+		T scaling = T(1) / (alpha - beta);
+		for(std::size_t i = j + 1; i != m; ++i){
+			column_j[std::ptrdiff_t(i) * stride1] *= scaling;
+		}
+		column_j[std::ptrdiff_t(j) * stride1] = beta;
+		for(std::size_t k = j + 1; k != n; ++k){
+			T* column_k = a + std::ptrdiff_t(k) * stride2;
+			T w = column_k[std::ptrdiff_t(j) * stride1];
+			for(std::size_t i = j + 1; i != m; ++i){
+				w += column_j[std::ptrdiff_t(i) * stride1] * column_k[std::ptrdiff_t(i) * stride1];
+			}
+			w *= tau[j];
+			column_k[std::ptrdiff_t(j) * stride1] -= w;
+			for(std::size_t i = j + 1; i != m; ++i){
+				column_k[std::ptrdiff_t(i) * stride1] -= w * column_j[std::ptrdiff_t(i) * stride1];
+			}
+		}
+	}
+}
+
+// H_1 H_2 ... H_k = I - V T V^T
+//column i of T is -tau_i T V^T v_i, computed from the columns left of it.
+template<class MatV, class VecTau, class MatT>
+void larft(
+	matrix_expression<MatV,cpu_tag> const& V,
+	vector_expression<VecTau,cpu_tag> const& tau,
+	matrix_expression<MatT,cpu_tag>& T,
+	boost::mpl::false_
+){
+	typedef typename MatT::value_type value_type;
+	std::size_t m = V().size1();
+	std::size_t k = V().size2();
+	for(std::size_t i = 0; i != k; ++i){
+		value_type tau_i = tau()(i);
+		for(std::size_t j = 0; j != i; ++j){
+			value_type x = V()(i, j);
+			for(std::size_t r = i + 1; r != m; ++r){
+				x += V()(r, j) * V()(r, i);
+			}
+			T()(j, i) = -tau_i * x;
+			T()(i, j) = value_type();
+		}
+		for(std::size_t j = 0; j != i; ++j){
+			value_type x = T()(j, j) * T()(j, i);
+			for(std::size_t l = j + 1; l != i; ++l){
+				x += T()(j, l) * T()(l, i);
+			}
+			T()(j, i) = x;
+		}
+		T()(i, i) = tau_i;
+	}
+}
+
+// C = (I - V T V^T)^T C
+//W = V^T C is computed in a temporary. The first k rows V_1 of V are unit lower triangular
+//and multiplied by trmm, the rows below by gemm.
+template<class MatV, class MatT, class MatC>
+void larfb(
+	matrix_expression<MatV,cpu_tag> const& V,
+	matrix_expression<MatT,cpu_tag> const& T,
+	matrix_expression<MatC,cpu_tag>& C,
+	boost::mpl::false_
+){
+	typedef typename MatC::value_type value_type;
+	typedef typename matrix_temporary<MatC>::type Workspace;
+	std::size_t m = V().size1();
+	std::size_t k = V().size2();
+	std::size_t n = C().size2();
+	if(k == 0 || n == 0)
+		return;
+	Workspace W(k, n, uninitialized_tag());
+	matrix_range<MatC> C1 = rows(C, 0, k);
+	kernels::assign<scalar_assign>(W, C1, value_type(1));
+	kernels::trmm(triangular<unit_upper>(trans(rows(V, 0, k))), W);
+	if(m > k)
+		kernels::gemm(trans(rows(V, k, m)), rows(C, k, m), W, value_type(1), value_type(1));
+	kernels::trmm(triangular<lower>(trans(T)), W);
+	if(m > k){
+		matrix_range<MatC> C2 = rows(C, k, m);
+		kernels::gemm(rows(V, k, m), W, C2, value_type(-1), value_type(1));
+	}
+	kernels::trmm(triangular<unit_lower>(rows(V, 0, k)), W);
+	kernels::assign<scalar_minus_assign>(C1, W, value_type(1));
+}
+
+//blocked decomposition. Every column block is decomposed by geqrf_block and its reflections are applied
+//to the columns right of it by larfb.
+template<class MatA, class VecTau>
+void geqrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecTau,cpu_tag>& tau,
+	boost::mpl::false_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t m = A().size1();
+	std::size_t n = A().size2();
+	std::size_t size = std::min(m, n);
+	std::size_t block = std::min(size, std::max<std::size_t>(1, kernels::tuning().triangular_block_size));
+	value_type* a = traits::storage(A);
+	std::ptrdiff_t stride1 = traits::stride1(A);
+	std::ptrdiff_t stride2 = traits::stride2(A);
+	matrix<value_type> T(block, block, uninitialized_tag());
+	for(std::size_t start = 0; start < size; start += block){
+		std::size_t end = std::min(size, start + block);
+		vector<value_type> tau_block(end - start, uninitialized_tag());
+		geqrf_block(m - start, end - start, a + std::ptrdiff_t(start) * (stride1 + stride2), stride1, stride2, traits::storage(tau_block));
+		for(std::size_t i = start; i != end; ++i){
+			tau()(i) = tau_block(i - start);
+		}
+		if(end == n)
+			continue;
+		matrix_range<matrix<value_type> > T_block = subrange(T, 0, end - start, 0, end - start);
+		matrix_range<MatA> trailing = subrange(A, start, m, end, n);
+		larft(subrange(A, start, m, start, end), tau_block, T_block, boost::mpl::false_());
+		larfb(subrange(A, start, m, start, end), T_block, trailing, boost::mpl::false_());
+	}
+}
+
+}}
+
+#endif
@@ -0,0 +1,97 @@
+/*!
+ * 
+ *
+ * \brief       Default implementation of the GER routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_DEFAULT_GER_HPP
+#define ABLAS_KERNELS_DEFAULT_GER_HPP
+
+#include "../../matrix_proxy.hpp"
+#include <boost/mpl/bool.hpp>
+
+namespace aBLAS {namespace bindings {
+
+//row major adds a multiple of y to every row
+template<class M, class E1, class E2>
+void ger_impl(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	row_major
+) {
+	typedef typename E1::const_iterator iterator;
+	iterator end = x().end();
+	for(iterator it = x().begin(); it != end; ++it) {
+		matrix_row<M> row_i(m(), it.index());
+		kernels::assign<scalar_plus_assign>(row_i, y, alpha * (*it));
+	}
+}
+
+//column major adds a multiple of x to every column
+template<class M, class E1, class E2>
+void ger_impl(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	column_major
+) {
+	typedef typename E2::const_iterator iterator;
+	iterator end = y().end();
+	for(iterator it = y().begin(); it != end; ++it) {
+		matrix_column<M> column_j(m(), it.index());
+		kernels::assign<scalar_plus_assign>(column_j, x, alpha * (*it));
+	}
+}
+
+//unknown orientation is dispatched to row_major
+template<class M, class E1, class E2>
+void ger_impl(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	unknown_orientation
+) {
+	ger_impl(x,y,m,alpha,row_major());
+}
+
+// m = m + alpha * x * y^T
+template<class M, class E1, class E2>
+void ger(
+	vector_expression<E1,cpu_tag> const& x,
+	vector_expression<E2,cpu_tag> const& y,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	boost::mpl::false_
+) {
+	ger_impl(x, y, m, alpha, typename M::orientation());
+}
+
+}}
+#endif
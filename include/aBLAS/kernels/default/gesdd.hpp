@@ -0,0 +1,199 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default singular value decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_GESDD_HPP
+#define ABLAS_KERNELS_DEFAULT_GESDD_HPP
+
+#include "syevd.hpp"
+#include "../traits.hpp"
+#include "../../matrix_proxy.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace aBLAS { namespace bindings {
+
+//one sided Jacobi method for m >= n. The columns w_p and w_q of a copy W of A are made orthogonal by a rotation
+//for every pair p<q in turn, which is the rotation of the two sided method applied to W^TW. The rotations are
+//accumulated in V, so that W=AV has orthogonal columns. The singular values are the norms of the columns of W
+//and the columns of U are the normalized columns of W. Columns of U of singular values which are zero
+//in working precision are completed to an orthonormal basis by orthogonalizing unit vectors against the others.
+//returns 0 on convergence and 1 if the maximum number of sweeps was not enough.
+template<class MatA, class VecS, class MatU, class MatV>
+std::size_t gesdd_impl(MatA const& A, VecS& s, MatU& U, MatV& VT){
+	typedef typename MatU::value_type value_type;
+	std::size_t m = A.size1();
+	std::size_t n = A.size2();
+	//W and V are stored column major
+	std::vector<value_type> W(m * n);
+	std::vector<value_type> V(n * n, value_type());
+	for(std::size_t j = 0; j != n; ++j){
+		for(std::size_t i = 0; i != m; ++i){
+			W[j * m + i] = A(i, j);
+		}
+		V[j * n + j] = value_type(1);
+	}
+	
+	std::size_t const max_sweeps = 64;
+	bool converged = false;
+	for(std::size_t sweep = 0; sweep != max_sweeps && !converged; ++sweep){
+		converged = true;
+		for(std::size_t p = 0; p != n; ++p){
+			for(std::size_t q = p + 1; q != n; ++q){
+				value_type alpha = value_type();
+				value_type beta = value_type();
+				value_type gamma = value_type();
+				for(std::size_t i = 0; i != m; ++i){
+					value_type x = W[p * m + i];
+					value_type y = W[q * m + i];
+					alpha += x * x;
+					beta += y * y;
+					gamma += x * y;
+				}
+				if(jacobi_negligible(gamma, alpha, beta))
+					continue;
+				converged = false;
+				value_type t = jacobi_tangent((beta - alpha) / (2 * gamma));
+				value_type c = 1 / std::sqrt(t * t + 1);
+				value_type s = t * c;
+				jacobi_rotate(m, W.data(), 1, std::ptrdiff_t(m), p, q, c, s);
+				jacobi_rotate(n, V.data(), 1, std::ptrdiff_t(n), p, q, c, s);
+			}
+		}
+	}
+	
+	//sort the singular values in descending order
+	std::vector<value_type> sigma(n);
+	for(std::size_t j = 0; j != n; ++j){
+		value_type norm = value_type();
+		for(std::size_t i = 0; i != m; ++i){
+			norm += W[j * m + i] * W[j * m + i];
+		}
+		sigma[j] = std::sqrt(norm);
+	}
+	for(std::size_t j = 0; j != n; ++j){
+		std::size_t k = j;
+		for(std::size_t l = j + 1; l != n; ++l){
+			if(sigma[l] > sigma[k])
+				k = l;
+		}
+		if(k == j)
+			continue;
+		std::swap(sigma[j], sigma[k]);
+		std::swap_ranges(W.begin() + j * m, W.begin() + (j + 1) * m, W.begin() + k * m);
+		std::swap_ranges(V.begin() + j * n, V.begin() + (j + 1) * n, V.begin() + k * n);
+	}
+	
+	value_type threshold = (n == 0)? value_type(): sigma[0] * std::numeric_limits<value_type>::epsilon() * m;
+	std::size_t rank = 0;
+	while(rank != n && sigma[rank] > threshold && sigma[rank] >= std::numeric_limits<value_type>::min())
+		++rank;
+	for(std::size_t j = 0; j != rank; ++j){
+		for(std::size_t i = 0; i != m; ++i){
+			W[j * m + i] /= sigma[j];
+		}
+	}
+	//Gram-Schmidt orthogonalization of a unit vector e_u against the columns computed so far, twice which is enough in
+	//working precision. The unit vector with the largest part outside of their span, 1-sum_l W_ul^2, is chosen.
+	for(std::size_t j = rank; j != n; ++j){
+		std::size_t unit = 0;
+		value_type max_norm = value_type(-1);
+		for(std::size_t i = 0; i != m; ++i){
+			value_type norm = value_type(1);
+			for(std::size_t l = 0; l != j; ++l){
+				norm -= W[l * m + i] * W[l * m + i];
+			}
+			if(norm > max_norm){
+				max_norm = norm;
+				unit = i;
+			}
+		}
+		value_type* w = W.data() + j * m;
+		std::fill(w, w + m, value_type());
+		w[unit] = value_type(1);
+		for(std::size_t pass = 0; pass != 2; ++pass){
+			for(std::size_t l = 0; l != j; ++l){
+				value_type const* u = W.data() + l * m;
+				value_type x = value_type();
+				for(std::size_t i = 0; i != m; ++i){
+					x += u[i] * w[i];
+				}
+				for(std::size_t i = 0; i != m; ++i){
+					w[i] -= x * u[i];
+				}
+			}
+		}
+		value_type norm = value_type();
+		for(std::size_t i = 0; i != m; ++i){
+			norm += w[i] * w[i];
+		}
+		norm = std::sqrt(norm);
+		for(std::size_t i = 0; i != m; ++i){
+			w[i] /= norm;
+		}
+	}
+	
+	for(std::size_t j = 0; j != n; ++j){
+		s(j) = sigma[j];
+		for(std::size_t i = 0; i != m; ++i){
+			U(i, j) = W[j * m + i];
+		}
+		for(std::size_t i = 0; i != n; ++i){
+			VT(j, i) = V[j * n + i];
+		}
+	}
+	return converged? 0: 1;
+}
+
+// A = U diag(s) VT
+//
+// For m < n the decomposition of A^T = V diag(s) U^T is computed, which has at least as many rows as columns.
+template<class MatA, class VecS, class MatU, class MatV>
+std::size_t gesdd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecS,cpu_tag>& s,
+	matrix_expression<MatU,cpu_tag>& U,
+	matrix_expression<MatV,cpu_tag>& VT,
+	boost::mpl::false_
+){
+	if(A().size1() >= A().size2())
+		return gesdd_impl(A(), s(), U(), VT());
+	matrix_transpose<MatA> A_trans(A());
+	matrix_transpose<MatU> U_trans(U());
+	matrix_transpose<MatV> VT_trans(VT());
+	return gesdd_impl(A_trans, s(), VT_trans, U_trans);
+}
+
+}}
+
+#endif
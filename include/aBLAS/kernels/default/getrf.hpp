@@ -0,0 +1,167 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default LU decomposition kernel with partial pivoting
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_GETRF_HPP
+#define ABLAS_KERNELS_DEFAULT_GETRF_HPP
+
+#include "../trsm.hpp"
+#include "../gemm.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include "../../matrix_proxy.hpp"
+#include "../../triangular_matrix.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace aBLAS { namespace bindings {
+
+//swaps the rows i and pivots[i-start] of the m x n block a for i=start,...,end-1
+template<class T>
+void laswp_block(
+	std::size_t n, T* a, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	std::size_t const* pivots, std::size_t start, std::size_t end
+){
+	for(std::size_t i = start; i != end; ++i){
+		std::size_t p = pivots[i - start];
+		if(p == i)
+			continue;
+		T* row_i = a + std::ptrdiff_t(i) * stride1;
+		T* row_p = a + std::ptrdiff_t(p) * stride1;
+		for(std::size_t j = 0; j != n; ++j){
+			std::swap(row_i[std::ptrdiff_t(j) * stride2], row_p[std::ptrdiff_t(j) * stride2]);
+		}
+	}
+}
+
+//unblocked LU decomposition of the m x n block a, column by column with a rank-1 update of the remaining columns.
+//pivots[j] is the row swapped with row j. A zero pivot does not stop the decomposition.
+//returns 0 if all pivots are nonzero, otherwise j+1 for the first zero pivot j.
+template<class T>
+std::size_t getrf_block(
+	std::size_t m, std::size_t n, T* a, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	std::size_t* pivots
+){
+	std::size_t info = 0;
+	for(std::size_t j = 0; j != std::min(m, n); ++j){
+		std::size_t p = j;
+		T max_value = std::abs(a[std::ptrdiff_t(j) * (stride1 + stride2)]);
+		for(std::size_t i = j + 1; i != m; ++i){
+			T value = std::abs(a[std::ptrdiff_t(i) * stride1 + std::ptrdiff_t(j) * stride2]);
+			if(value > max_value){
+				max_value = value;
+				p = i;
+			}
+		}
+		pivots[j] = p;
+		laswp_block(n, a, stride1, stride2, pivots + j, j, j + 1);
+		T pivot = a[std::ptrdiff_t(j) * (stride1 + stride2)];
+		if(pivot == T(0)){
+			if(!info)
+				info = j + 1;
+			continue;
+		}
+		T const* row_j = a + std::ptrdiff_t(j) * stride1;
+		for(std::size_t i = j + 1; i != m; ++i){
+			T* row_i = a + std::ptrdiff_t(i) * stride1;
+			T l = row_i[std::ptrdiff_t(j) * stride2] /= pivot;
+			for(std::size_t k = j + 1; k != n; ++k){
+				row_i[std::ptrdiff_t(k) * stride2] -= l * row_j[std::ptrdiff_t(k) * stride2];
+			}
+		}
+	}
+	return info;
+}
+
+//blocked right looking decomposition. Every column block is decomposed by getrf_block, the row swaps are applied
+//to the columns left and right of it, the row block right of the diagonal is solved by trsm
+//and the remaining matrix is updated by gemm.
+template<class MatA, class VecP>
+std::size_t getrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecP,cpu_tag>& P,
+	boost::mpl::false_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t m = A().size1();
+	std::size_t n = A().size2();
+	std::size_t size = std::min(m, n);
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	value_type* a = traits::storage(A);
+	std::ptrdiff_t stride1 = traits::stride1(A);
+	std::ptrdiff_t stride2 = traits::stride2(A);
+	std::vector<std::size_t> pivots(size);
+	std::size_t info = 0;
+	for(std::size_t start = 0; start < size; start += block){
+		std::size_t end = std::min(size, start + block);
+		value_type* diagonal = a + std::ptrdiff_t(start) * (stride1 + stride2);
+		std::size_t block_info = getrf_block(m - start, end - start, diagonal, stride1, stride2, &pivots[start]);
+		if(block_info && !info)
+			info = start + block_info;
+		for(std::size_t i = start; i != end; ++i){
+			pivots[i] += start;
+		}
+		laswp_block(start, a, stride1, stride2, &pivots[start], start, end);
+		if(end == n)
+			continue;
+		laswp_block(n - end, a + std::ptrdiff_t(end) * stride2, stride1, stride2, &pivots[start], start, end);
+		matrix_range<MatA> row_block = subrange(A, start, end, end, n);
+		kernels::trsm(triangular<unit_lower>(subrange(A, start, end, start, end)), row_block);
+		if(end == m)
+			continue;
+		matrix_range<MatA> trailing = subrange(A, end, m, end, n);
+		kernels::gemm(subrange(A, end, m, start, end), row_block, trailing, value_type(-1), value_type(1));
+	}
+	for(std::size_t i = 0; i != size; ++i){
+		P()(i) = pivots[i];
+	}
+	return info;
+}
+
+//swaps row i with row P(i) for i=start,...,end-1
+template<class VecP, class MatA>
+void laswp(
+	vector_expression<VecP,cpu_tag> const& P,
+	matrix_expression<MatA,cpu_tag>& A,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_
+){
+	std::vector<std::size_t> pivots(end - start);
+	for(std::size_t i = start; i != end; ++i){
+		pivots[i - start] = P()(i);
+	}
+	laswp_block(A().size2(), traits::storage(A), traits::stride1(A), traits::stride2(A), pivots.data(), start, end);
+}
+
+}}
+
+#endif
@@ -0,0 +1,231 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Matrix products of low precision storage with accumulation in higher precision
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_MIXED_PRECISION_HPP
+#define ABLAS_KERNELS_DEFAULT_MIXED_PRECISION_HPP
+
+#include "convert.hpp"
+#include "../traits.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace aBLAS{namespace bindings{
+
+///\brief Type in which products with results of type T are accumulated: float for 16 bit types, T otherwise.
+template<class T>
+struct mixed_accumulator: public boost::mpl::if_<is_low_precision<T>,float,T>{};
+
+//types of arguments of mixed precision products
+template<class T>
+struct is_mixed_argument: public boost::mpl::or_<
+	is_low_precision<T>, boost::is_same<T,float>
+>{};
+//types of results of mixed precision products
+template<class T>
+struct is_mixed_result: public boost::mpl::or_<
+	is_mixed_argument<T>, boost::is_same<T,double>
+>{};
+
+///\brief True if the product of dense A and B is stored in low precision or accumulated in a higher precision than its arguments.
+///
+/// This is the case when A or B store half, bfloat16 or float values, the result is one of these or double and
+/// the result is stored in 16 bit or not all three have the same type. These products are computed by gemm_mixed.
+template<class M, class E1, class E2>
+struct has_mixed_precision_gemm: public boost::mpl::and_<
+	boost::mpl::and_<
+		boost::is_same<typename M::storage_category, dense_tag>,
+		boost::is_same<typename E1::storage_category, dense_tag>,
+		boost::is_same<typename E2::storage_category, dense_tag>
+	>,
+	is_mixed_argument<typename E1::value_type>,
+	is_mixed_argument<typename E2::value_type>,
+	is_mixed_result<typename M::value_type>,
+	boost::mpl::or_<
+		is_low_precision<typename M::value_type>,
+		boost::mpl::not_<boost::mpl::and_<
+			boost::is_same<typename E1::value_type, typename M::value_type>,
+			boost::is_same<typename E2::value_type, typename M::value_type>
+		> >
+	>
+>{};
+
+///\brief True if the product of dense A and x is stored in low precision or accumulated in a higher precision than its arguments.
+template<class ResultV, class M, class V>
+struct has_mixed_precision_gemv: public has_mixed_precision_gemm<ResultV,M,V>{};
+
+//Updates a result line of a product: c[j*inc] = beta * c[j*inc] + alpha * acc[j].
+//beta=0 overwrites the values, so that uninitialized values do not propagate
+template<class T, class Acc>
+void mixed_update(std::size_t n, T* c, std::ptrdiff_t inc, Acc const* acc, Acc alpha, Acc beta){
+	if(beta == Acc()){
+		for(std::size_t j = 0; j != n; ++j)
+			c[std::ptrdiff_t(j) * inc] = alpha * acc[j];
+	}else{
+		for(std::size_t j = 0; j != n; ++j){
+			T& value = c[std::ptrdiff_t(j) * inc];
+			value = beta * static_cast<Acc>(value) + alpha * acc[j];
+		}
+	}
+}
+
+///\brief Computes m = beta * m + alpha * e1 * e2 for dense arguments of mixed precision.
+///
+/// Panels of e1 and e2 are converted to the accumulation type in blocks that fit into the cache,
+/// so that the 16 bit values are read once from memory and converted once per block. The products
+/// are accumulated over the whole inner dimension in a block of rows of the accumulation type, which the compiler
+/// vectorizes, and the result is rounded to the type of m only once, when the block is written back.
+template<class M, class E1, class E2>
+void gemm_mixed(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta
+){
+	typedef typename mixed_accumulator<typename M::value_type>::type value_type;
+	std::size_t const block_m = 64;
+	std::size_t const block_k = 128;
+	std::size_t const block_n = 256;
+	std::size_t size1 = m().size1();
+	std::size_t size2 = m().size2();
+	std::size_t size_k = e1().size2();
+
+	auto A = traits::storage(e1);
+	auto B = traits::storage(e2);
+	auto C = traits::storage(m);
+	std::ptrdiff_t stride1A = e1().stride1(), stride2A = e1().stride2();
+	std::ptrdiff_t stride1B = e2().stride1(), stride2B = e2().stride2();
+	std::ptrdiff_t stride1C = m().stride1(), stride2C = m().stride2();
+
+	value_type alpha_acc = static_cast<value_type>(alpha);
+	value_type beta_acc = static_cast<value_type>(beta);
+	std::size_t max_n = std::min(block_n,size2);
+	std::vector<value_type> panel(block_k * max_n);
+	std::vector<value_type> row(std::min(block_k,size_k));
+	std::vector<value_type> acc(std::min(block_m,size1) * max_n);
+	for(std::size_t j = 0; j < size2; j += block_n){
+		std::size_t size_n = std::min(block_n, size2 - j);
+		for(std::size_t i = 0; i < size1; i += block_m){
+			std::size_t size_m = std::min(block_m, size1 - i);
+			std::fill(acc.begin(), acc.begin() + size_m * size_n, value_type());
+			for(std::size_t l = 0; l < size_k; l += block_k){
+				std::size_t size_l = std::min(block_k, size_k - l);
+				for(std::size_t ll = 0; ll != size_l; ++ll){
+					convert(
+						size_n, B + std::ptrdiff_t(l + ll) * stride1B + std::ptrdiff_t(j) * stride2B, stride2B,
+						panel.data() + ll * size_n, 1
+					);
+				}
+				for(std::size_t ii = 0; ii != size_m; ++ii){
+					convert(size_l, A + std::ptrdiff_t(i + ii) * stride1A + std::ptrdiff_t(l) * stride2A, stride2A, row.data(), 1);
+					value_type* acc_row = acc.data() + ii * size_n;
+					for(std::size_t ll = 0; ll != size_l; ++ll){
+						value_type a = row[ll];
+						value_type const* b = panel.data() + ll * size_n;
+						for(std::size_t jj = 0; jj != size_n; ++jj)
+							acc_row[jj] += a * b[jj];
+					}
+				}
+			}
+			//for size_k=0 only the scaling by beta remains
+			for(std::size_t ii = 0; ii != size_m; ++ii){
+				mixed_update(
+					size_n, C + std::ptrdiff_t(i + ii) * stride1C + std::ptrdiff_t(j) * stride2C, stride2C,
+					acc.data() + ii * size_n, alpha_acc, beta_acc
+				);
+			}
+		}
+	}
+}
+
+///\brief Computes result = beta * result + alpha * A * x for dense arguments of mixed precision.
+///
+/// For row major A the rows are converted in chunks and reduced with x, which is converted once.
+/// For column major A blocks of the result are accumulated as linear combinations of converted column chunks.
+template<class ResultV, class M, class V>
+void gemv_mixed(
+	matrix_expression<M,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& result,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta
+){
+	typedef typename mixed_accumulator<typename ResultV::value_type>::type value_type;
+	std::size_t const block = 1024;
+	std::size_t size1 = A().size1();
+	std::size_t size2 = A().size2();
+
+	auto matA = traits::storage(A);
+	auto vecX = traits::storage(x);
+	auto vecY = traits::storage(result);
+	std::ptrdiff_t stride1A = A().stride1(), stride2A = A().stride2();
+	std::ptrdiff_t strideX = x().stride(), strideY = result().stride();
+	value_type alpha_acc = static_cast<value_type>(alpha);
+	value_type beta_acc = static_cast<value_type>(beta);
+
+	std::vector<value_type> chunk(std::min(block, std::max(size1,size2)));
+	if(boost::is_same<typename M::orientation, row_major>::value){
+		std::vector<value_type> xconv(size2);
+		convert(size2, vecX, strideX, xconv.data(), 1);
+		for(std::size_t i = 0; i != size1; ++i){
+			value_type sum = value_type();
+			for(std::size_t j = 0; j < size2; j += block){
+				std::size_t size_j = std::min(block, size2 - j);
+				convert(size_j, matA + std::ptrdiff_t(i) * stride1A + std::ptrdiff_t(j) * stride2A, stride2A, chunk.data(), 1);
+				for(std::size_t jj = 0; jj != size_j; ++jj)
+					sum += chunk[jj] * xconv[j + jj];
+			}
+			mixed_update(1, vecY + std::ptrdiff_t(i) * strideY, 0, &sum, alpha_acc, beta_acc);
+		}
+	}else{
+		std::vector<value_type> acc(std::min(block, size1));
+		for(std::size_t i = 0; i < size1; i += block){
+			std::size_t size_i = std::min(block, size1 - i);
+			std::fill(acc.begin(), acc.begin() + size_i, value_type());
+			for(std::size_t j = 0; j != size2; ++j){
+				value_type xj = static_cast<value_type>(vecX[std::ptrdiff_t(j) * strideX]);
+				convert(size_i, matA + std::ptrdiff_t(i) * stride1A + std::ptrdiff_t(j) * stride2A, stride1A, chunk.data(), 1);
+				for(std::size_t ii = 0; ii != size_i; ++ii)
+					acc[ii] += xj * chunk[ii];
+			}
+			mixed_update(size_i, vecY + std::ptrdiff_t(i) * strideY, strideY, acc.data(), alpha_acc, beta_acc);
+		}
+	}
+}
+
+}}
+#endif
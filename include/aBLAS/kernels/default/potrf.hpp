@@ -0,0 +1,130 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default Cholesky decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_POTRF_HPP
+#define ABLAS_KERNELS_DEFAULT_POTRF_HPP
+
+#include "../trsm.hpp"
+#include "../syrk.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include "../../matrix_proxy.hpp"
+#include "../../triangular_matrix.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace aBLAS { namespace bindings {
+
+//unblocked Cholesky decomposition of the lower triangle of the n x n block a. The columns of L are computed
+//one after another, every element by a dot product of the rows computed so far.
+//returns 0 on success, otherwise j+1 for the first pivot j which is not positive.
+template<class T>
+std::size_t potrf_block(std::size_t n, T* a, std::ptrdiff_t stride1, std::ptrdiff_t stride2){
+	for(std::size_t j = 0; j != n; ++j){
+		T* row_j = a + std::ptrdiff_t(j) * stride1;
+		T pivot = row_j[std::ptrdiff_t(j) * stride2];
+		for(std::size_t k = 0; k != j; ++k){
+			T x = row_j[std::ptrdiff_t(k) * stride2];
+			pivot -= x * x;
+		}
+		if(!(pivot > T(0)))
+			return j + 1;
+		pivot = std::sqrt(pivot);
+		row_j[std::ptrdiff_t(j) * stride2] = pivot;
+		for(std::size_t i = j + 1; i != n; ++i){
+			T* row_i = a + std::ptrdiff_t(i) * stride1;
+			T x = row_i[std::ptrdiff_t(j) * stride2];
+			for(std::size_t k = 0; k != j; ++k){
+				x -= row_i[std::ptrdiff_t(k) * stride2] * row_j[std::ptrdiff_t(k) * stride2];
+			}
+			row_i[std::ptrdiff_t(j) * stride2] = x / pivot;
+		}
+	}
+	return 0;
+}
+
+//blocked right looking decomposition A=LL^T. The blocks on the diagonal are decomposed by potrf_block,
+//the column below by trsm and the remaining matrix is updated by syrk.
+//syrk writes both triangles, the triangle above the diagonal is cleared afterwards.
+template<class MatA>
+std::size_t potrf_impl(matrix_expression<MatA,cpu_tag>& A){
+	typedef typename MatA::value_type value_type;
+	std::size_t n = A().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	value_type* a = traits::storage(A);
+	std::ptrdiff_t stride1 = traits::stride1(A);
+	std::ptrdiff_t stride2 = traits::stride2(A);
+	for(std::size_t start = 0; start < n; start += block){
+		std::size_t end = std::min(n, start + block);
+		std::size_t info = potrf_block(end - start, a + std::ptrdiff_t(start) * (stride1 + stride2), stride1, stride2);
+		if(info)
+			return start + info;
+		if(end == n)
+			break;
+		//L21 = A21 * L11^-T, computed as L11 * L21^T = A21^T
+		matrix_range<MatA> column_block = subrange(A, end, n, start, end);
+		matrix_transpose<matrix_range<MatA> > column_block_trans(column_block);
+		kernels::trsm(triangular<lower>(subrange(A, start, end, start, end)), column_block_trans);
+		matrix_range<MatA> trailing = subrange(A, end, n, end, n);
+		kernels::syrk(column_block, trailing, value_type(-1), value_type(1));
+	}
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = i + 1; j != n; ++j){
+			a[std::ptrdiff_t(i) * stride1 + std::ptrdiff_t(j) * stride2] = value_type();
+		}
+	}
+	return 0;
+}
+
+template<class MatA>
+std::size_t potrf_impl(matrix_expression<MatA,cpu_tag>& A, lower){
+	return potrf_impl(A);
+}
+//A=U^TU is the decomposition of the transpose
+template<class MatA>
+std::size_t potrf_impl(matrix_expression<MatA,cpu_tag>& A, upper){
+	matrix_transpose<MatA> A_trans(A());
+	return potrf_impl(A_trans);
+}
+
+// A = LL^T or A = U^TU
+template<class TriangularType, class MatA>
+std::size_t potrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	boost::mpl::false_
+){
+	return potrf_impl(A, TriangularType());
+}
+
+}}
+
+#endif
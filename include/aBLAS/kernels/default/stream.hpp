@@ -0,0 +1,173 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Fill and copy kernels with non-temporal stores
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_STREAM_HPP
+#define ABLAS_KERNELS_DEFAULT_STREAM_HPP
+
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace aBLAS{namespace bindings{
+
+///\brief Vector registers and non-temporal stores of T.
+///
+/// Non-temporal stores write whole cache lines directly to memory without reading them into
+/// the cache first, so large results do not evict the data other kernels are working on.
+/// The specializations exist for the types and instruction sets which support them.
+template<class T>
+struct streaming_store: public boost::mpl::false_{};
+
+#ifdef __AVX__
+template<>
+struct streaming_store<float>: public boost::mpl::true_{
+	typedef __m256 register_type;
+	static const std::size_t size = 8;
+	static register_type set1(float x){return _mm256_set1_ps(x);}
+	static register_type load(float const* x){return _mm256_loadu_ps(x);}
+	static register_type mul(register_type x, register_type y){return _mm256_mul_ps(x,y);}
+	static void stream(float* x, register_type v){_mm256_stream_ps(x,v);}
+};
+template<>
+struct streaming_store<double>: public boost::mpl::true_{
+	typedef __m256d register_type;
+	static const std::size_t size = 4;
+	static register_type set1(double x){return _mm256_set1_pd(x);}
+	static register_type load(double const* x){return _mm256_loadu_pd(x);}
+	static register_type mul(register_type x, register_type y){return _mm256_mul_pd(x,y);}
+	static void stream(double* x, register_type v){_mm256_stream_pd(x,v);}
+};
+#elif defined(__SSE2__)
+template<>
+struct streaming_store<float>: public boost::mpl::true_{
+	typedef __m128 register_type;
+	static const std::size_t size = 4;
+	static register_type set1(float x){return _mm_set1_ps(x);}
+	static register_type load(float const* x){return _mm_loadu_ps(x);}
+	static register_type mul(register_type x, register_type y){return _mm_mul_ps(x,y);}
+	static void stream(float* x, register_type v){_mm_stream_ps(x,v);}
+};
+template<>
+struct streaming_store<double>: public boost::mpl::true_{
+	typedef __m128d register_type;
+	static const std::size_t size = 2;
+	static register_type set1(double x){return _mm_set1_pd(x);}
+	static register_type load(double const* x){return _mm_loadu_pd(x);}
+	static register_type mul(register_type x, register_type y){return _mm_mul_pd(x,y);}
+	static void stream(double* x, register_type v){_mm_stream_pd(x,v);}
+};
+#endif
+
+///\brief Sets x[i] = value for i < n.
+template<class T>
+void fill(std::size_t n, T value, T* x){
+	std::fill(x, x + n, value);
+}
+
+#if defined(__AVX__) || defined(__SSE2__)
+//number of elements before x is aligned for the non-temporal stores
+template<class T>
+std::size_t streaming_store_prologue(std::size_t n, T* x){
+	std::size_t misalignment = reinterpret_cast<std::uintptr_t>(x) % (streaming_store<T>::size * sizeof(T)) / sizeof(T);
+	return misalignment == 0? 0 : std::min(n, streaming_store<T>::size - misalignment);
+}
+
+template<class T>
+void stream_fill(std::size_t n, T value, T* x, boost::mpl::true_){
+	typedef streaming_store<T> store;
+	std::size_t prologue = streaming_store_prologue(n, x);
+	fill(prologue, value, x);
+	typename store::register_type v = store::set1(value);
+	std::size_t i = prologue;
+	for(; i + store::size <= n; i += store::size){
+		store::stream(x + i, v);
+	}
+	fill(n - i, value, x + i);
+	_mm_sfence();
+}
+#endif
+template<class T>
+void stream_fill(std::size_t n, T value, T* x, boost::mpl::false_){
+	fill(n, value, x);
+}
+
+///\brief Sets x[i] = value for i < n with non-temporal stores if T supports them.
+template<class T>
+void stream_fill(std::size_t n, T value, T* x){
+	stream_fill(n, value, x, streaming_store<T>());
+}
+
+#if defined(__AVX__) || defined(__SSE2__)
+template<class T>
+void stream_copy(std::size_t n, T alpha, T const* x, T* y, boost::mpl::true_){
+	typedef streaming_store<T> store;
+	std::size_t prologue = streaming_store_prologue(n, y);
+	for(std::size_t i = 0; i != prologue; ++i){
+		y[i] = alpha * x[i];
+	}
+	std::size_t i = prologue;
+	if(alpha == T(1)){
+		for(; i + store::size <= n; i += store::size){
+			store::stream(y + i, store::load(x + i));
+		}
+	}else{
+		typename store::register_type a = store::set1(alpha);
+		for(; i + store::size <= n; i += store::size){
+			store::stream(y + i, store::mul(a, store::load(x + i)));
+		}
+	}
+	for(; i != n; ++i){
+		y[i] = alpha * x[i];
+	}
+	_mm_sfence();
+}
+#endif
+template<class T>
+void stream_copy(std::size_t n, T alpha, T const* x, T* y, boost::mpl::false_){
+	for(std::size_t i = 0; i != n; ++i){
+		y[i] = alpha * x[i];
+	}
+}
+
+///\brief Sets y[i] = alpha * x[i] for i < n with non-temporal stores if T supports them. x and y must not overlap.
+template<class T>
+void stream_copy(std::size_t n, T alpha, T const* x, T* y){
+	stream_copy(n, alpha, x, y, streaming_store<T>());
+}
+
+}}
+#endif
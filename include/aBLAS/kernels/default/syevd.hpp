@@ -0,0 +1,143 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default eigen decomposition kernel of symmetric matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_SYEVD_HPP
+#define ABLAS_KERNELS_DEFAULT_SYEVD_HPP
+
+#include "../traits.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace aBLAS { namespace bindings {
+
+//rotates the columns p and q of the m x n block a: (a_p, a_q) = (c a_p - s a_q, s a_p + c a_q)
+template<class T>
+void jacobi_rotate(
+	std::size_t m, T* a, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	std::size_t p, std::size_t q, T c, T s
+){
+	T* column_p = a + std::ptrdiff_t(p) * stride2;
+	T* column_q = a + std::ptrdiff_t(q) * stride2;
+	for(std::size_t i = 0; i != m; ++i){
+		T x = column_p[std::ptrdiff_t(i) * stride1];
+		T y = column_q[std::ptrdiff_t(i) * stride1];
+		column_p[std::ptrdiff_t(i) * stride1] = c * x - s * y;
+		column_q[std::ptrdiff_t(i) * stride1] = s * x + c * y;
+	}
+}
+
+//tangent of the rotation angle which makes (a_p, a_q) orthogonal, given by zeta = (a_q^Ta_q - a_p^Ta_p) / (2 a_p^Ta_q).
+//the smaller root of t^2 + 2 zeta t - 1 = 0 is the rotation by the smaller angle
+template<class T>
+T jacobi_tangent(T zeta){
+	T t = T(1) / (std::abs(zeta) + std::hypot(zeta, T(1)));
+	return zeta < T(0)? -t: t;
+}
+
+//true if the off diagonal element x is negligible compared to the diagonal elements y and z
+template<class T>
+bool jacobi_negligible(T x, T y, T z){
+	T epsilon = std::numeric_limits<T>::epsilon();
+	return std::abs(x) <= epsilon * std::sqrt(std::abs(y * z)) || std::abs(x) < std::numeric_limits<T>::min();
+}
+
+//cyclic Jacobi method. A copy S of the symmetric matrix is diagonalized by a rotation J for every pair p<q in turn,
+//S=J^TSJ, which zeroes the elements S_pq and S_qp. The rotations are accumulated in the columns of A. Pairs whose off diagonal
+//element is negligible are skipped and the iteration stops after a sweep without rotations.
+//returns 0 on convergence and 1 if the maximum number of sweeps was not enough.
+template<class MatA, class VecW>
+std::size_t syevd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecW,cpu_tag>& w,
+	boost::mpl::false_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t n = A().size1();
+	std::vector<value_type> S(n * n);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			S[i * n + j] = A()(std::max(i, j), std::min(i, j));
+		}
+	}
+	value_type* a = traits::storage(A);
+	std::ptrdiff_t stride1 = traits::stride1(A);
+	std::ptrdiff_t stride2 = traits::stride2(A);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != n; ++j){
+			a[std::ptrdiff_t(i) * stride1 + std::ptrdiff_t(j) * stride2] = (i == j)? value_type(1): value_type();
+		}
+	}
+	
+	std::size_t const max_sweeps = 64;
+	bool converged = false;
+	for(std::size_t sweep = 0; sweep != max_sweeps && !converged; ++sweep){
+		converged = true;
+		for(std::size_t p = 0; p != n; ++p){
+			for(std::size_t q = p + 1; q != n; ++q){
+				value_type s_pq = S[p * n + q];
+				if(jacobi_negligible(s_pq, S[p * n + p], S[q * n + q]))
+					continue;
+				converged = false;
+				value_type t = jacobi_tangent((S[q * n + q] - S[p * n + p]) / (2 * s_pq));
+				value_type c = 1 / std::sqrt(t * t + 1);
+				value_type s = t * c;
+				jacobi_rotate(n, S.data(), std::ptrdiff_t(n), 1, p, q, c, s);
+				jacobi_rotate(n, S.data(), 1, std::ptrdiff_t(n), p, q, c, s);
+				S[p * n + q] = S[q * n + p] = value_type();
+				jacobi_rotate(n, a, stride1, stride2, p, q, c, s);
+			}
+		}
+	}
+	
+	//sort the eigenvalues in ascending order
+	for(std::size_t i = 0; i != n; ++i){
+		std::size_t k = i;
+		for(std::size_t j = i + 1; j != n; ++j){
+			if(S[j * n + j] < S[k * n + k])
+				k = j;
+		}
+		w()(i) = S[k * n + k];
+		if(k == i)
+			continue;
+		std::swap(S[k * n + k], S[i * n + i]);
+		for(std::size_t j = 0; j != n; ++j){
+			std::swap(a[std::ptrdiff_t(j) * stride1 + std::ptrdiff_t(i) * stride2], a[std::ptrdiff_t(j) * stride1 + std::ptrdiff_t(k) * stride2]);
+		}
+	}
+	return converged? 0: 1;
+}
+
+}}
+
+#endif
@@ -0,0 +1,115 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default symmetric matrix-matrix product kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_SYMM_HPP
+#define ABLAS_KERNELS_DEFAULT_SYMM_HPP
+
+#include "../gemm.hpp"
+#include "../symv.hpp"
+#include "../tuning.hpp"
+#include "../../matrix_proxy.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+
+namespace aBLAS { namespace bindings {
+
+//dense symmetric matrices are processed in blocks of rows of the stored triangle. The block on the diagonal is
+//mirrored into a temporary, the rest of the row block is used twice by gemm: for its own rows of C and transposed
+//for the rows of the mirrored block.
+template<class MatA, class MatB, class MatC>
+void symm_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag> const& B,
+	matrix_expression<MatC,cpu_tag>& C,
+	typename MatC::value_type alpha,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	typedef typename MatC::value_type value_type;
+	typedef typename matrix_temporary<MatC>::type BlockStorage;
+	std::size_t n = A().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	BlockStorage diagonal(std::min(block, n), std::min(block, n), uninitialized_tag());
+	for(std::size_t start = 0; start < n; start += block){
+		std::size_t end = std::min(n, start + block);
+		matrix_range<BlockStorage> diagonal_block = subrange(diagonal, 0, end - start, 0, end - start);
+		for(std::size_t i = start; i != end; ++i){
+			for(std::size_t j = start; j != end; ++j){
+				bool stored = Triangular::is_upper? j >= i: j <= i;
+				diagonal_block(i - start, j - start) = stored? A().expression()(i,j): A().expression()(j,i);
+			}
+		}
+		matrix_range<MatC> target = rows(C, start, end);
+		kernels::gemm(diagonal_block, rows(B, start, end), target, alpha, value_type(1));
+		
+		std::size_t first = Triangular::is_upper? end: 0;
+		std::size_t last = Triangular::is_upper? n: start;
+		if(first == last)
+			continue;
+		matrix_range<MatC> mirrored_target = rows(C, first, last);
+		kernels::gemm(subrange(A().expression(), start, end, first, last), rows(B, first, last), target, alpha, value_type(1));
+		kernels::gemm(trans(subrange(A().expression(), start, end, first, last)), rows(B, start, end), mirrored_target, alpha, value_type(1));
+	}
+}
+
+//packed matrices are multiplied with every column of B by symv
+template<class MatA, class MatB, class MatC>
+void symm_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag> const& B,
+	matrix_expression<MatC,cpu_tag>& C,
+	typename MatC::value_type alpha,
+	packed_tag
+){
+	typedef typename MatC::value_type value_type;
+	for(std::size_t j = 0; j != B().size2(); ++j){
+		matrix_column<MatC> c = column(C, j);
+		kernels::symv(A, column(B, j), c, alpha, value_type(1));
+	}
+}
+
+// C = beta * C + alpha * A * B
+template<class MatA, class MatB, class MatC>
+void symm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag> const& B,
+	matrix_expression<MatC,cpu_tag>& C,
+	typename MatC::value_type alpha,
+	typename MatC::value_type beta,
+	boost::mpl::false_
+){
+	scale_result(C, beta);
+	symm_impl(A, B, C, alpha, typename MatA::storage_category());
+}
+
+}}
+
+#endif
@@ -0,0 +1,161 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default symmetric matrix-vector product kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_SYMV_HPP
+#define ABLAS_KERNELS_DEFAULT_SYMV_HPP
+
+#include "gemv.hpp"
+#include "trmv.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+
+namespace aBLAS { namespace bindings {
+
+//y += alpha * A * x for a symmetric block of size n with element (i,j) at A[i*stride1+j*stride2]
+//of which only the triangle given by Triangular is read.
+template<class Triangular, class TA, class TX, class T>
+void symv_block(
+	std::size_t n, T alpha, TA const* A, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	TX const* x, std::ptrdiff_t incx, T* y, std::ptrdiff_t incy
+){
+	for(std::size_t i = 0; i != n; ++i){
+		T sum = T();
+		for(std::size_t j = 0; j != n; ++j){
+			bool stored = Triangular::is_upper? j >= i: j <= i;
+			TA a = stored? A[std::ptrdiff_t(i) * stride1 + std::ptrdiff_t(j) * stride2]: A[std::ptrdiff_t(j) * stride1 + std::ptrdiff_t(i) * stride2];
+			sum += a * x[std::ptrdiff_t(j) * incx];
+		}
+		y[std::ptrdiff_t(i) * incy] += alpha * sum;
+	}
+}
+
+//y += alpha * A * x for a packed symmetric matrix of size n.
+//Every element of line k is A(k,l) = A(l,k), so it is used for y(k) and y(l) while it is in a register.
+template<class Packed, class TA, class TX, class T>
+void packed_symv(
+	std::size_t n, T alpha, TA const* A,
+	TX const* x, std::ptrdiff_t incx, T* y, std::ptrdiff_t incy
+){
+	typedef packed_lines<Packed> lines;
+	for(std::size_t k = 0; k != n; ++k){
+		TA const* line = A + lines::offset(k, n);
+		std::size_t end = lines::end(k, n);
+		T xk = alpha * x[std::ptrdiff_t(k) * incx];
+		T sum = line[k] * x[std::ptrdiff_t(k) * incx];
+		for(std::size_t l = lines::begin(k); l != k; ++l){
+			sum += line[l] * x[std::ptrdiff_t(l) * incx];
+			y[std::ptrdiff_t(l) * incy] += line[l] * xk;
+		}
+		for(std::size_t l = k + 1; l < end; ++l){
+			sum += line[l] * x[std::ptrdiff_t(l) * incx];
+			y[std::ptrdiff_t(l) * incy] += line[l] * xk;
+		}
+		y[std::ptrdiff_t(k) * incy] += alpha * sum;
+	}
+}
+
+//dense symmetric matrices are processed in blocks of rows of the stored triangle. The block on the diagonal is
+//computed by symv_block, the rest of the row block is used twice by gemv: for its own rows and transposed
+//for the rows of the mirrored block.
+template<class MatA, class V, class ResultV>
+void symv_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	std::size_t n = A().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	typename MatA::value_type const* a = traits::storage(A().expression());
+	std::ptrdiff_t stride1 = traits::stride1(A().expression());
+	std::ptrdiff_t stride2 = traits::stride2(A().expression());
+	typename V::value_type const* px = traits::storage(x);
+	std::ptrdiff_t incx = traits::stride(x);
+	typename ResultV::value_type* py = traits::storage(y);
+	std::ptrdiff_t incy = traits::stride(y);
+	for(std::size_t start = 0; start < n; start += block){
+		std::size_t end = std::min(n, start + block);
+		symv_block<Triangular>(
+			end - start, alpha, a + std::ptrdiff_t(start) * (stride1 + stride2), stride1, stride2,
+			px + std::ptrdiff_t(start) * incx, incx, py + std::ptrdiff_t(start) * incy, incy
+		);
+		std::size_t first = Triangular::is_upper? end: 0;
+		std::size_t last = Triangular::is_upper? n: start;
+		typename MatA::value_type const* off = a + std::ptrdiff_t(start) * stride1 + std::ptrdiff_t(first) * stride2;
+		gemv_strided(
+			end - start, last - first, alpha, off, stride1, stride2,
+			px + std::ptrdiff_t(first) * incx, incx,
+			typename ResultV::value_type(1), py + std::ptrdiff_t(start) * incy, incy
+		);
+		gemv_strided(
+			last - first, end - start, alpha, off, stride2, stride1,
+			px + std::ptrdiff_t(start) * incx, incx,
+			typename ResultV::value_type(1), py + std::ptrdiff_t(first) * incy, incy
+		);
+	}
+}
+
+template<class MatA, class V, class ResultV>
+void symv_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	packed_tag
+){
+	typedef typename MatA::orientation orientation;
+	packed_symv<orientation>(
+		A().size1(), alpha, traits::storage(A),
+		traits::storage(x), traits::stride(x), traits::storage(y), traits::stride(y)
+	);
+}
+
+// y = beta * y + alpha * A * x
+template<class MatA, class V, class ResultV>
+void symv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta,
+	boost::mpl::false_
+){
+	scale_result(y, beta);
+	symv_impl(A, x, y, alpha, typename MatA::storage_category());
+}
+
+}}
+
+#endif
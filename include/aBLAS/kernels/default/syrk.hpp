@@ -0,0 +1,110 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default implementation of the SYRK routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_SYRK_HPP
+#define ABLAS_KERNELS_DEFAULT_SYRK_HPP
+
+#include "../gemm.hpp"
+#include "../tuning.hpp"
+#include "../../matrix_proxy.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+
+namespace aBLAS { namespace bindings {
+
+//copies the strictly lower triangle of the square matrix m to the upper triangle, block by block.
+template<class M>
+void mirror_lower_triangle(matrix_expression<M,cpu_tag>& m){
+	typedef typename M::value_type value_type;
+	std::size_t n = m().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().syrk_block_size);
+	for(std::size_t i = 0; i < n; i += block){
+		std::size_t end_i = std::min(n, i + block);
+		for(std::size_t j = 0; j < i; j += block){
+			matrix_range<M> upper = subrange(m, j, j + block, i, end_i);
+			kernels::assign<scalar_assign>(upper, trans(subrange(m, i, end_i, j, j + block)), value_type(1));
+		}
+		for(std::size_t k = i; k != end_i; ++k){
+			for(std::size_t l = i; l != k; ++l){
+				m()(l,k) = m()(k,l);
+			}
+		}
+	}
+}
+
+// m = beta * m + alpha * e * e^T
+//
+// The result is computed in blocks of tuning().syrk_block_size rows and columns. The products of the
+// blocks on and below the diagonal are computed by gemm, the blocks above the diagonal are their transposes.
+// For beta=0 the lower block is mirrored, otherwise the product is computed in a temporary and added to both blocks.
+template<class M, class E>
+void syrk(
+	matrix_expression<E,cpu_tag> const& e,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	boost::mpl::false_
+) {
+	typedef typename M::value_type value_type;
+	typedef typename matrix_temporary<M>::type BlockStorage;
+	std::size_t n = m().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().syrk_block_size);
+	bool overwrite = beta == value_type();
+	BlockStorage block_storage(
+		overwrite? 0: std::min(block, n), overwrite? 0: std::min(block, n), uninitialized_tag()
+	);
+	for(std::size_t i = 0; i < n; i += block){
+		std::size_t end_i = std::min(n, i + block);
+		for(std::size_t j = 0; j <= i; j += block){
+			std::size_t end_j = std::min(n, j + block);
+			matrix_range<M> lower = subrange(m, i, end_i, j, end_j);
+			matrix_range<M> upper = subrange(m, j, end_j, i, end_i);
+			if(overwrite){
+				kernels::gemm(rows(e, i, end_i), trans(rows(e, j, end_j)), lower, alpha, value_type());
+				if(i != j)
+					kernels::assign<scalar_assign>(upper, trans(lower), value_type(1));
+			}else{
+				matrix_range<BlockStorage> product = subrange(block_storage, 0, end_i - i, 0, end_j - j);
+				kernels::gemm(rows(e, i, end_i), trans(rows(e, j, end_j)), product, alpha, value_type());
+				scale_result(lower, beta);
+				kernels::assign<scalar_plus_assign>(lower, product, value_type(1));
+				if(i != j){
+					scale_result(upper, beta);
+					kernels::assign<scalar_plus_assign>(upper, trans(product), value_type(1));
+				}
+			}
+		}
+	}
+}
+
+}}
+
+#endif
@@ -0,0 +1,250 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Blocked transposition of dense storage
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_DEFAULT_TRANSPOSE_HPP
+#define ABLAS_KERNELS_DEFAULT_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace aBLAS{namespace bindings{
+
+///\brief Transposes a square block of size x size elements: B[j*ldb+i] = A[i*lda+j].
+///
+/// The specializations transpose the block in registers.
+template<class T>
+struct transpose_micro_kernel{
+	static const std::size_t size = 1;
+	static void apply(T const* A, std::ptrdiff_t, T* B, std::ptrdiff_t){
+		*B = *A;
+	}
+};
+
+#ifdef __AVX__
+template<>
+struct transpose_micro_kernel<float>{
+	static const std::size_t size = 8;
+	static void apply(float const* A, std::ptrdiff_t lda, float* B, std::ptrdiff_t ldb){
+		__m256 r0 = _mm256_loadu_ps(A);
+		__m256 r1 = _mm256_loadu_ps(A + lda);
+		__m256 r2 = _mm256_loadu_ps(A + 2 * lda);
+		__m256 r3 = _mm256_loadu_ps(A + 3 * lda);
+		__m256 r4 = _mm256_loadu_ps(A + 4 * lda);
+		__m256 r5 = _mm256_loadu_ps(A + 5 * lda);
+		__m256 r6 = _mm256_loadu_ps(A + 6 * lda);
+		__m256 r7 = _mm256_loadu_ps(A + 7 * lda);
+		//interleave pairs of rows, then pairs of pairs, then swap the 128 bit halves
+		__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+		__m256 t1 = _mm256_unpackhi_ps(r0, r1);
+		__m256 t2 = _mm256_unpacklo_ps(r2, r3);
+		__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+		__m256 t4 = _mm256_unpacklo_ps(r4, r5);
+		__m256 t5 = _mm256_unpackhi_ps(r4, r5);
+		__m256 t6 = _mm256_unpacklo_ps(r6, r7);
+		__m256 t7 = _mm256_unpackhi_ps(r6, r7);
+		r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+		r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+		r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+		r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+		r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+		r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+		r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+		r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+		_mm256_storeu_ps(B, _mm256_permute2f128_ps(r0, r4, 0x20));
+		_mm256_storeu_ps(B + ldb, _mm256_permute2f128_ps(r1, r5, 0x20));
+		_mm256_storeu_ps(B + 2 * ldb, _mm256_permute2f128_ps(r2, r6, 0x20));
+		_mm256_storeu_ps(B + 3 * ldb, _mm256_permute2f128_ps(r3, r7, 0x20));
+		_mm256_storeu_ps(B + 4 * ldb, _mm256_permute2f128_ps(r0, r4, 0x31));
+		_mm256_storeu_ps(B + 5 * ldb, _mm256_permute2f128_ps(r1, r5, 0x31));
+		_mm256_storeu_ps(B + 6 * ldb, _mm256_permute2f128_ps(r2, r6, 0x31));
+		_mm256_storeu_ps(B + 7 * ldb, _mm256_permute2f128_ps(r3, r7, 0x31));
+	}
+};
+template<>
+struct transpose_micro_kernel<double>{
+	static const std::size_t size = 4;
+	static void apply(double const* A, std::ptrdiff_t lda, double* B, std::ptrdiff_t ldb){
+		__m256d r0 = _mm256_loadu_pd(A);
+		__m256d r1 = _mm256_loadu_pd(A + lda);
+		__m256d r2 = _mm256_loadu_pd(A + 2 * lda);
+		__m256d r3 = _mm256_loadu_pd(A + 3 * lda);
+		__m256d t0 = _mm256_unpacklo_pd(r0, r1);
+		__m256d t1 = _mm256_unpackhi_pd(r0, r1);
+		__m256d t2 = _mm256_unpacklo_pd(r2, r3);
+		__m256d t3 = _mm256_unpackhi_pd(r2, r3);
+		_mm256_storeu_pd(B, _mm256_permute2f128_pd(t0, t2, 0x20));
+		_mm256_storeu_pd(B + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+		_mm256_storeu_pd(B + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+		_mm256_storeu_pd(B + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+	}
+};
+#elif defined(__SSE2__)
+template<>
+struct transpose_micro_kernel<float>{
+	static const std::size_t size = 4;
+	static void apply(float const* A, std::ptrdiff_t lda, float* B, std::ptrdiff_t ldb){
+		__m128 r0 = _mm_loadu_ps(A);
+		__m128 r1 = _mm_loadu_ps(A + lda);
+		__m128 r2 = _mm_loadu_ps(A + 2 * lda);
+		__m128 r3 = _mm_loadu_ps(A + 3 * lda);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(B, r0);
+		_mm_storeu_ps(B + ldb, r1);
+		_mm_storeu_ps(B + 2 * ldb, r2);
+		_mm_storeu_ps(B + 3 * ldb, r3);
+	}
+};
+template<>
+struct transpose_micro_kernel<double>{
+	static const std::size_t size = 2;
+	static void apply(double const* A, std::ptrdiff_t lda, double* B, std::ptrdiff_t ldb){
+		__m128d r0 = _mm_loadu_pd(A);
+		__m128d r1 = _mm_loadu_pd(A + lda);
+		_mm_storeu_pd(B, _mm_unpacklo_pd(r0, r1));
+		_mm_storeu_pd(B + ldb, _mm_unpackhi_pd(r0, r1));
+	}
+};
+#endif
+
+///\brief Transposes a tile which fits into the L1 cache: B[j*ldb+i] = A[i*lda+j] for i < rows, j < cols.
+template<class T>
+void transpose_tile(
+	std::size_t rows, std::size_t cols,
+	T const* A, std::ptrdiff_t lda,
+	T* B, std::ptrdiff_t ldb
+){
+	std::size_t const size = transpose_micro_kernel<T>::size;
+	std::size_t rows_kernel = rows - rows % size;
+	std::size_t cols_kernel = cols - cols % size;
+	for(std::size_t i = 0; i != rows_kernel; i += size){
+		for(std::size_t j = 0; j != cols_kernel; j += size){
+			transpose_micro_kernel<T>::apply(
+				A + std::ptrdiff_t(i) * lda + j, lda,
+				B + std::ptrdiff_t(j) * ldb + i, ldb
+			);
+		}
+	}
+	//the remaining columns of all rows and the remaining rows of the other columns
+	for(std::size_t j = cols_kernel; j != cols; ++j){
+		for(std::size_t i = 0; i != rows; ++i){
+			B[std::ptrdiff_t(j) * ldb + i] = A[std::ptrdiff_t(i) * lda + j];
+		}
+	}
+	for(std::size_t j = 0; j != cols_kernel; ++j){
+		for(std::size_t i = rows_kernel; i != rows; ++i){
+			B[std::ptrdiff_t(j) * ldb + i] = A[std::ptrdiff_t(i) * lda + j];
+		}
+	}
+}
+
+///\brief Computes B[j*ldb+i] = A[i*lda+j] for i < rows, j < cols. A and B must not overlap.
+///
+/// The larger dimension is halved recursively until the blocks fit into the L1 cache, so that
+/// at every level of the cache hierarchy the blocks of A and B which are read and written fit into the cache,
+/// without knowing its size. The tiles are transposed in registers if the instruction set allows it.
+template<class T>
+void transpose(
+	std::size_t rows, std::size_t cols,
+	T const* A, std::ptrdiff_t lda,
+	T* B, std::ptrdiff_t ldb
+){
+	std::size_t const tile_size = 32;
+	if(rows <= tile_size && cols <= tile_size){
+		transpose_tile(rows, cols, A, lda, B, ldb);
+		return;
+	}
+	//split at a multiple of the tile size so that all tiles are full
+	if(rows >= cols){
+		std::size_t split = (rows / 2 + tile_size - 1) / tile_size * tile_size;
+		transpose(split, cols, A, lda, B, ldb);
+		transpose(rows - split, cols, A + std::ptrdiff_t(split) * lda, lda, B + split, ldb);
+	}else{
+		std::size_t split = (cols / 2 + tile_size - 1) / tile_size * tile_size;
+		transpose(rows, split, A, lda, B, ldb);
+		transpose(rows, cols - split, A + split, lda, B + std::ptrdiff_t(split) * ldb, ldb);
+	}
+}
+
+//swaps the rows x cols block X with the transpose of the cols x rows block Y
+template<class T>
+void transpose_swap(
+	std::size_t rows, std::size_t cols,
+	T* X, T* Y, std::ptrdiff_t ld
+){
+	std::size_t const tile_size = 32;
+	if(rows <= tile_size && cols <= tile_size){
+		T buffer[tile_size * tile_size];
+		transpose_tile(rows, cols, X, ld, buffer, std::ptrdiff_t(tile_size));
+		transpose_tile(cols, rows, Y, ld, X, ld);
+		for(std::size_t j = 0; j != cols; ++j){
+			std::copy(buffer + j * tile_size, buffer + j * tile_size + rows, Y + std::ptrdiff_t(j) * ld);
+		}
+		return;
+	}
+	if(rows >= cols){
+		std::size_t split = (rows / 2 + tile_size - 1) / tile_size * tile_size;
+		transpose_swap(split, cols, X, Y, ld);
+		transpose_swap(rows - split, cols, X + std::ptrdiff_t(split) * ld, Y + split, ld);
+	}else{
+		std::size_t split = (cols / 2 + tile_size - 1) / tile_size * tile_size;
+		transpose_swap(rows, split, X, Y, ld);
+		transpose_swap(rows, cols - split, X + split, Y + std::ptrdiff_t(split) * ld, ld);
+	}
+}
+
+///\brief Transposes the n x n block A in place.
+///
+/// The diagonal blocks are transposed recursively and the off-diagonal blocks are swapped with
+/// the transpose of their mirror block.
+template<class T>
+void transpose_inplace(std::size_t n, T* A, std::ptrdiff_t lda){
+	std::size_t const tile_size = 32;
+	if(n <= tile_size){
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != i; ++j){
+				std::swap(A[std::ptrdiff_t(i) * lda + j], A[std::ptrdiff_t(j) * lda + i]);
+			}
+		}
+		return;
+	}
+	std::size_t split = (n / 2 + tile_size - 1) / tile_size * tile_size;
+	transpose_inplace(split, A, lda);
+	transpose_inplace(n - split, A + std::ptrdiff_t(split) * lda + split, lda);
+	transpose_swap(split, n - split, A + split, A + std::ptrdiff_t(split) * lda, lda);
+}
+
+}}
+#endif
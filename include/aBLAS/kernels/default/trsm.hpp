@@ -0,0 +1,111 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default triangular solve kernel for a matrix right hand side
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_TRSM_HPP
+#define ABLAS_KERNELS_DEFAULT_TRSM_HPP
+
+#include "../gemm.hpp"
+#include "../trsv.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include "../../matrix_proxy.hpp"
+#include "trsv.hpp"
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+
+namespace aBLAS { namespace bindings {
+
+//dense triangular matrices are processed in blocks of rows in the order of the substitution. The solved rows of B
+//are subtracted from the row block of B by gemm, then the columns of the row block are solved
+//with the block on the diagonal by trsv_block.
+template<class MatA, class MatB>
+void trsm_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag>& B,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	typedef typename MatB::value_type value_type;
+	std::size_t n = A().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	typename MatA::value_type const* a = traits::storage(A().expression());
+	std::ptrdiff_t stride1 = traits::stride1(A().expression());
+	std::ptrdiff_t stride2 = traits::stride2(A().expression());
+	value_type* b = traits::storage(B);
+	std::ptrdiff_t b_stride1 = traits::stride1(B);
+	std::ptrdiff_t b_stride2 = traits::stride2(B);
+	for(std::size_t step = 0; step < n; step += block){
+		std::size_t start = Triangular::is_upper? n - std::min(n, step + block): step;
+		std::size_t end = Triangular::is_upper? n - step: std::min(n, step + block);
+		std::size_t first = Triangular::is_upper? end: 0;
+		std::size_t last = Triangular::is_upper? n: start;
+		if(first != last){
+			matrix_range<MatB> target = rows(B, start, end);
+			kernels::gemm(
+				subrange(A().expression(), start, end, first, last), rows(B, first, last),
+				target, value_type(-1), value_type(1)
+			);
+		}
+		for(std::size_t j = 0; j != B().size2(); ++j){
+			trsv_block<Triangular>(
+				end - start, a + std::ptrdiff_t(start) * (stride1 + stride2), stride1, stride2,
+				b + std::ptrdiff_t(start) * b_stride1 + std::ptrdiff_t(j) * b_stride2, b_stride1
+			);
+		}
+	}
+}
+
+//packed matrices are solved for every column of B by trsv
+template<class MatA, class MatB>
+void trsm_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag>& B,
+	packed_tag
+){
+	for(std::size_t j = 0; j != B().size2(); ++j){
+		matrix_column<MatB> b = column(B, j);
+		kernels::trsv(A, b);
+	}
+}
+
+// B = A^-1 * B
+template<class MatA, class MatB>
+void trsm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag>& B,
+	boost::mpl::false_
+){
+	trsm_impl(A, B, typename MatA::storage_category());
+}
+
+}}
+
+#endif
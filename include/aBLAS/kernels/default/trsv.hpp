@@ -0,0 +1,159 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Default triangular solve kernel for a vector right hand side
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_DEFAULT_TRSV_HPP
+#define ABLAS_KERNELS_DEFAULT_TRSV_HPP
+
+#include "gemv.hpp"
+#include "trmv.hpp"
+#include "../tuning.hpp"
+#include "../traits.hpp"
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+
+namespace aBLAS { namespace bindings {
+
+//x = A^-1 x for a triangular block of size n with element (i,j) at A[i*stride1+j*stride2] by forward (lower)
+//or backward (upper) substitution.
+template<class Triangular, class TA, class T>
+void trsv_block(
+	std::size_t n, TA const* A, std::ptrdiff_t stride1, std::ptrdiff_t stride2,
+	T* x, std::ptrdiff_t incx
+){
+	for(std::size_t step = 0; step != n; ++step){
+		std::size_t i = Triangular::is_upper? n - 1 - step: step;
+		TA const* row = A + std::ptrdiff_t(i) * stride1;
+		T sum = x[std::ptrdiff_t(i) * incx];
+		std::size_t begin = Triangular::is_upper? i + 1: 0;
+		std::size_t end = Triangular::is_upper? n: i;
+		for(std::size_t j = begin; j < end; ++j){
+			sum -= row[std::ptrdiff_t(j) * stride2] * x[std::ptrdiff_t(j) * incx];
+		}
+		x[std::ptrdiff_t(i) * incx] = Triangular::is_unit? sum: sum / row[std::ptrdiff_t(i) * stride2];
+	}
+}
+
+//x = A^-1 x for a packed triangular matrix of size n.
+//Rows of row major storage are reduced with the solved part of x, the solved elements are subtracted
+//from x column by column for column major storage.
+template<class Packed, class TA, class T>
+void packed_trsv(std::size_t n, TA const* A, T* x, std::ptrdiff_t incx){
+	typedef packed_lines<Packed> lines;
+	typedef typename Packed::triangular_type Triangular;
+	bool rows = boost::is_same<typename Packed::orientation, row_major>::value;
+	for(std::size_t step = 0; step != n; ++step){
+		std::size_t k = Triangular::is_upper? n - 1 - step: step;
+		TA const* line = A + lines::offset(k, n);
+		std::size_t end = lines::end(k, n);
+		T& xk = x[std::ptrdiff_t(k) * incx];
+		if(rows){
+			T sum = xk;
+			for(std::size_t l = lines::begin(k); l != k; ++l){
+				sum -= line[l] * x[std::ptrdiff_t(l) * incx];
+			}
+			for(std::size_t l = k + 1; l < end; ++l){
+				sum -= line[l] * x[std::ptrdiff_t(l) * incx];
+			}
+			xk = Triangular::is_unit? sum: sum / line[k];
+		}else{
+			if(!Triangular::is_unit)
+				xk /= line[k];
+			T value = xk;
+			for(std::size_t l = lines::begin(k); l != k; ++l){
+				x[std::ptrdiff_t(l) * incx] -= line[l] * value;
+			}
+			for(std::size_t l = k + 1; l < end; ++l){
+				x[std::ptrdiff_t(l) * incx] -= line[l] * value;
+			}
+		}
+	}
+}
+
+//dense triangular matrices are processed in blocks of rows in the order of the substitution. The solved part of x
+//is subtracted from the block of x by gemv, then the block on the diagonal is solved by trsv_block.
+template<class MatA, class V>
+void trsv_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	dense_tag
+){
+	typedef typename MatA::triangular_type Triangular;
+	typedef typename V::value_type value_type;
+	std::size_t n = A().size1();
+	std::size_t block = std::max<std::size_t>(1, kernels::tuning().triangular_block_size);
+	typename MatA::value_type const* a = traits::storage(A().expression());
+	std::ptrdiff_t stride1 = traits::stride1(A().expression());
+	std::ptrdiff_t stride2 = traits::stride2(A().expression());
+	value_type* px = traits::storage(x);
+	std::ptrdiff_t incx = traits::stride(x);
+	for(std::size_t step = 0; step < n; step += block){
+		std::size_t start = Triangular::is_upper? n - std::min(n, step + block): step;
+		std::size_t end = Triangular::is_upper? n - step: std::min(n, step + block);
+		//the solved elements are right of the block for upper and left of the block for lower matrices
+		std::size_t first = Triangular::is_upper? end: 0;
+		std::size_t last = Triangular::is_upper? n: start;
+		gemv_strided(
+			end - start, last - first, value_type(-1),
+			a + std::ptrdiff_t(start) * stride1 + std::ptrdiff_t(first) * stride2, stride1, stride2,
+			px + std::ptrdiff_t(first) * incx, incx,
+			value_type(1), px + std::ptrdiff_t(start) * incx, incx
+		);
+		trsv_block<Triangular>(
+			end - start, a + std::ptrdiff_t(start) * (stride1 + stride2), stride1, stride2,
+			px + std::ptrdiff_t(start) * incx, incx
+		);
+	}
+}
+
+template<class MatA, class V>
+void trsv_impl(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	packed_tag
+){
+	typedef typename MatA::orientation orientation;
+	packed_trsv<orientation>(A().size1(), traits::storage(A), traits::storage(x), traits::stride(x));
+}
+
+// x = A^-1 * x
+template<class MatA, class V>
+void trsv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x,
+	boost::mpl::false_
+){
+	trsv_impl(A, x, typename MatA::storage_category());
+}
+
+}}
+
+#endif
@@ -0,0 +1,157 @@
+/*!
+ * 
+ *
+ * \brief       Default implementation of the dense vector assignment kernels
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_DEFAULT_VECTOR_ASSIGN_HPP
+#define ABLAS_KERNELS_DEFAULT_VECTOR_ASSIGN_HPP
+
+#include "../../detail/functional.hpp"
+#include "../../expression_types.hpp"
+#include "../traits.hpp"
+#include "convert.hpp"
+#include "elementwise_math.hpp"
+#include <boost/mpl/bool.hpp>
+
+namespace aBLAS {namespace bindings{
+
+// v = f(v,t) elementwise for the elements start,...,end-1
+template<template <class T1, class T2> class F, class V>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	typename V::value_type t,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_
+){
+	typedef F<typename V::iterator::reference, typename V::value_type> Function;
+	Function f(typename V::value_type(1));
+	typedef typename V::iterator iterator;
+	iterator end_v = v().begin() + end;
+	for (iterator it = v().begin() + start; it != end_v; ++it){
+		f(*it, t);
+	}
+}
+
+// v = f(v,t) elementwise
+template<template <class T1, class T2> class F, class V>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	typename V::value_type t,
+	boost::mpl::false_
+){
+	vector_assign<F>(v, t, 0, v().size(), boost::mpl::false_());
+}
+
+// v = f(v,alpha*e) elementwise for the elements start,...,end-1 of dense v and e
+template<template <class T1, class T2> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_, boost::mpl::false_
+) {
+	F<typename V::reference, typename E::value_type> f(alpha);
+	typename V::iterator end_v = v().begin() + end;
+	typename V::iterator pos_v = v().begin() + start;
+	typename E::const_iterator pos_e = e().begin() + start;
+	for(; pos_v != end_v; ++pos_v,++pos_e){
+		f(*pos_v,*pos_e);
+	}
+}
+
+// v = e converting from or to 16 bit storage. Scaled assignments are computed elementwise
+// so that the result is rounded only once.
+template<template <class T1, class T2> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_, boost::mpl::true_
+) {
+	if(alpha != typename V::value_type(1)){
+		vector_assign<F>(v,e,alpha,start,end,boost::mpl::false_(),boost::mpl::false_());
+		return;
+	}
+	convert(
+		end - start,
+		traits::storage(e) + std::ptrdiff_t(start) * traits::stride(e), traits::stride(e),
+		traits::storage(v) + std::ptrdiff_t(start) * traits::stride(v), traits::stride(v)
+	);
+}
+
+template<template <class T1, class T2> class F, class V, class E, class Conversion>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_, Conversion, boost::mpl::false_
+) {
+	vector_assign<F>(v,e,alpha,start,end,boost::mpl::false_(),Conversion());
+}
+
+// v = f(v,alpha*g(x)) where g is computed by the vectorized implementation
+template<template <class T1, class T2> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_, boost::mpl::false_, boost::mpl::true_
+) {
+	F<typename V::reference, typename E::value_type> f(alpha);
+	apply_vectorized(e().functor(), f, e().expression().begin() + start, v().begin() + start, end - start);
+}
+
+template<template <class T1, class T2> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::false_
+) {
+	typedef typename has_optimized_conversion<F,V,E>::type conversion;
+	typedef typename has_vectorized_function<E>::type vectorized;
+	vector_assign<F>(v,e,alpha,start,end,boost::mpl::false_(),conversion(),vectorized());
+}
+
+// v = f(v,alpha*e) for all elements of dense v and e
+template<template <class T1, class T2> class F, class V, class E>
+void vector_assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const& e,
+	typename V::value_type alpha,
+	boost::mpl::false_
+) {
+	vector_assign<F>(v,e,alpha,0,v().size(),boost::mpl::false_());
+}
+
+}}
+#endif
@@ -30,9 +30,9 @@
 #ifndef ABLAS_KERNELS_DOT_HPP
 #define ABLAS_KERNELS_DOT_HPP
 
-#include "default/dot.hpp"
-
-
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/dot.hpp"
+#else
 // if no bindings are included, we have to provide the default has_optimized_dot
 // otherwise the binding will take care of this
 namespace aBLAS { namespace bindings{
@@ -40,6 +40,10 @@ template<class V1, class V2,class result_type>
 struct  has_optimized_dot
 : public boost::mpl::false_{};
 }}
+#endif
+
+#include "default/dot.hpp"
+#include "tuning.hpp"
 
 namespace aBLAS {namespace kernels{
 	
@@ -52,10 +56,11 @@ void dot(
 ) {
 	ABLAS_SIZE_CHECK(e1().size() == e2().size());
 	
-	bindings::dot(
-		e1, e2,result,
-		typename bindings::has_optimized_dot<E1,E2,result_type>::type()
-	);
+	typedef typename bindings::has_optimized_dot<E1,E2,result_type>::type optimized;
+	if(optimized::value && e1().size() >= tuning().vector_binding_min_size)
+		bindings::dot(e1, e2,result, optimized());
+	else
+		bindings::dot(e1, e2,result, boost::mpl::false_());
 }
 
 }}
@@ -0,0 +1,107 @@
+/*!
+ * 
+ *
+ * \brief       Assignment kernels for fixed size vectors and matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_FIXED_ASSIGN_HPP
+#define ABLAS_KERNELS_FIXED_ASSIGN_HPP
+
+#include "../../detail/unroll.hpp"
+#include "../../detail/structure.hpp"
+#include <boost/type_traits/is_same.hpp>
+#include <cstddef>
+
+namespace aBLAS{
+
+template<class T, std::size_t N>
+class fixed_vector;
+template<class T, std::size_t M, std::size_t N, class Orientation>
+class fixed_matrix;
+template<class V>
+class fixed_vector_closure;
+template<class M>
+class fixed_matrix_closure;
+
+namespace kernels{
+
+//the kernels for fixed size arguments are overloads of the general kernels which
+//are preferred whenever all arguments are fixed size. All loops are unrolled completely.
+
+///\brief Assigns a constant value with functor to all elements of a fixed size vector
+template<template <class T1, class T2> class F, class T, std::size_t N>
+void assign(fixed_vector<T,N>& v, typename fixed_vector<T,N>::value_type t){
+	F<T&, T> f(T(1));
+	detail::unroll<N>::apply([&](std::size_t i){
+		f(v(i),t);
+	});
+}
+
+///\brief Assignment of fixed size vectors with functor, v_i=f(v_i,alpha*e_i)
+template<template <class T1, class T2> class F, class T, class U, std::size_t N>
+void assign(
+	fixed_vector<T,N>& v,
+	fixed_vector<U,N> const& e,
+	typename fixed_vector<T,N>::value_type alpha
+){
+	F<T&, U> f(alpha);
+	detail::unroll<N>::apply([&](std::size_t i){
+		f(v(i),e(i));
+	});
+}
+
+///\brief Assigns a constant value with functor to all elements of a fixed size matrix
+template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class O>
+void assign(fixed_matrix<T,M,N,O>& m, typename fixed_matrix<T,M,N,O>::value_type t){
+	F<T&, T> f(T(1));
+	detail::unroll<M * N>::apply([&](std::size_t k){
+		f(m.storage()[k],t);//the storage is dense, so the order of the elements does not matter
+	});
+}
+
+///\brief Assignment of fixed size matrices with functor, m_ij=f(m_ij,alpha*e_ij)
+///
+/// The elements are traversed in the storage order of m.
+template<template <class T1, class T2> class F, class T, class U, std::size_t M, std::size_t N, class O1, class O2>
+void assign(
+	fixed_matrix<T,M,N,O1>& m,
+	fixed_matrix<U,M,N,O2> const& e,
+	typename fixed_matrix<T,M,N,O1>::value_type alpha
+){
+	F<T&, U> f(alpha);
+	static const std::size_t major_size = boost::is_same<O1,row_major>::value? M : N;
+	static const std::size_t minor_size = boost::is_same<O1,row_major>::value? N : M;
+	detail::unroll<major_size>::apply([&](std::size_t major){
+		detail::unroll<minor_size>::apply([&](std::size_t minor){
+			std::size_t i = O1::index_row(major,minor);
+			std::size_t j = O1::index_col(major,minor);
+			f(m(i,j),e(i,j));
+		});
+	});
+}
+
+}}
+#endif
@@ -0,0 +1,51 @@
+/*!
+ * 
+ *
+ * \brief       Dot product kernel for fixed size vectors
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_FIXED_DOT_HPP
+#define ABLAS_KERNELS_FIXED_DOT_HPP
+
+#include "assign.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Dot-product r=<e1,e2>=sum_i e1_i*e2_i of fixed size vectors.
+template<class T, class U, std::size_t N, class result_type>
+void dot(
+	fixed_vector<T,N> const& e1,
+	fixed_vector<U,N> const& e2,
+	result_type& result
+){
+	result = result_type();
+	detail::unroll<N>::apply([&](std::size_t i){
+		result += e1(i) * e2(i);
+	});
+}
+
+}}
+#endif
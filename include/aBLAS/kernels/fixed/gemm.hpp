@@ -0,0 +1,82 @@
+/*!
+ * 
+ *
+ * \brief       Matrix-matrix product kernel for fixed size matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_FIXED_GEMM_HPP
+#define ABLAS_KERNELS_FIXED_GEMM_HPP
+
+#include "assign.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief GEneral Matrix-Matrix product C=beta*C+alpha*A*B of fixed size matrices.
+///
+/// For beta=0 the previous values of C are not read.
+/// The product is accumulated in a local block which is traversed in the storage order of C, so that the
+/// innermost loop is a vectorizable axpy. All loops are unrolled, thus this is meant for small matrices.
+template<class T, class U, class V, std::size_t M, std::size_t N, std::size_t K, class O1, class O2, class O3>
+void gemm(
+	fixed_matrix<U,M,K,O1> const& A,
+	fixed_matrix<V,K,N,O2> const& B,
+	fixed_matrix<T,M,N,O3>& C,
+	typename fixed_matrix<T,M,N,O3>::value_type alpha,
+	typename fixed_matrix<T,M,N,O3>::value_type beta = T(1)
+){
+	if(boost::is_same<O3,row_major>::value){
+		T result[M][N] = {};
+		detail::unroll<M>::apply([&](std::size_t i){
+			detail::unroll<K>::apply([&](std::size_t k){
+				detail::unroll<N>::apply([&](std::size_t j){
+					result[i][j] += A(i,k) * B(k,j);
+				});
+			});
+		});
+		detail::unroll<M>::apply([&](std::size_t i){
+			detail::unroll<N>::apply([&](std::size_t j){
+				C(i,j) = beta == T()? alpha * result[i][j] : beta * C(i,j) + alpha * result[i][j];
+			});
+		});
+	}else{
+		T result[N][M] = {};
+		detail::unroll<N>::apply([&](std::size_t j){
+			detail::unroll<K>::apply([&](std::size_t k){
+				detail::unroll<M>::apply([&](std::size_t i){
+					result[j][i] += A(i,k) * B(k,j);
+				});
+			});
+		});
+		detail::unroll<N>::apply([&](std::size_t j){
+			detail::unroll<M>::apply([&](std::size_t i){
+				C(i,j) = beta == T()? alpha * result[j][i] : beta * C(i,j) + alpha * result[j][i];
+			});
+		});
+	}
+}
+
+}}
+#endif
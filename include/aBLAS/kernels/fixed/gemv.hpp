@@ -0,0 +1,71 @@
+/*!
+ * 
+ *
+ * \brief       Matrix-vector product kernel for fixed size matrices and vectors
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_FIXED_GEMV_HPP
+#define ABLAS_KERNELS_FIXED_GEMV_HPP
+
+#include "assign.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief GEneral Matrix-Vector product x=beta*x+alpha*A*v of fixed size arguments.
+///
+/// For beta=0 the previous values of x are not read.
+/// The product is accumulated in registers and in the order of the storage of A.
+template<class T, class U, class V, std::size_t M, std::size_t N, class O>
+void gemv(
+	fixed_matrix<U,M,N,O> const& A,
+	fixed_vector<V,N> const& v,
+	fixed_vector<T,M>& x,
+	typename fixed_vector<T,M>::value_type alpha,
+	typename fixed_vector<T,M>::value_type beta = T(1)
+){
+	T result[M] = {};
+	if(boost::is_same<O,row_major>::value){
+		//dot product with every row
+		detail::unroll<M>::apply([&](std::size_t i){
+			detail::unroll<N>::apply([&](std::size_t j){
+				result[i] += A(i,j) * v(j);
+			});
+		});
+	}else{
+		//sum of the columns weighted by v
+		detail::unroll<N>::apply([&](std::size_t j){
+			detail::unroll<M>::apply([&](std::size_t i){
+				result[i] += A(i,j) * v(j);
+			});
+		});
+	}
+	detail::unroll<M>::apply([&](std::size_t i){
+		x(i) = beta == T()? alpha * result[i] : beta * x(i) + alpha * result[i];
+	});
+}
+
+}}
+#endif
@@ -43,31 +43,130 @@ struct  has_optimized_gemm
 #endif
 
 #include "default/gemm.hpp"
+#include "tuning.hpp"
+#include <algorithm>
+#include <vector>
 
-namespace aBLAS {namespace kernels{
+namespace aBLAS {
+
+///\brief Epilogue of a matrix product which leaves the product unchanged.
+///
+/// Epilogues are applied to the elements of a product inside of the gemm kernel, see kernels::gemm.
+/// Further epilogues are created by add_to_rows(), add_to_columns() and transform_elements() on prod().
+struct identity_epilogue{
+	template<class T>
+	T operator()(std::size_t /*i*/, std::size_t /*j*/, T value)const{
+		return value;
+	}
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return std::vector<scheduling::dependency_node*>();
+	}
+};
+
+namespace kernels{
 	
-///\brief Well known GEneral Matrix-Matrix product kernel M+=alpha*E1*E2.
+///\brief Well known GEneral Matrix-Matrix product kernel M=beta*M+alpha*E1*E2.
 ///
+/// For beta=0 the previous values of M are not read, so M may be uninitialized.
 /// If bindings are included and the matrix combination allow for a specific binding
 /// to be applied, the binding is called automatically from {binding}/gemm.h
 /// otherwise default/gemm.h is used which is fully implemented for all dense/sparse combinations.
 /// if a combination is optimized, bindings::has_optimized_gemm<M,E1,E2>::type evaluates to boost::mpl::true_
+/// Products with m*n*k below tuning().gemm_binding_min_size_for(m,n,k) are computed by the default kernel anyway.
 /// The kernels themselves are implemented in blas::bindings::gemm.
 template<class M, class E1, class E2>
 void gemm(
 	matrix_expression<E1,cpu_tag> const& e1,
 	matrix_expression<E2,cpu_tag> const& e2,
 	matrix_expression<M,cpu_tag>& m,
-	typename M::value_type alpha
+	typename M::value_type alpha,
+	typename M::value_type beta = typename M::value_type(1)
 ) {
 	ABLAS_SIZE_CHECK(m().size1() == e1().size1());
 	ABLAS_SIZE_CHECK(m().size2() == e2().size2());
 	ABLAS_SIZE_CHECK(e1().size2() == e2().size1());
 	
-	bindings::gemm(
-		e1, e2, m,alpha,
-		typename bindings::has_optimized_gemm<M,E1,E2>::type()
+	typedef typename bindings::has_optimized_gemm<M,E1,E2>::type optimized;
+	std::size_t size = m().size1() * m().size2() * e1().size2();
+	if(optimized::value && size >= tuning().gemm_binding_min_size_for(m().size1(), m().size2(), e1().size2()))
+		bindings::gemm(e1, e2, m,alpha,beta, optimized());
+	else
+		bindings::gemm(e1, e2, m,alpha,beta, boost::mpl::false_());
+}
+
+///\brief Computes M=beta*M+alpha*f(E1*E2) for an epilogue f.
+///
+/// The epilogue maps each element of the product to its final value, value = f(i,j,value),
+/// where i and j are the row and column of the element, see identity_epilogue.
+/// The result is computed in tiles of tuning().gemm_epilogue_tile_size rows and columns and the epilogue
+/// is applied to each tile directly after its product is computed, while the tile is still in cache.
+/// This saves the additional passes over M for e.g. adding a bias and computing an activation function.
+template<class M, class E1, class E2, class Epilogue>
+void gemm(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	Epilogue const& epilogue
+) {
+	ABLAS_SIZE_CHECK(m().size1() == e1().size1());
+	ABLAS_SIZE_CHECK(m().size2() == e2().size2());
+	ABLAS_SIZE_CHECK(e1().size2() == e2().size1());
+	typedef typename M::value_type value_type;
+	typedef typename M::orientation orientation;
+	typedef typename matrix_temporary<M>::type TileStorage;
+
+	std::size_t tile_size = std::max<std::size_t>(1, tuning().gemm_epilogue_tile_size);
+	std::size_t size1 = m().size1();
+	std::size_t size2 = m().size2();
+	//for beta!=0 the product is computed in a temporary and then added to the tile of m
+	bool overwrite = beta == value_type();
+	TileStorage tile_storage(
+		overwrite? 0: std::min(tile_size,size1), overwrite? 0: std::min(tile_size,size2), uninitialized_tag()
 	);
+	for(std::size_t i = 0; i < size1; i += tile_size){
+		for(std::size_t j = 0; j < size2; j += tile_size){
+			std::size_t tile_size1 = std::min(tile_size, size1 - i);
+			std::size_t tile_size2 = std::min(tile_size, size2 - j);
+			matrix_range<M> m_tile = subrange(m, i, i + tile_size1, j, j + tile_size2);
+			//calls f(row,col) for the elements of the tile in the storage order of m
+			auto for_each_element = [&](auto f){
+				std::size_t size_M = orientation::index_M(tile_size1, tile_size2);
+				std::size_t size_m = orientation::index_m(tile_size1, tile_size2);
+				for(std::size_t k = 0; k != size_M; ++k){
+					for(std::size_t l = 0; l != size_m; ++l){
+						f(orientation::index_row(k,l), orientation::index_col(k,l));
+					}
+				}
+			};
+			if(overwrite){
+				gemm(rows(e1, i, i + tile_size1), columns(e2, j, j + tile_size2), m_tile, value_type(1), value_type());
+				for_each_element([&](std::size_t row, std::size_t col){
+					m_tile(row,col) = alpha * epilogue(i + row, j + col, value_type(m_tile(row,col)));
+				});
+			}else{
+				matrix_range<TileStorage> product = subrange(tile_storage, 0, tile_size1, 0, tile_size2);
+				gemm(rows(e1, i, i + tile_size1), columns(e2, j, j + tile_size2), product, value_type(1), value_type());
+				for_each_element([&](std::size_t row, std::size_t col){
+					m_tile(row,col) = beta * m_tile(row,col) + alpha * epilogue(i + row, j + col, value_type(product(row,col)));
+				});
+			}
+		}
+	}
+}
+
+///\brief gemm without an epilogue is computed by the kernels of the product.
+template<class M, class E1, class E2>
+void gemm(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	identity_epilogue const&
+) {
+	gemm(e1, e2, m, alpha, beta);
 }
 
 }}
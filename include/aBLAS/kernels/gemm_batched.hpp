@@ -0,0 +1,76 @@
+/*!
+ * 
+ *
+ * \brief       Dispatcher for the batched GEMM routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_GEMM_BATCHED_HPP
+#define ABLAS_KERNELS_GEMM_BATCHED_HPP
+
+#include "gemm.hpp"
+#include "default/gemm_batched.hpp"
+
+#include <boost/type_traits/decay.hpp>
+#include <cstddef>
+
+namespace aBLAS {namespace kernels{
+
+///\brief Batched GEneral Matrix-Matrix product C[k]=beta*C[k]+alpha*A[k]*B[k] for k=start,...,end-1.
+///
+/// A, B and C are sequences of matrices which are accessed via operator[], e.g. closures of matrix_stack
+/// or std::vector of matrix closures. All matrices of a sequence must have the same type.
+/// For beta=0 the previous values of C are not read, so C may be uninitialized.
+/// If bindings are included and the matrix combination allow for a specific binding
+/// to be applied, every product of the batch is computed by the binding, unless the products are smaller
+/// than tuning().gemm_binding_min_size_for(m,n,k). The shape of the first product is taken for the whole batch.
+/// Otherwise default/gemm_batched.hpp is used, which computes small dense products with a register blocked kernel
+/// which shares its packing buffers across the batch.
+template<class StackA, class StackB, class StackC, class T>
+void gemm_batched(
+	StackA const& A,
+	StackB const& B,
+	StackC& C,
+	T alpha, T beta,
+	std::size_t start, std::size_t end
+){
+	typedef typename boost::decay<decltype(A[0])>::type MatA;
+	typedef typename boost::decay<decltype(B[0])>::type MatB;
+	typedef typename boost::decay<decltype(C[0])>::type MatC;
+	
+	typedef typename bindings::has_optimized_gemm<MatC,MatA,MatB>::type optimized;
+	if(start == end)
+		return;
+	std::size_t m = A[start].size1();
+	std::size_t n = B[start].size2();
+	std::size_t k = A[start].size2();
+	if(optimized::value && m * n * k >= tuning().gemm_binding_min_size_for(m, n, k))
+		bindings::gemm_batched(A, B, C, alpha, beta, start, end, optimized());
+	else
+		bindings::gemm_batched(A, B, C, alpha, beta, start, end, boost::mpl::false_());
+}
+
+}}
+#endif
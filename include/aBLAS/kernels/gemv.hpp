@@ -43,30 +43,54 @@ struct  has_optimized_gemv
 #endif
 
 #include "default/gemv.hpp"
+#include "tuning.hpp"
 	
 namespace aBLAS {namespace kernels{
 	
-///\brief Well known GEneral Matrix-Vector product kernel M+=alpha*E1*e2.
+///\brief Well known GEneral Matrix-Vector product kernel M=beta*M+alpha*E1*e2.
 ///
+/// For beta=0 the previous values of M are not read, so M may be uninitialized.
 /// If bindings are included and the matrix/vector combination allows for a specific binding
 /// to be applied, the binding is called automatically from {binding}/gemv.h
 /// otherwise default/gemv.h is used which is fully implemented for all dense/sparse combinations.
 /// if a combination is optimized, bindings::has_optimized_gemv<M,E1,E2>::type evaluates to boost::mpl::true_
+/// Products with m*n below tuning().gemv_binding_min_size_for(m,n) are computed by the default kernel anyway.
 /// The kernels themselves are implemented in blas::bindings::gemv.
 template<class M, class E1, class E2>
 void gemv(
 	matrix_expression<E1,cpu_tag> const& e1,
 	vector_expression<E2,cpu_tag> const& e2,
 	vector_expression<M,cpu_tag>& m,
-	typename M::value_type alpha
+	typename M::value_type alpha,
+	typename M::value_type beta = typename M::value_type(1)
 ) {
 	ABLAS_SIZE_CHECK(m().size() == e1().size1());
 	ABLAS_SIZE_CHECK(e1().size2() == e2().size());
 	
-	bindings::gemv(
-		e1, e2, m,alpha,
-		typename bindings::has_optimized_gemv<M,E1,E2>::type()
-	);
+	typedef typename bindings::has_optimized_gemv<M,E1,E2>::type optimized;
+	if(optimized::value && e1().size1() * e1().size2() >= tuning().gemv_binding_min_size_for(e1().size1(), e1().size2()))
+		bindings::gemv(e1, e2, m,alpha,beta, optimized());
+	else
+		bindings::gemv(e1, e2, m,alpha,beta, boost::mpl::false_());
+}
+
+///\brief Computes the elements start,...,end-1 of M=beta*M+alpha*E1*e2 using the default kernel.
+///
+/// The remaining elements of M are not touched, so that disjoint ranges of rows can be computed in parallel.
+template<class M, class E1, class E2>
+void gemv(
+	matrix_expression<E1,cpu_tag> const& e1,
+	vector_expression<E2,cpu_tag> const& e2,
+	vector_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta,
+	std::size_t start, std::size_t end
+) {
+	ABLAS_SIZE_CHECK(m().size() == e1().size1());
+	ABLAS_SIZE_CHECK(e1().size2() == e2().size());
+	ABLAS_SIZE_CHECK(start <= end && end <= m().size());
+	
+	bindings::gemv(e1, e2, m, alpha, beta, start, end);
 }
 
 }}
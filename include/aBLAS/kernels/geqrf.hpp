@@ -0,0 +1,115 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       QR decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_GEQRF_HPP
+#define ABLAS_KERNELS_GEQRF_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#ifdef ABLAS_USE_LAPACK
+#include "lapack/geqrf.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_geqrf
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class VecTau>
+struct  has_optimized_geqrf
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/geqrf.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known GEneral QR Factorization kernel, the decomposition A=QR by Householder reflections.
+///
+/// A is a dense m x n matrix. R is stored on and above the diagonal of A. Q = H_0 H_1 ... H_{k-1}, k=min(m,n), is a product of
+/// reflections H_j = I - tau(j) v_j v_j^T, where v_j is zero above element j, one at element j and stored below the diagonal
+/// in column j of A. tau has k elements. This is the storage used by LAPACK.
+/// If LAPACK bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from lapack/geqrf.hpp
+/// otherwise default/geqrf.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_geqrf<MatA,VecTau>::type evaluates to boost::mpl::true_
+/// Matrices with m*n*min(m,n) below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class VecTau>
+void geqrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecTau,cpu_tag>& tau
+){
+	ABLAS_SIZE_CHECK(tau().size() == std::min(A().size1(), A().size2()));
+	
+	typedef typename bindings::has_optimized_geqrf<MatA,VecTau>::type optimized;
+	std::size_t size = A().size1() * A().size2() * tau().size();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		bindings::geqrf(A, tau, optimized());
+	else
+		bindings::geqrf(A, tau, boost::mpl::false_());
+}
+
+///\brief Computes the triangular factor T of a block of k Householder reflections, H_0 H_1 ... H_{k-1} = I - V T V^T.
+///
+/// V is an m x k matrix, m>=k, storing the reflections in the format of geqrf: the elements above the diagonal are not read
+/// and the diagonal is assumed to be 1. T is k x k and upper triangular, its lower triangle is cleared.
+template<class MatV, class VecTau, class MatT>
+void larft(
+	matrix_expression<MatV,cpu_tag> const& V,
+	vector_expression<VecTau,cpu_tag> const& tau,
+	matrix_expression<MatT,cpu_tag>& T
+){
+	ABLAS_SIZE_CHECK(V().size1() >= V().size2());
+	ABLAS_SIZE_CHECK(tau().size() == V().size2());
+	ABLAS_SIZE_CHECK(T().size1() == V().size2());
+	ABLAS_SIZE_CHECK(T().size2() == V().size2());
+	bindings::larft(V, tau, T, boost::mpl::false_());
+}
+
+///\brief Applies the transpose of a block of Householder reflections to C, C = (I - V T V^T)^T C.
+///
+/// V and T are the reflections and the triangular factor computed by larft. This is Q^T C for the Q of geqrf
+/// when V holds all reflections.
+template<class MatV, class MatT, class MatC>
+void larfb(
+	matrix_expression<MatV,cpu_tag> const& V,
+	matrix_expression<MatT,cpu_tag> const& T,
+	matrix_expression<MatC,cpu_tag>& C
+){
+	ABLAS_SIZE_CHECK(V().size1() >= V().size2());
+	ABLAS_SIZE_CHECK(T().size1() == V().size2());
+	ABLAS_SIZE_CHECK(T().size2() == V().size2());
+	ABLAS_SIZE_CHECK(C().size1() == V().size1());
+	bindings::larfb(V, T, C, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+ * 
+ *
+ * \brief       Dispatcher for the GER routine
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_GER_HPP
+#define ABLAS_KERNELS_GER_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/ger.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_ger
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class M, class E1, class E2>
+struct  has_optimized_ger
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/ger.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known rank-1 update kernel m+=alpha*e1*e2^T.
+///
+/// If bindings are included and the matrix/vector combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/ger.hpp
+/// otherwise default/ger.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_ger<M,E1,E2>::type evaluates to boost::mpl::true_
+/// The kernels themselves are implemented in bindings::ger.
+template<class M, class E1, class E2>
+void ger(
+	vector_expression<E1,cpu_tag> const& e1,
+	vector_expression<E2,cpu_tag> const& e2,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha
+) {
+	ABLAS_SIZE_CHECK(m().size1() == e1().size());
+	ABLAS_SIZE_CHECK(m().size2() == e2().size());
+
+	bindings::ger(
+		e1, e2, m, alpha,
+		typename bindings::has_optimized_ger<M,E1,E2>::type()
+	);
+}
+
+}}
+#endif
@@ -0,0 +1,88 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Singular value decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_GESDD_HPP
+#define ABLAS_KERNELS_GESDD_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#ifdef ABLAS_USE_LAPACK
+#include "lapack/gesdd.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_gesdd
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class VecS, class MatU, class MatV>
+struct  has_optimized_gesdd
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/gesdd.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known GEneral Singular value Decomposition kernel (Divide and conquer in LAPACK), the thin decomposition A = U diag(s) VT.
+///
+/// A is a dense m x n matrix, k=min(m,n). U is m x k and VT is k x n, both with orthonormal rows or columns,
+/// and the k singular values are stored in s in descending order. The contents of A are destroyed.
+/// Returns 0 on success, otherwise the algorithm did not converge and the results are not accurate.
+/// If LAPACK bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from lapack/gesdd.hpp
+/// otherwise default/gesdd.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_gesdd<MatA,VecS,MatU,MatV>::type evaluates to boost::mpl::true_
+/// Matrices with m*n*k below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class VecS, class MatU, class MatV>
+std::size_t gesdd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecS,cpu_tag>& s,
+	matrix_expression<MatU,cpu_tag>& U,
+	matrix_expression<MatV,cpu_tag>& VT
+){
+	std::size_t k = std::min(A().size1(), A().size2());
+	ABLAS_SIZE_CHECK(s().size() == k);
+	ABLAS_SIZE_CHECK(U().size1() == A().size1());
+	ABLAS_SIZE_CHECK(U().size2() == k);
+	ABLAS_SIZE_CHECK(VT().size1() == k);
+	ABLAS_SIZE_CHECK(VT().size2() == A().size2());
+	
+	typedef typename bindings::has_optimized_gesdd<MatA,VecS,MatU,MatV>::type optimized;
+	std::size_t size = A().size1() * A().size2() * k;
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		return bindings::gesdd(A, s, U, VT, optimized());
+	else
+		return bindings::gesdd(A, s, U, VT, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,104 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LU decomposition kernel with partial pivoting
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_GETRF_HPP
+#define ABLAS_KERNELS_GETRF_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#ifdef ABLAS_USE_LAPACK
+#include "lapack/getrf.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_getrf
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class VecP>
+struct  has_optimized_getrf
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/getrf.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known GEneral TRiangular Factorization kernel, the LU decomposition PA=LU with partial pivoting.
+///
+/// A is a dense m x n matrix and is overwritten by L and U, where L is unit lower triangular (trapezoidal if m>n)
+/// and stored below the diagonal and U is upper triangular (trapezoidal if m<n).
+/// P has min(m,n) elements and stores the row interchanges: row i was swapped with row P(i) for i=0,1,...
+/// in this order, see laswp.
+/// Returns 0 if U is nonsingular, otherwise j+1 for the first zero pivot j. The decomposition is completed anyway.
+/// If LAPACK bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from lapack/getrf.hpp
+/// otherwise default/getrf.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_getrf<MatA,VecP>::type evaluates to boost::mpl::true_
+/// Matrices with m*n*min(m,n) below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class VecP>
+std::size_t getrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecP,cpu_tag>& P
+){
+	ABLAS_SIZE_CHECK(P().size() == std::min(A().size1(), A().size2()));
+	
+	typedef typename bindings::has_optimized_getrf<MatA,VecP>::type optimized;
+	std::size_t size = A().size1() * A().size2() * P().size();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		return bindings::getrf(A, P, optimized());
+	else
+		return bindings::getrf(A, P, boost::mpl::false_());
+}
+
+///\brief Applies the row interchanges P(start),...,P(end-1) of getrf to A: row i is swapped with row P(i) for i=start,...,end-1.
+template<class VecP, class MatA>
+void laswp(
+	vector_expression<VecP,cpu_tag> const& P,
+	matrix_expression<MatA,cpu_tag>& A,
+	std::size_t start, std::size_t end
+){
+	ABLAS_RANGE_CHECK(start <= end);
+	ABLAS_RANGE_CHECK(end <= P().size());
+	bindings::laswp(P, A, start, end, boost::mpl::false_());
+}
+
+///\brief Applies all row interchanges P of getrf to A, i.e. computes PA.
+template<class VecP, class MatA>
+void laswp(
+	vector_expression<VecP,cpu_tag> const& P,
+	matrix_expression<MatA,cpu_tag>& A
+){
+	laswp(P, A, 0, P().size());
+}
+
+}}
+
+#endif
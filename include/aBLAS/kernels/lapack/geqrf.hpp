@@ -0,0 +1,87 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LAPACK binding of the QR decomposition
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_GEQRF_HPP
+#define ABLAS_KERNELS_LAPACK_GEQRF_HPP
+
+#include "lapack_inc.hpp"
+#include "../default/geqrf.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline lapack_int geqrf(lapack_int m, lapack_int n, float* A, lapack_int lda, float* tau, float* work, lapack_int lwork){
+	lapack_int info = 0;
+	sgeqrf_(&m, &n, A, &lda, tau, work, &lwork, &info);
+	return info;
+}
+
+inline lapack_int geqrf(lapack_int m, lapack_int n, double* A, lapack_int lda, double* tau, double* work, lapack_int lwork){
+	lapack_int info = 0;
+	dgeqrf_(&m, &n, A, &lda, tau, work, &lwork, &info);
+	return info;
+}
+
+// A = QR
+//
+// The size of the workspace is queried first. Only column major matrices are bound: the decomposition
+// of the transpose is the LQ decomposition of A.
+template<class MatA, class VecTau>
+void geqrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecTau,cpu_tag>& tau,
+	boost::mpl::true_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t m = A().size1();
+	std::size_t n = A().size2();
+	if(m == 0 || n == 0 || !lapack_fits(m) || !lapack_fits(n) || !lapack_fits(traits::leading_dimension(A))){
+		geqrf(A, tau, boost::mpl::false_());
+		return;
+	}
+	lapack_int lda = (lapack_int)traits::leading_dimension(A);
+	std::vector<value_type> taus(std::min(m, n));
+	value_type work_size = 0;
+	geqrf((lapack_int)m, (lapack_int)n, traits::storage(A), lda, taus.data(), &work_size, -1);
+	std::vector<value_type> work(std::max<std::size_t>(1, std::size_t(work_size)));
+	geqrf((lapack_int)m, (lapack_int)n, traits::storage(A), lda, taus.data(), work.data(), (lapack_int)work.size());
+	for(std::size_t i = 0; i != taus.size(); ++i){
+		tau()(i) = taus[i];
+	}
+}
+
+template<class MatA, class VecTau>
+struct has_optimized_geqrf: public boost::mpl::and_<
+	lapack_dense_matrix<MatA, true>,
+	boost::is_same<typename MatA::value_type, typename VecTau::value_type>
+>{};
+
+}}
+#endif
@@ -0,0 +1,128 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LAPACK binding of the singular value decomposition
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_GESDD_HPP
+#define ABLAS_KERNELS_LAPACK_GESDD_HPP
+
+#include "lapack_inc.hpp"
+#include "../default/gesdd.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline lapack_int gesdd(
+	lapack_int m, lapack_int n, float* A, lapack_int lda, float* s,
+	float* U, lapack_int ldu, float* VT, lapack_int ldvt,
+	float* work, lapack_int lwork, lapack_int* iwork
+){
+	char jobz = 'S';
+	lapack_int info = 0;
+	sgesdd_(&jobz, &m, &n, A, &lda, s, U, &ldu, VT, &ldvt, work, &lwork, iwork, &info, 1);
+	return info;
+}
+
+inline lapack_int gesdd(
+	lapack_int m, lapack_int n, double* A, lapack_int lda, double* s,
+	double* U, lapack_int ldu, double* VT, lapack_int ldvt,
+	double* work, lapack_int lwork, lapack_int* iwork
+){
+	char jobz = 'S';
+	lapack_int info = 0;
+	dgesdd_(&jobz, &m, &n, A, &lda, s, U, &ldu, VT, &ldvt, work, &lwork, iwork, &info, 1);
+	return info;
+}
+
+// A = U diag(s) VT
+//
+// The column major storage of row major matrices is their transpose. In this case the decomposition
+// A^T = V diag(s) U^T is computed, where V is stored in VT and U^T in U.
+template<class MatA, class VecS, class MatU, class MatV>
+std::size_t gesdd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecS,cpu_tag>& s,
+	matrix_expression<MatU,cpu_tag>& U,
+	matrix_expression<MatV,cpu_tag>& VT,
+	boost::mpl::true_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t m = A().size1();
+	std::size_t n = A().size2();
+	std::size_t k = std::min(m, n);
+	if(
+		k == 0 || !lapack_fits(m) || !lapack_fits(n) || !lapack_fits(8 * k)
+		|| !lapack_fits(traits::leading_dimension(A))
+		|| !lapack_fits(traits::leading_dimension(U))
+		|| !lapack_fits(traits::leading_dimension(VT))
+	)
+		return gesdd(A, s, U, VT, boost::mpl::false_());
+	
+	bool transposed = boost::is_same<typename MatA::orientation, row_major>::value;
+	lapack_int rows = (lapack_int)(transposed? n: m);
+	lapack_int columns = (lapack_int)(transposed? m: n);
+	value_type* left = transposed? traits::storage(VT): traits::storage(U);
+	value_type* right = transposed? traits::storage(U): traits::storage(VT);
+	lapack_int ld_left = (lapack_int)(transposed? traits::leading_dimension(VT): traits::leading_dimension(U));
+	lapack_int ld_right = (lapack_int)(transposed? traits::leading_dimension(U): traits::leading_dimension(VT));
+	lapack_int lda = (lapack_int)traits::leading_dimension(A);
+	
+	std::vector<value_type> values(k);
+	std::vector<lapack_int> iwork(8 * k);
+	value_type work_size = 0;
+	gesdd(rows, columns, traits::storage(A), lda, values.data(), left, ld_left, right, ld_right, &work_size, -1, iwork.data());
+	std::vector<value_type> work(std::max<std::size_t>(1, std::size_t(work_size)));
+	lapack_int info = gesdd(
+		rows, columns, traits::storage(A), lda, values.data(),
+		left, ld_left, right, ld_right, work.data(), (lapack_int)work.size(), iwork.data()
+	);
+	for(std::size_t i = 0; i != k; ++i){
+		s()(i) = values[i];
+	}
+	return std::size_t(info);
+}
+
+//all matrices must have the same orientation
+template<class MatA, class VecS, class MatU, class MatV>
+struct has_optimized_gesdd: public boost::mpl::and_<
+	lapack_dense_matrix<MatA>,
+	lapack_dense_matrix<MatU>,
+	lapack_dense_matrix<MatV>,
+	boost::mpl::and_<
+		boost::is_same<typename MatA::orientation, typename MatU::orientation>,
+		boost::is_same<typename MatA::orientation, typename MatV::orientation>
+	>,
+	boost::mpl::and_<
+		boost::is_same<typename MatA::value_type, typename VecS::value_type>,
+		boost::is_same<typename MatA::value_type, typename MatU::value_type>,
+		boost::is_same<typename MatA::value_type, typename MatV::value_type>
+	>
+>{};
+
+}}
+#endif
@@ -0,0 +1,80 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LAPACK binding of the LU decomposition
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_GETRF_HPP
+#define ABLAS_KERNELS_LAPACK_GETRF_HPP
+
+#include "lapack_inc.hpp"
+#include "../default/getrf.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline lapack_int getrf(lapack_int m, lapack_int n, float* A, lapack_int lda, lapack_int* ipiv){
+	lapack_int info = 0;
+	sgetrf_(&m, &n, A, &lda, ipiv, &info);
+	return info;
+}
+
+inline lapack_int getrf(lapack_int m, lapack_int n, double* A, lapack_int lda, lapack_int* ipiv){
+	lapack_int info = 0;
+	dgetrf_(&m, &n, A, &lda, ipiv, &info);
+	return info;
+}
+
+// PA = LU
+//
+// The pivots of LAPACK start at 1. Only column major matrices are bound: the decomposition of the transpose
+// would pivot the columns of A.
+template<class MatA, class VecP>
+std::size_t getrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecP,cpu_tag>& P,
+	boost::mpl::true_
+){
+	std::size_t m = A().size1();
+	std::size_t n = A().size2();
+	if(m == 0 || n == 0 || !lapack_fits(m) || !lapack_fits(n) || !lapack_fits(traits::leading_dimension(A)))
+		return getrf(A, P, boost::mpl::false_());
+	std::vector<lapack_int> pivots(std::min(m, n));
+	lapack_int info = getrf(
+		(lapack_int)m, (lapack_int)n, traits::storage(A), (lapack_int)traits::leading_dimension(A), pivots.data()
+	);
+	for(std::size_t i = 0; i != pivots.size(); ++i){
+		P()(i) = std::size_t(pivots[i] - 1);
+	}
+	return std::size_t(info);
+}
+
+template<class MatA, class VecP>
+struct has_optimized_getrf: public lapack_dense_matrix<MatA, true>{};
+
+}}
+#endif
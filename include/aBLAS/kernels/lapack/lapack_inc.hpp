@@ -0,0 +1,113 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Declarations of the LAPACK routines used by the bindings
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_LAPACK_INC_HPP
+#define ABLAS_KERNELS_LAPACK_LAPACK_INC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include "../traits.hpp"
+
+namespace aBLAS {
+namespace bindings {
+
+///\brief Integer type of the sizes and leading dimensions passed to LAPACK.
+///
+/// With ABLAS_LAPACK_ILP64 defined a 64 bit integer is used, which requires a LAPACK built with 64 bit integers.
+#ifdef ABLAS_LAPACK_ILP64
+typedef std::int64_t lapack_int;
+#else
+typedef int lapack_int;
+#endif
+
+///\brief Returns true if a size or leading dimension can be passed to LAPACK.
+///
+/// Decompositions can not be split, larger arguments are computed by the default kernels.
+inline bool lapack_fits(std::size_t value){
+	return value <= std::size_t(std::numeric_limits<lapack_int>::max());
+}
+
+///\brief True for the value types supported by the bindings, float and double.
+template<class T>
+struct lapack_real_type: public boost::mpl::false_{};
+template<> struct lapack_real_type<float>: public boost::mpl::true_{};
+template<> struct lapack_real_type<double>: public boost::mpl::true_{};
+
+///\brief True for dense matrices of a value type supported by the bindings. Only column major storage is accepted if ColumnMajor is true.
+template<class M, bool ColumnMajor = false>
+struct lapack_dense_matrix: public boost::mpl::and_<
+	boost::is_same<typename M::storage_category, dense_tag>,
+	lapack_real_type<typename M::value_type>,
+	boost::mpl::bool_<!ColumnMajor || boost::is_same<typename M::orientation, column_major>::value>
+>{};
+
+}}
+
+// The routines are called through the Fortran interface, which is provided by every LAPACK, e.g. OpenBLAS, MKL
+// or the reference implementation. All arguments are passed by pointer and matrices are stored column major.
+// Character arguments are followed by their hidden length arguments at the end of the list.
+extern "C" {
+void spotrf_(char const* uplo, aBLAS::bindings::lapack_int const* n, float* A, aBLAS::bindings::lapack_int const* lda,
+	aBLAS::bindings::lapack_int* info, std::size_t uplo_length);
+void dpotrf_(char const* uplo, aBLAS::bindings::lapack_int const* n, double* A, aBLAS::bindings::lapack_int const* lda,
+	aBLAS::bindings::lapack_int* info, std::size_t uplo_length);
+
+void sgetrf_(aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, float* A, aBLAS::bindings::lapack_int const* lda,
+	aBLAS::bindings::lapack_int* ipiv, aBLAS::bindings::lapack_int* info);
+void dgetrf_(aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, double* A, aBLAS::bindings::lapack_int const* lda,
+	aBLAS::bindings::lapack_int* ipiv, aBLAS::bindings::lapack_int* info);
+
+void sgeqrf_(aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, float* A, aBLAS::bindings::lapack_int const* lda,
+	float* tau, float* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* info);
+void dgeqrf_(aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, double* A, aBLAS::bindings::lapack_int const* lda,
+	double* tau, double* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* info);
+
+void ssyevd_(char const* jobz, char const* uplo, aBLAS::bindings::lapack_int const* n, float* A, aBLAS::bindings::lapack_int const* lda,
+	float* w, float* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* iwork, aBLAS::bindings::lapack_int const* liwork,
+	aBLAS::bindings::lapack_int* info, std::size_t jobz_length, std::size_t uplo_length);
+void dsyevd_(char const* jobz, char const* uplo, aBLAS::bindings::lapack_int const* n, double* A, aBLAS::bindings::lapack_int const* lda,
+	double* w, double* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* iwork, aBLAS::bindings::lapack_int const* liwork,
+	aBLAS::bindings::lapack_int* info, std::size_t jobz_length, std::size_t uplo_length);
+
+void sgesdd_(char const* jobz, aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, float* A, aBLAS::bindings::lapack_int const* lda,
+	float* s, float* U, aBLAS::bindings::lapack_int const* ldu, float* VT, aBLAS::bindings::lapack_int const* ldvt,
+	float* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* iwork, aBLAS::bindings::lapack_int* info, std::size_t jobz_length);
+void dgesdd_(char const* jobz, aBLAS::bindings::lapack_int const* m, aBLAS::bindings::lapack_int const* n, double* A, aBLAS::bindings::lapack_int const* lda,
+	double* s, double* U, aBLAS::bindings::lapack_int const* ldu, double* VT, aBLAS::bindings::lapack_int const* ldvt,
+	double* work, aBLAS::bindings::lapack_int const* lwork, aBLAS::bindings::lapack_int* iwork, aBLAS::bindings::lapack_int* info, std::size_t jobz_length);
+}
+
+#endif
@@ -0,0 +1,85 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LAPACK binding of the Cholesky decomposition
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_POTRF_HPP
+#define ABLAS_KERNELS_LAPACK_POTRF_HPP
+
+#include "lapack_inc.hpp"
+#include "../default/potrf.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline lapack_int potrf(char uplo, lapack_int n, float* A, lapack_int lda){
+	lapack_int info = 0;
+	spotrf_(&uplo, &n, A, &lda, &info, 1);
+	return info;
+}
+
+inline lapack_int potrf(char uplo, lapack_int n, double* A, lapack_int lda){
+	lapack_int info = 0;
+	dpotrf_(&uplo, &n, A, &lda, &info, 1);
+	return info;
+}
+
+// A = LL^T or A = U^TU
+//
+// Row major storage is the column major storage of the transpose, in which the factor is stored in the other triangle.
+// LAPACK does not change the other triangle, it is cleared afterwards as in the default kernel.
+template<class TriangularType, class MatA>
+std::size_t potrf(
+	matrix_expression<MatA,cpu_tag>& A,
+	boost::mpl::true_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t n = A().size1();
+	if(n == 0 || !lapack_fits(n) || !lapack_fits(traits::leading_dimension(A)))
+		return potrf<TriangularType>(A, boost::mpl::false_());
+	bool transposed = boost::is_same<typename MatA::orientation, row_major>::value;
+	char uplo = (TriangularType::is_upper != transposed)? 'U': 'L';
+	lapack_int info = potrf(uplo, (lapack_int)n, traits::storage(A), (lapack_int)traits::leading_dimension(A));
+	if(info != 0)
+		return std::size_t(info);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = i + 1; j != n; ++j){
+			if(TriangularType::is_upper)
+				A()(j, i) = value_type();
+			else
+				A()(i, j) = value_type();
+		}
+	}
+	return 0;
+}
+
+template<class MatA>
+struct has_optimized_potrf: public lapack_dense_matrix<MatA>{};
+
+}}
+#endif
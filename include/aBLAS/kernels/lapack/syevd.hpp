@@ -0,0 +1,103 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       LAPACK binding of the eigen decomposition of symmetric matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_LAPACK_SYEVD_HPP
+#define ABLAS_KERNELS_LAPACK_SYEVD_HPP
+
+#include "lapack_inc.hpp"
+#include "../matrix_assign.hpp"
+#include "../default/syevd.hpp"
+
+namespace aBLAS { namespace bindings {
+
+inline lapack_int syevd(
+	char uplo, lapack_int n, float* A, lapack_int lda, float* w,
+	float* work, lapack_int lwork, lapack_int* iwork, lapack_int liwork
+){
+	char jobz = 'V';
+	lapack_int info = 0;
+	ssyevd_(&jobz, &uplo, &n, A, &lda, w, work, &lwork, iwork, &liwork, &info, 1, 1);
+	return info;
+}
+
+inline lapack_int syevd(
+	char uplo, lapack_int n, double* A, lapack_int lda, double* w,
+	double* work, lapack_int lwork, lapack_int* iwork, lapack_int liwork
+){
+	char jobz = 'V';
+	lapack_int info = 0;
+	dsyevd_(&jobz, &uplo, &n, A, &lda, w, work, &lwork, iwork, &liwork, &info, 1, 1);
+	return info;
+}
+
+// A = V diag(w) V^T
+//
+// The lower triangle of a row major matrix is the upper triangle of its column major storage. The eigenvectors
+// are stored in the columns of the column major storage, i.e. in the rows of A, and are transposed afterwards.
+template<class MatA, class VecW>
+std::size_t syevd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecW,cpu_tag>& w,
+	boost::mpl::true_
+){
+	typedef typename MatA::value_type value_type;
+	std::size_t n = A().size1();
+	if(n == 0 || !lapack_fits(n) || !lapack_fits(traits::leading_dimension(A)))
+		return syevd(A, w, boost::mpl::false_());
+	bool transposed = boost::is_same<typename MatA::orientation, row_major>::value;
+	char uplo = transposed? 'U': 'L';
+	lapack_int lda = (lapack_int)traits::leading_dimension(A);
+	std::vector<value_type> eigenvalues(n);
+	value_type work_size = 0;
+	lapack_int iwork_size = 0;
+	syevd(uplo, (lapack_int)n, traits::storage(A), lda, eigenvalues.data(), &work_size, -1, &iwork_size, -1);
+	std::vector<value_type> work(std::max<std::size_t>(1, std::size_t(work_size)));
+	std::vector<lapack_int> iwork(std::max<lapack_int>(1, iwork_size));
+	lapack_int info = syevd(
+		uplo, (lapack_int)n, traits::storage(A), lda, eigenvalues.data(),
+		work.data(), (lapack_int)work.size(), iwork.data(), (lapack_int)iwork.size()
+	);
+	if(transposed)
+		kernels::transpose_inplace(A);
+	for(std::size_t i = 0; i != n; ++i){
+		w()(i) = eigenvalues[i];
+	}
+	return std::size_t(info);
+}
+
+template<class MatA, class VecW>
+struct has_optimized_syevd: public boost::mpl::and_<
+	lapack_dense_matrix<MatA>,
+	boost::is_same<typename MatA::value_type, typename VecW::value_type>
+>{};
+
+}}
+#endif
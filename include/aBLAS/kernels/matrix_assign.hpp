@@ -33,6 +33,14 @@
 #define ABLAS_KERNELS_MATRIX_ASSIGN_HPP
 
 #include "../detail/traits.hpp"
+#include "tuning.hpp"
+#include "traits.hpp"
+#include "default/convert.hpp"
+#include "default/elementwise_math.hpp"
+#include "default/transpose.hpp"
+#include "default/stream.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <algorithm>
 namespace aBLAS{
 	
@@ -46,16 +54,74 @@ template<template <class T1, class T2> class F, class M, class Orientation >
 void assign(
 	matrix_expression<M,cpu_tag> &m, 
 	typename M::value_type t, 
+	std::size_t start, std::size_t end,
 	Orientation,
 	dense_random_access_iterator_tag
 ){
-	std::size_t majorSize = Orientation::index_M(m().size1(),m().size2());
 	F<typename M::reference, typename M::value_type> f(typename M::value_type(1));
-	for(std::size_t i = 0; i != majorSize; ++i){
+	for(std::size_t i = start; i != end; ++i){
 		std::for_each(major_begin(m,i),major_end(m,i),[t,&f](typename M::reference& val){f(val,t);});
 	}
 }
 
+//m = t with non-temporal stores for the major lines start,...,end-1 of dense m with unit minor stride,
+//if m is at least tuning().streaming_store_min_size bytes large. Returns false otherwise.
+template<class M>
+bool fill_streaming(
+	matrix_expression<M,cpu_tag> &m, 
+	typename M::value_type t, 
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+){
+	typedef typename M::orientation orientation;
+	if(m().size1() * m().size2() * sizeof(typename M::value_type) < tuning().streaming_store_min_size)
+		return false;
+	if(orientation::index_m(bindings::traits::stride1(m),bindings::traits::stride2(m)) != 1)
+		return false;
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	std::ptrdiff_t ld = bindings::traits::leading_dimension(m);
+	typename M::value_type* storage = bindings::traits::storage(m);
+	if(bindings::traits::is_contiguous(m)){
+		bindings::stream_fill((end - start) * size_m, t, storage + start * size_m);
+		return true;
+	}
+	for(std::size_t i = start; i != end; ++i){
+		bindings::stream_fill(size_m, t, storage + std::ptrdiff_t(i) * ld);
+	}
+	return true;
+}
+template<class M>
+bool fill_streaming(
+	matrix_expression<M,cpu_tag> &, 
+	typename M::value_type, 
+	std::size_t, std::size_t,
+	boost::mpl::false_
+){
+	return false;
+}
+
+///\brief Computes m(i,j)=f(m(i,j),t) for the major lines start,...,end-1 of m.
+///
+/// m=t of large dense matrices uses non-temporal stores, see tuning().streaming_store_min_size.
+template<template <class T1, class T2> class F, class M>
+void assign(
+	matrix_expression<M,cpu_tag> &m, 
+	typename M::value_type t,
+	std::size_t start, std::size_t end
+){
+	typedef typename M::orientation orientation;
+	typedef typename major_iterator<M>::type::iterator_category category;
+	ABLAS_SIZE_CHECK(start <= end && end <= orientation::index_M(m().size1(),m().size2()));
+	typedef typename boost::mpl::and_<
+		boost::is_same<F<int,int>, scalar_assign<int,int> >,
+		boost::is_same<typename M::storage_category, dense_tag>,
+		bindings::streaming_store<typename M::value_type>
+	>::type streaming;
+	if(fill_streaming(m, t, start, end, streaming()))
+		return;
+	assign<F>(m, t, start, end, orientation(),category());
+}
+
 // Dispatcher
 template<template <class T1, class T2> class F, class M>
 void assign(
@@ -63,28 +129,29 @@ void assign(
 	typename M::value_type t
 ){
 	typedef typename M::orientation orientation;
-	typedef typename major_iterator<M>::type::iterator_category category;
-	assign<F>(m, t, orientation(),category());
+	assign<F>(m, t, 0, orientation::index_M(m().size1(),m().size2()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 //////Matrix Assignment With Functor implementing =, +=,-=...
 ///////////////////////////////////////////////////////////////////////////////////////////
 
+// The kernels compute the assignment for the major lines start,...,end-1 of m,
+// that is the rows of a row major m or the columns of a column major m.
+
 template<template <class, class> class F, class M, class E, class Orientation>
-void assign(
+void assign_dense(
 	matrix_expression<M,cpu_tag> &m, 
 	matrix_expression<E,cpu_tag> const& e,
 	typename M::value_type alpha,
-	Orientation, Orientation,
-	dense_random_access_iterator_tag,
-	dense_random_access_iterator_tag
+	std::size_t start, std::size_t end,
+	Orientation,
+	boost::mpl::false_
 ) {
-	std::size_t size_M = Orientation::index_M(m().size1(),m().size2());
 	F<typename M::reference, typename E::value_type> f(alpha);
 	typedef typename major_iterator<M>::type M_iterator;
 	typedef typename major_iterator<E const>::type E_iterator;
-	for(std::size_t i = 0; i != size_M; ++i){
+	for(std::size_t i = start; i != end; ++i){
 		M_iterator end_M = major_end(m,i);
 		M_iterator pos_M =major_begin(m,i);
 		E_iterator pos_E =major_begin(e,i);
@@ -93,29 +160,264 @@ void assign(
 		}
 	}
 }
+//m = e converting from or to 16 bit storage, computed line by line.
+template<template <class, class> class F, class M, class E, class Orientation>
+void assign_dense(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	Orientation,
+	boost::mpl::true_
+) {
+	if(alpha != typename M::value_type(1)){
+		assign_dense<F>(m,e,alpha,start,end,Orientation(),boost::mpl::false_());
+		return;
+	}
+	std::size_t size_m = Orientation::index_m(m().size1(),m().size2());
+	std::ptrdiff_t major_stride_m = Orientation::index_M(m().stride1(),m().stride2());
+	std::ptrdiff_t minor_stride_m = Orientation::index_m(m().stride1(),m().stride2());
+	std::ptrdiff_t major_stride_e = Orientation::index_M(e().stride1(),e().stride2());
+	std::ptrdiff_t minor_stride_e = Orientation::index_m(e().stride1(),e().stride2());
+	auto m_storage = bindings::traits::storage(m);
+	auto e_storage = bindings::traits::storage(e);
+	for(std::size_t i = start; i != end; ++i){
+		bindings::convert(
+			size_m,
+			e_storage + std::ptrdiff_t(i) * major_stride_e, minor_stride_e,
+			m_storage + std::ptrdiff_t(i) * major_stride_m, minor_stride_m
+		);
+	}
+}
+
+template<template <class, class> class F, class M, class E, class Orientation, class Conversion>
+void assign_dense(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	Orientation, Conversion, boost::mpl::false_
+) {
+	assign_dense<F>(m,e,alpha,start,end,Orientation(),Conversion());
+}
+//m = f(m,alpha*g(x)) where g is computed by the vectorized implementation, line by line.
+template<template <class, class> class F, class M, class E, class Orientation>
+void assign_dense(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	Orientation, boost::mpl::false_, boost::mpl::true_
+) {
+	std::size_t size_m = Orientation::index_m(m().size1(),m().size2());
+	F<typename M::reference, typename E::value_type> f(alpha);
+	for(std::size_t i = start; i != end; ++i){
+		bindings::apply_vectorized(
+			e().functor(), f,
+			major_begin(e().expression(),i), major_begin(m,i), size_m
+		);
+	}
+}
+
+//m = f(m,alpha*e) for m and e with contiguous storage, computed by a single loop over the storage
+//instead of line by line. Returns false if the storage of m or e is not contiguous.
+template<template <class, class> class F, class M, class E, class Conversion>
+bool assign_contiguous(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	Conversion, boost::mpl::true_
+) {
+	if(!bindings::traits::is_contiguous(m) || !bindings::traits::is_contiguous(e))
+		return false;
+	typedef typename M::orientation orientation;
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	std::size_t size = (end - start) * size_m;
+	auto m_storage = bindings::traits::storage(m) + start * size_m;
+	auto e_storage = bindings::traits::storage(e) + start * size_m;
+	if(Conversion::value && alpha == typename M::value_type(1)){
+		bindings::convert(size, e_storage, 1, m_storage, 1);
+		return true;
+	}
+	F<typename M::reference, typename E::value_type> f(alpha);
+	for(std::size_t i = 0; i != size; ++i){
+		f(m_storage[i], e_storage[i]);
+	}
+	return true;
+}
+template<template <class, class> class F, class M, class E, class Conversion>
+bool assign_contiguous(
+	matrix_expression<M,cpu_tag> &, 
+	matrix_expression<E,cpu_tag> const&,
+	typename M::value_type,
+	std::size_t, std::size_t,
+	Conversion, boost::mpl::false_
+) {
+	return false;
+}
+
+//m = alpha*e with non-temporal stores for the major lines start,...,end-1 of m and e with unit minor stride,
+//if m is at least tuning().streaming_store_min_size bytes large. Returns false otherwise.
+template<class M, class E>
+bool copy_streaming(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+) {
+	typedef typename M::orientation orientation;
+	if(m().size1() * m().size2() * sizeof(typename M::value_type) < tuning().streaming_store_min_size)
+		return false;
+	if(orientation::index_m(bindings::traits::stride1(m),bindings::traits::stride2(m)) != 1)
+		return false;
+	if(orientation::index_m(bindings::traits::stride1(e),bindings::traits::stride2(e)) != 1)
+		return false;
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	std::ptrdiff_t ldm = bindings::traits::leading_dimension(m);
+	std::ptrdiff_t lde = bindings::traits::leading_dimension(e);
+	auto m_storage = bindings::traits::storage(m);
+	auto e_storage = bindings::traits::storage(e);
+	if(bindings::traits::is_contiguous(m) && bindings::traits::is_contiguous(e)){
+		bindings::stream_copy((end - start) * size_m, alpha, e_storage + start * size_m, m_storage + start * size_m);
+		return true;
+	}
+	for(std::size_t i = start; i != end; ++i){
+		bindings::stream_copy(size_m, alpha, e_storage + std::ptrdiff_t(i) * lde, m_storage + std::ptrdiff_t(i) * ldm);
+	}
+	return true;
+}
+template<class M, class E>
+bool copy_streaming(
+	matrix_expression<M,cpu_tag> &, 
+	matrix_expression<E,cpu_tag> const&,
+	typename M::value_type,
+	std::size_t, std::size_t,
+	boost::mpl::false_
+) {
+	return false;
+}
+
 template<template <class, class> class F, class M, class E, class Orientation>
 void assign(
 	matrix_expression<M,cpu_tag> &m, 
 	matrix_expression<E,cpu_tag> const& e,
 	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	Orientation, Orientation,
+	dense_random_access_iterator_tag,
+	dense_random_access_iterator_tag
+) {
+	typedef typename bindings::has_optimized_conversion<F,M,E>::type conversion;
+	typedef typename bindings::has_vectorized_function<E>::type vectorized;
+	typedef typename boost::mpl::and_<
+		boost::is_same<typename M::storage_category, dense_tag>,
+		boost::is_same<typename E::storage_category, dense_tag>
+	>::type dense_storage;
+	typedef typename boost::mpl::and_<
+		boost::is_same<F<int,int>, scalar_assign<int,int> >,
+		dense_storage,
+		boost::is_same<typename M::value_type, typename E::value_type>,
+		bindings::streaming_store<typename M::value_type>
+	>::type streaming;
+	if(copy_streaming(m,e,alpha,start,end,streaming()))
+		return;
+	if(assign_contiguous<F>(m,e,alpha,start,end,conversion(),dense_storage()))
+		return;
+	assign_dense<F>(m,e,alpha,start,end,Orientation(),conversion(),vectorized());
+}
+
+//m = f(m,alpha*e) for m and e with dense storage of the same type and unit minor stride, where e has the
+//transposed orientation. Plain copies are transposed directly into m, otherwise tiles of e are transposed
+//into a buffer which is then assigned to m line by line. Returns false if a minor stride is not 1.
+template<template <class, class> class F, class M, class E>
+bool assign_transposed(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+) {
+	typedef typename M::orientation orientation;
+	typedef typename E::orientation e_orientation;
+	if(orientation::index_m(bindings::traits::stride1(m),bindings::traits::stride2(m)) != 1)
+		return false;
+	if(e_orientation::index_m(bindings::traits::stride1(e),bindings::traits::stride2(e)) != 1)
+		return false;
+	typedef typename M::value_type value_type;
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	std::ptrdiff_t ldm = bindings::traits::leading_dimension(m);
+	std::ptrdiff_t lde = bindings::traits::leading_dimension(e);
+	value_type* m_storage = bindings::traits::storage(m) + std::ptrdiff_t(start) * ldm;
+	value_type const* e_storage = bindings::traits::storage(e) + start;
+	
+	typedef F<typename M::reference, typename E::value_type> functor;
+	if(boost::is_same<functor, scalar_assign<typename M::reference, typename E::value_type> >::value && alpha == value_type(1)){
+		bindings::transpose(size_m, end - start, e_storage, lde, m_storage, ldm);
+		return true;
+	}
+	std::size_t const tile_size = 32;
+	value_type buffer[tile_size * tile_size];
+	functor f(alpha);
+	for(std::size_t i = 0; i < end - start; i += tile_size){
+		for(std::size_t j = 0; j < size_m; j += tile_size){
+			std::size_t rows = std::min(tile_size, end - start - i);
+			std::size_t cols = std::min(tile_size, size_m - j);
+			bindings::transpose_tile(cols, rows, e_storage + std::ptrdiff_t(j) * lde + i, lde, buffer, tile_size);
+			for(std::size_t i1 = 0; i1 != rows; ++i1){
+				value_type* m_line = m_storage + std::ptrdiff_t(i + i1) * ldm + j;
+				for(std::size_t j1 = 0; j1 != cols; ++j1){
+					f(m_line[j1], buffer[i1 * tile_size + j1]);
+				}
+			}
+		}
+	}
+	return true;
+}
+template<template <class, class> class F, class M, class E>
+bool assign_transposed(
+	matrix_expression<M,cpu_tag> &, 
+	matrix_expression<E,cpu_tag> const&,
+	typename M::value_type,
+	std::size_t, std::size_t,
+	boost::mpl::false_
+) {
+	return false;
+}
+
+template<template <class, class> class F, class M, class E, class Orientation>
+void assign(
+	matrix_expression<M,cpu_tag> &m, 
+	matrix_expression<E,cpu_tag> const& e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
 	Orientation, typename Orientation::transposed_orientation,
 	dense_random_access_iterator_tag,
 	dense_random_access_iterator_tag
 ) {
+	typedef typename boost::mpl::and_<
+		boost::is_same<typename M::storage_category, dense_tag>,
+		boost::is_same<typename E::storage_category, dense_tag>,
+		boost::is_same<typename M::value_type, typename E::value_type>
+	>::type dense_storage;
+	if(assign_transposed<F>(m,e,alpha,start,end,dense_storage()))
+		return;
+	
 	typedef typename M::size_type size_type;
 	//compute blockwise the assignment blockwise using an intermediate blockStorage
 	//this is chosen as the blockStorage can be kept in L1 cache and thus we do not have
 	//to worry about access speed of it and thus can first write the block in a way that is
 	//quick for e and then write the block to m that is quick for m.
-	size_type const blockSize = 16;
-	typename M::value_type blockStorage[blockSize][blockSize];
+	size_type const maxBlockSize = 32;
+	size_type const blockSize = std::max<size_type>(1,std::min<size_type>(tuning().assign_block_size,maxBlockSize));
+	typename M::value_type blockStorage[maxBlockSize][maxBlockSize];
 	
-	size_type size_M = Orientation::index_M(m().size1(),m().size2());
 	size_type size_m = Orientation::index_m(m().size1(),m().size2());
 	F<typename M::reference, typename E::value_type> f(alpha);
-	for (size_type iblock = 0; iblock < size_M; iblock += blockSize){
+	for (size_type iblock = start; iblock < end; iblock += blockSize){
 		for (size_type jblock = 0; jblock < size_m; jblock += blockSize){
-			std::size_t blockSizei = std::min(blockSize,size_M-iblock);
+			std::size_t blockSizei = std::min(blockSize,end-iblock);
 			std::size_t blockSizej = std::min(blockSize,size_m-jblock);
 			
 			//read block values into the block by iterating over the fast direction of e
@@ -151,22 +453,74 @@ void assign(
 	matrix_expression<M,cpu_tag> &m, 
 	matrix_expression<E,cpu_tag> const& e,
 	typename M::value_type alpha,
+	std::size_t start, std::size_t end,
 	row_major, unknown_orientation ,TagE tagE, TagM tagM
 ) {
-	assign<F> (m,e,alpha, row_major(),row_major(),tagE,tagM);
+	assign<F> (m,e,alpha,start,end, row_major(),row_major(),tagE,tagM);
 }
 
-//Dispatcher
+///\brief Computes m(i,j)=f(m(i,j),alpha*e(i,j)) for the major lines start,...,end-1 of m.
+///
+/// The major lines are the rows of a row major m and the columns of a column major m.
+/// This allows to split an assignment in several kernels working on disjoint parts of m.
 template<template <class,class> class F, class M, class E>
-void assign(matrix_expression<M,cpu_tag> &m, const matrix_expression<E,cpu_tag> &e, typename M::value_type alpha) {
+void assign(
+	matrix_expression<M,cpu_tag> &m,
+	const matrix_expression<E,cpu_tag> &e,
+	typename M::value_type alpha,
+	std::size_t start, std::size_t end
+) {
 	ABLAS_SIZE_CHECK(m().size1()  == e().size1());
 	ABLAS_SIZE_CHECK(m().size2()  == e().size2());
 	typedef typename M::orientation MOrientation;
 	typedef typename E::orientation EOrientation;
 	typedef typename major_iterator<M>::type::iterator_category MCategory;
 	typedef typename major_iterator<E>::type::iterator_category ECategory;
+	ABLAS_SIZE_CHECK(start <= end && end <= MOrientation::index_M(m().size1(),m().size2()));
 	
-	assign<F>(m, e, alpha, MOrientation(),EOrientation(), MCategory(), ECategory());
+	assign<F>(m, e, alpha, start, end, MOrientation(),EOrientation(), MCategory(), ECategory());
+}
+
+//Dispatcher
+template<template <class,class> class F, class M, class E>
+void assign(matrix_expression<M,cpu_tag> &m, const matrix_expression<E,cpu_tag> &e, typename M::value_type alpha) {
+	typedef typename M::orientation MOrientation;
+	assign<F>(m, e, alpha, 0, MOrientation::index_M(m().size1(),m().size2()));
+}
+
+//////////////////////////////////////////////////////
+////In-place transposition
+/////////////////////////////////////////////////////
+
+template<class M, class Tag>
+void transpose_inplace(matrix_expression<M,cpu_tag>& m, Tag){
+	using std::swap;
+	for(std::size_t i = 0; i != m().size1(); ++i){
+		for(std::size_t j = 0; j != i; ++j){
+			swap(m()(i,j), m()(j,i));
+		}
+	}
+}
+
+template<class M>
+void transpose_inplace(matrix_expression<M,cpu_tag>& m, dense_tag){
+	typedef typename M::orientation orientation;
+	if(orientation::index_m(bindings::traits::stride1(m),bindings::traits::stride2(m)) != 1){
+		transpose_inplace(m, unknown_storage_tag());
+		return;
+	}
+	bindings::transpose_inplace(m().size1(), bindings::traits::storage(m), bindings::traits::leading_dimension(m));
+}
+
+///\brief Transposes the square matrix m in place, m = trans(m).
+///
+/// For dense storage the matrix is split recursively into tiles which are swapped with their mirror tiles,
+/// so that the transposition runs at memory bandwidth. Reinterpreting the result with the other orientation,
+/// e.g. by trans(m), converts the matrix between row_major and column_major storage without a copy.
+template<class M>
+void transpose_inplace(matrix_expression<M,cpu_tag>& m){
+	ABLAS_SIZE_CHECK(m().size1() == m().size2());
+	transpose_inplace(m, typename M::storage_category());
 }
 
 }}
@@ -0,0 +1,80 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Cholesky decomposition kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_POTRF_HPP
+#define ABLAS_KERNELS_POTRF_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#ifdef ABLAS_USE_LAPACK
+#include "lapack/potrf.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_potrf
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA>
+struct  has_optimized_potrf
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/potrf.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known POsitive definite TRiangular Factorization kernel, the Cholesky decomposition A=LL^T or A=U^TU.
+///
+/// TriangularType is lower or upper. A is a symmetric positive definite dense matrix of which only the elements
+/// of the triangle TriangularType are read. They are overwritten by the factor and the other triangle is cleared,
+/// so that A can be used as a dense triangular matrix afterwards.
+/// Returns 0 on success. If A is not positive definite, the decomposition stops at the first pivot j which is not
+/// positive and j+1 is returned. In this case A is partially overwritten.
+/// If LAPACK bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from lapack/potrf.hpp
+/// otherwise default/potrf.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_potrf<MatA>::type evaluates to boost::mpl::true_
+/// Matrices with n*n*n below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class TriangularType, class MatA>
+std::size_t potrf(matrix_expression<MatA,cpu_tag>& A){
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	
+	typedef typename bindings::has_optimized_potrf<MatA>::type optimized;
+	std::size_t size = A().size1() * A().size1() * A().size1();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		return bindings::potrf<TriangularType>(A, optimized());
+	else
+		return bindings::potrf<TriangularType>(A, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,167 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Quantization of matrices to 8 bit integers with per-row or per-column scales
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef ABLAS_KERNELS_QUANTIZE_HPP
+#define ABLAS_KERNELS_QUANTIZE_HPP
+
+#include "../detail/traits.hpp"
+#include <cmath>
+#include <limits>
+
+namespace aBLAS{
+
+namespace detail{
+///\brief Rounds to the nearest integer, ties to even, and saturates to the range of T. NaN is mapped to 0.
+template<class T, class S>
+T saturate_round(S value){
+	if(!(value == value))
+		return T(0);
+	value = std::nearbyint(value);
+	if(value <= S(std::numeric_limits<T>::lowest()))
+		return std::numeric_limits<T>::lowest();
+	if(value >= S(std::numeric_limits<T>::max()))
+		return std::numeric_limits<T>::max();
+	return T(value);
+}
+
+//calls m(i,j) = f(i,j) in the storage order of m
+template<class M, class F>
+void assign_indexed(matrix_expression<M,cpu_tag>& m, F f){
+	typedef typename M::orientation orientation;
+	std::size_t size_M = orientation::index_M(m().size1(),m().size2());
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	for(std::size_t i = 0; i != size_M; ++i){
+		for(std::size_t j = 0; j != size_m; ++j){
+			std::size_t row = orientation::index_row(i,j);
+			std::size_t col = orientation::index_col(i,j);
+			m()(row,col) = f(row,col);
+		}
+	}
+}
+}
+
+namespace kernels{
+
+///\brief Quantizes e with one scale per row: m(i,j) = round(e(i,j)/scales(i)).
+///
+/// The values are rounded to nearest and saturated to the range of the integer type of m,
+/// e.g. int8_t or uint8_t. A common choice of scale is max_j |e(i,j)|/127.
+template<class M, class E, class V>
+void quantize_rows(
+	matrix_expression<E,cpu_tag> const& e,
+	vector_expression<V,cpu_tag> const& scales,
+	matrix_expression<M,cpu_tag>& m
+){
+	ABLAS_SIZE_CHECK(m().size1() == e().size1());
+	ABLAS_SIZE_CHECK(m().size2() == e().size2());
+	ABLAS_SIZE_CHECK(scales().size() == e().size1());
+	typedef typename M::value_type value_type;
+	typedef typename promote_traits<typename E::value_type, typename V::value_type>::promote_type real_type;
+	detail::assign_indexed(m,[&](std::size_t i, std::size_t j){
+		return detail::saturate_round<value_type>(real_type(e()(i,j)) / real_type(scales()(i)));
+	});
+}
+
+///\brief Quantizes e with one scale per column: m(i,j) = round(e(i,j)/scales(j)).
+///
+/// The values are rounded to nearest and saturated to the range of the integer type of m.
+template<class M, class E, class V>
+void quantize_columns(
+	matrix_expression<E,cpu_tag> const& e,
+	vector_expression<V,cpu_tag> const& scales,
+	matrix_expression<M,cpu_tag>& m
+){
+	ABLAS_SIZE_CHECK(m().size1() == e().size1());
+	ABLAS_SIZE_CHECK(m().size2() == e().size2());
+	ABLAS_SIZE_CHECK(scales().size() == e().size2());
+	typedef typename M::value_type value_type;
+	typedef typename promote_traits<typename E::value_type, typename V::value_type>::promote_type real_type;
+	detail::assign_indexed(m,[&](std::size_t i, std::size_t j){
+		return detail::saturate_round<value_type>(real_type(e()(i,j)) / real_type(scales()(j)));
+	});
+}
+
+///\brief Dequantizes q with one scale per row: m(i,j) = scales(i) * q(i,j).
+template<class M, class E, class V>
+void dequantize_rows(
+	matrix_expression<E,cpu_tag> const& q,
+	vector_expression<V,cpu_tag> const& scales,
+	matrix_expression<M,cpu_tag>& m
+){
+	ABLAS_SIZE_CHECK(m().size1() == q().size1());
+	ABLAS_SIZE_CHECK(m().size2() == q().size2());
+	ABLAS_SIZE_CHECK(scales().size() == q().size1());
+	typedef typename M::value_type value_type;
+	detail::assign_indexed(m,[&](std::size_t i, std::size_t j){
+		return value_type(scales()(i)) * value_type(q()(i,j));
+	});
+}
+
+///\brief Dequantizes q with one scale per column: m(i,j) = scales(j) * q(i,j).
+template<class M, class E, class V>
+void dequantize_columns(
+	matrix_expression<E,cpu_tag> const& q,
+	vector_expression<V,cpu_tag> const& scales,
+	matrix_expression<M,cpu_tag>& m
+){
+	ABLAS_SIZE_CHECK(m().size1() == q().size1());
+	ABLAS_SIZE_CHECK(m().size2() == q().size2());
+	ABLAS_SIZE_CHECK(scales().size() == q().size2());
+	typedef typename M::value_type value_type;
+	detail::assign_indexed(m,[&](std::size_t i, std::size_t j){
+		return value_type(scales()(j)) * value_type(q()(i,j));
+	});
+}
+
+///\brief Dequantizes the result of a quantized product: m(i,j) = row_scales(i) * column_scales(j) * q(i,j).
+///
+/// If A was quantized by rows with scales a and B by columns with scales b, then
+/// the int32 result q of prod(A,B) is dequantized to A*B by dequantize(q,a,b,m).
+template<class M, class E, class V1, class V2>
+void dequantize(
+	matrix_expression<E,cpu_tag> const& q,
+	vector_expression<V1,cpu_tag> const& row_scales,
+	vector_expression<V2,cpu_tag> const& column_scales,
+	matrix_expression<M,cpu_tag>& m
+){
+	ABLAS_SIZE_CHECK(m().size1() == q().size1());
+	ABLAS_SIZE_CHECK(m().size2() == q().size2());
+	ABLAS_SIZE_CHECK(row_scales().size() == q().size1());
+	ABLAS_SIZE_CHECK(column_scales().size() == q().size2());
+	typedef typename M::value_type value_type;
+	detail::assign_indexed(m,[&](std::size_t i, std::size_t j){
+		return value_type(row_scales()(i)) * value_type(column_scales()(j)) * value_type(q()(i,j));
+	});
+}
+
+}}
+#endif
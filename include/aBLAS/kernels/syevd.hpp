@@ -0,0 +1,82 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Eigen decomposition kernel of symmetric matrices
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_SYEVD_HPP
+#define ABLAS_KERNELS_SYEVD_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#ifdef ABLAS_USE_LAPACK
+#include "lapack/syevd.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_syevd
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class VecW>
+struct  has_optimized_syevd
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/syevd.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known SYmmetric EigenValue Decomposition kernel, A = V diag(w) V^T.
+///
+/// A is a symmetric dense n x n matrix of which only the lower triangle is read. It is overwritten by the orthogonal
+/// matrix V, which stores the eigenvectors in its columns. The eigenvalues are stored in w in ascending order.
+/// Returns 0 on success, otherwise the algorithm did not converge and the results are not accurate.
+/// If LAPACK bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from lapack/syevd.hpp
+/// otherwise default/syevd.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_syevd<MatA,VecW>::type evaluates to boost::mpl::true_
+/// Matrices with n*n*n below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class VecW>
+std::size_t syevd(
+	matrix_expression<MatA,cpu_tag>& A,
+	vector_expression<VecW,cpu_tag>& w
+){
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(w().size() == A().size1());
+	
+	typedef typename bindings::has_optimized_syevd<MatA,VecW>::type optimized;
+	std::size_t size = A().size1() * A().size1() * A().size1();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		return bindings::syevd(A, w, optimized());
+	else
+		return bindings::syevd(A, w, boost::mpl::false_());
+}
+
+}}
+
+#endif
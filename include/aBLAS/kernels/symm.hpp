@@ -0,0 +1,85 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Symmetric matrix-matrix product kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_SYMM_HPP
+#define ABLAS_KERNELS_SYMM_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/symm.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_symm
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class MatB, class MatC>
+struct  has_optimized_symm
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/symm.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known SYmmetric Matrix-Matrix product kernel C=beta*C+alpha*A*B.
+///
+/// A is a symmetric matrix, either a view symmetric<Type>(M) of a dense matrix or a packed symmetric_matrix,
+/// see triangular_matrix.hpp. Only the elements of its stored triangle are read.
+/// For beta=0 the previous values of C are not read, so C may be uninitialized.
+/// If bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/symm.hpp
+/// otherwise default/symm.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_symm<MatA,MatB,MatC>::type evaluates to boost::mpl::true_
+/// Products with n*n*m below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class MatB, class MatC>
+void symm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag> const& B,
+	matrix_expression<MatC,cpu_tag>& C,
+	typename MatC::value_type alpha,
+	typename MatC::value_type beta = typename MatC::value_type(1)
+) {
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(A().size2() == B().size1());
+	ABLAS_SIZE_CHECK(A().size1() == C().size1());
+	ABLAS_SIZE_CHECK(B().size2() == C().size2());
+	
+	typedef typename bindings::has_optimized_symm<MatA,MatB,MatC>::type optimized;
+	std::size_t size = A().size1() * A().size2() * B().size2();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		bindings::symm(A, B, C, alpha, beta, optimized());
+	else
+		bindings::symm(A, B, C, alpha, beta, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,83 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Symmetric matrix-vector product kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_SYMV_HPP
+#define ABLAS_KERNELS_SYMV_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/symv.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_symv
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class V, class ResultV>
+struct  has_optimized_symv
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/symv.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known SYmmetric Matrix-Vector product kernel y=beta*y+alpha*A*x.
+///
+/// A is a symmetric matrix, either a view symmetric<Type>(M) of a dense matrix or a packed symmetric_matrix,
+/// see triangular_matrix.hpp. Only the elements of its stored triangle are read.
+/// For beta=0 the previous values of y are not read, so y may be uninitialized.
+/// If bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/symv.hpp
+/// otherwise default/symv.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_symv<MatA,V,ResultV>::type evaluates to boost::mpl::true_
+/// Products with n*n below tuning().gemv_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class V, class ResultV>
+void symv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag> const& x,
+	vector_expression<ResultV,cpu_tag>& y,
+	typename ResultV::value_type alpha,
+	typename ResultV::value_type beta = typename ResultV::value_type(1)
+) {
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(A().size2() == x().size());
+	ABLAS_SIZE_CHECK(A().size1() == y().size());
+	
+	typedef typename bindings::has_optimized_symv<MatA,V,ResultV>::type optimized;
+	if(optimized::value && A().size1() * A().size2() >= tuning().gemv_binding_min_size)
+		bindings::symv(A, x, y, alpha, beta, optimized());
+	else
+		bindings::symv(A, x, y, alpha, beta, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,123 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Symmetric rank-k update kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_SYRK_HPP
+#define ABLAS_KERNELS_SYRK_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/syrk.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_syrk
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class M, class E>
+struct  has_optimized_syrk
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/syrk.hpp"
+#include "tuning.hpp"
+#include "traits.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known SYmmetric Rank-K update kernel M=beta*M+alpha*E*E^T.
+///
+/// The product is symmetric, so only the triangle below the diagonal is computed and the triangle above is copied
+/// from it. M does not need to be symmetric, for beta!=0 both triangles of M are scaled.
+/// For beta=0 the previous values of M are not read, so M may be uninitialized.
+/// If bindings are included and the matrix combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/syrk.hpp
+/// otherwise default/syrk.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_syrk<M,E>::type evaluates to boost::mpl::true_
+/// Products with n*n*k below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class M, class E>
+void syrk(
+	matrix_expression<E,cpu_tag> const& e,
+	matrix_expression<M,cpu_tag>& m,
+	typename M::value_type alpha,
+	typename M::value_type beta = typename M::value_type(1)
+) {
+	ABLAS_SIZE_CHECK(m().size1() == e().size1());
+	ABLAS_SIZE_CHECK(m().size2() == e().size1());
+	
+	typedef typename bindings::has_optimized_syrk<M,E>::type optimized;
+	std::size_t size = m().size1() * m().size2() * e().size2();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		bindings::syrk(e, m, alpha, beta, optimized());
+	else
+		bindings::syrk(e, m, alpha, beta, boost::mpl::false_());
+}
+
+//dense expressions are compared by their storage, other expressions are never recognized
+template<class E1, class E2>
+bool is_transpose_of(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2,
+	boost::mpl::true_
+){
+	return e1().size1() == e2().size2() && e1().size2() == e2().size1()
+		&& bindings::traits::storage(e1) == bindings::traits::storage(e2)
+		&& bindings::traits::stride1(e1) == bindings::traits::stride2(e2)
+		&& bindings::traits::stride2(e1) == bindings::traits::stride1(e2);
+}
+template<class E1, class E2>
+bool is_transpose_of(
+	matrix_expression<E1,cpu_tag> const&,
+	matrix_expression<E2,cpu_tag> const&,
+	boost::mpl::false_
+){
+	return false;
+}
+
+///\brief Returns true if e2 is stored in the same memory as the transpose of e1.
+///
+/// In this case the product e1*e2 is symmetric and can be computed by syrk(e1,m), as is done for
+/// prod(A,trans(A)) and prod(trans(A),A). Only dense expressions of the same value type are recognized.
+template<class E1, class E2>
+bool is_transpose_of(
+	matrix_expression<E1,cpu_tag> const& e1,
+	matrix_expression<E2,cpu_tag> const& e2
+){
+	typedef typename boost::mpl::and_<
+		boost::is_same<typename E1::storage_category, dense_tag>,
+		boost::is_same<typename E2::storage_category, dense_tag>,
+		boost::is_same<typename E1::value_type, typename E2::value_type>
+	>::type dense;
+	return is_transpose_of(e1, e2, dense());
+}
+
+}}
+
+#endif
@@ -76,6 +76,20 @@ typename M::difference_type leading_dimension(matrix_expression<M,Device> const&
 	return  M::orientation::index_M(stride1(m),stride2(m));
 }
 
+///\brief Returns true if the elements of m are stored in major order without gaps between the major lines.
+///
+/// This is the case for whole unpadded matrices and ranges of whole rows of a row major matrix,
+/// their storage can be treated as a single vector.
+template <typename M,class Device>
+bool is_contiguous(matrix_expression<M,Device> const& m) {
+	typedef typename M::orientation orientation;
+	std::size_t size_M = orientation::index_M(m().size1(),m().size2());
+	std::size_t size_m = orientation::index_m(m().size1(),m().size2());
+	if(orientation::index_m(stride1(m),stride2(m)) != 1 && size_m > 1)
+		return false;
+	return size_M <= 1 || leading_dimension(m) == typename M::difference_type(size_m);
+}
+
 template<class M1, class M2,class Device1, class Device2>
 bool same_orientation(matrix_expression<M1,Device1> const& m1, matrix_expression<M2,Device2> const& m2){
 	return boost::is_same<typename M1::orientation,typename M2::orientation>::value;
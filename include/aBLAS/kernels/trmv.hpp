@@ -0,0 +1,78 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Triangular matrix-vector product kernel
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_TRMV_HPP
+#define ABLAS_KERNELS_TRMV_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/trmv.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_trmv
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class V>
+struct  has_optimized_trmv
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/trmv.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known TRiangular Matrix-Vector product kernel x=A*x.
+///
+/// A is a triangular matrix, either a view triangular<Type>(M) of a dense matrix or a packed triangular_matrix,
+/// see triangular_matrix.hpp. Only the elements of its triangle are read, for unit triangular matrices the diagonal is not read.
+/// If bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/trmv.hpp
+/// otherwise default/trmv.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_trmv<MatA,V>::type evaluates to boost::mpl::true_
+/// Products with n*n below tuning().gemv_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class V>
+void trmv(
+	matrix_expression<MatA,cpu_tag> const& A,
+	vector_expression<V,cpu_tag>& x
+) {
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(A().size2() == x().size());
+	
+	typedef typename bindings::has_optimized_trmv<MatA,V>::type optimized;
+	if(optimized::value && A().size1() * A().size2() >= tuning().gemv_binding_min_size)
+		bindings::trmv(A, x, optimized());
+	else
+		bindings::trmv(A, x, boost::mpl::false_());
+}
+
+}}
+
+#endif
@@ -0,0 +1,80 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Triangular solve kernel for a matrix right hand side
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_KERNELS_TRSM_HPP
+#define ABLAS_KERNELS_TRSM_HPP
+
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/trsm.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_trsm
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<class MatA, class MatB>
+struct  has_optimized_trsm
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/trsm.hpp"
+#include "tuning.hpp"
+
+namespace aBLAS {namespace kernels{
+
+///\brief Well known TRiangular Solve kernel for Matrices B=A^-1*B, i.e. solves AX=B and stores X in B.
+///
+/// A is a triangular matrix, either a view triangular<Type>(M) of a dense matrix or a packed triangular_matrix,
+/// see triangular_matrix.hpp. Only the elements of its triangle are read, for unit triangular matrices the diagonal is not read.
+/// The diagonal elements must be nonzero, this is not checked.
+/// If bindings are included and the combination allows for a specific binding
+/// to be applied, the binding is called automatically from {binding}/trsm.hpp
+/// otherwise default/trsm.hpp is used.
+/// if a combination is optimized, bindings::has_optimized_trsm<MatA,MatB>::type evaluates to boost::mpl::true_
+/// Systems with n*n*m below tuning().gemm_binding_min_size are computed by the default kernel anyway.
+template<class MatA, class MatB>
+void trsm(
+	matrix_expression<MatA,cpu_tag> const& A,
+	matrix_expression<MatB,cpu_tag>& B
+) {
+	ABLAS_SIZE_CHECK(A().size1() == A().size2());
+	ABLAS_SIZE_CHECK(A().size2() == B().size1());
+	
+	typedef typename bindings::has_optimized_trsm<MatA,MatB>::type optimized;
+	std::size_t size = A().size1() * A().size2() * B().size2();
+	if(optimized::value && size >= tuning().gemm_binding_min_size)
+		bindings::trsm(A, B, optimized());
+	else
+		bindings::trsm(A, B, boost::mpl::false_());
+}
+
+}}
+
+#endif
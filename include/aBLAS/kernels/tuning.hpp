@@ -0,0 +1,198 @@
+/*!
+ * 
+ *
+ * \brief       Machine dependent parameters of the kernels
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_KERNELS_TUNING_HPP
+#define ABLAS_KERNELS_TUNING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace aBLAS {namespace kernels{
+
+/// \brief Machine dependent parameters of the kernels.
+///
+/// The parameters consist of the block sizes of the default kernels and the crossover points
+/// below which the default kernels are used even if bindings are available, as for small arguments
+/// the call overhead of the bindings dominates. The crossover points of gemm and gemv are stored per shape class,
+/// as the bindings reach their peak performance for thin matrices at other sizes than for square matrices,
+/// see gemm_binding_min_size_for() and gemv_binding_min_size_for().
+/// The defaults are reasonable for most machines. The values of the target machine are measured by
+/// autotune() in aBLAS/autotune.hpp and can be stored in a tuning file, see save() and load().
+///
+/// The parameters are shared by all kernels, changing them while kernels are in flight is not safe.
+struct tuning_parameters{
+	tuning_parameters()
+	: gemm_block_size(24)
+	, assign_block_size(16)
+	, gemm_binding_min_size(512)
+	, gemm_thin_inner_binding_min_size(512)
+	, gemm_thin_outer_binding_min_size(512)
+	, gemv_binding_min_size(64)
+	, gemv_tall_binding_min_size(64)
+	, gemv_wide_binding_min_size(64)
+	, vector_binding_min_size(32)
+	, gemm_epilogue_tile_size(128)
+	, parallel_assign_grain_size(256 * 1024)
+	, streaming_store_min_size(32 * 1024 * 1024)
+	, syrk_block_size(128)
+	, triangular_block_size(64)
+	, factorization_tile_size(256){}
+
+	///\brief Block size of the default gemm for column major arguments and row major result
+	std::size_t gemm_block_size;
+	///\brief Block size for the assignment of matrices with different orientation. At most 32.
+	std::size_t assign_block_size;
+	///\brief gemm with m*n*k smaller than this uses the default kernel.
+	///
+	/// Used for products in which no dimension is smaller than a quarter of the largest and by the kernels
+	/// built on gemm, e.g. syrk, trsm and the factorizations.
+	std::size_t gemm_binding_min_size;
+	///\brief gemm_binding_min_size for products in which the inner dimension k is the smallest and less than a quarter of the largest.
+	std::size_t gemm_thin_inner_binding_min_size;
+	///\brief gemm_binding_min_size for products in which m or n is the smallest dimension and less than a quarter of the largest.
+	std::size_t gemm_thin_outer_binding_min_size;
+	///\brief gemv with m*n smaller than this uses the default kernel.
+	///
+	/// Used for matrices in which no dimension is smaller than a quarter of the other and by the kernels built on gemv, e.g. trmv and symv.
+	std::size_t gemv_binding_min_size;
+	///\brief gemv_binding_min_size for matrices with at least four times as many rows as columns.
+	std::size_t gemv_tall_binding_min_size;
+	///\brief gemv_binding_min_size for matrices with at least four times as many columns as rows.
+	std::size_t gemv_wide_binding_min_size;
+	///\brief dot and vector assignment with less elements use the default kernels
+	std::size_t vector_binding_min_size;
+	///\brief Size of the tiles of the result of gemm with an epilogue, the epilogue is applied to each tile while it is in cache
+	std::size_t gemm_epilogue_tile_size;
+	///\brief Minimum number of bytes written by each kernel of an elementwise assignment which is split in parallel kernels.
+	///
+	/// The default is the size of a typical per core L2 cache, so that the overhead of a kernel is small compared to its work.
+	std::size_t parallel_assign_grain_size;
+	///\brief Fills and copies writing at least this many bytes use non-temporal stores.
+	///
+	/// Non-temporal stores bypass the cache, so that results much larger than the last level cache
+	/// do not evict the working set of other kernels. 0 uses them for all fills and copies, std::size_t(-1) never.
+	std::size_t streaming_store_min_size;
+	///\brief Block size of the default syrk. Blocks above the diagonal are copied from the blocks below.
+	std::size_t syrk_block_size;
+	///\brief Block size of the default kernels of triangular and symmetric matrices.
+	///
+	/// The blocks on the diagonal are computed element by element, all other blocks by gemv and gemm.
+	std::size_t triangular_block_size;
+	///\brief Size of the tiles of the Cholesky, LU and QR decompositions in factorizations.hpp.
+	///
+	/// Every tile kernel is a work item of the scheduler. Smaller tiles allow more kernels to run in parallel, larger tiles
+	/// reduce the scheduling overhead and make the kernels on the tiles more efficient.
+	std::size_t factorization_tile_size;
+
+	///\brief Crossover point of gemm for the product of an m x k and a k x n matrix.
+	std::size_t gemm_binding_min_size_for(std::size_t m, std::size_t n, std::size_t k)const{
+		std::size_t smallest = std::min(std::min(m, n), k);
+		std::size_t largest = std::max(std::max(m, n), k);
+		if(4 * smallest >= largest)
+			return gemm_binding_min_size;
+		return k == smallest? gemm_thin_inner_binding_min_size: gemm_thin_outer_binding_min_size;
+	}
+	
+	///\brief Crossover point of gemv for an m x n matrix.
+	std::size_t gemv_binding_min_size_for(std::size_t m, std::size_t n)const{
+		if(4 * std::min(m, n) >= std::max(m, n))
+			return gemv_binding_min_size;
+		return m > n? gemv_tall_binding_min_size: gemv_wide_binding_min_size;
+	}
+
+	///\brief Reads parameters from a tuning file.
+	///
+	/// The file consists of lines "name value". Parameters not in the file keep their value, unknown names are ignored.
+	/// Returns false if the file can not be read.
+	bool load(std::string const& filename){
+		std::ifstream file(filename.c_str());
+		if(!file)
+			return false;
+		std::string name;
+		std::size_t value;
+		while(file >> name >> value){
+			if(name == "gemm_block_size") gemm_block_size = value;
+			else if(name == "assign_block_size") assign_block_size = value;
+			else if(name == "gemm_binding_min_size") gemm_binding_min_size = value;
+			else if(name == "gemm_thin_inner_binding_min_size") gemm_thin_inner_binding_min_size = value;
+			else if(name == "gemm_thin_outer_binding_min_size") gemm_thin_outer_binding_min_size = value;
+			else if(name == "gemv_binding_min_size") gemv_binding_min_size = value;
+			else if(name == "gemv_tall_binding_min_size") gemv_tall_binding_min_size = value;
+			else if(name == "gemv_wide_binding_min_size") gemv_wide_binding_min_size = value;
+			else if(name == "vector_binding_min_size") vector_binding_min_size = value;
+			else if(name == "gemm_epilogue_tile_size") gemm_epilogue_tile_size = value;
+			else if(name == "parallel_assign_grain_size") parallel_assign_grain_size = value;
+			else if(name == "streaming_store_min_size") streaming_store_min_size = value;
+			else if(name == "syrk_block_size") syrk_block_size = value;
+			else if(name == "triangular_block_size") triangular_block_size = value;
+			else if(name == "factorization_tile_size") factorization_tile_size = value;
+		}
+		return true;
+	}
+
+	///\brief Writes the parameters to a tuning file. Returns false if the file can not be written.
+	bool save(std::string const& filename)const{
+		std::ofstream file(filename.c_str());
+		file << "gemm_block_size " << gemm_block_size << "\n";
+		file << "assign_block_size " << assign_block_size << "\n";
+		file << "gemm_binding_min_size " << gemm_binding_min_size << "\n";
+		file << "gemm_thin_inner_binding_min_size " << gemm_thin_inner_binding_min_size << "\n";
+		file << "gemm_thin_outer_binding_min_size " << gemm_thin_outer_binding_min_size << "\n";
+		file << "gemv_binding_min_size " << gemv_binding_min_size << "\n";
+		file << "gemv_tall_binding_min_size " << gemv_tall_binding_min_size << "\n";
+		file << "gemv_wide_binding_min_size " << gemv_wide_binding_min_size << "\n";
+		file << "vector_binding_min_size " << vector_binding_min_size << "\n";
+		file << "gemm_epilogue_tile_size " << gemm_epilogue_tile_size << "\n";
+		file << "parallel_assign_grain_size " << parallel_assign_grain_size << "\n";
+		file << "streaming_store_min_size " << streaming_store_min_size << "\n";
+		file << "syrk_block_size " << syrk_block_size << "\n";
+		file << "triangular_block_size " << triangular_block_size << "\n";
+		file << "factorization_tile_size " << factorization_tile_size << "\n";
+		return bool(file);
+	}
+};
+
+/// \brief Returns the parameters used by the kernels.
+///
+/// On first use the file named by the environment variable ABLAS_TUNING_FILE is loaded, if it is set.
+inline tuning_parameters& tuning(){
+	static tuning_parameters parameters = [](){
+		tuning_parameters p;
+		if(char const* filename = std::getenv("ABLAS_TUNING_FILE"))
+			p.load(filename);
+		return p;
+	}();
+	return parameters;
+}
+
+}}
+#endif
@@ -33,27 +33,154 @@
 #include "../detail/functional.hpp"
 #include "../expression_types.hpp"
 
+#ifdef ABLAS_USE_CBLAS
+#include "cblas/vector_assign.hpp"
+#else
+// if no bindings are included, we have to provide the default has_optimized_vector_assign
+// otherwise the binding will take care of this
+namespace aBLAS { namespace bindings{
+template<template <class, class> class F, class V, class E>
+struct  has_optimized_vector_assign
+: public boost::mpl::false_{};
+template<template <class, class> class F, class V>
+struct  has_optimized_vector_scalar_assign
+: public boost::mpl::false_{};
+}}
+#endif
+
+#include "default/vector_assign.hpp"
+#include "default/stream.hpp"
+#include "tuning.hpp"
+#include <boost/mpl/and.hpp>
+#include <boost/type_traits/is_same.hpp>
+
 namespace aBLAS{
 namespace kernels{
 
 ////////////////////////////////////////////
 //assignment of constant value with functor
 ////////////////////////////////////////////
+
+//v = t with non-temporal stores for dense v with unit stride, if v is at least
+//tuning().streaming_store_min_size bytes large. Returns false otherwise.
+template<class V>
+bool fill_streaming(
+	vector_expression<V,cpu_tag>& v,
+	typename V::value_type t,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+){
+	if(v().size() * sizeof(typename V::value_type) < tuning().streaming_store_min_size)
+		return false;
+	if(bindings::traits::stride(v) != 1)
+		return false;
+	bindings::stream_fill(end - start, t, bindings::traits::storage(v) + start);
+	return true;
+}
+template<class V>
+bool fill_streaming(
+	vector_expression<V,cpu_tag>&,
+	typename V::value_type,
+	std::size_t, std::size_t,
+	boost::mpl::false_
+){
+	return false;
+}
+
+///\brief Computes v(i)=f(v(i),t) for the elements i=start,...,end-1 of v.
+///
+/// v=t of large dense vectors uses non-temporal stores, see tuning().streaming_store_min_size.
+template<template <class T1, class T2> class F, class V>
+void assign(
+	vector_expression<V,cpu_tag>& v,
+	typename V::value_type t,
+	std::size_t start, std::size_t end
+) {
+	ABLAS_SIZE_CHECK(start <= end && end <= v().size());
+	typedef typename boost::mpl::and_<
+		boost::is_same<F<int,int>, scalar_assign<int,int> >,
+		boost::is_same<typename V::storage_category, dense_tag>,
+		bindings::streaming_store<typename V::value_type>
+	>::type streaming;
+	if(fill_streaming(v, t, start, end, streaming()))
+		return;
+	bindings::vector_assign<F>(v, t, start, end, boost::mpl::false_());
+}
+
+///\brief Computes v=f(v,t) for all elements of v.
+///
+/// With bindings v*=t is computed by the SCAL routine for dense v
+/// with at least tuning().vector_binding_min_size elements.
 template<template <class T1, class T2> class F, class V>
 void assign(vector_expression<V,cpu_tag>& v, typename V::value_type t) {
-	typedef F<typename V::iterator::reference, typename V::value_type> Function;
-	Function f(typename V::value_type(1));
-	typedef typename V::iterator iterator;
-	iterator end = v().end();
-	for (iterator it = v().begin(); it != end; ++it){
-		f(*it, t);
-	}
+	typedef typename bindings::has_optimized_vector_scalar_assign<F,V>::type optimized;
+	if(optimized::value && v().size() >= tuning().vector_binding_min_size)
+		bindings::vector_assign<F>(v, t, optimized());
+	else
+		assign<F>(v, t, 0, v().size());
 }
 
 ////////////////////////////////////////////
 //assignment with functor
 ////////////////////////////////////////////
 
+//v = alpha*e with non-temporal stores for dense v and e with unit stride, if v is at least
+//tuning().streaming_store_min_size bytes large. Returns false otherwise.
+template<class V, class E>
+bool copy_streaming(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const&e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end,
+	boost::mpl::true_
+){
+	if(v().size() * sizeof(typename V::value_type) < tuning().streaming_store_min_size)
+		return false;
+	if(bindings::traits::stride(v) != 1 || bindings::traits::stride(e) != 1)
+		return false;
+	bindings::stream_copy(end - start, alpha, bindings::traits::storage(e) + start, bindings::traits::storage(v) + start);
+	return true;
+}
+template<class V, class E>
+bool copy_streaming(
+	vector_expression<V,cpu_tag>&,
+	vector_expression<E,cpu_tag> const&,
+	typename V::value_type,
+	std::size_t, std::size_t,
+	boost::mpl::false_
+){
+	return false;
+}
+
+///\brief Computes v(i)=f(v(i),alpha*e(i)) for the elements i=start,...,end-1 of dense v and e.
+///
+/// This allows to split an assignment in several kernels working on disjoint ranges of v.
+/// v=alpha*e of large vectors with dense storage uses non-temporal stores, see tuning().streaming_store_min_size.
+template<template <class T1, class T2> class F, class V, class E>
+void assign(
+	vector_expression<V,cpu_tag>& v,
+	vector_expression<E,cpu_tag> const&e,
+	typename V::value_type alpha,
+	std::size_t start, std::size_t end
+) {
+	ABLAS_SIZE_CHECK(v().size() == e().size());
+	ABLAS_SIZE_CHECK(start <= end && end <= v().size());
+	typedef typename boost::mpl::and_<
+		boost::is_same<F<int,int>, scalar_assign<int,int> >,
+		boost::is_same<typename V::storage_category, dense_tag>,
+		boost::is_same<typename E::storage_category, dense_tag>,
+		boost::is_same<typename V::value_type, typename E::value_type>,
+		bindings::streaming_store<typename V::value_type>
+	>::type streaming;
+	if(copy_streaming(v, e, alpha, start, end, streaming()))
+		return;
+	typedef typename bindings::has_optimized_vector_assign<F,V,E>::type optimized;
+	if(optimized::value && end - start >= tuning().vector_binding_min_size)
+		bindings::vector_assign<F>(v, e, alpha, start, end, optimized());
+	else
+		bindings::vector_assign<F>(v, e, alpha, start, end, boost::mpl::false_());
+}
+
 //dense dense case
 template<template <class T1, class T2> class F, class V, class E>
 void assign(
@@ -62,16 +189,13 @@ void assign(
 	typename V::value_type alpha,
 	dense_random_access_iterator_tag, dense_random_access_iterator_tag
 ) {
-	F<typename V::reference, typename E::value_type> f(alpha);
-	typename V::iterator end_v = v().end();
-	typename V::iterator pos_v =v().begin();
-	typename E::const_iterator pos_e =e().begin();
-	for(; pos_v != end_v; ++pos_v,++pos_e){
-		f(*pos_v,*pos_e);
-	}
+	assign<F>(v, e, alpha, 0, v().size());
 }
 
-// Dispatcher
+///\brief Computes v=f(v,alpha*e) elementwise.
+///
+/// With bindings v=alpha*e and v+=alpha*e of dense vectors are computed by
+/// the COPY, SCAL and AXPY routines if they have at least tuning().vector_binding_min_size elements.
 template<template <class T1, class T2> class F, class V, class E>
 void assign(
 	vector_expression<V,cpu_tag>& v,
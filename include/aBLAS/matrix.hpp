@@ -37,12 +37,14 @@
 
 #include "assignment.hpp"
 #include "detail/iterator.hpp"
+#include "detail/alignment.hpp"
+#include "detail/temporary_pool.hpp"
 
 namespace aBLAS { namespace detail{
 	
-template<class T>
+template<class T, class O, class A>
 struct dense_matrix_state{
-	typedef boost::container::vector<T> storage_type;//better handling of std::matrix<bool>...
+	typedef boost::container::vector<T,A> storage_type;//better handling of std::matrix<bool>...
 	typedef storage_type const const_storage_type;
 	typedef typename storage_type::size_type size_type;
 	typedef typename storage_type::value_type value_type;
@@ -50,10 +52,37 @@ struct dense_matrix_state{
 	mutable scheduling::dependency_node dependencies;
 	size_type size1;
 	size_type size2;
+	size_type leading_dimension;
+	
+	explicit dense_matrix_state(A const& alloc):data(alloc),size1(0),size2(0),leading_dimension(0){}
+	dense_matrix_state(size_type size1, size_type size2, A const& alloc)
+	: data(alloc),size1(size1),size2(size2)
+	, leading_dimension(padded_leading_dimension<T>(O::index_m(size1,size2))){
+		data.resize(storage_size());
+	}
+	dense_matrix_state(size_type size1, size_type size2, uninitialized_tag, A const& alloc)
+	: data(alloc),size1(size1),size2(size2)
+	, leading_dimension(padded_leading_dimension<T>(O::index_m(size1,size2))){
+		data.resize(storage_size(), boost::container::default_init);
+	}
+	dense_matrix_state(size_type size1, size_type size2, value_type init, A const& alloc)
+	: data(alloc),size1(size1),size2(size2)
+	, leading_dimension(padded_leading_dimension<T>(O::index_m(size1,size2))){
+		data.resize(storage_size(), init);
+	}
+	
+	///\brief Changes the size of the matrix. The values of the elements are undefined afterwards.
+	void resize(size_type new_size1, size_type new_size2){
+		size1 = new_size1;
+		size2 = new_size2;
+		leading_dimension = padded_leading_dimension<T>(O::index_m(size1,size2));
+		data.resize(storage_size(), boost::container::default_init);
+	}
 	
-	dense_matrix_state():size1(0),size2(0){}
-	dense_matrix_state(size_type size1, size_type size2):data(size1*size2), size1(size1),size2(size2){}
-	dense_matrix_state(size_type size1, size_type size2, value_type init):data(size1* size2, init), size1(size1),size2(size2){}
+	///\brief Number of elements in memory including the padding at the end of each major row.
+	size_type storage_size()const{
+		return O::index_M(size1,size2) * leading_dimension;
+	}
 };
 	
 template<class SharedState, class O, class IsNonConstReference =  boost::mpl::false_>
@@ -135,12 +164,20 @@ public:
 	}
 	
 	///\brief Returns the stride in memory between two rows.
+	///
+	/// Consecutive major rows are leading_dimension() elements apart, which can be
+	/// larger than the length of a row when the storage is padded.
 	difference_type stride1()const{
-		return orientation::stride1(size1(),size2());
+		return orientation::index_row(leading_dimension(),1);
 	}
 	///\brief Returns the stride in memory between two columns.
 	difference_type stride2()const{
-		return orientation::stride2(size1(),size2());
+		return orientation::index_col(leading_dimension(),1);
+	}
+	
+	///\brief Returns the distance in memory between the starts of two consecutive major rows.
+	size_type leading_dimension()const{
+		return m_internals->leading_dimension;
 	}
 	
 	///\brief Returns the offset from the start of storage()
@@ -186,13 +223,17 @@ public:
 		reference,
 		const_reference
 	>::type& operator()(index_type i, index_type j) const {
-		return storage()[orientation::element(i, size1(), j, size2())];
+		ABLAS_SIZE_CHECK(i < size1());
+		ABLAS_SIZE_CHECK(j < size2());
+		return storage()[i*stride1()+j*stride2()];
 	}
 	/// \brief Returns element (i,j) of the matrix
 	/// \param i the row index
 	/// \param j the column index
 	reference operator()(index_type i, index_type j) {
-		return storage()[orientation::element(i, size1(), j, size2())];
+		ABLAS_SIZE_CHECK(i < size1());
+		ABLAS_SIZE_CHECK(j < size2());
+		return storage()[i*stride1()+j*stride2()];
 	}
 
 	//Iterators
@@ -255,33 +296,36 @@ private:
 ///
 /// For a \f$(m \times n)\f$-dimensional matrix and \f$ 0 \leq i < m, 0 \leq j < n\f$, every element \f$ m_{i,j} \f$ is mapped to
 /// the \f$(i*n + j)\f$-th element of the container for row major orientation or the \f$ (i + j*m) \f$-th element of
-/// the container for column major orientation. In a dense matrix all elements are represented in memory in a
-/// contiguous chunk of memory by definition.
+/// the container for column major orientation. The storage is aligned to the size of a cache line.
+/// When ABLAS_PAD_LEADING_DIMENSION is defined, every row (column for column major) is padded so that it starts
+/// on a cache line boundary, i.e. the element is mapped to \f$ i*ld + j \f$ with leading_dimension() \f$ ld \geq n \f$.
+/// In this case the storage is no longer contiguous and only stride1() and stride2() describe the layout.
 ///
 /// Orientation can also be specified, otherwise a \c row_major is used.
 ///
 /// \tparam T the type of object stored in the matrix (like double, float, complex, etc...)
 /// \tparam O the storage organization. It can be either \c row_major or \c column_major. Default is \c row_major
-template<class T, class O=row_major>
+/// \tparam A the allocator of the storage. The default allocator aligns the storage to a cache line, see allocators.hpp for alternatives
+template<class T, class O=row_major, class A = typename detail::default_allocator<T>::type>
 class matrix
-	: public matrix_expression<matrix<T, O>,cpu_tag >
-	, public detail::dense_matrix_base<detail::dense_matrix_state<T>, O> {
+	: public matrix_expression<matrix<T,O,A>,cpu_tag >
+	, public detail::dense_matrix_base<detail::dense_matrix_state<T,O,A>, O> {
 private:
-	typedef typename detail::dense_matrix_base<detail::dense_matrix_state<T>,O> base;
+	typedef typename detail::dense_matrix_base<detail::dense_matrix_state<T,O,A>,O> base;
 
 	struct closure_type_base
 	: public matrix_expression<closure_type_base, cpu_tag >,
-	  public detail::dense_matrix_base<detail::dense_matrix_state<T>, O, boost::mpl::true_>
+	  public detail::dense_matrix_base<detail::dense_matrix_state<T,O,A>, O, boost::mpl::true_>
 	{
-		typedef typename matrix<T,O>::const_closure_type const_closure_type;
-		typedef typename matrix<T,O>::closure_type closure_type;
-		closure_type_base(matrix const& v):detail::dense_matrix_base<detail::dense_matrix_state<T>, O, boost::mpl::true_>(v){}
+		typedef typename matrix<T,O,A>::const_closure_type const_closure_type;
+		typedef typename matrix<T,O,A>::closure_type closure_type;
+		closure_type_base(matrix const& v):detail::dense_matrix_base<detail::dense_matrix_state<T,O,A>, O, boost::mpl::true_>(v){}
 			
 		// -------------------
 		// Assignment operators
 		// -------------------
 			
-		using detail::dense_matrix_base<detail::dense_matrix_state<T>, O, boost::mpl::true_>::operator();
+		using detail::dense_matrix_base<detail::dense_matrix_state<T,O,A>, O, boost::mpl::true_>::operator();
 		
 		/// \brief Operator=
 		matrix& operator = (closure_type_base const& v) {
@@ -299,39 +343,33 @@ private:
 		}
 		
 		/// \brief Clear the matrix, i.e. set all values to the \c zero value.
+		///
+		/// Large matrices are cleared by parallel kernels, and with non-temporal stores
+		/// if they are larger than kernels::tuning().streaming_store_min_size.
 		void clear() {
-			//running via the scheduler is a lot of overhead for a simple operation
-			//so if no kernels are in flight, we can just call the kernel directly
-			//otherwise, we have to enqueue it.
-			if(is_ready()){
-				kernels::assign<scalar_assign>(*this, value_type/*zero*/());
-			}else{
-				closure_type_base closure(*this);
-				system::scheduler().spawn([closure]()mutable{
-					kernels::assign<scalar_assign>(closure, value_type/*zero*/());
-				},this->dependencies());
-			}
+			detail::spawn_fill(*this, value_type/*zero*/());
 		}
 	};
 	
 	struct const_closure_type_base
 	: public matrix_expression<const_closure_type_base, cpu_tag >,
-	  public detail::dense_matrix_base<detail::dense_matrix_state<T> const,O >
+	  public detail::dense_matrix_base<detail::dense_matrix_state<T,O,A> const,O >
 	{
-		typedef typename matrix<T,O>::const_closure_type const_closure_type;
-		typedef typename matrix<T,O>::const_closure_type closure_type;
+		typedef typename matrix<T,O,A>::const_closure_type const_closure_type;
+		typedef typename matrix<T,O,A>::const_closure_type closure_type;
 
-		using detail::dense_matrix_base<detail::dense_matrix_state<T> const,O >::operator();
+		using detail::dense_matrix_base<detail::dense_matrix_state<T,O,A> const,O >::operator();
 		
-		const_closure_type_base(matrix const& v):detail::dense_matrix_base<detail::dense_matrix_state<T> const,O >(v){}
+		const_closure_type_base(matrix const& v):detail::dense_matrix_base<detail::dense_matrix_state<T,O,A> const,O >(v){}
 		//constructor for non-const->const copying
 		const_closure_type_base(closure_type_base const& c)
-		:detail::dense_matrix_base<detail::dense_matrix_state<T> const,O >(c){}
+		:detail::dense_matrix_base<detail::dense_matrix_state<T,O,A> const,O >(c){}
 	};
 
 public:
 	typedef typename base::size_type size_type;
 	typedef typename base::value_type value_type;
+	typedef A allocator_type;
 	typedef closure_type_base closure_type;
 	typedef const_closure_type_base const_closure_type;
 	using base::is_ready;
@@ -347,14 +385,28 @@ public:
 	// Construction and destruction
 
 	/// \brief Default Dense Matrix constructor of size (0,0)
-	matrix():m_internals(new detail::dense_matrix_state<T>()) {
+	/// \param alloc the allocator used for the storage
+	explicit matrix(allocator_type const& alloc = allocator_type()):m_internals(new detail::dense_matrix_state<T,O,A>(alloc)) {
 		set_state(m_internals.get());
 	}
 
 	/// \brief Constructor of a matrix with a predefined size
 	/// \param size1 number of rows of the matrix
 	/// \param size2 number of columns of the matrix
-	matrix(size_type size1, size_type size2):m_internals(new detail::dense_matrix_state<T>(size1,size2)) {
+	/// \param alloc the allocator used for the storage
+	matrix(size_type size1, size_type size2, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_matrix_state<T,O,A>(size1,size2,alloc)) {
+		set_state(m_internals.get());
+	}
+
+	/// \brief Constructor of a matrix with a predefined size whose elements are not initialized
+	///
+	/// All elements must be written before they are read, e.g. by assigning an expression to the matrix.
+	/// \param size1 number of rows of the matrix
+	/// \param size2 number of columns of the matrix
+	/// \param alloc the allocator used for the storage
+	matrix(size_type size1, size_type size2, uninitialized_tag, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_matrix_state<T,O,A>(size1,size2,uninitialized_tag(),alloc)) {
 		set_state(m_internals.get());
 	}
 
@@ -362,13 +414,18 @@ public:
 	/// \param size1 number of rows of the matrix
 	/// \param size2 number of columns of the matrix
 	/// \param init value to assign to each element of the matrix
-	matrix(size_type size1, size_type size2, value_type init):m_internals(new detail::dense_matrix_state<T>(size1,size2, init)) {
+	/// \param alloc the allocator used for the storage
+	matrix(size_type size1, size_type size2, value_type init, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_matrix_state<T,O,A>(size1,size2, init,alloc)) {
 		set_state(m_internals.get());
 	}
 
 	/// \brief Copy-constructor of a matrix
+	///
+	/// The copy uses a copy of the allocator of m.
 	/// \param m is the matrix to be copied
-	matrix(matrix const& m):m_internals(new detail::dense_matrix_state<T>(m.size1(), m.size2())) {
+	matrix(matrix const& m)
+	:m_internals(new detail::dense_matrix_state<T,O,A>(m.size1(), m.size2(), uninitialized_tag(), m.get_allocator())) {
 		set_state(m_internals.get());
 		if(m.is_ready())//m has no kernels in flight, just copy
 			storage() = m.storage();
@@ -381,13 +438,15 @@ public:
 	///Moving a matrix with active kernels is a well defined operation and guaranteed to work and non-blocking.
 	matrix(matrix && m): m_internals(std::move(m.m_internals)){
 		set_state(m_internals.get());
+		m.set_state(nullptr);//m is empty and must not wait for kernels of *this
 	}
 
 	/// \brief Creates a matrix from a matrix_expression
 	/// \param m the matrix_expression which values will be assigned to the matrix
+	/// \param alloc the allocator used for the storage
 	template<class M>
-	matrix(matrix_expression<M, cpu_tag> const& m)
-	:m_internals(new detail::dense_matrix_state<T>(m().size1(),m().size2())){
+	matrix(matrix_expression<M, cpu_tag> const& m, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_matrix_state<T,O,A>(m().size1(),m().size2(),uninitialized_tag(),alloc)){
 		set_state(m_internals.get());
 		assign(*this, m);
 	}
@@ -407,9 +466,7 @@ public:
 	matrix& operator = (matrix const& m) {
 		//if this matrix is not used, we do not need to create a copy
 		if(is_ready()){
-			m_internals->data.resize(m.size1()*m.size2());
-			m_internals->size1 = m.size1;
-			m_internals->size2 = m.size2;
+			m_internals->resize(m.size1(),m.size2());
 			
 			if(m.is_ready())//v has no kernels in flight, just copy
 				storage() = m.storage();
@@ -417,7 +474,7 @@ public:
 				assign(*this,m);//start assignment kernel
 		}else{
 			matrix temporary(m);//start assignment kernel in temporary
-			swap(*this,temporary);//swap detail::dense_matrix_state<T>, destructor of the temporary will transfer ownership to the scheduler
+			swap(*this,temporary);//swap detail::dense_matrix_state<T,O,A>, destructor of the temporary will transfer ownership to the scheduler
 		}
 		return *this;
 	}
@@ -429,6 +486,7 @@ public:
 			system::scheduler().make_closure_variable(*this);
 		m_internals = std::move(m.m_internals);
 		set_state(m_internals.get());
+		m.set_state(nullptr);
 		return *this;
 	}
 	
@@ -440,7 +498,7 @@ public:
 	/// \return a reference to the resulting matrix
 	template<class M>
 	matrix& operator = (matrix_expression<M, cpu_tag> const& m) {
-		matrix temporary(m);
+		matrix temporary(m, get_allocator());
 		swap(*this,temporary);
 		return *this;
 	}
@@ -454,16 +512,19 @@ public:
 		if(new_size1 == size1() && new_size2 == size2())
 			return;
 		if(is_ready()){
-			m_internals->data.resize(new_size1 * new_size1);
-			m_internals->size1 = new_size1;
-			m_internals->size2 = new_size2;
+			m_internals->resize(new_size1, new_size2);
 		}else{
 			//there are still kernels using this matrix, so create a new variable and let the scheduler handle everything
-			matrix temporary(new_size1, new_size2);
+			matrix temporary(new_size1, new_size2, uninitialized_tag(), get_allocator());
 			swap(*this,temporary);
 		}
 	}
 	
+	///\brief Returns a copy of the allocator used by the storage
+	allocator_type get_allocator()const{
+		return storage().get_allocator();
+	}
+	
 	/// \brief Swap the content of two matrices
 	friend void swap(matrix& m1, matrix& m2) {
 		m1.m_internals.swap(m2.m_internals);
@@ -471,30 +532,23 @@ public:
 	}
 	
 	/// \brief Clear the matrix, i.e. set all values to the \c zero value.
+	///
+	/// Large matrices are cleared by parallel kernels, and with non-temporal stores
+	/// if they are larger than kernels::tuning().streaming_store_min_size.
 	void clear() {
-		//running via the scheduler is a lot of overhead for a simple operation
-		//so if no kernels are in flight, we can just call the kernel directly
-		//otherwise, we have to enqueue it.
-		if(is_ready()){
-			kernels::assign<scalar_assign>(*this, value_type/*zero*/());
-		}else{
-			closure_type closure(*this);
-			system::scheduler().spawn([closure]()mutable{
-				kernels::assign<scalar_assign>(closure, value_type/*zero*/());
-			},this->dependencies());
-		}
+		detail::spawn_fill(*this, value_type/*zero*/());
 	}
 private:
-	std::unique_ptr<detail::dense_matrix_state<T> > m_internals;
+	std::unique_ptr<detail::dense_matrix_state<T,O,A> > m_internals;
 };
 template<class T, class L>
 struct matrix_temporary_type<T,L,dense_random_access_iterator_tag, cpu_tag>{
-	typedef matrix<T,L> type;
+	typedef matrix<T,L,typename detail::temporary_allocator<T>::type> type;
 };
 
 template<class T>
 struct matrix_temporary_type<T,unknown_orientation,dense_random_access_iterator_tag, cpu_tag>{
-	typedef matrix<T,row_major> type;
+	typedef matrix<T,row_major,typename detail::temporary_allocator<T>::type> type;
 };
 
 } //namespace aBLAS
@@ -9,6 +9,7 @@
 #include "detail/iterator.hpp"
 #include "kernels/gemm.hpp"
 #include "kernels/gemv.hpp"
+#include "kernels/syrk.hpp"
 
 namespace aBLAS {
 	
@@ -47,6 +48,8 @@ public:
 		elementwise_tag,
 		blockwise_tag
 	>::type evaluation_category;
+	typedef unknown_orientation orientation;
+	typedef Device device_category;
 	// Construction and destruction
 	scalar_matrix():
 		m_size1(0), m_size2(0), m_value() {}
@@ -404,6 +407,314 @@ typename boost::enable_if<
 	return scalar_matrix<T, Device>(e().size1(),e().size2(),t) - e;
 }
 
+///\brief Applies a scalar functor to every element of a matrix expression, X_ij = f(E_ij).
+///
+/// If E is elementwise, the functor is computed inside of the assignment kernel. Otherwise E is evaluated into a temporary first.
+template<class E, class F>
+class matrix_unary:public matrix_expression<matrix_unary<E, F>, typename E::device_category > {
+public:
+	typedef typename E::const_closure_type expression_closure_type;
+	typedef F functor_type;
+
+	typedef typename F::result_type value_type;
+	typedef value_type const_reference;
+	typedef const_reference reference;
+	typedef typename E::size_type size_type;
+	typedef typename E::difference_type difference_type;
+
+	typedef typename E::index_type index_type;
+
+	typedef matrix_unary const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef typename E::orientation orientation;
+	typedef unknown_storage_tag storage_category;
+	typedef typename E::evaluation_category evaluation_category;
+	typedef typename E::device_category device_category;
+
+private:
+	expression_closure_type m_expression;
+	F m_functor;
+public:
+
+	// Construction and destruction
+	matrix_unary(expression_closure_type const& e, F const& functor):
+		m_expression(e), m_functor(functor){}
+
+	// Accessors
+	size_type size1() const {
+		return m_expression.size1();
+	}
+	size_type size2() const {
+		return m_expression.size2();
+	}
+
+	auto dependencies()const -> decltype(this->m_expression.dependencies()){
+		return m_expression.dependencies();
+	}
+	expression_closure_type const &expression() const {
+		return m_expression;
+	}
+	functor_type const& functor() const {
+		return m_functor;
+	}
+
+	// Element access
+	const_reference operator()(index_type i, index_type j) const {
+		return m_functor(m_expression(i, j));
+	}
+
+	//computation kernels, only called for blockwise arguments
+	template<class MatX>
+	void assign_to(matrix_expression<MatX,device_category>& X, typename MatX::value_type alpha = typename MatX::value_type(1) )const{
+		typedef typename matrix_temporary<E>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size1(),size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary& temporary){
+				assign(temporary,m_expression);
+				assign(X, matrix_unary<Temporary,F>(temporary, m_functor), alpha);
+			}
+		);
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX,device_category>& X, typename MatX::value_type alpha = typename MatX::value_type(1) )const{
+		typedef typename matrix_temporary<E>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size1(),size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary& temporary){
+				assign(temporary,m_expression);
+				plus_assign(X, matrix_unary<Temporary,F>(temporary, m_functor), alpha);
+			}
+		);
+	}
+
+	// Iterator types
+	typedef transform_iterator<typename E::const_row_iterator, F> const_row_iterator;
+	typedef transform_iterator<typename E::const_column_iterator, F> const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	const_row_iterator row_begin(index_type i) const {
+		return const_row_iterator(m_expression.row_begin(i),m_functor);
+	}
+	const_row_iterator row_end(index_type i) const {
+		return const_row_iterator(m_expression.row_end(i),m_functor);
+	}
+
+	const_column_iterator column_begin(index_type j) const {
+		return const_column_iterator(m_expression.column_begin(j),m_functor);
+	}
+	const_column_iterator column_end(index_type j) const {
+		return const_column_iterator(m_expression.column_end(j),m_functor);
+	}
+};
+
+///\brief Applies a binary scalar functor to every pair of elements of two matrix expressions, X_ij = f(E1_ij,E2_ij).
+///
+/// If one of the arguments is blockwise, both are evaluated into temporaries first.
+template<class E1, class E2, class F>
+class matrix_binary: public matrix_expression<matrix_binary<E1, E2, F>, typename E1::device_category > {
+public:
+	typedef typename E1::const_closure_type lhs_closure_type;
+	typedef typename E2::const_closure_type rhs_closure_type;
+	typedef F functor_type;
+
+	typedef typename E1::size_type size_type;
+	typedef typename E1::difference_type difference_type;
+	typedef typename F::result_type value_type;
+	typedef value_type const_reference;
+	typedef const_reference reference;
+	typedef typename E1::index_type index_type;
+
+	typedef matrix_binary const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef typename E1::orientation orientation;
+	typedef unknown_storage_tag storage_category;
+	typedef typename evaluation_restrict_traits<E1,E2>::type evaluation_category;
+	typedef typename E1::device_category device_category;
+
+	// Construction
+	matrix_binary(
+		lhs_closure_type const& e1,
+		rhs_closure_type const& e2,
+		F const& functor
+	): m_lhs(e1), m_rhs(e2), m_functor(functor){
+		ABLAS_SIZE_CHECK(e1.size1() == e2.size1());
+		ABLAS_SIZE_CHECK(e1.size2() == e2.size2());
+	}
+
+	// Accessors
+	size_type size1 () const {
+		return m_lhs.size1();
+	}
+	size_type size2 () const {
+		return m_lhs.size2();
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return gather_dependencies(m_lhs.dependencies(),m_rhs.dependencies());
+	}
+	lhs_closure_type const& expression1() const {
+		return m_lhs;
+	}
+	rhs_closure_type const& expression2() const {
+		return m_rhs;
+	}
+	functor_type const& functor() const {
+		return m_functor;
+	}
+
+	const_reference operator () (index_type i, index_type j) const {
+		return m_functor(m_lhs(i, j), m_rhs(i,j));
+	}
+
+	//computation kernels, only called if one of the arguments is blockwise
+	template<class MatX>
+	void assign_to(matrix_expression<MatX,device_category>& X, typename MatX::value_type alpha = typename MatX::value_type(1) )const{
+		typedef typename matrix_temporary<E1>::type Temporary1;
+		typedef typename matrix_temporary<E2>::type Temporary2;
+		system::scheduler().create_closure(
+			Temporary1(size1(),size2(), uninitialized_tag()),
+			Temporary2(size1(),size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary1& temp1, Temporary2& temp2){
+				assign(temp1,m_lhs);
+				assign(temp2,m_rhs);
+				assign(X, matrix_binary<Temporary1,Temporary2,F>(temp1,temp2, m_functor), alpha);
+			}
+		);
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX,device_category>& X, typename MatX::value_type alpha = typename MatX::value_type(1) )const{
+		typedef typename matrix_temporary<E1>::type Temporary1;
+		typedef typename matrix_temporary<E2>::type Temporary2;
+		system::scheduler().create_closure(
+			Temporary1(size1(),size2(), uninitialized_tag()),
+			Temporary2(size1(),size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary1& temp1, Temporary2& temp2){
+				assign(temp1,m_lhs);
+				assign(temp2,m_rhs);
+				plus_assign(X, matrix_binary<Temporary1,Temporary2,F>(temp1,temp2, m_functor), alpha);
+			}
+		);
+	}
+
+	// Iterator types
+	typedef binary_transform_iterator<
+		typename E1::const_row_iterator,
+		typename E2::const_row_iterator,
+		F
+	> const_row_iterator;
+	typedef binary_transform_iterator<
+		typename E1::const_column_iterator,
+		typename E2::const_column_iterator,
+		F
+	> const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	const_row_iterator row_begin(index_type i) const {
+		return const_row_iterator (m_functor,
+			m_lhs.row_begin(i),m_lhs.row_end(i),
+			m_rhs.row_begin(i),m_rhs.row_end(i)
+		);
+	}
+	const_row_iterator row_end(index_type i) const {
+		return const_row_iterator (m_functor,
+			m_lhs.row_end(i),m_lhs.row_end(i),
+			m_rhs.row_end(i),m_rhs.row_end(i)
+		);
+	}
+
+	const_column_iterator column_begin(index_type j) const {
+		return const_column_iterator (m_functor,
+			m_lhs.column_begin(j),m_lhs.column_end(j),
+			m_rhs.column_begin(j),m_rhs.column_end(j)
+		);
+	}
+	const_column_iterator column_end(index_type j) const {
+		return const_column_iterator (m_functor,
+			m_lhs.column_end(j),m_lhs.column_end(j),
+			m_rhs.column_end(j),m_rhs.column_end(j)
+		);
+	}
+
+private:
+	lhs_closure_type m_lhs;
+	rhs_closure_type m_rhs;
+	F m_functor;
+};
+
+#define ABLAS_UNARY_MATRIX_TRANSFORMATION(name, F)\
+template<class E, class Device>\
+matrix_unary<E,F<typename E::value_type> >\
+name(matrix_expression<E, Device> const& e){\
+	typedef F<typename E::value_type> functor_type;\
+	return matrix_unary<E, functor_type>(e(), functor_type());\
+}
+ABLAS_UNARY_MATRIX_TRANSFORMATION(exp, scalar_exp)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(log, scalar_log)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(sqrt, scalar_sqrt)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(abs, scalar_abs)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(sqr, scalar_sqr)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(tanh, scalar_tanh)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(atanh, scalar_atanh)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(sigmoid, scalar_sigmoid)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(erf, scalar_erf)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(sin, scalar_sin)
+ABLAS_UNARY_MATRIX_TRANSFORMATION(cos, scalar_cos)
+#undef ABLAS_UNARY_MATRIX_TRANSFORMATION
+
+///\brief Applies a functor with a scalar argument to every element, e.g. pow(A,2) or max(A,0) or A < 1.
+///
+/// The comparisons return matrices of 0 and 1.
+#define ABLAS_MATRIX_SCALAR_TRANSFORMATION(name, F)\
+template<class E, class T, class Device>\
+typename boost::enable_if<\
+	boost::is_convertible<T, typename E::value_type>,\
+	matrix_unary<E,F<typename E::value_type,T> >\
+>::type name(matrix_expression<E, Device> const& e, T t){\
+	typedef F<typename E::value_type,T> functor_type;\
+	return matrix_unary<E, functor_type>(e(), functor_type(t));\
+}
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(pow, scalar_pow)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(min, scalar_min)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(max, scalar_max)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator<, scalar_less_than)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator<=, scalar_less_equal_than)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator>, scalar_bigger_than)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator>=, scalar_bigger_equal_than)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator==, scalar_equal)
+ABLAS_MATRIX_SCALAR_TRANSFORMATION(operator!=, scalar_not_equal)
+#undef ABLAS_MATRIX_SCALAR_TRANSFORMATION
+
+///\brief Combines the elements of two matrices, e.g. element_prod(A,B) or max(A,B).
+#define ABLAS_BINARY_MATRIX_TRANSFORMATION(name, F)\
+template<class E1, class E2, class Device>\
+matrix_binary<E1,E2,F<typename E1::value_type, typename E2::value_type> >\
+name(matrix_expression<E1, Device> const& e1, matrix_expression<E2, Device> const& e2){\
+	typedef F<typename E1::value_type, typename E2::value_type> functor_type;\
+	return matrix_binary<E1,E2, functor_type>(e1(),e2(), functor_type());\
+}
+ABLAS_BINARY_MATRIX_TRANSFORMATION(element_prod, scalar_binary_multiply)
+ABLAS_BINARY_MATRIX_TRANSFORMATION(element_div, scalar_binary_divide)
+ABLAS_BINARY_MATRIX_TRANSFORMATION(pow, scalar_binary_pow)
+ABLAS_BINARY_MATRIX_TRANSFORMATION(min, scalar_binary_min)
+ABLAS_BINARY_MATRIX_TRANSFORMATION(max, scalar_binary_max)
+#undef ABLAS_BINARY_MATRIX_TRANSFORMATION
+
+///\brief Divides two matrices elementwise, returning default_value where the divisor is zero.
+template<class E1, class E2, class T, class Device>
+typename boost::enable_if<
+	boost::is_convertible<T, typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type>,
+	matrix_binary<E1,E2,scalar_binary_safe_divide<typename E1::value_type, typename E2::value_type> >
+>::type safe_div(
+	matrix_expression<E1, Device> const& e1,
+	matrix_expression<E2, Device> const& e2,
+	T default_value
+){
+	typedef scalar_binary_safe_divide<typename E1::value_type, typename E2::value_type> functor_type;
+	return matrix_binary<E1,E2, functor_type>(e1(),e2(), functor_type(default_value));
+}
+
 template<class MatA, class VecV>
 class matrix_vector_prod:
 	public vector_expression<matrix_vector_prod<MatA, VecV>, typename MatA::device_category > {
@@ -455,68 +766,95 @@ public:
 	//computation kernels
 	template<class VecX>
 	void assign_to(vector_expression<VecX, device_category>& x, value_type alpha = value_type(1) )const{
-		x().clear();
-		plus_assign_to(x,alpha);
+		//beta=0 overwrites x, so there is no need to clear it first
+		prod_assign_to(x(),alpha, value_type(), typename matrix_closure_type::evaluation_category(), typename vector_closure_type::evaluation_category());
 	}
 	template<class VecX>
 	void plus_assign_to(vector_expression<VecX, device_category>& x, value_type alpha = value_type(1) )const{
 		//dispatch based on whether the arguments require the creation of intermediate results
-		plus_assign_to(x(),alpha, typename matrix_closure_type::evaluation_category(), typename vector_closure_type::evaluation_category());
+		prod_assign_to(x(),alpha, value_type(1), typename matrix_closure_type::evaluation_category(), typename vector_closure_type::evaluation_category());
 	}
 	
 private:
+	//computes x=beta*x+alpha*Av
 	template<class VecX>
-	void plus_assign_to(VecX& x, value_type alpha, elementwise_tag, elementwise_tag)const{
-		start_kernel(x,alpha,m_matrix, m_vector, device_category());
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, elementwise_tag, elementwise_tag)const{
+		start_kernel(x,alpha,beta,m_matrix, m_vector, device_category());
 	}
 	
 	template<class VecX>
-	void plus_assign_to(VecX& x, value_type alpha, blockwise_tag, elementwise_tag)const{
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, blockwise_tag, elementwise_tag)const{
 		typedef typename matrix_temporary<matrix_closure_type>::type Temporary;
 		system::scheduler().create_closure(
-			Temporary(m_matrix.size1(),m_matrix.size2()),
-			[this, &x,alpha](Temporary& temporary){
+			Temporary(m_matrix.size1(),m_matrix.size2(), uninitialized_tag()),
+			[this, &x,alpha,beta](Temporary& temporary){
 				assign(temporary,m_matrix);
-				start_kernel(x,alpha,temporary, m_vector, device_category());
+				start_kernel(x,alpha,beta,temporary, m_vector, device_category());
 			}
 		);
 	}
 	
 	template<class VecX>
-	void plus_assign_to(VecX& x, value_type alpha, elementwise_tag, blockwise_tag)const{
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, elementwise_tag, blockwise_tag)const{
 		typedef typename vector_temporary<vector_closure_type>::type Temporary;
 		system::scheduler().create_closure(
-			Temporary(m_vector.size()),
-			[this, &x,alpha](Temporary& temporary){
-				assign(temporary,m_matrix);
-				start_kernel(x,alpha,m_matrix, temporary, device_category());
+			Temporary(m_vector.size(), uninitialized_tag()),
+			[this, &x,alpha,beta](Temporary& temporary){
+				assign(temporary,m_vector);
+				start_kernel(x,alpha,beta,m_matrix, temporary, device_category());
 			}
 		);
 	}
 	
 	template<class VecX>
-	void plus_assign_to(VecX& x, value_type alpha, blockwise_tag, blockwise_tag)const{
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, blockwise_tag, blockwise_tag)const{
 		typedef typename matrix_temporary<matrix_closure_type>::type TemporaryM;
 		typedef typename vector_temporary<vector_closure_type>::type TemporaryV;
 		system::scheduler().create_closure(
-			TemporaryM(m_matrix.size1(),m_matrix.size2()),
-			TemporaryV(m_vector.size()),
-			[this, &x,alpha](TemporaryM& tempM, TemporaryV& tempV){
+			TemporaryM(m_matrix.size1(),m_matrix.size2(), uninitialized_tag()),
+			TemporaryV(m_vector.size(), uninitialized_tag()),
+			[this, &x,alpha,beta](TemporaryM& tempM, TemporaryV& tempV){
 				assign(tempM,m_matrix);
 				assign(tempV,m_vector);
-				start_kernel(x,alpha,tempM, tempV, device_category());
+				start_kernel(x,alpha,beta,tempM, tempV, device_category());
 			}
 		);
 	}
 
 	//the actual kernel calling routine (cpu version)
 	template<class VecX, class MatrixA, class ArgV>
-	void start_kernel(VecX& x, value_type alpha, MatrixA const& A, ArgV const& v,cpu_tag)const{
-		typename VecX::closure_type x_closure(x());
-		typename ArgV::const_closure_type v_closure(v());
-		typename MatrixA::const_closure_type A_closure(A());
-		system::scheduler().spawn([alpha, x_closure, v_closure, A_closure](){
-			kernels::gemv(A_closure, v_closure, x_closure, alpha);
+	void start_kernel(VecX& x, value_type alpha, value_type beta, MatrixA const& A, ArgV const& v,cpu_tag)const{
+		typedef typename bindings::has_blocked_gemv<VecX,MatrixA,ArgV>::type blocked;
+		start_kernel(x, alpha, beta, A, v, blocked());
+	}
+	
+	//products computed by the blocked kernels are split into ranges of rows computed in parallel if A is large enough
+	template<class VecX, class MatrixA, class ArgV>
+	void start_kernel(VecX& x, value_type alpha, value_type beta, MatrixA const& A, ArgV const& v, boost::mpl::true_)const{
+		typedef typename bindings::has_optimized_gemv<VecX,MatrixA,ArgV>::type optimized;
+		bool binding = optimized::value && A.size1() * A.size2() >= kernels::tuning().gemv_binding_min_size_for(A.size1(), A.size2());
+		std::vector<std::size_t> bounds = detail::parallel_assign_ranges(
+			A.size1(), A.size2() * sizeof(typename MatrixA::value_type), system::scheduler().concurrency()
+		);
+		if(binding || bounds.size() <= 2){
+			start_kernel(x, alpha, beta, A, v, boost::mpl::false_());
+			return;
+		}
+		typename VecX::closure_type x_closure(x);
+		typename ArgV::const_closure_type v_closure(v);
+		typename MatrixA::const_closure_type A_closure(A);
+		detail::spawn_parallel_assign(bounds, [alpha, beta, x_closure, v_closure, A_closure](std::size_t start, std::size_t end)mutable{
+			kernels::gemv(A_closure, v_closure, x_closure, alpha, beta, start, end);
+		},x.dependencies(),gather_dependencies(v.dependencies(),A.dependencies()));
+	}
+	
+	template<class VecX, class MatrixA, class ArgV>
+	void start_kernel(VecX& x, value_type alpha, value_type beta, MatrixA const& A, ArgV const& v, boost::mpl::false_)const{
+		typename VecX::closure_type x_closure(x);
+		typename ArgV::const_closure_type v_closure(v);
+		typename MatrixA::const_closure_type A_closure(A);
+		system::scheduler().spawn([alpha, beta, x_closure, v_closure, A_closure]()mutable{
+			kernels::gemv(A_closure, v_closure, x_closure, alpha, beta);
 		},x.dependencies(),v.dependencies(),A.dependencies());
 	}
 
@@ -542,9 +880,70 @@ prod(vector_expression<VecV, Device> const& v,matrix_expression<MatA, Device> co
 	return matrix_vector_prod<matrix_transpose<MatA>,VecV>(trans(A),v());
 }
 
+///\brief Epilogue adding a vector to every row of a product: X(i,j) = e(i,j,X(i,j)) + v(j).
+template<class Epilogue, class V>
+class row_broadcast_epilogue{
+public:
+	row_broadcast_epilogue(Epilogue const& epilogue, typename V::const_closure_type const& v)
+	:m_epilogue(epilogue), m_vector(v){}
+
+	template<class T>
+	T operator()(std::size_t i, std::size_t j, T value)const{
+		return T(m_epilogue(i,j,value) + m_vector(j));
+	}
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return gather_dependencies(m_epilogue.dependencies(), m_vector.dependencies());
+	}
+private:
+	Epilogue m_epilogue;
+	typename V::const_closure_type m_vector;
+};
+
+///\brief Epilogue adding a vector to every column of a product: X(i,j) = e(i,j,X(i,j)) + v(i).
+template<class Epilogue, class V>
+class column_broadcast_epilogue{
+public:
+	column_broadcast_epilogue(Epilogue const& epilogue, typename V::const_closure_type const& v)
+	:m_epilogue(epilogue), m_vector(v){}
+
+	template<class T>
+	T operator()(std::size_t i, std::size_t j, T value)const{
+		return T(m_epilogue(i,j,value) + m_vector(i));
+	}
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return gather_dependencies(m_epilogue.dependencies(), m_vector.dependencies());
+	}
+private:
+	Epilogue m_epilogue;
+	typename V::const_closure_type m_vector;
+};
+
+///\brief Epilogue applying a scalar functor to every element of a product: X(i,j) = f(e(i,j,X(i,j))).
+template<class Epilogue, class F>
+class transform_epilogue{
+public:
+	transform_epilogue(Epilogue const& epilogue, F const& f)
+	:m_epilogue(epilogue), m_functor(f){}
+
+	template<class T>
+	T operator()(std::size_t i, std::size_t j, T value)const{
+		return T(m_functor(m_epilogue(i,j,value)));
+	}
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return m_epilogue.dependencies();
+	}
+private:
+	Epilogue m_epilogue;
+	F m_functor;
+};
+
 //matrix-matrix prod
-template<class MatA, class MatB>
-class matrix_matrix_prod: public matrix_expression<matrix_matrix_prod<MatA, MatB>, typename MatA::device_category > {
+///\brief Product of two matrices, optionally followed by an epilogue which is applied inside of the gemm kernel.
+///
+/// The epilogue computes the final value of each element of the product, see identity_epilogue.
+/// Assigning the product computes X = alpha*f(AB) with the epilogue f.
+template<class MatA, class MatB, class Epilogue = identity_epilogue>
+class matrix_matrix_prod: public matrix_expression<matrix_matrix_prod<MatA, MatB, Epilogue>, typename MatA::device_category > {
 public:
 	typedef typename MatA::const_closure_type matrix_closure_typeA;
 	typedef typename MatB::const_closure_type matrix_closure_typeB;
@@ -557,7 +956,7 @@ public:
 	typedef typename MatA::difference_type difference_type;
 	typedef typename MatA::index_type index_type;
 
-	typedef matrix_matrix_prod<MatA, MatB> const_closure_type;
+	typedef matrix_matrix_prod<MatA, MatB, Epilogue> const_closure_type;
 	typedef const_closure_type closure_type;
 	typedef unknown_storage_tag storage_category;
 	typedef blockwise_tag evaluation_category;
@@ -575,8 +974,9 @@ public:
 	// Construction and destruction
 	matrix_matrix_prod(
 		matrix_closure_typeA const& matrixA,
-		matrix_closure_typeB const& matrixB
-	):m_matrixA(matrixA), m_matrixB(matrixB) {}
+		matrix_closure_typeB const& matrixB,
+		Epilogue const& epilogue = Epilogue()
+	):m_matrixA(matrixA), m_matrixB(matrixB), m_epilogue(epilogue) {}
 
 	size_type size1() const {
 		return m_matrixA.size1();
@@ -591,6 +991,9 @@ public:
 	matrix_closure_typeB const& matrixB() const {
 		return m_matrixB;
 	}
+	Epilogue const& epilogue() const {
+		return m_epilogue;
+	}
 	
 	std::vector<scheduling::dependency_node*> dependencies()const{
 		return std::vector<scheduling::dependency_node*>();
@@ -599,72 +1002,95 @@ public:
 	//computation kernels
 	template<class MatX>
 	void assign_to(matrix_expression<MatX,device_category>& X, value_type alpha = value_type(1) )const{
-		X().clear();
-		plus_assign_to(X,alpha);
+		//beta=0 overwrites X, so there is no need to clear it first
+		prod_assign_to(X(),alpha, value_type(), typename matrix_closure_typeA::evaluation_category(), typename matrix_closure_typeB::evaluation_category());
 	}
 	template<class MatX>
 	void plus_assign_to(matrix_expression<MatX, device_category>& X, value_type alpha = value_type(1) )const{
-		plus_assign_to(X(),alpha, typename matrix_closure_typeA::evaluation_category(), typename matrix_closure_typeB::evaluation_category());
+		prod_assign_to(X(),alpha, value_type(1), typename matrix_closure_typeA::evaluation_category(), typename matrix_closure_typeB::evaluation_category());
 	}
 	
 private:
+	//computes X=beta*X+alpha*AB
 	template<class MatX>
-	void plus_assign_to(MatX& X, value_type alpha, elementwise_tag, elementwise_tag)const{
-		start_kernel(X,alpha,m_matrixA, m_matrixB, device_category());
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, elementwise_tag, elementwise_tag)const{
+		start_kernel(X,alpha,beta,m_matrixA, m_matrixB, device_category());
 	}
 	
 	template<class MatX>
-	void plus_assign_to(MatX& X, value_type alpha, blockwise_tag, elementwise_tag)const{
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, blockwise_tag, elementwise_tag)const{
 		typedef typename matrix_temporary<matrix_closure_typeA>::type Temporary;
 		system::scheduler().create_closure(
-			Temporary(m_matrixA.size1(),m_matrixA.size2()),
-			[this, &X,alpha](Temporary& temporary){
+			Temporary(m_matrixA.size1(),m_matrixA.size2(), uninitialized_tag()),
+			[this, &X,alpha,beta](Temporary& temporary){
 				assign(temporary,m_matrixA);
-				start_kernel(X,alpha,temporary, m_matrixB, device_category());
+				start_kernel(X,alpha,beta,temporary, m_matrixB, device_category());
 			}
 		);
 	}
 	
 	template<class MatX>
-	void plus_assign_to(MatX& X, value_type alpha, elementwise_tag, blockwise_tag)const{
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, elementwise_tag, blockwise_tag)const{
 		typedef typename matrix_temporary<matrix_closure_typeB>::type Temporary;
 		system::scheduler().create_closure(
-			Temporary(m_matrixA.size1(),m_matrixA.size2()),
-			[this, &X,alpha](Temporary& temporary){
+			Temporary(m_matrixB.size1(),m_matrixB.size2(), uninitialized_tag()),
+			[this, &X,alpha,beta](Temporary& temporary){
 				assign(temporary,m_matrixB);
-				start_kernel(X,alpha,m_matrixA, temporary, device_category());
+				start_kernel(X,alpha,beta,m_matrixA, temporary, device_category());
 			}
 		);
 	}
 	
 	template<class MatX>
-	void plus_assign_to(MatX& X, value_type alpha, blockwise_tag, blockwise_tag)const{
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, blockwise_tag, blockwise_tag)const{
 		typedef typename matrix_temporary<matrix_closure_typeA>::type TemporaryA;
 		typedef typename matrix_temporary<matrix_closure_typeB>::type TemporaryB;
 		system::scheduler().create_closure(
-			TemporaryA(m_matrixA.size1(),m_matrixA.size2()),
-			TemporaryB(m_matrixB.size1(),m_matrixB.size2()),
-			[this, &X,alpha](TemporaryA& tempA, TemporaryB& tempB){
+			TemporaryA(m_matrixA.size1(),m_matrixA.size2(), uninitialized_tag()),
+			TemporaryB(m_matrixB.size1(),m_matrixB.size2(), uninitialized_tag()),
+			[this, &X,alpha,beta](TemporaryA& tempA, TemporaryB& tempB){
 				assign(tempA, m_matrixA);
 				assign(tempB, m_matrixB);
-				start_kernel(X,alpha,tempA, tempB, device_category());
+				start_kernel(X,alpha,beta,tempA, tempB, device_category());
 			}
 		);
 	}
 
 	//the actual kernel calling routine (cpu version)
 	template<class MatrixX, class MatrixA, class MatrixB>
-	void start_kernel(MatrixX& X, value_type alpha, MatrixA const& A, MatrixB const& B,cpu_tag)const{
+	void start_kernel(MatrixX& X, value_type alpha, value_type beta, MatrixA const& A, MatrixB const& B,cpu_tag)const{
+		typedef typename boost::is_same<Epilogue, identity_epilogue>::type plain_product;
+		start_kernel(X,alpha,beta,A,B,plain_product());
+	}
+	
+	//products of an expression with its own transpose, e.g. prod(A,trans(A)), are symmetric and computed by syrk
+	template<class MatrixX, class MatrixA, class MatrixB>
+	void start_kernel(MatrixX& X, value_type alpha, value_type beta, MatrixA const& A, MatrixB const& B, boost::mpl::true_)const{
+		if(!kernels::is_transpose_of(A,B)){
+			start_kernel(X,alpha,beta,A,B,boost::mpl::false_());
+			return;
+		}
+		typename MatrixX::closure_type X_closure(X);
+		typename MatrixA::const_closure_type A_closure(A);
+		system::scheduler().spawn([alpha, beta, X_closure, A_closure]()mutable{
+			kernels::syrk(A_closure, X_closure, alpha, beta);
+		},X.dependencies(),gather_dependencies(A.dependencies(),B.dependencies()));
+	}
+	
+	template<class MatrixX, class MatrixA, class MatrixB>
+	void start_kernel(MatrixX& X, value_type alpha, value_type beta, MatrixA const& A, MatrixB const& B, boost::mpl::false_)const{
 		typename MatrixX::closure_type X_closure(X);
 		typename MatrixA::const_closure_type A_closure(A);
 		typename MatrixB::const_closure_type B_closure(B);
-		system::scheduler().spawn([alpha, X_closure, A_closure, B_closure]()mutable{
-			kernels::gemm(A_closure, B_closure, X_closure, alpha);
-		},X.dependencies(),A.dependencies(),B.dependencies());
+		Epilogue epilogue = m_epilogue;
+		system::scheduler().spawn([alpha, beta, X_closure, A_closure, B_closure, epilogue]()mutable{
+			kernels::gemm(A_closure, B_closure, X_closure, alpha, beta, epilogue);
+		},X.dependencies(),gather_dependencies(gather_dependencies(A.dependencies(),B.dependencies()),m_epilogue.dependencies()));
 	}
 	
 	matrix_closure_typeA m_matrixA;
 	matrix_closure_typeB m_matrixB;
+	Epilogue m_epilogue;
 };
 
 /// \brief computes the matrix-matrix product X+=AB
@@ -676,6 +1102,54 @@ matrix_matrix_prod<MatA,MatB> prod(
 	return matrix_matrix_prod<MatA,MatB>(A(),B());
 }
 
+/// \brief Adds v to every row of the product, X(i,j) = (AB)(i,j) + v(j).
+///
+/// The addition is computed by the gemm kernel while the result is in cache, e.g.
+/// noalias(Y) = add_to_rows(prod(X,W),bias) computes the affine map of all rows of X in a single pass over Y.
+/// v must be a vector container or proxy.
+template<class MatA, class MatB, class Epilogue, class V>
+matrix_matrix_prod<MatA,MatB,row_broadcast_epilogue<Epilogue,V> > add_to_rows(
+	matrix_matrix_prod<MatA,MatB,Epilogue> const& product,
+	vector_expression<V, cpu_tag> const& v
+) {
+	ABLAS_SIZE_CHECK(v().size() == product.size2());
+	return matrix_matrix_prod<MatA,MatB,row_broadcast_epilogue<Epilogue,V> >(
+		product.matrixA(),product.matrixB(),
+		row_broadcast_epilogue<Epilogue,V>(product.epilogue(),v())
+	);
+}
+
+/// \brief Adds v to every column of the product, X(i,j) = (AB)(i,j) + v(i).
+///
+/// The addition is computed by the gemm kernel while the result is in cache. v must be a vector container or proxy.
+template<class MatA, class MatB, class Epilogue, class V>
+matrix_matrix_prod<MatA,MatB,column_broadcast_epilogue<Epilogue,V> > add_to_columns(
+	matrix_matrix_prod<MatA,MatB,Epilogue> const& product,
+	vector_expression<V, cpu_tag> const& v
+) {
+	ABLAS_SIZE_CHECK(v().size() == product.size1());
+	return matrix_matrix_prod<MatA,MatB,column_broadcast_epilogue<Epilogue,V> >(
+		product.matrixA(),product.matrixB(),
+		column_broadcast_epilogue<Epilogue,V>(product.epilogue(),v())
+	);
+}
+
+/// \brief Applies the scalar functor f to every element of the product, X(i,j) = f((AB)(i,j)).
+///
+/// f is applied by the gemm kernel while the result is in cache, e.g.
+/// transform_elements(add_to_rows(prod(X,W),bias), scalar_tanh<float>()) computes a layer of a neural network.
+/// f can be any of the unary functors in detail/functional.hpp, e.g. scalar_max<T,T>(0) for a rectifier.
+template<class MatA, class MatB, class Epilogue, class F>
+matrix_matrix_prod<MatA,MatB,transform_epilogue<Epilogue,F> > transform_elements(
+	matrix_matrix_prod<MatA,MatB,Epilogue> const& product,
+	F const& f
+) {
+	return matrix_matrix_prod<MatA,MatB,transform_epilogue<Epilogue,F> >(
+		product.matrixA(),product.matrixB(),
+		transform_epilogue<Epilogue,F>(product.epilogue(),f)
+	);
+}
+
 }
 
 #endif
@@ -118,7 +118,7 @@ public:
 	}
 	
 	///\brief Returns the internal matrix storage
-	storage_type storage()const{
+	storage_type& storage()const{
 		return expression().storage();
 	}
 	
@@ -287,7 +287,7 @@ public:
 	}
 	
 	///\brief Returns the internal matrix storage
-	storage_type storage()const{
+	storage_type& storage()const{
 		return expression().storage();
 	}
 	
@@ -339,10 +339,7 @@ public:
 	}
 	
 	void clear(){
-		closure_type closure(*this);
-		system::scheduler().spawn([closure]()mutable{
-			kernels::assign<scalar_assign>(closure,value_type/* zero */());
-		},dependencies());
+		detail::spawn_fill(*this,value_type/* zero */());
 	}
 	
 private:
@@ -447,7 +444,7 @@ public:
 	}
 	
 	///\brief Returns the internal matrix storage
-	storage_type storage()const{
+	storage_type& storage()const{
 		return expression().storage();
 	}
 	
@@ -505,10 +502,7 @@ public:
 	}
 	
 	void clear(){
-		closure_type closure(*this);
-		system::scheduler().spawn([closure]()mutable{
-			kernels::assign<scalar_assign>(closure,value_type/* zero */());
-		},dependencies());
+		detail::spawn_fill(*this,value_type/* zero */());
 	}
 
 private:
@@ -626,7 +620,7 @@ public:
 	}
 	
 	///\brief Returns the internal matrix storage
-	storage_type storage()const{
+	storage_type& storage()const{
 		return expression().storage();
 	}
 	
@@ -707,10 +701,7 @@ public:
 	}
 	
 	void clear(){
-		closure_type closure(*this);
-		system::scheduler().spawn([closure]()mutable{
-			kernels::assign<scalar_assign>(closure,value_type/* zero */());
-		},dependencies());
+		detail::spawn_fill(*this,value_type/* zero */());
 	}
 
 private:
@@ -0,0 +1,351 @@
+/*!
+ *
+ *
+ * \brief       Stacks of equally sized matrices and batched products on them
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_MATRIX_STACK_HPP
+#define ABLAS_MATRIX_STACK_HPP
+
+#include "matrix.hpp"
+#include "matrix_proxy.hpp"
+#include "kernels/gemm_batched.hpp"
+
+#include <boost/type_traits/is_same.hpp>
+#include <functional>
+#include <vector>
+
+namespace aBLAS{
+
+/// \brief Closure of a matrix_stack.
+///
+/// Stores a closure of the matrix holding all slices. Copies are cheap and refer to the same slices,
+/// so it can be captured by kernels.
+template<class M>
+class matrix_stack_closure{
+public:
+	typedef std::size_t size_type;
+	typedef typename M::value_type value_type;
+	typedef typename M::orientation orientation;
+	typedef matrix_range<M> slice_type;
+
+	matrix_stack_closure(M const& matrix, size_type size, size_type size1, size_type size2)
+	:m_matrix(matrix), m_size(size), m_size1(size1), m_size2(size2){}
+
+	//conversion closure->const_closure
+	template<class E>
+	matrix_stack_closure(matrix_stack_closure<E> const& other)
+	:m_matrix(other.stacked_matrix()), m_size(other.size()), m_size1(other.size1()), m_size2(other.size2()){}
+
+	///\brief Returns the number of matrices in the stack.
+	size_type size()const{
+		return m_size;
+	}
+	///\brief Returns the number of rows of every matrix in the stack.
+	size_type size1()const{
+		return m_size1;
+	}
+	///\brief Returns the number of columns of every matrix in the stack.
+	size_type size2()const{
+		return m_size2;
+	}
+
+	///\brief Returns the k-th matrix of the stack.
+	slice_type operator[](size_type k)const{
+		if(boost::is_same<orientation,row_major>::value)
+			return slice_type(m_matrix, range(k*m_size1,(k+1)*m_size1), range(0,m_size2));
+		else
+			return slice_type(m_matrix, range(0,m_size1), range(k*m_size2,(k+1)*m_size2));
+	}
+
+	///\brief Returns the matrix holding all slices.
+	M const& stacked_matrix()const{
+		return m_matrix;
+	}
+
+	///\brief Returns the dependencies of the stack. All slices share them.
+	scheduling::dependency_node& dependencies() const{
+		return m_matrix.dependencies();
+	}
+private:
+	M m_matrix;
+	size_type m_size;
+	size_type m_size1;
+	size_type m_size2;
+};
+
+/// \brief A stack of equally sized dense matrices in one block of memory.
+///
+/// This is the container for batches of small matrix operations, e.g. gemm_batched.
+/// The matrices are stored as slices of one matrix: for row_major the slices are stacked on top of each other,
+/// a matrix of size (size()*size1(), size2()), and for column_major next to each other, a matrix of size
+/// (size1(), size()*size2()). Thus every slice is a dense matrix with the leading dimension of the stack.
+///
+/// All slices share one dependency_node, so a kernel writing to one slice has to wait for all kernels reading any slice.
+/// Batched operations take this into account by splitting the batch into a few kernels which are computed in parallel.
+///
+/// \tparam T the type of object stored in the matrices (like double, float, complex, etc...)
+/// \tparam O the storage organization of every matrix. It can be either \c row_major or \c column_major. Default is \c row_major
+/// \tparam A the allocator of the storage
+template<class T, class O=row_major, class A = typename detail::default_allocator<T>::type>
+class matrix_stack{
+public:
+	typedef matrix<T,O,A> matrix_type;
+	typedef std::size_t size_type;
+	typedef T value_type;
+	typedef A allocator_type;
+	typedef O orientation;
+	typedef typename matrix_type::reference reference;
+	typedef typename matrix_type::const_reference const_reference;
+	typedef matrix_stack_closure<typename matrix_type::closure_type> closure_type;
+	typedef matrix_stack_closure<typename matrix_type::const_closure_type> const_closure_type;
+	typedef typename closure_type::slice_type slice_type;
+	typedef typename const_closure_type::slice_type const_slice_type;
+
+	/// \brief Creates an empty stack
+	/// \param alloc the allocator used for the storage
+	explicit matrix_stack(allocator_type const& alloc = allocator_type())
+	:m_matrix(alloc), m_size(0), m_size1(0), m_size2(0){}
+
+	/// \brief Creates a stack of size matrices of size (size1,size2)
+	/// \param size number of matrices
+	/// \param size1 number of rows of every matrix
+	/// \param size2 number of columns of every matrix
+	/// \param alloc the allocator used for the storage
+	matrix_stack(size_type size, size_type size1, size_type size2, allocator_type const& alloc = allocator_type())
+	:m_matrix(stacked_size1(size,size1), stacked_size2(size,size2), alloc), m_size(size), m_size1(size1), m_size2(size2){}
+
+	/// \brief Creates a stack of matrices whose elements are not initialized
+	/// \param size number of matrices
+	/// \param size1 number of rows of every matrix
+	/// \param size2 number of columns of every matrix
+	/// \param alloc the allocator used for the storage
+	matrix_stack(size_type size, size_type size1, size_type size2, uninitialized_tag, allocator_type const& alloc = allocator_type())
+	:m_matrix(stacked_size1(size,size1), stacked_size2(size,size2), uninitialized_tag(), alloc), m_size(size), m_size1(size1), m_size2(size2){}
+
+	/// \brief Creates a stack of matrices with all elements initialized to an initial value
+	/// \param size number of matrices
+	/// \param size1 number of rows of every matrix
+	/// \param size2 number of columns of every matrix
+	/// \param init value to assign to each element
+	/// \param alloc the allocator used for the storage
+	matrix_stack(size_type size, size_type size1, size_type size2, value_type init, allocator_type const& alloc = allocator_type())
+	:m_matrix(stacked_size1(size,size1), stacked_size2(size,size2), init, alloc), m_size(size), m_size1(size1), m_size2(size2){}
+
+	///\brief Returns the number of matrices in the stack.
+	size_type size()const{
+		return m_size;
+	}
+	///\brief Returns the number of rows of every matrix in the stack.
+	size_type size1()const{
+		return m_size1;
+	}
+	///\brief Returns the number of columns of every matrix in the stack.
+	size_type size2()const{
+		return m_size2;
+	}
+
+	///\brief Returns the k-th matrix of the stack.
+	slice_type operator[](size_type k){
+		return closure()[k];
+	}
+	///\brief Returns the k-th matrix of the stack.
+	const_slice_type operator[](size_type k)const{
+		return const_closure()[k];
+	}
+
+	/// \brief Returns element (i,j) of the k-th matrix
+	reference operator()(size_type k, size_type i, size_type j){
+		return stacked_matrix()(stacked_index1(k,i),stacked_index2(k,j));
+	}
+	/// \brief Returns element (i,j) of the k-th matrix
+	const_reference operator()(size_type k, size_type i, size_type j)const{
+		return stacked_matrix()(stacked_index1(k,i),stacked_index2(k,j));
+	}
+
+	///\brief Returns a closure of the stack which can be captured by kernels.
+	closure_type closure(){
+		return closure_type(m_matrix,m_size,m_size1,m_size2);
+	}
+	///\brief Returns a closure of the stack which can be captured by kernels.
+	const_closure_type const_closure()const{
+		return const_closure_type(m_matrix,m_size,m_size1,m_size2);
+	}
+
+	///\brief Returns the matrix holding all slices.
+	matrix_type& stacked_matrix(){
+		return m_matrix;
+	}
+	///\brief Returns the matrix holding all slices.
+	matrix_type const& stacked_matrix()const{
+		return m_matrix;
+	}
+
+	/// \brief Resizes the stack. The values of the elements after resize are undefined.
+	void resize(size_type size, size_type size1, size_type size2){
+		m_matrix.resize(stacked_size1(size,size1), stacked_size2(size,size2));
+		m_size = size;
+		m_size1 = size1;
+		m_size2 = size2;
+	}
+
+	/// \brief Clear all matrices, i.e. set all values to the \c zero value.
+	void clear(){
+		m_matrix.clear();
+	}
+
+	// ---------
+	// Async Interface
+	// ---------
+
+	/// \brief Returns true if no kernels are in flight on any matrix of the stack
+	bool is_ready()const{
+		return m_matrix.is_ready();
+	}
+
+	/// \brief Blocks this thread until all kernels are computed.
+	void wait(){
+		m_matrix.wait();
+	}
+
+	///\brief Returns the dependencies of the stack. All slices share them.
+	scheduling::dependency_node& dependencies() const{
+		return m_matrix.dependencies();
+	}
+private:
+	static size_type stacked_size1(size_type size, size_type size1){
+		return boost::is_same<O,row_major>::value? size*size1: size1;
+	}
+	static size_type stacked_size2(size_type size, size_type size2){
+		return boost::is_same<O,row_major>::value? size2: size*size2;
+	}
+	size_type stacked_index1(size_type k, size_type i)const{
+		return boost::is_same<O,row_major>::value? k*m_size1+i: i;
+	}
+	size_type stacked_index2(size_type k, size_type j)const{
+		return boost::is_same<O,row_major>::value? j: k*m_size2+j;
+	}
+
+	matrix_type m_matrix;
+	size_type m_size;
+	size_type m_size1;
+	size_type m_size2;
+};
+
+namespace detail{
+//splits a batch of the given size in at most as many contiguous chunks as the scheduler has threads.
+//returns the boundaries of the chunks
+inline std::vector<std::size_t> batch_chunks(std::size_t size){
+	std::size_t num_chunks = std::min<std::size_t>(size, system::scheduler().concurrency());
+	std::vector<std::size_t> bounds(1,0);
+	for(std::size_t c = 1; c <= num_chunks; ++c)
+		bounds.push_back(c * size / num_chunks);
+	return bounds;
+}
+}
+
+/// \brief Computes the batch of products C[k]=beta*C[k]+alpha*A[k]*B[k] for all matrices of the stacks.
+///
+/// The batch is split by index in as many kernels as the scheduler has threads. These write to disjoint slices of C
+/// and are computed in parallel. Each uses kernels::gemm_batched which reuses its packing buffer for the whole chunk.
+/// For beta=0 the previous values of C are not read, so C may be uninitialized. C must not alias A or B.
+template<class T, class OA, class OB, class OC, class AA, class AB, class AC>
+void gemm_batched(
+	matrix_stack<T,OA,AA> const& A,
+	matrix_stack<T,OB,AB> const& B,
+	matrix_stack<T,OC,AC>& C,
+	T alpha = T(1), T beta = T()
+){
+	ABLAS_SIZE_CHECK(A.size() == C.size());
+	ABLAS_SIZE_CHECK(B.size() == C.size());
+	ABLAS_SIZE_CHECK(A.size1() == C.size1());
+	ABLAS_SIZE_CHECK(B.size2() == C.size2());
+	ABLAS_SIZE_CHECK(A.size2() == B.size1());
+
+	typename matrix_stack<T,OA,AA>::const_closure_type a = A.const_closure();
+	typename matrix_stack<T,OB,AB>::const_closure_type b = B.const_closure();
+	typename matrix_stack<T,OC,AC>::closure_type c = C.closure();
+
+	std::vector<std::size_t> bounds = detail::batch_chunks(C.size());
+	std::vector<std::function<void()> > work;
+	for(std::size_t i = 0; i + 1 < bounds.size(); ++i){
+		std::size_t start = bounds[i];
+		std::size_t end = bounds[i+1];
+		work.push_back([a,b,c,alpha,beta,start,end]()mutable{
+			kernels::gemm_batched(a,b,c,alpha,beta,start,end);
+		});
+	}
+	std::vector<scheduling::dependency_node*> read_variables;
+	read_variables.push_back(&A.dependencies());
+	read_variables.push_back(&B.dependencies());
+	system::scheduler().spawn_parallel(std::move(work), C.dependencies(), read_variables);
+}
+
+/// \brief Computes the batch of products C[k]=beta*C[k]+alpha*A[k]*B[k] for k=0,...,C.size()-1
+///
+/// The arguments are arrays of matrices or of their closures. The matrices may have different sizes.
+/// The same matrix may appear several times in A or B, but every matrix in C must be distinct and must not alias A or B.
+/// The batch is split by index in as many kernels as the scheduler has threads. Each kernel waits only for the
+/// matrices of its own chunk and kernels::gemm_batched reuses the packing buffer across the chunk.
+/// For beta=0 the previous values of C are not read.
+template<class MatA, class MatB, class MatC>
+void gemm_batched(
+	std::vector<MatA> const& A,
+	std::vector<MatB> const& B,
+	std::vector<MatC>& C,
+	typename MatC::value_type alpha = typename MatC::value_type(1),
+	typename MatC::value_type beta = typename MatC::value_type()
+){
+	ABLAS_SIZE_CHECK(A.size() == C.size());
+	ABLAS_SIZE_CHECK(B.size() == C.size());
+	for(std::size_t k = 0; k != C.size(); ++k){
+		ABLAS_SIZE_CHECK(A[k].size1() == C[k].size1());
+		ABLAS_SIZE_CHECK(B[k].size2() == C[k].size2());
+		ABLAS_SIZE_CHECK(A[k].size2() == B[k].size1());
+	}
+
+	std::vector<std::size_t> bounds = detail::batch_chunks(C.size());
+	for(std::size_t i = 0; i + 1 < bounds.size(); ++i){
+		std::vector<typename MatA::const_closure_type> a(A.begin()+bounds[i],A.begin()+bounds[i+1]);
+		std::vector<typename MatB::const_closure_type> b(B.begin()+bounds[i],B.begin()+bounds[i+1]);
+		std::vector<typename MatC::closure_type> c(C.begin()+bounds[i],C.begin()+bounds[i+1]);
+		std::vector<scheduling::dependency_node*> write_variables;
+		std::vector<scheduling::dependency_node*> read_variables;
+		for(std::size_t k = 0; k != c.size(); ++k){
+			write_variables.push_back(&c[k].dependencies());
+			read_variables.push_back(&a[k].dependencies());
+			read_variables.push_back(&b[k].dependencies());
+		}
+		system::scheduler().spawn([a,b,c,alpha,beta]()mutable{
+			kernels::gemm_batched(a,b,c,alpha,beta,0,c.size());
+		},write_variables,read_variables);
+	}
+}
+
+}
+#endif
@@ -41,9 +41,15 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include "synchronous_scheduling.hpp"
+
 namespace aBLAS{ namespace scheduling{
 
 class dependency_node;
+
+///\brief Tag to create a dependency_node whose writers are computed in the calling thread.
+struct synchronous_tag{};
+
 class dependency_scheduling{
 private:
 	struct work_item{
@@ -81,12 +87,33 @@ public:
 	void spawn(std::function<void()> && f, dependency_node& write_variable,  dependency_node& read_variable1, dependency_node& read_variable2 ){
 		enqueue_work(std::move(f),write_variable,{&read_variable1, &read_variable2});
 	}
+	//function which writes to a list of variables and reads a list of variables
+	void spawn(std::function<void()> && f, std::vector<dependency_node*> const& write_variables, std::vector<dependency_node*> const& read_variables){
+		std::vector<std::function<void()> > work;
+		work.push_back(std::move(f));
+		enqueue_work(std::move(work),write_variables,read_variables);
+	}
+	
+	/// \brief Spawns a group of work items which write to the same variables at the same time.
+	///
+	/// Normally two work items writing to the same variable are computed one after another.
+	/// The work items of a group are instead computed in parallel, which is only correct if they write to
+	/// disjoint parts of the variables, e.g. a batch of matrices split by index. Work items spawned later wait for
+	/// the whole group.
+	void spawn_parallel(std::vector<std::function<void()> > && work, dependency_node& write_variable, std::vector<dependency_node*> const& read_variables){
+		enqueue_work(std::move(work),{&write_variable},read_variables);
+	}
+	
+	///\brief Returns the number of threads computing work items.
+	std::size_t concurrency()const{
+		return m_concurrency;
+	}
 	
 	/// \brief Creates a closure filled with a temporary variable that survives until all kernels spawned in the closure are computed
 	///
 	/// Creates internally a temporary variable of type T and then calls work_item_producer synchronously with the temporary as argument.
 	/// The work_item_producer spawns work items involving T. It is guaranteed that the temporary outlives the last kernel using it spawned this way.
-	///  The only requirement on T is that it offers a method m_dependencies returning a reference to a dependency_node
+	///  The only requirement on T is that it offers a method dependencies() returning a reference to a dependency_node
 	template<class T, class F>
 	void create_closure(T&& temporary,F const& work_item_producer){
 		//create variable and append kernels to it
@@ -104,7 +131,7 @@ public:
 		//let f add kernels to the temporary
 		work_item_producer(*temporary_copy1, *temporary_copy2);
 		//add the clean-up kernel
-		spawn(std::function<void()>([temporary_copy1, temporary_copy2](){/*call dtor of copy of both ptrs*/}),temporary_copy1->m_dependencies,{temporary_copy2->m_dependencies});
+		spawn(std::function<void()>([temporary_copy1, temporary_copy2](){/*call dtor of copy of both ptrs*/}),temporary_copy1->dependencies(),temporary_copy2->dependencies());
 	}
 	
 	template<class T>
@@ -125,11 +152,29 @@ private:
 	}
 	
 	/// \brief Adds a new work item to the graph and submits it directly if possible
-	void enqueue_work(std::function<void()> && f, dependency_node& write_variable, std::vector<dependency_node*> const& read_variables);
+	void enqueue_work(std::function<void()> && f, dependency_node& write_variable, std::vector<dependency_node*> const& read_variables){
+		std::vector<std::function<void()> > work;
+		work.push_back(std::move(f));
+		enqueue_work(std::move(work),{&write_variable},read_variables);
+	}
+	/// \brief Adds a group of work items with the same dependencies to the graph
+	void enqueue_work(
+		std::vector<std::function<void()> > && work,
+		std::vector<dependency_node*> write_variables,
+		std::vector<dependency_node*> read_variables
+	);
 	
 	/// \brief Removes a finished work item from the dependency graph and submits work items that are now ready for execution
 	void finalize_work(std::list<work_item>::iterator work);
 	
+	/// \brief Computes work items writing a synchronous variable in the calling thread once their variables are ready
+	void compute_synchronous(
+		std::vector<std::function<void()> > && work,
+		std::vector<dependency_node*> const& write_variables,
+		std::vector<dependency_node*> const& read_variables
+	);
+	
+	unsigned m_concurrency = std::max(boost::thread::hardware_concurrency(), 1u);
 	boost::basic_thread_pool m_pool;
 	boost::mutex m_work_items_mutex;
 	std::list<work_item> m_work_items;
@@ -140,7 +185,13 @@ class dependency_node{
 private:
 	friend class dependency_scheduling;
 public:
-	dependency_node():m_is_write_dependency(false){}
+	dependency_node():m_num_dependencies(0),m_synchronous(false){}
+	///\brief Creates a variable whose writers are computed in the calling thread.
+	///
+	/// Work items writing the variable wait until the other variables they use are ready and are computed
+	/// before spawn returns. Reads are not tracked, kernels in flight must read a copy of the variable.
+	/// This is used for values which can not keep their storage alive for kernels in flight, e.g. fixed size containers.
+	explicit dependency_node(synchronous_tag):m_num_dependencies(0),m_synchronous(true){}
 	bool is_ready(){
 		return m_num_dependencies.load() == 0;
 	}
@@ -150,86 +201,148 @@ public:
 			boost::this_thread::yield();
 	}
 private:
-	std::vector<dependency_scheduling::work_item*> m_dependencies;
+	//the last work items writing the variable and the work items reading it since then.
+	//readers only wait for the writers, writers wait for both.
+	std::vector<dependency_scheduling::work_item*> m_write_dependencies;
+	std::vector<dependency_scheduling::work_item*> m_read_dependencies;
 	std::atomic_uint m_num_dependencies;
-	bool m_is_write_dependency;
+	bool m_synchronous;
 
 	//internal functions called for dependency management
 	//all these functions can only be called sequentially. This means that the scheduler must be locked and there is only one scheduler!
 
-	void write_dependency(dependency_scheduling::work_item* work){
+	void write_dependency(std::vector<dependency_scheduling::work_item*> const& work){
 		//write dependencies overwrite everything as work items will wait for all reads and writes to the same variables are enqueued sequentially
-		m_dependencies.clear();
-		m_dependencies.push_back(work);
-		m_is_write_dependency = true;
-		m_num_dependencies.store(1);
+		//there are several write dependencies when a group of work items writes in parallel
+		m_write_dependencies = work;
+		m_read_dependencies.clear();
+		m_num_dependencies.store(work.size());
 	}
 	void add_read_dependency(dependency_scheduling::work_item* work){
-		if(m_is_write_dependency){
-			m_is_write_dependency = false;
-			m_dependencies.clear();
-			m_num_dependencies.store(0);
-		}
-		m_dependencies.push_back(work);
+		m_read_dependencies.push_back(work);
 		++m_num_dependencies;
 	}
 	//remove finished dependencies in case they are still stored
+	//the counter is decremented last: as soon as it reaches zero, a waiting thread may destroy the variable
 	void remove_dependency(dependency_scheduling::work_item* work){
-		std::vector<dependency_scheduling::work_item*>::iterator pos = std::find(m_dependencies.begin(),m_dependencies.end(),work);
-		if(pos != m_dependencies.end()){
-			--m_num_dependencies;
-			m_dependencies.erase(pos);
-		}
-		if(m_dependencies.empty())
-			m_is_write_dependency = false;
+		if(!remove_dependency(m_write_dependencies, work) && !remove_dependency(m_read_dependencies, work))
+			return;
+		--m_num_dependencies;
+	}
+	static bool remove_dependency(std::vector<dependency_scheduling::work_item*>& dependencies, dependency_scheduling::work_item* work){
+		std::vector<dependency_scheduling::work_item*>::iterator pos = std::find(dependencies.begin(),dependencies.end(),work);
+		if(pos == dependencies.end())
+			return false;
+		dependencies.erase(pos);
+		return true;
 	}
 
 };
 
-void dependency_scheduling::enqueue_work(std::function<void()> && f, dependency_node& write_variable, std::vector<dependency_node*> const& read_variables){
+void dependency_scheduling::enqueue_work(
+	std::vector<std::function<void()> > && work,
+	std::vector<dependency_node*> write_variables,
+	std::vector<dependency_node*> read_variables
+){
+	//a variable can be passed several times, e.g. when the same matrix is used by several products of a batch
+	//but every work item must be added only once to every variable
+	std::sort(write_variables.begin(),write_variables.end());
+	write_variables.erase(std::unique(write_variables.begin(),write_variables.end()),write_variables.end());
+	std::sort(read_variables.begin(),read_variables.end());
+	read_variables.erase(std::unique(read_variables.begin(),read_variables.end()),read_variables.end());
+	
+	//synchronous variables are not part of the graph. Work items writing one are computed directly
+	auto is_synchronous = [](dependency_node* node){return node->m_synchronous;};
+	bool synchronous = std::any_of(write_variables.begin(),write_variables.end(),is_synchronous);
+	write_variables.erase(std::remove_if(write_variables.begin(),write_variables.end(),is_synchronous),write_variables.end());
+	read_variables.erase(std::remove_if(read_variables.begin(),read_variables.end(),is_synchronous),read_variables.end());
+	if(synchronous){
+		compute_synchronous(std::move(work),write_variables,read_variables);
+		return;
+	}
+	
 	//do not allow any changes of andy work item while we collect information and change the structure
 	boost::unique_lock<boost::mutex> lock(m_work_items_mutex);
 	
 	//collect all work items this work item has to wait for. these are write dependencies in 
 	// read_variables (read a variable only after all previous write) and 
-	// all dependencies of write_variable (only write when no-one else is using it)
+	// all dependencies of write_variables (only write when no-one else is using it)
 	std::vector<work_item*> dependencies;
-	dependencies.insert(dependencies.end(),write_variable.m_dependencies.begin(),write_variable.m_dependencies.end());
-	for(dependency_node* node : read_variables){
-		if(node->m_is_write_dependency)
-			dependencies.push_back(node->m_dependencies.front());//there can only be one write dependency
+	for(dependency_node* node : write_variables){
+		dependencies.insert(dependencies.end(),node->m_write_dependencies.begin(),node->m_write_dependencies.end());
+		dependencies.insert(dependencies.end(),node->m_read_dependencies.begin(),node->m_read_dependencies.end());
 	}
-	//erase duplicates(todo: are duplicates possible at all?)
+	for(dependency_node* node : read_variables)//all work items of a parallel group are write dependencies
+		dependencies.insert(dependencies.end(),node->m_write_dependencies.begin(),node->m_write_dependencies.end());
+	//erase duplicates
+	std::sort(dependencies.begin(),dependencies.end());
 	dependencies.erase(std::unique(dependencies.begin(),dependencies.end()),dependencies.end());
 	
-	//construct work item
-	work_item new_item;
-	new_item.workload = std::move(f);
-	new_item.in_variables = std::move(read_variables);
-	new_item.active_dependencies = dependencies.size();
-	m_work_items.push_back(std::move(new_item));
+	//construct work items
+	std::vector<std::list<work_item>::iterator> items;
+	std::vector<work_item*> item_pointers;
+	for(auto& f: work){
+		work_item new_item;
+		new_item.workload = std::move(f);
+		new_item.in_variables = read_variables;
+		new_item.active_dependencies = dependencies.size();
+		m_work_items.push_back(std::move(new_item));
+		items.push_back(std::prev(m_work_items.end()));
+		item_pointers.push_back(&m_work_items.back());
+	}
 	
-	//insert the work item into the graph
+	//insert the work items into the graph
 		
-	//first add new dependency to all work items for which the new work item has to wait
-	std::list<work_item>::iterator pos = std::prev(m_work_items.end());
+	//first add new dependency to all work items for which the new work items have to wait
 	for(work_item* item : dependencies)
-		item->out_edges.push_back(pos);
+		item->out_edges.insert(item->out_edges.end(),items.begin(),items.end());
 	
-	//then add this kernel as read dependency to the enqueued variables
-	for(dependency_node* node : pos->in_variables)
-		node->add_read_dependency(&(*pos));
+	//then add the kernels as read dependency to the enqueued variables
+	for(auto pos: items){
+		for(dependency_node* node : pos->in_variables)
+			node->add_read_dependency(&(*pos));
+	}
 	
 	//and also add write dependency to dependency list
 	//this order ensures that write_dependencies are always
 	//active even if the same variable is a read and write dependency
-	write_variable.write_dependency(&(*pos));
-	pos->in_variables.push_back(&write_variable);
+	//such a variable is stored only once in in_variables: a second removal in finalize_work would
+	//access the variable after the first one set its counter to zero, when it may be destroyed already
+	for(dependency_node* node : write_variables){
+		node->write_dependency(item_pointers);
+		if(std::binary_search(read_variables.begin(),read_variables.end(),node))
+			continue;
+		for(auto pos: items)
+			pos->in_variables.push_back(node);
+	}
 
-	//submit this work item directly if it depends on nothing
+	//submit the work items directly if they depend on nothing
 	if(dependencies.empty()){
-		submit(pos);
+		for(auto pos: items)
+			submit(pos);
+	}
+}
+
+void dependency_scheduling::compute_synchronous(
+	std::vector<std::function<void()> > && work,
+	std::vector<dependency_node*> const& write_variables,
+	std::vector<dependency_node*> const& read_variables
+){
+	//wait until all writes to the read variables are done and the other written variables are not used anymore
+	auto is_written = [](dependency_node* node){return node->m_write_dependencies.empty();};
+	auto is_unused = [](dependency_node* node){return node->is_ready();};
+	for(;;){
+		{
+			boost::unique_lock<boost::mutex> lock(m_work_items_mutex);
+			if(
+				std::all_of(read_variables.begin(),read_variables.end(),is_written)
+				&& std::all_of(write_variables.begin(),write_variables.end(),is_unused)
+			) break;
+		}
+		boost::this_thread::yield();
 	}
+	for(auto& f: work)
+		f();
 }
 
 void dependency_scheduling::finalize_work(std::list<work_item>::iterator work){
@@ -255,8 +368,14 @@ void dependency_scheduling::finalize_work(std::list<work_item>::iterator work){
 }
 
 namespace system{
-	scheduling::dependency_scheduling& scheduler(){
-		static scheduling::dependency_scheduling scheduler;
+#ifdef ABLAS_SYNCHRONOUS
+	//all kernels are computed directly in the calling thread
+	typedef scheduling::synchronous_scheduling scheduler_type;
+#else
+	typedef scheduling::dependency_scheduling scheduler_type;
+#endif
+	scheduler_type& scheduler(){
+		static scheduler_type scheduler;
 		return scheduler;
 	}
 }
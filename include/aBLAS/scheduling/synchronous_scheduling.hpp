@@ -0,0 +1,107 @@
+/*!
+ *
+ *
+ * \brief       Scheduler which computes all kernels directly in the calling thread
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef ABLAS_SCHEDULING_SYNCHRONOUS_SCHEDULING_HPP
+#define ABLAS_SCHEDULING_SYNCHRONOUS_SCHEDULING_HPP
+
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace aBLAS{ namespace scheduling{
+
+class dependency_node;
+
+/// \brief Scheduler offering the interface of dependency_scheduling but computing every kernel immediately
+///
+/// spawn() calls the work item directly in the calling thread, so by the time an aBLAS statement returns,
+/// its result is computed. There is no dependency graph, no std::function, no locking and no thread pool involved.
+/// As every kernel is finished before the next one is spawned, the order of evaluation is the order
+/// of the statements in the program and thus expression semantics are the same as with the asynchronous scheduler.
+/// All variables are always ready.
+///
+/// The scheduler is selected at compile time by defining ABLAS_SYNCHRONOUS before including any aBLAS header.
+class synchronous_scheduling{
+public:
+	void wait(){}
+
+	//function which writes to one variable
+	template<class F>
+	void spawn(F&& f, dependency_node& /*write_variable*/){
+		f();
+	}
+	//function which writes to one variable and reads one or a list of variables
+	template<class F, class ReadVariables>
+	void spawn(F&& f, dependency_node& /*write_variable*/, ReadVariables const& /*read_variables*/){
+		f();
+	}
+	//function which writes to one variable and reads two
+	template<class F, class ReadVariables1, class ReadVariables2>
+	void spawn(F&& f, dependency_node& /*write_variable*/, ReadVariables1 const&, ReadVariables2 const&){
+		f();
+	}
+	//function which writes to a list of variables and reads a list of variables
+	template<class F, class ReadVariables>
+	void spawn(F&& f, std::vector<dependency_node*> const& /*write_variables*/, ReadVariables const& /*read_variables*/){
+		f();
+	}
+	//group of functions writing to the same variable, computed one after another
+	template<class Work, class ReadVariables>
+	void spawn_parallel(Work&& work, dependency_node& /*write_variable*/, ReadVariables const& /*read_variables*/){
+		for(auto& f: work)
+			f();
+	}
+	
+	///\brief All work items are computed by the calling thread
+	std::size_t concurrency()const{
+		return 1;
+	}
+
+	/// \brief Calls work_item_producer with the temporary variable.
+	///
+	/// As all kernels spawned by work_item_producer are finished when spawn returns, the temporary is not moved
+	/// to the heap but stays in the stack frame of the caller.
+	template<class T, class F>
+	void create_closure(T&& temporary,F const& work_item_producer){
+		work_item_producer(temporary);
+	}
+	template<class T1, class T2, class F>
+	void create_closure(T1&& temporary1, T2&& temporary2,F const& work_item_producer){
+		work_item_producer(temporary1, temporary2);
+	}
+
+	/// \brief No kernel can be in flight, so the variable can be destroyed immediately.
+	template<class T>
+	void make_closure_variable(T&& /*temporary*/){}
+};
+
+}}
+#endif
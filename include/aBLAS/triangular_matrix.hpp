@@ -0,0 +1,1133 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Triangular and symmetric matrices: views of dense matrices, packed containers and triangular solves.
+ *
+ * \author      O. Krause
+ * \date        2015
+ *
+ *
+ * \par Copyright 1995-2015 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://image.diku.dk/shark/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef ABLAS_TRIANGULAR_MATRIX_HPP
+#define ABLAS_TRIANGULAR_MATRIX_HPP
+
+#include <boost/container/vector.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "matrix_expression.hpp"
+#include "kernels/trmv.hpp"
+#include "kernels/trmm.hpp"
+#include "kernels/symv.hpp"
+#include "kernels/symm.hpp"
+#include "kernels/trsv.hpp"
+#include "kernels/trsm.hpp"
+
+namespace aBLAS {
+namespace detail{
+
+///\brief Computes X(i,j) (F) alpha*e(i,j) for all elements of X, where e is a triangular or symmetric matrix.
+///
+/// Used to evaluate triangular and symmetric matrices in dense form, e.g. in the assignment to a dense matrix.
+template<template <class, class> class F, class MatX, class E>
+void spawn_structured_assign(matrix_expression<MatX, cpu_tag>& X, E const& e, typename MatX::value_type alpha){
+	typedef typename MatX::orientation orientation;
+	typename MatX::closure_type X_closure(X());
+	system::scheduler().spawn([alpha, X_closure, e]()mutable{
+		F<typename MatX::reference, typename MatX::value_type> f(alpha);
+		std::size_t size_M = orientation::index_M(X_closure.size1(), X_closure.size2());
+		std::size_t size_m = orientation::index_m(X_closure.size1(), X_closure.size2());
+		for(std::size_t k = 0; k != size_M; ++k){
+			for(std::size_t l = 0; l != size_m; ++l){
+				std::size_t i = orientation::index_row(k,l);
+				std::size_t j = orientation::index_col(k,l);
+				f(X_closure(i,j), e(i,j));
+			}
+		}
+	},X().dependencies(),e.dependencies());
+}
+
+///\brief Element (i,j) of a matrix with the given structure of which only the elements with stored(i,j) are read.
+///
+/// Triangular matrices are zero outside of their triangle, unit triangular matrices have ones on the diagonal.
+/// Symmetric matrices are mirrored.
+template<class TriangularType, class T, class E>
+T structured_element(E const& e, std::size_t i, std::size_t j, triangular_tag){
+	if(TriangularType::is_unit && i == j)
+		return T(1);
+	bool stored = TriangularType::is_upper? j >= i: i >= j;
+	return stored? T(e(i,j)): T();
+}
+template<class TriangularType, class T, class E>
+T structured_element(E const& e, std::size_t i, std::size_t j, symmetric_tag){
+	bool stored = TriangularType::is_upper? j >= i: i >= j;
+	return stored? T(e(i,j)): T(e(j,i));
+}
+
+}
+
+///\brief View of a square dense matrix of which only one triangle is used.
+///
+/// Structure is triangular_tag for a triangular matrix, which is zero outside of the triangle given by TriangularType,
+/// or symmetric_tag for a symmetric matrix whose elements outside the triangle are the mirrored elements inside it.
+/// The other triangle of the matrix is never read, so it can contain arbitrary values, e.g. the other factor of an LU decomposition.
+/// The view is read-only. It is evaluated blockwise: products with it are computed by the kernels trmv, trmm, symv and symm,
+/// and assigning it to a dense matrix writes the full matrix.
+template<class M, class TriangularType, class Structure>
+class matrix_structured_view: public matrix_expression<matrix_structured_view<M, TriangularType, Structure>, cpu_tag > {
+public:
+	typedef typename M::size_type size_type;
+	typedef typename M::difference_type difference_type;
+	typedef typename M::value_type value_type;
+	typedef value_type const_reference;
+	typedef const_reference reference;
+	typedef typename M::index_type index_type;
+
+	typedef typename M::const_closure_type matrix_closure_type;
+	typedef matrix_structured_view<M, TriangularType, Structure> const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef typename M::storage_category storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef typename M::orientation orientation;
+	typedef cpu_tag device_category;
+	typedef TriangularType triangular_type;
+	typedef Structure structure_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary matrices
+	typedef typename M::const_row_iterator const_row_iterator;
+	typedef typename M::const_column_iterator const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	explicit matrix_structured_view(matrix_closure_type const& m):m_expression(m){
+		ABLAS_SIZE_CHECK(m.size1() == m.size2());
+	}
+
+	matrix_closure_type const& expression() const{
+		return m_expression;
+	}
+
+	size_type size1() const {
+		return m_expression.size1();
+	}
+	size_type size2() const {
+		return m_expression.size2();
+	}
+
+	///\brief Returns the dependencies of the viewed matrix.
+	scheduling::dependency_node& dependencies() const{
+		return m_expression.dependencies();
+	}
+
+	///\brief Returns element (i,j) of the triangular or symmetric matrix.
+	value_type operator()(index_type i, index_type j) const {
+		ABLAS_SIZE_CHECK(i < size1());
+		ABLAS_SIZE_CHECK(j < size2());
+		return detail::structured_element<TriangularType, value_type>(m_expression, i, j, Structure());
+	}
+
+	//computation kernels
+	template<class MatX>
+	void assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1))const{
+		detail::spawn_structured_assign<scalar_assign>(X, *this, alpha);
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1))const{
+		detail::spawn_structured_assign<scalar_plus_assign>(X, *this, alpha);
+	}
+private:
+	matrix_closure_type m_expression;
+};
+
+///\brief Returns the triangular matrix given by the triangle TriangularType of the square dense matrix A, e.g. triangular<lower>(A).
+///
+/// TriangularType is one of lower, upper, unit_lower and unit_upper. The other triangle of A is not read.
+template<class TriangularType, class M>
+matrix_structured_view<M, TriangularType, triangular_tag>
+triangular(matrix_expression<M, cpu_tag> const& A){
+	return matrix_structured_view<M, TriangularType, triangular_tag>(A());
+}
+
+///\brief Returns the symmetric matrix whose elements are stored in the triangle TriangularType of the square dense matrix A, e.g. symmetric<lower>(A).
+///
+/// TriangularType is lower or upper. The other triangle of A is not read.
+template<class TriangularType, class M>
+matrix_structured_view<M, TriangularType, symmetric_tag>
+symmetric(matrix_expression<M, cpu_tag> const& A){
+	return matrix_structured_view<M, TriangularType, symmetric_tag>(A());
+}
+
+namespace detail{
+
+template<class T, class A>
+struct packed_matrix_state{
+	typedef boost::container::vector<T,A> storage_type;
+	typedef storage_type const const_storage_type;
+	typedef typename storage_type::size_type size_type;
+	typedef typename storage_type::value_type value_type;
+	storage_type data;
+	mutable scheduling::dependency_node dependencies;
+	size_type size;
+
+	explicit packed_matrix_state(A const& alloc):data(alloc),size(0){}
+	packed_matrix_state(size_type size, A const& alloc)
+	:data(storage_size(size),alloc),size(size){}
+	packed_matrix_state(size_type size, uninitialized_tag, A const& alloc)
+	:data(storage_size(size),boost::container::default_init,alloc),size(size){}
+	packed_matrix_state(size_type size, value_type init, A const& alloc)
+	:data(storage_size(size),init,alloc),size(size){}
+
+	///\brief Changes the size of the matrix. The values of the elements are undefined afterwards.
+	void resize(size_type new_size){
+		size = new_size;
+		data.resize(storage_size(size), boost::container::default_init);
+	}
+
+	///\brief Number of elements of a triangle including the diagonal.
+	static size_type storage_size(size_type size){
+		return size * (size + 1) / 2;
+	}
+};
+
+template<class SharedState, class Structure, class Orientation, class IsNonConstReference =  boost::mpl::false_>
+class packed_matrix_base{
+protected:
+	void set_state(SharedState* state){
+		m_internals = state;
+	}
+
+	template<class, class, class, class> friend class packed_matrix_base;
+public:
+	typedef typename boost::mpl::if_<
+		boost::is_const<SharedState>,
+	        typename SharedState::const_storage_type,
+	        typename SharedState::storage_type
+	>::type storage_type;
+	typedef typename SharedState::const_storage_type const_storage_type;
+	typedef typename storage_type::size_type size_type;
+	typedef typename storage_type::difference_type difference_type;
+	typedef typename storage_type::value_type value_type;
+	typedef value_type const_reference;
+	typedef typename boost::mpl::if_<
+		boost::is_const<SharedState>,
+	        typename storage_type::const_reference ,
+		typename storage_type::reference
+	>::type reference;
+
+	typedef std::size_t index_type;
+
+	typedef packed_tag storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+	typedef Orientation orientation;
+	typedef typename Orientation::triangular_type triangular_type;
+	typedef Structure structure_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary matrices
+	typedef dense_storage_iterator<typename storage_type::const_iterator> const_row_iterator;
+	typedef dense_storage_iterator<typename storage_type::const_iterator> const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	// Construction
+	packed_matrix_base(){}
+
+	//allows conversion non-const->const
+	template<class S, class R>
+	packed_matrix_base(packed_matrix_base<S,Structure,Orientation,R> const& state):m_internals(state.m_internals){}
+
+	///\brief Returns the number of rows of the matrix.
+	size_type size1() const {
+		return m_internals->size;
+	}
+	///\brief Returns the number of columns of the matrix.
+	size_type size2() const {
+		return m_internals->size;
+	}
+
+	// ---------
+	// Packed low level interface
+	// ---------
+
+	///\brief Returns the internal storage of the triangle.
+	///
+	/// Element (i,j) of the triangle is stored at storage()[offset()+orientation::element(i,j,size1())],
+	/// i.e. the rows (columns for column major orientation) of the triangle are stored one after another.
+	typename boost::mpl::if_<
+		IsNonConstReference,
+		storage_type,
+		const_storage_type
+	>::type& storage()const{
+		return m_internals->data;
+	}
+	storage_type& storage(){
+		return m_internals->data;
+	}
+
+	///\brief Returns the offset from the start of storage()
+	difference_type offset()const{
+		return 0;
+	}
+
+	// ---------
+	// Async Interface
+	// ---------
+
+	/// \brief Returns true if this matrix does not wait for operations to complete
+	bool is_ready()const{
+		return !m_internals || m_internals->dependencies.is_ready();
+	}
+
+	/// \brief Blocks this thread until all kernels are computed.
+	void wait(){
+		m_internals->dependencies.wait();
+	}
+
+	///\brief Returns the dependices of this matrix.
+	scheduling::dependency_node& dependencies() const{
+		return m_internals->dependencies;
+	}
+
+	// ---------
+	// High level interface
+	// ---------
+
+	/// \brief Returns element (i,j) of the triangular or symmetric matrix.
+	value_type operator()(index_type i, index_type j) const {
+		ABLAS_SIZE_CHECK(i < size1());
+		ABLAS_SIZE_CHECK(j < size2());
+		return detail::structured_element<triangular_type, value_type>(stored_elements(), i, j, Structure());
+	}
+
+	/// \brief Returns a reference to the stored element (i,j).
+	///
+	/// For symmetric matrices, elements outside of the stored triangle refer to their mirrored element.
+	/// Triangular matrices only store the elements of their triangle.
+	reference operator()(index_type i, index_type j) {
+		ABLAS_SIZE_CHECK(i < size1());
+		ABLAS_SIZE_CHECK(j < size2());
+		if(boost::is_same<Structure, symmetric_tag>::value && !orientation::non_zero(i,j))
+			std::swap(i,j);
+		ABLAS_RANGE_CHECK(orientation::non_zero(i,j));
+		return storage()[orientation::element(i,j,size1())];
+	}
+
+	//computation kernels
+	template<class MatX>
+	void assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1))const{
+		detail::spawn_structured_assign<scalar_assign>(X, const_view(*this), alpha);
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1))const{
+		detail::spawn_structured_assign<scalar_plus_assign>(X, const_view(*this), alpha);
+	}
+
+private:
+	typedef packed_matrix_base<SharedState const, Structure, Orientation> const_view;
+
+	//reads the elements of the stored triangle
+	struct stored_element_access{
+		stored_element_access(const_storage_type& data, size_type size):m_data(data),m_size(size){}
+		value_type operator()(index_type i, index_type j)const{
+			return m_data[orientation::element(i,j,m_size)];
+		}
+		const_storage_type& m_data;
+		size_type m_size;
+	};
+	stored_element_access stored_elements()const{
+		return stored_element_access(m_internals->data, m_internals->size);
+	}
+
+	SharedState* m_internals;
+};
+
+}
+
+/// \brief A square matrix of which one triangle is stored in packed form.
+///
+/// Only the n(n+1)/2 elements of the triangle given by TriangularType are stored. The rows of the triangle are
+/// stored one after another for row major orientation, the columns for column major orientation, which is the
+/// packed format of BLAS. For Structure=triangular_tag the matrix is zero outside of the triangle,
+/// for Structure=symmetric_tag it is symmetric and the elements outside of the triangle are mirrored.
+/// Use the aliases triangular_matrix and symmetric_matrix.
+///
+/// The matrix is evaluated blockwise: products with it are computed by the kernels trmv, trmm, symv and symm
+/// which work directly on the packed storage, and assigning it to a dense matrix writes the full matrix.
+/// It can be constructed and assigned from any square matrix expression, of which only the elements of the triangle are read.
+///
+/// \tparam T the type of object stored in the matrix (like double, float, complex, etc...)
+/// \tparam Structure triangular_tag or symmetric_tag
+/// \tparam O the order in which the triangle is stored, \c row_major or \c column_major
+/// \tparam TriangularType the stored triangle: lower or upper, for triangular matrices also unit_lower or unit_upper
+/// \tparam A the allocator of the storage
+template<class T, class Structure, class O=row_major, class TriangularType=lower, class A = typename detail::default_allocator<T>::type>
+class packed_matrix
+	: public matrix_expression<packed_matrix<T,Structure,O,TriangularType,A>,cpu_tag >
+	, public detail::packed_matrix_base<detail::packed_matrix_state<T,A>, Structure, packed<O,TriangularType> > {
+private:
+	typedef detail::packed_matrix_state<T,A> state_type;
+	typedef packed<O,TriangularType> packed_orientation;
+	typedef detail::packed_matrix_base<state_type, Structure, packed_orientation> base;
+
+	struct closure_type_base
+	: public matrix_expression<closure_type_base, cpu_tag >,
+	  public detail::packed_matrix_base<state_type, Structure, packed_orientation, boost::mpl::true_>
+	{
+		typedef typename packed_matrix::const_closure_type const_closure_type;
+		typedef typename packed_matrix::closure_type closure_type;
+		closure_type_base(packed_matrix const& m)
+		:detail::packed_matrix_base<state_type, Structure, packed_orientation, boost::mpl::true_>(m){}
+
+		using detail::packed_matrix_base<state_type, Structure, packed_orientation, boost::mpl::true_>::operator();
+	};
+
+	struct const_closure_type_base
+	: public matrix_expression<const_closure_type_base, cpu_tag >,
+	  public detail::packed_matrix_base<state_type const, Structure, packed_orientation>
+	{
+		typedef typename packed_matrix::const_closure_type const_closure_type;
+		typedef typename packed_matrix::const_closure_type closure_type;
+
+		using detail::packed_matrix_base<state_type const, Structure, packed_orientation>::operator();
+
+		const_closure_type_base(packed_matrix const& m)
+		:detail::packed_matrix_base<state_type const, Structure, packed_orientation>(m){}
+		//constructor for non-const->const copying
+		const_closure_type_base(closure_type_base const& c)
+		:detail::packed_matrix_base<state_type const, Structure, packed_orientation>(c){}
+	};
+
+public:
+	typedef typename base::size_type size_type;
+	typedef typename base::value_type value_type;
+	typedef typename base::orientation orientation;
+	typedef A allocator_type;
+	typedef closure_type_base closure_type;
+	typedef const_closure_type_base const_closure_type;
+	using base::is_ready;
+	using base::storage;
+	using base::set_state;
+	using base::size1;
+	using base::size2;
+	using base::dependencies;
+	using base::operator();
+
+	// Construction and destruction
+
+	/// \brief Default constructor of a matrix of size (0,0)
+	/// \param alloc the allocator used for the storage
+	explicit packed_matrix(allocator_type const& alloc = allocator_type()):m_internals(new state_type(alloc)) {
+		set_state(m_internals.get());
+	}
+
+	/// \brief Constructor of a matrix with a predefined size
+	/// \param size number of rows and columns of the matrix
+	/// \param alloc the allocator used for the storage
+	explicit packed_matrix(size_type size, allocator_type const& alloc = allocator_type())
+	:m_internals(new state_type(size,alloc)) {
+		set_state(m_internals.get());
+	}
+
+	/// \brief Constructor of a matrix with a predefined size whose elements are not initialized
+	/// \param size number of rows and columns of the matrix
+	/// \param alloc the allocator used for the storage
+	packed_matrix(size_type size, uninitialized_tag, allocator_type const& alloc = allocator_type())
+	:m_internals(new state_type(size,uninitialized_tag(),alloc)) {
+		set_state(m_internals.get());
+	}
+
+	/// \brief Constructor of a matrix with a predefined size with all stored elements initialized to an initial value
+	/// \param size number of rows and columns of the matrix
+	/// \param init value to assign to each stored element of the matrix
+	/// \param alloc the allocator used for the storage
+	packed_matrix(size_type size, value_type init, allocator_type const& alloc = allocator_type())
+	:m_internals(new state_type(size,init,alloc)) {
+		set_state(m_internals.get());
+	}
+
+	/// \brief Copy-constructor
+	packed_matrix(packed_matrix const& m)
+	:m_internals(new state_type(m.size1(), uninitialized_tag(), m.get_allocator())) {
+		set_state(m_internals.get());
+		pack(m, elementwise_tag());
+	}
+
+	/// \brief Move Constructor
+	///
+	///Moving a matrix with active kernels is a well defined operation and guaranteed to work and non-blocking.
+	packed_matrix(packed_matrix && m): m_internals(std::move(m.m_internals)){
+		set_state(m_internals.get());
+		m.set_state(nullptr);//m is empty and must not wait for kernels of *this
+	}
+
+	/// \brief Creates a matrix from the triangle of a square matrix_expression
+	/// \param e the matrix_expression whose elements in the triangle are assigned to the matrix
+	/// \param alloc the allocator used for the storage
+	template<class E>
+	packed_matrix(matrix_expression<E, cpu_tag> const& e, allocator_type const& alloc = allocator_type())
+	:m_internals(new state_type(e().size1(),uninitialized_tag(),alloc)){
+		ABLAS_SIZE_CHECK(e().size1() == e().size2());
+		set_state(m_internals.get());
+		pack(e(), typename E::evaluation_category());
+	}
+
+	~packed_matrix(){
+		//if this still owns memory and there are still kernels in flight, transfer ownership to the scheduler
+		//this delays destruction until the last kernel using *this is finished
+		if(!is_ready())
+			system::scheduler().make_closure_variable(*this);
+	}
+
+	// -------------------
+	// Assignment operators
+	// -------------------
+
+	/// \brief Operator=
+	packed_matrix& operator = (packed_matrix const& m) {
+		packed_matrix temporary(m);
+		swap(*this,temporary);
+		return *this;
+	}
+
+	/// \brief Move Operator=
+	packed_matrix& operator = (packed_matrix && m) {
+		//if this matrix is used, we have to transfer ownership to the scheduler
+		if(!is_ready())
+			system::scheduler().make_closure_variable(*this);
+		m_internals = std::move(m.m_internals);
+		set_state(m_internals.get());
+		m.set_state(nullptr);
+		return *this;
+	}
+
+	/// \brief Assigns the triangle of a square matrix_expression to the matrix
+	template<class E>
+	packed_matrix& operator = (matrix_expression<E, cpu_tag> const& e) {
+		packed_matrix temporary(e, get_allocator());
+		swap(*this,temporary);
+		return *this;
+	}
+
+	/// \brief Resizes the matrix
+	///
+	///The value of the elements after resize are undefined.
+	void resize(size_type new_size){
+		if(new_size == size1())
+			return;
+		if(is_ready()){
+			m_internals->resize(new_size);
+		}else{
+			packed_matrix temporary(new_size, uninitialized_tag(), get_allocator());
+			swap(*this,temporary);
+		}
+	}
+
+	///\brief Returns a copy of the allocator used by the storage
+	allocator_type get_allocator()const{
+		return storage().get_allocator();
+	}
+
+	/// \brief Swap the content of two matrices
+	friend void swap(packed_matrix& m1, packed_matrix& m2) {
+		m1.m_internals.swap(m2.m_internals);
+		std::swap(static_cast<base&>(m1),static_cast<base&>(m2));
+	}
+
+	/// \brief Clear the matrix, i.e. set all stored values to the \c zero value.
+	void clear() {
+		closure_type self(*this);
+		system::scheduler().spawn([self]()mutable{
+			std::fill(self.storage().begin(), self.storage().end(), value_type());
+		},dependencies());
+	}
+private:
+	//copies the elements of the triangle of e line by line in storage order
+	template<class E>
+	void pack(E const& e, elementwise_tag){
+		typedef typename packed_orientation::orientation storage_orientation;
+		closure_type self(*this);
+		typename E::const_closure_type e_closure(e);
+		system::scheduler().spawn([self, e_closure]()mutable{
+			std::size_t n = self.size1();
+			for(std::size_t k = 0; k != n; ++k){
+				for(std::size_t l = 0; l != n; ++l){
+					std::size_t i = storage_orientation::index_row(k,l);
+					std::size_t j = storage_orientation::index_col(k,l);
+					if(packed_orientation::non_zero(i,j))
+						self.storage()[packed_orientation::element(i,j,n)] = e_closure(i,j);
+				}
+			}
+		},dependencies(),e.dependencies());
+	}
+	template<class E>
+	void pack(E const& e, blockwise_tag){
+		typedef typename matrix_temporary<E>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(e.size1(), e.size2(), uninitialized_tag()),
+			[this, &e](Temporary& temporary){
+				assign(temporary, e);
+				pack(temporary, elementwise_tag());
+			}
+		);
+	}
+
+	std::unique_ptr<state_type> m_internals;
+};
+
+///\brief A packed triangular matrix, see packed_matrix.
+template<class T, class O=row_major, class TriangularType=lower, class A = typename detail::default_allocator<T>::type>
+using triangular_matrix = packed_matrix<T, triangular_tag, O, TriangularType, A>;
+
+///\brief A packed symmetric matrix of which only the triangle TriangularType is stored, see packed_matrix.
+template<class T, class O=row_major, class TriangularType=lower, class A = typename detail::default_allocator<T>::type>
+using symmetric_matrix = packed_matrix<T, symmetric_tag, O, TriangularType, A>;
+
+//packed matrices are evaluated in dense temporaries of the orientation of their storage
+template<class T, class O, class TriangularType>
+struct matrix_temporary_type<T,packed<O,TriangularType>,dense_random_access_iterator_tag, cpu_tag>{
+	typedef matrix<T,O,typename detail::temporary_allocator<T>::type> type;
+};
+
+///\brief Product of a triangular or symmetric matrix with a vector.
+///
+/// Products with triangular matrices are computed in place by trmv after the vector is copied to the result.
+/// Products with symmetric matrices are computed by symv.
+template<class MatA, class VecV>
+class structured_matrix_vector_prod:
+	public vector_expression<structured_matrix_vector_prod<MatA, VecV>, cpu_tag > {
+public:
+	typedef typename MatA::const_closure_type matrix_closure_type;
+	typedef typename VecV::const_closure_type vector_closure_type;
+public:
+	typedef typename promote_traits<
+		typename MatA::value_type,
+		typename VecV::value_type
+	>::promote_type value_type;
+	typedef typename MatA::size_type size_type;
+	typedef typename MatA::difference_type difference_type;
+	typedef typename MatA::index_type index_type;
+
+	typedef structured_matrix_vector_prod<MatA, VecV> const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary vectors
+	typedef typename VecV::const_iterator const_iterator;
+	typedef const_iterator iterator;
+
+	structured_matrix_vector_prod(
+		matrix_closure_type const& matrix,
+		vector_closure_type  const& vector
+	):m_matrix(matrix), m_vector(vector) {}
+
+	size_type size() const {
+		return m_matrix.size1();
+	}
+
+	matrix_closure_type const& matrix() const {
+		return m_matrix;
+	}
+	vector_closure_type const& vector() const {
+		return m_vector;
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return std::vector<scheduling::dependency_node*>();
+	}
+
+	//computation kernels
+	template<class VecX>
+	void assign_to(vector_expression<VecX, cpu_tag>& x, value_type alpha = value_type(1) )const{
+		prod_assign_to(x(), alpha, false, typename MatA::structure_category());
+	}
+	template<class VecX>
+	void plus_assign_to(vector_expression<VecX, cpu_tag>& x, value_type alpha = value_type(1) )const{
+		prod_assign_to(x(), alpha, true, typename MatA::structure_category());
+	}
+
+private:
+	//x = alpha*v is multiplied in place. To add the product, it is computed in a temporary.
+	template<class VecX>
+	void prod_assign_to(VecX& x, value_type alpha, bool add, triangular_tag)const{
+		if(!add){
+			assign(x, m_vector, alpha);
+			spawn_trmv(x);
+			return;
+		}
+		typedef typename vector_temporary<VecX>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary& temporary){
+				assign(temporary, m_vector, alpha);
+				spawn_trmv(temporary);
+				plus_assign(x, temporary);
+			}
+		);
+	}
+
+	template<class VecX>
+	void spawn_trmv(VecX& x)const{
+		typename VecX::closure_type x_closure(x);
+		matrix_closure_type A_closure(m_matrix);
+		system::scheduler().spawn([x_closure, A_closure]()mutable{
+			kernels::trmv(A_closure, x_closure);
+		},x.dependencies(),m_matrix.dependencies());
+	}
+
+	//symv reads v from memory, other vector expressions are evaluated in a temporary first
+	template<class VecX>
+	void prod_assign_to(VecX& x, value_type alpha, bool add, symmetric_tag)const{
+		typedef typename boost::is_same<typename vector_closure_type::storage_category, dense_tag>::type dense;
+		prod_assign_to(x, alpha, add? value_type(1): value_type(), dense());
+	}
+	template<class VecX>
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, boost::mpl::true_)const{
+		spawn_symv(x, alpha, beta, m_vector);
+	}
+	template<class VecX>
+	void prod_assign_to(VecX& x, value_type alpha, value_type beta, boost::mpl::false_)const{
+		typedef typename vector_temporary<vector_closure_type>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size(), uninitialized_tag()),
+			[this, &x, alpha, beta](Temporary& temporary){
+				assign(temporary, m_vector);
+				spawn_symv(x, alpha, beta, temporary);
+			}
+		);
+	}
+
+	template<class VecX, class V>
+	void spawn_symv(VecX& x, value_type alpha, value_type beta, V const& v)const{
+		typename VecX::closure_type x_closure(x);
+		typename V::const_closure_type v_closure(v);
+		matrix_closure_type A_closure(m_matrix);
+		system::scheduler().spawn([alpha, beta, x_closure, v_closure, A_closure]()mutable{
+			kernels::symv(A_closure, v_closure, x_closure, alpha, beta);
+		},x.dependencies(),m_matrix.dependencies(),v.dependencies());
+	}
+
+	matrix_closure_type m_matrix;
+	vector_closure_type m_vector;
+};
+
+///\brief Product of a triangular or symmetric matrix with a matrix.
+///
+/// Products with triangular matrices are computed in place by trmm after the matrix is copied to the result.
+/// Products with symmetric matrices are computed by symm.
+template<class MatA, class MatB>
+class structured_matrix_matrix_prod:
+	public matrix_expression<structured_matrix_matrix_prod<MatA, MatB>, cpu_tag > {
+public:
+	typedef typename MatA::const_closure_type matrix_closure_typeA;
+	typedef typename MatB::const_closure_type matrix_closure_typeB;
+public:
+	typedef typename promote_traits<
+		typename MatA::value_type,
+		typename MatB::value_type
+	>::promote_type value_type;
+	typedef typename MatA::size_type size_type;
+	typedef typename MatA::difference_type difference_type;
+	typedef typename MatA::index_type index_type;
+
+	typedef structured_matrix_matrix_prod<MatA, MatB> const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef unknown_orientation orientation;
+	typedef cpu_tag device_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary matrices
+	typedef typename MatB::const_row_iterator const_row_iterator;
+	typedef typename MatB::const_column_iterator const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	structured_matrix_matrix_prod(
+		matrix_closure_typeA const& matrixA,
+		matrix_closure_typeB const& matrixB
+	):m_matrixA(matrixA), m_matrixB(matrixB) {}
+
+	size_type size1() const {
+		return m_matrixA.size1();
+	}
+	size_type size2() const {
+		return m_matrixB.size2();
+	}
+
+	matrix_closure_typeA const& matrixA() const {
+		return m_matrixA;
+	}
+	matrix_closure_typeB const& matrixB() const {
+		return m_matrixB;
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return std::vector<scheduling::dependency_node*>();
+	}
+
+	//computation kernels
+	template<class MatX>
+	void assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1) )const{
+		prod_assign_to(X(), alpha, false, typename MatA::structure_category());
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1) )const{
+		prod_assign_to(X(), alpha, true, typename MatA::structure_category());
+	}
+
+private:
+	//X = alpha*B is multiplied in place. To add the product, it is computed in a temporary.
+	template<class MatX>
+	void prod_assign_to(MatX& X, value_type alpha, bool add, triangular_tag)const{
+		if(!add){
+			assign(X, m_matrixB, alpha);
+			spawn_trmm(X);
+			return;
+		}
+		typedef typename matrix_temporary<MatX>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size1(), size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary& temporary){
+				assign(temporary, m_matrixB, alpha);
+				spawn_trmm(temporary);
+				plus_assign(X, temporary);
+			}
+		);
+	}
+
+	template<class MatX>
+	void spawn_trmm(MatX& X)const{
+		typename MatX::closure_type X_closure(X);
+		matrix_closure_typeA A_closure(m_matrixA);
+		system::scheduler().spawn([X_closure, A_closure]()mutable{
+			kernels::trmm(A_closure, X_closure);
+		},X.dependencies(),m_matrixA.dependencies());
+	}
+
+	//symm reads B from memory, other matrix expressions are evaluated in a temporary first
+	template<class MatX>
+	void prod_assign_to(MatX& X, value_type alpha, bool add, symmetric_tag)const{
+		typedef typename boost::is_same<typename matrix_closure_typeB::storage_category, dense_tag>::type dense;
+		prod_assign_to(X, alpha, add? value_type(1): value_type(), dense());
+	}
+	template<class MatX>
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, boost::mpl::true_)const{
+		spawn_symm(X, alpha, beta, m_matrixB);
+	}
+	template<class MatX>
+	void prod_assign_to(MatX& X, value_type alpha, value_type beta, boost::mpl::false_)const{
+		typedef typename matrix_temporary<matrix_closure_typeB>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(m_matrixB.size1(), m_matrixB.size2(), uninitialized_tag()),
+			[this, &X, alpha, beta](Temporary& temporary){
+				assign(temporary, m_matrixB);
+				spawn_symm(X, alpha, beta, temporary);
+			}
+		);
+	}
+
+	template<class MatX, class MatrixB>
+	void spawn_symm(MatX& X, value_type alpha, value_type beta, MatrixB const& B)const{
+		typename MatX::closure_type X_closure(X);
+		typename MatrixB::const_closure_type B_closure(B);
+		matrix_closure_typeA A_closure(m_matrixA);
+		system::scheduler().spawn([alpha, beta, X_closure, B_closure, A_closure]()mutable{
+			kernels::symm(A_closure, B_closure, X_closure, alpha, beta);
+		},X.dependencies(),m_matrixA.dependencies(),B.dependencies());
+	}
+
+	matrix_closure_typeA m_matrixA;
+	matrix_closure_typeB m_matrixB;
+};
+
+/// \brief Computes the product of a triangular or symmetric view with a vector.
+template<class M, class TriangularType, class Structure, class VecV>
+structured_matrix_vector_prod<matrix_structured_view<M, TriangularType, Structure>, VecV> prod(
+	matrix_structured_view<M, TriangularType, Structure> const& A,
+	vector_expression<VecV, cpu_tag> const& v
+){
+	return structured_matrix_vector_prod<matrix_structured_view<M, TriangularType, Structure>, VecV>(A, v());
+}
+
+/// \brief Computes the product of a triangular or symmetric view with a matrix.
+template<class M, class TriangularType, class Structure, class MatB>
+structured_matrix_matrix_prod<matrix_structured_view<M, TriangularType, Structure>, MatB> prod(
+	matrix_structured_view<M, TriangularType, Structure> const& A,
+	matrix_expression<MatB, cpu_tag> const& B
+){
+	return structured_matrix_matrix_prod<matrix_structured_view<M, TriangularType, Structure>, MatB>(A, B());
+}
+
+/// \brief Computes the product of a packed triangular or symmetric matrix with a vector.
+template<class T, class Structure, class O, class TriangularType, class A, class VecV>
+structured_matrix_vector_prod<packed_matrix<T, Structure, O, TriangularType, A>, VecV> prod(
+	packed_matrix<T, Structure, O, TriangularType, A> const& P,
+	vector_expression<VecV, cpu_tag> const& v
+){
+	return structured_matrix_vector_prod<packed_matrix<T, Structure, O, TriangularType, A>, VecV>(P, v());
+}
+
+/// \brief Computes the product of a packed triangular or symmetric matrix with a matrix.
+template<class T, class Structure, class O, class TriangularType, class A, class MatB>
+structured_matrix_matrix_prod<packed_matrix<T, Structure, O, TriangularType, A>, MatB> prod(
+	packed_matrix<T, Structure, O, TriangularType, A> const& P,
+	matrix_expression<MatB, cpu_tag> const& B
+){
+	return structured_matrix_matrix_prod<packed_matrix<T, Structure, O, TriangularType, A>, MatB>(P, B());
+}
+
+///\brief Solution x of the triangular system of equations Ax=b.
+///
+/// The right hand side is copied to the result, which is then overwritten with the solution by trsv.
+template<class MatA, class VecB>
+class matrix_vector_solve:
+	public vector_expression<matrix_vector_solve<MatA, VecB>, cpu_tag > {
+public:
+	typedef typename MatA::const_closure_type matrix_closure_type;
+	typedef typename VecB::const_closure_type vector_closure_type;
+public:
+	typedef typename promote_traits<
+		typename MatA::value_type,
+		typename VecB::value_type
+	>::promote_type value_type;
+	typedef typename MatA::size_type size_type;
+	typedef typename MatA::difference_type difference_type;
+	typedef typename MatA::index_type index_type;
+
+	typedef matrix_vector_solve<MatA, VecB> const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef cpu_tag device_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary vectors
+	typedef typename VecB::const_iterator const_iterator;
+	typedef const_iterator iterator;
+
+	matrix_vector_solve(
+		matrix_closure_type const& matrix,
+		vector_closure_type  const& vector
+	):m_matrix(matrix), m_vector(vector) {}
+
+	size_type size() const {
+		return m_matrix.size1();
+	}
+
+	matrix_closure_type const& matrix() const {
+		return m_matrix;
+	}
+	vector_closure_type const& vector() const {
+		return m_vector;
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return std::vector<scheduling::dependency_node*>();
+	}
+
+	//computation kernels
+	template<class VecX>
+	void assign_to(vector_expression<VecX, cpu_tag>& x, value_type alpha = value_type(1) )const{
+		assign(x, m_vector, alpha);
+		spawn_trsv(x());
+	}
+	template<class VecX>
+	void plus_assign_to(vector_expression<VecX, cpu_tag>& x, value_type alpha = value_type(1) )const{
+		typedef typename vector_temporary<VecX>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary& temporary){
+				assign(temporary, m_vector, alpha);
+				spawn_trsv(temporary);
+				plus_assign(x, temporary);
+			}
+		);
+	}
+
+private:
+	template<class VecX>
+	void spawn_trsv(VecX& x)const{
+		typename VecX::closure_type x_closure(x);
+		matrix_closure_type A_closure(m_matrix);
+		system::scheduler().spawn([x_closure, A_closure]()mutable{
+			kernels::trsv(A_closure, x_closure);
+		},x.dependencies(),m_matrix.dependencies());
+	}
+
+	matrix_closure_type m_matrix;
+	vector_closure_type m_vector;
+};
+
+///\brief Solution X of the triangular system of equations AX=B.
+///
+/// The right hand side is copied to the result, which is then overwritten with the solution by trsm.
+/// The columns of the right hand side are solved independently, so large right hand sides are
+/// split into ranges of columns solved by parallel kernels.
+template<class MatA, class MatB>
+class matrix_matrix_solve:
+	public matrix_expression<matrix_matrix_solve<MatA, MatB>, cpu_tag > {
+public:
+	typedef typename MatA::const_closure_type matrix_closure_typeA;
+	typedef typename MatB::const_closure_type matrix_closure_typeB;
+public:
+	typedef typename promote_traits<
+		typename MatA::value_type,
+		typename MatB::value_type
+	>::promote_type value_type;
+	typedef typename MatA::size_type size_type;
+	typedef typename MatA::difference_type difference_type;
+	typedef typename MatA::index_type index_type;
+
+	typedef matrix_matrix_solve<MatA, MatB> const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef blockwise_tag evaluation_category;
+	typedef unknown_orientation orientation;
+	typedef cpu_tag device_category;
+
+	//FIXME: This workaround is required to be able to generate
+	// temporary matrices
+	typedef typename MatB::const_row_iterator const_row_iterator;
+	typedef typename MatB::const_column_iterator const_column_iterator;
+	typedef const_row_iterator row_iterator;
+	typedef const_column_iterator column_iterator;
+
+	matrix_matrix_solve(
+		matrix_closure_typeA const& matrixA,
+		matrix_closure_typeB const& matrixB
+	):m_matrixA(matrixA), m_matrixB(matrixB) {}
+
+	size_type size1() const {
+		return m_matrixA.size1();
+	}
+	size_type size2() const {
+		return m_matrixB.size2();
+	}
+
+	matrix_closure_typeA const& matrixA() const {
+		return m_matrixA;
+	}
+	matrix_closure_typeB const& matrixB() const {
+		return m_matrixB;
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return std::vector<scheduling::dependency_node*>();
+	}
+
+	//computation kernels
+	template<class MatX>
+	void assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1) )const{
+		assign(X, m_matrixB, alpha);
+		spawn_trsm(X());
+	}
+	template<class MatX>
+	void plus_assign_to(matrix_expression<MatX, cpu_tag>& X, value_type alpha = value_type(1) )const{
+		typedef typename matrix_temporary<MatX>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size1(), size2(), uninitialized_tag()),
+			[this, &X, alpha](Temporary& temporary){
+				assign(temporary, m_matrixB, alpha);
+				spawn_trsm(temporary);
+				plus_assign(X, temporary);
+			}
+		);
+	}
+
+private:
+	//every kernel solves a range of columns of X
+	template<class MatX>
+	void spawn_trsm(MatX& X)const{
+		typedef typename MatX::closure_type closure_type;
+		closure_type X_closure(X);
+		matrix_closure_typeA A_closure(m_matrixA);
+		std::vector<std::size_t> bounds = detail::parallel_assign_ranges(
+			X.size2(), X.size1() * sizeof(typename MatX::value_type), system::scheduler().concurrency()
+		);
+		if(bounds.size() <= 2){
+			system::scheduler().spawn([X_closure, A_closure]()mutable{
+				kernels::trsm(A_closure, X_closure);
+			},X.dependencies(),m_matrixA.dependencies());
+			return;
+		}
+		detail::spawn_parallel_assign(bounds, [X_closure, A_closure](std::size_t start, std::size_t end)mutable{
+			matrix_range<closure_type> columns = subrange(X_closure, 0, X_closure.size1(), start, end);
+			kernels::trsm(A_closure, columns);
+		},X.dependencies(),m_matrixA.dependencies());
+	}
+
+	matrix_closure_typeA m_matrixA;
+	matrix_closure_typeB m_matrixB;
+};
+
+/// \brief Solves the system of equations Ax=b for a triangular view A, e.g. solve(triangular<lower>(L), b).
+template<class M, class TriangularType, class VecB>
+matrix_vector_solve<matrix_structured_view<M, TriangularType, triangular_tag>, VecB> solve(
+	matrix_structured_view<M, TriangularType, triangular_tag> const& A,
+	vector_expression<VecB, cpu_tag> const& b
+){
+	return matrix_vector_solve<matrix_structured_view<M, TriangularType, triangular_tag>, VecB>(A, b());
+}
+
+/// \brief Solves the system of equations AX=B for a triangular view A, e.g. solve(triangular<lower>(L), B).
+template<class M, class TriangularType, class MatB>
+matrix_matrix_solve<matrix_structured_view<M, TriangularType, triangular_tag>, MatB> solve(
+	matrix_structured_view<M, TriangularType, triangular_tag> const& A,
+	matrix_expression<MatB, cpu_tag> const& B
+){
+	return matrix_matrix_solve<matrix_structured_view<M, TriangularType, triangular_tag>, MatB>(A, B());
+}
+
+/// \brief Solves the system of equations Ax=b for a packed triangular matrix A.
+template<class T, class O, class TriangularType, class A, class VecB>
+matrix_vector_solve<triangular_matrix<T, O, TriangularType, A>, VecB> solve(
+	triangular_matrix<T, O, TriangularType, A> const& P,
+	vector_expression<VecB, cpu_tag> const& b
+){
+	return matrix_vector_solve<triangular_matrix<T, O, TriangularType, A>, VecB>(P, b());
+}
+
+/// \brief Solves the system of equations AX=B for a packed triangular matrix A.
+template<class T, class O, class TriangularType, class A, class MatB>
+matrix_matrix_solve<triangular_matrix<T, O, TriangularType, A>, MatB> solve(
+	triangular_matrix<T, O, TriangularType, A> const& P,
+	matrix_expression<MatB, cpu_tag> const& B
+){
+	return matrix_matrix_solve<triangular_matrix<T, O, TriangularType, A>, MatB>(P, B());
+}
+
+}
+
+#endif
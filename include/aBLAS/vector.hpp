@@ -34,6 +34,8 @@
 
 #include "assignment.hpp"
 #include "detail/iterator.hpp"
+#include "detail/alignment.hpp"
+#include "detail/temporary_pool.hpp"
 
 #include <memory>
 #include <boost/container/vector.hpp>
@@ -41,20 +43,21 @@
 namespace aBLAS {
 namespace detail{
 	
-template<class T>	
+template<class T, class A>
 struct dense_vector_state{
-	typedef boost::container::vector<T> storage_type;//better handling of std::vector<bool>...
+	typedef boost::container::vector<T,A> storage_type;//better handling of std::vector<bool>...
 	typedef storage_type const const_storage_type;
 	typedef typename storage_type::size_type size_type;
 	typedef typename storage_type::value_type value_type;
 	storage_type data;
 	mutable scheduling::dependency_node dependencies;
 	
-	dense_vector_state(){}
-	dense_vector_state(size_type size):data(size){}
-	dense_vector_state(size_type size, value_type init):data(size,init){}
+	explicit dense_vector_state(A const& alloc):data(alloc){}
+	dense_vector_state(size_type size, A const& alloc):data(size,alloc){}
+	dense_vector_state(size_type size, uninitialized_tag, A const& alloc):data(size,boost::container::default_init,alloc){}
+	dense_vector_state(size_type size, value_type init, A const& alloc):data(size,init,alloc){}
 	template<class Iter>
-	dense_vector_state(Iter begin, Iter end):data(begin,end){}
+	dense_vector_state(Iter begin, Iter end, A const& alloc):data(begin,end,alloc){}
 };
 	
 template<class SharedState>
@@ -103,17 +106,29 @@ public:
 	}
 	
 	/// \brief Clear the vector, i.e. set all values to the \c zero value.
+	///
+	/// Large vectors are cleared by parallel kernels, and with non-temporal stores
+	/// if they are larger than kernels::tuning().streaming_store_min_size.
 	void clear() {
+		bool streaming = size() * sizeof(value_type) >= kernels::tuning().streaming_store_min_size;
+		dense_vector_base closure(*this);
+		auto kernel = [closure, streaming](std::size_t start, std::size_t end)mutable{
+			value_type* data = closure.storage().data();
+			if(streaming)
+				bindings::stream_fill(end - start, value_type/*zero*/(), data + start);
+			else
+				std::fill(data + start, data + end, value_type/*zero*/());
+		};
+		std::vector<std::size_t> bounds = detail::parallel_assign_ranges(
+			size(), sizeof(value_type), system::scheduler().concurrency()
+		);
 		//running via the scheduler is a lot of overhead for a simple operation
-		//so if no kernels are in flight, we can just call std::fill directly
-		//otherwise, we have to enqueue it as a kernel
-		if(is_ready()){
-			std::fill(storage().begin(), storage.end(), value_type/*zero*/());
+		//so if no kernels are in flight and the vector is not split, we can just call the kernel directly
+		//otherwise, we have to enqueue it
+		if(bounds.size() == 2 && is_ready()){
+			kernel(0, size());
 		}else{
-			dense_vector_base closure(*this);
-			system::scheduler().spawn([closure](){
-				std::fill(closure.begin(), closure.end(), value_type/*zero*/());
-			},dependencies());
+			detail::spawn_parallel_assign(bounds, kernel, dependencies(), std::vector<scheduling::dependency_node*>());
 		}
 	}
 
@@ -155,7 +170,7 @@ public:
 	// ---------
 	
 	/// \brief Returns true if this vector does not wait for operations to complete
-	bool is_ready(){
+	bool is_ready()const{
 		return !m_internals || m_internals->dependencies.is_ready();
 	}
 	
@@ -271,17 +286,18 @@ private:
 /// to the \f$i\f$-th element of the container. 
 ///
 /// \tparam T type of the objects stored in the vector (like int, double, complex,...)
-template<class T>
-class vector:public vector_expression<vector<T>, cpu_tag >, public detail::dense_vector_base<detail::dense_vector_state<T> > {
+/// \tparam A the allocator of the storage. The default allocator aligns the storage to a cache line, see allocators.hpp for alternatives
+template<class T, class A = typename detail::default_allocator<T>::type>
+class vector:public vector_expression<vector<T,A>, cpu_tag >, public detail::dense_vector_base<detail::dense_vector_state<T,A> > {
 private:
-	typedef typename detail::dense_vector_base<detail::dense_vector_state<T> > base;
+	typedef typename detail::dense_vector_base<detail::dense_vector_state<T,A> > base;
 
 	struct closure_type_base
 	: public vector_expression<closure_type_base, cpu_tag >,
 	  public base
 	{
-		typedef typename vector<T>::const_closure_type const_closure_type;
-		typedef typename vector<T>::closure_type closure_type;
+		typedef typename vector<T,A>::const_closure_type const_closure_type;
+		typedef typename vector<T,A>::closure_type closure_type;
 		closure_type_base(vector const& v):base(v){}
 			
 		using base::operator();
@@ -312,20 +328,21 @@ private:
 	
 	struct const_closure_type_base
 	: public vector_expression<const_closure_type_base, cpu_tag >,
-	  public detail::dense_vector_base<detail::dense_vector_state<T> const >
+	  public detail::dense_vector_base<detail::dense_vector_state<T,A> const >
 	{
-		typedef typename vector<T>::const_closure_type const_closure_type;
-		typedef typename vector<T>::const_closure_type closure_type;
+		typedef typename vector<T,A>::const_closure_type const_closure_type;
+		typedef typename vector<T,A>::const_closure_type closure_type;
 		
-		using detail::dense_vector_base<detail::dense_vector_state<T> const >::operator();
+		using detail::dense_vector_base<detail::dense_vector_state<T,A> const >::operator();
 
-		const_closure_type_base(vector const& v):detail::dense_vector_base<detail::dense_vector_state<T> const >(v){}
+		const_closure_type_base(vector const& v):detail::dense_vector_base<detail::dense_vector_state<T,A> const >(v){}
 		//constructor for non-const->const copying
-		const_closure_type_base(closure_type_base const& c):detail::dense_vector_base<detail::dense_vector_state<T> const >(c){}
+		const_closure_type_base(closure_type_base const& c):detail::dense_vector_base<detail::dense_vector_state<T,A> const >(c){}
 	};
 public:
 	typedef typename base::size_type size_type;
 	typedef typename base::value_type value_type;
+	typedef A allocator_type;
 	typedef closure_type_base closure_type;
 	typedef const_closure_type_base const_closure_type;
 	using base::is_ready;
@@ -339,32 +356,50 @@ public:
 
 	/// \brief Constructor of a vector
 	/// By default it is empty, i.e. \c size()==0.
-	vector():m_internals(new detail::dense_vector_state<T>()){
+	/// \param alloc the allocator used for the storage
+	explicit vector(allocator_type const& alloc = allocator_type()):m_internals(new detail::dense_vector_state<T,A>(alloc)){
 		set_state(m_internals.get());
 	}
 
 	/// \brief Constructor of a vector with a predefined size
 	/// \param size initial size of the vector
-	explicit vector(size_type size):m_internals(new detail::dense_vector_state<T>(size)){
+	/// \param alloc the allocator used for the storage
+	explicit vector(size_type size, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_vector_state<T,A>(size,alloc)){
+		set_state(m_internals.get());
+	}
+		
+	/// \brief Constructor of a vector with a predefined size whose elements are not initialized
+	///
+	/// All elements must be written before they are read, e.g. by assigning an expression to the vector.
+	/// \param size initial size of the vector
+	/// \param alloc the allocator used for the storage
+	vector(size_type size, uninitialized_tag, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_vector_state<T,A>(size,uninitialized_tag(),alloc)){
 		set_state(m_internals.get());
 	}
 		
 	/// \brief Constructs the vector from a predefined range
 	template<class Iter>
-	vector(Iter begin, Iter end):m_internals(new detail::dense_vector_state<T>(begin,end)){
+	vector(Iter begin, Iter end, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_vector_state<T,A>(begin,end,alloc)){
 		set_state(m_internals.get());
 	}
 
 	/// \brief Constructor of a vector with a predefined size with all elements initialized to an initial value
 	/// \param size of the vector
 	/// \param init value to assign to each element of the vector
-	vector(size_type size, value_type init):m_internals(new detail::dense_vector_state<T>(size,init)){
+	/// \param alloc the allocator used for the storage
+	vector(size_type size, value_type init, allocator_type const& alloc = allocator_type())
+	:m_internals(new detail::dense_vector_state<T,A>(size,init,alloc)){
 		set_state(m_internals.get());
 	}
 
 	/// \brief Copy-constructor of a vector
+	///
+	/// The copy uses a copy of the allocator of v.
 	/// \param v is the vector to be duplicated
-	vector(vector const& v):m_internals(new detail::dense_vector_state<T>(v.size())) {
+	vector(vector const& v):m_internals(new detail::dense_vector_state<T,A>(v.size(),uninitialized_tag(),v.get_allocator())) {
 		set_state(m_internals.get());
 		if(v.is_ready())//v has no kernels in flight, just copy
 			storage() = v.storage();
@@ -377,13 +412,15 @@ public:
 	///Moving a vector with active kernels is a well defined operation and guaranteed to work and non-blocking.
 	vector(vector && v): m_internals(std::move(v.m_internals)){
 		set_state(m_internals.get());
+		v.set_state(nullptr);//v is empty and must not wait for kernels of *this
 	}
 
 	/// \brief Creates a vector from a vector_expression
 	/// \param v the vector_expression which values will be assigned to the vector
+	/// \param alloc the allocator used for the storage
 	template<class V>
-	vector(vector_expression<V, cpu_tag> const& v)
-		:m_internals(new detail::dense_vector_state<T>(v().size())) {
+	vector(vector_expression<V, cpu_tag> const& v, allocator_type const& alloc = allocator_type())
+		:m_internals(new detail::dense_vector_state<T,A>(v().size(),uninitialized_tag(),alloc)) {
 		set_state(m_internals.get());
 		assign(*this, v);
 	}
@@ -403,7 +440,7 @@ public:
 	vector& operator = (vector const& v) {
 		//if this vector is not used, we do not need to create a copy
 		if(is_ready()){
-			storage().resize(v.size());
+			storage().resize(v.size(), boost::container::default_init);
 			if(v.is_ready())//v has no kernels in flight, just copy
 				storage() = v.storage();
 			else
@@ -422,6 +459,7 @@ public:
 			system::scheduler().make_closure_variable(std::move(*this));
 		m_internals = std::move(v.m_internals);
 		set_state(m_internals.get());
+		v.set_state(nullptr);
 		
 		return *this;
 	}
@@ -434,7 +472,7 @@ public:
 	/// \return a reference to the resulting vector
 	template<class V>
 	vector& operator = (vector_expression<V, cpu_tag> const& v) {
-		vector temporary(v);
+		vector temporary(v, get_allocator());
 		swap(*this,temporary);
 		return *this;
 	}
@@ -448,14 +486,19 @@ public:
 		if(new_size == size())
 			return;
 		if(is_ready()){
-			storage().resize(new_size);
+			storage().resize(new_size, boost::container::default_init);
 		}else{
 			//there are still kernels using this vector, so create a new variable and let the scheduler handle everything
-			vector temporary(new_size);
+			vector temporary(new_size, uninitialized_tag(), get_allocator());
 			swap(*this,temporary);
 		}
 	}
 	
+	///\brief Returns a copy of the allocator used by the storage
+	allocator_type get_allocator()const{
+		return storage().get_allocator();
+	}
+	
 	/// \brief Swap the content of two vectors
 	/// \param v1 is the first vector. It takes values from v2
 	/// \param v2 is the second vector It takes values from v1
@@ -464,12 +507,12 @@ public:
 		std::swap(static_cast<base&>(v1),static_cast<base&>(v2));
 	}
 private:
-	std::unique_ptr<detail::dense_vector_state<T> > m_internals;
+	std::unique_ptr<detail::dense_vector_state<T,A> > m_internals;
 };
 
 template<class T>
 struct vector_temporary_type<T,dense_random_access_iterator_tag, cpu_tag>{
-	typedef vector<T> type;
+	typedef vector<T,typename detail::temporary_allocator<T>::type> type;
 };
 
 } //namespace aBLAS
@@ -391,6 +391,292 @@ typename boost::enable_if<
 	return scalar_vector<T,Device>(e().size(),t) - e;
 }
 
+///\brief Applies a scalar functor to every element of a vector expression, x_i = f(e_i).
+///
+/// If e is elementwise, assignment computes the functor inside of the assignment kernel, thus
+/// an expression like exp(2*x+y) is evaluated in a single pass over the arguments.
+/// Otherwise e is evaluated into a temporary first.
+template<class E, class F>
+class vector_unary: public vector_expression<vector_unary<E, F>, typename E::device_category > {
+public:
+	typedef typename E::const_closure_type expression_closure_type;
+	typedef F functor_type;
+	typedef typename E::size_type size_type;
+	typedef typename E::difference_type difference_type;
+	typedef typename F::result_type value_type;
+	typedef value_type const_reference;
+	typedef value_type reference;
+
+	typedef typename E::index_type index_type;
+
+	typedef vector_unary const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef typename E::evaluation_category evaluation_category;
+	typedef typename E::device_category device_category;
+
+private:
+	expression_closure_type m_expression;
+	F m_functor;
+public:
+
+	// Construction and destruction
+	vector_unary(expression_closure_type const& e, F const& functor):
+		m_expression(e), m_functor(functor) {}
+
+	// Accessors
+	size_type size() const {
+		return m_expression.size();
+	}
+
+	auto dependencies()const -> decltype(this->m_expression.dependencies()){
+		return m_expression.dependencies();
+	}
+	// Expression accessors
+	expression_closure_type const &expression() const {
+		return m_expression;
+	}
+	functor_type const& functor() const {
+		return m_functor;
+	}
+
+	// Element access
+	const_reference operator()(index_type i) const {
+		return m_functor(m_expression(i));
+	}
+
+	const_reference operator[](index_type i) const {
+		return m_functor(m_expression(i));
+	}
+
+	//computation kernels, only called for blockwise arguments
+	template<class VecX>
+	void assign_to(vector_expression<VecX, device_category>& x, typename VecX::value_type alpha = typename VecX::value_type(1) )const{
+		typedef typename vector_temporary<E>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary& temporary){
+				assign(temporary,m_expression);
+				assign(x, vector_unary<Temporary,F>(temporary, m_functor), alpha);
+			}
+		);
+	}
+	template<class VecX>
+	void plus_assign_to(vector_expression<VecX, device_category>& x, typename VecX::value_type alpha = typename VecX::value_type(1) )const{
+		typedef typename vector_temporary<E>::type Temporary;
+		system::scheduler().create_closure(
+			Temporary(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary& temporary){
+				assign(temporary,m_expression);
+				plus_assign(x, vector_unary<Temporary,F>(temporary, m_functor), alpha);
+			}
+		);
+	}
+
+	//iterators
+	typedef transform_iterator<typename E::const_iterator, F> const_iterator;
+	typedef const_iterator iterator;
+
+	const_iterator begin() const {
+		return const_iterator(m_expression.begin(),m_functor);
+	}
+	const_iterator end() const {
+		return const_iterator(m_expression.end(),m_functor);
+	}
+};
+
+///\brief Applies a binary scalar functor to every pair of elements of two vector expressions, x_i = f(e1_i,e2_i).
+///
+/// As with vector_unary, elementwise arguments are evaluated in a single pass. If one of the arguments
+/// is blockwise, both are evaluated into temporaries first.
+template<class E1, class E2, class F>
+class vector_binary: public vector_expression<vector_binary<E1,E2,F>, typename E1::device_category > {
+public:
+	typedef F functor_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef typename F::result_type value_type;
+	typedef value_type const_reference;
+	typedef value_type reference;
+
+	typedef typename E1::index_type index_type;
+	typedef typename E1::const_closure_type expression_closure1_type;
+	typedef typename E2::const_closure_type expression_closure2_type;
+
+	typedef vector_binary const_closure_type;
+	typedef const_closure_type closure_type;
+	typedef unknown_storage_tag storage_category;
+	typedef typename evaluation_restrict_traits<E1,E2>::type evaluation_category;
+	typedef typename E1::device_category device_category;
+
+	// Construction and destruction
+	vector_binary(
+		expression_closure1_type const& e1,
+		expression_closure2_type const& e2,
+		F const& functor
+	):m_lhs(e1),m_rhs(e2), m_functor(functor){
+		ABLAS_SIZE_CHECK(e1.size() == e2.size());
+	}
+
+	// Accessors
+	size_type size() const {
+		return m_lhs.size();
+	}
+
+	std::vector<scheduling::dependency_node*> dependencies()const{
+		return gather_dependencies(m_lhs.dependencies(),m_rhs.dependencies());
+	}
+	// Expression accessors
+	expression_closure1_type const& expression1() const {
+		return m_lhs;
+	}
+	expression_closure2_type const& expression2() const {
+		return m_rhs;
+	}
+	functor_type const& functor() const {
+		return m_functor;
+	}
+
+	// Element access
+	const_reference operator() (index_type i) const {
+		ABLAS_SIZE_CHECK(i < size());
+		return m_functor(m_lhs(i), m_rhs(i));
+	}
+
+	const_reference operator[] (index_type i) const {
+		ABLAS_SIZE_CHECK(i < size());
+		return m_functor(m_lhs(i), m_rhs(i));
+	}
+
+	//computation kernels, only called if one of the arguments is blockwise
+	template<class VecX>
+	void assign_to(vector_expression<VecX, device_category>& x, typename VecX::value_type alpha = typename VecX::value_type(1) )const{
+		typedef typename vector_temporary<E1>::type Temporary1;
+		typedef typename vector_temporary<E2>::type Temporary2;
+		system::scheduler().create_closure(
+			Temporary1(size(), uninitialized_tag()),
+			Temporary2(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary1& temp1, Temporary2& temp2){
+				assign(temp1,m_lhs);
+				assign(temp2,m_rhs);
+				assign(x, vector_binary<Temporary1,Temporary2,F>(temp1,temp2, m_functor), alpha);
+			}
+		);
+	}
+	template<class VecX>
+	void plus_assign_to(vector_expression<VecX, device_category>& x, typename VecX::value_type alpha = typename VecX::value_type(1) )const{
+		typedef typename vector_temporary<E1>::type Temporary1;
+		typedef typename vector_temporary<E2>::type Temporary2;
+		system::scheduler().create_closure(
+			Temporary1(size(), uninitialized_tag()),
+			Temporary2(size(), uninitialized_tag()),
+			[this, &x, alpha](Temporary1& temp1, Temporary2& temp2){
+				assign(temp1,m_lhs);
+				assign(temp2,m_rhs);
+				plus_assign(x, vector_binary<Temporary1,Temporary2,F>(temp1,temp2, m_functor), alpha);
+			}
+		);
+	}
+
+	// Iterator types
+	typedef binary_transform_iterator<
+		typename E1::const_iterator,
+		typename E2::const_iterator,
+		F
+	> const_iterator;
+	typedef const_iterator iterator;
+
+	const_iterator begin () const {
+		return const_iterator(m_functor,
+			m_lhs.begin(),m_lhs.end(),
+			m_rhs.begin(),m_rhs.end()
+		);
+	}
+	const_iterator end() const {
+		return const_iterator(m_functor,
+			m_lhs.end(),m_lhs.end(),
+			m_rhs.end(),m_rhs.end()
+		);
+	}
+
+private:
+	expression_closure1_type m_lhs;
+	expression_closure2_type m_rhs;
+	F m_functor;
+};
+
+#define ABLAS_UNARY_VECTOR_TRANSFORMATION(name, F)\
+template<class E, class Device>\
+vector_unary<E,F<typename E::value_type> >\
+name(vector_expression<E, Device> const& e){\
+	typedef F<typename E::value_type> functor_type;\
+	return vector_unary<E, functor_type>(e(), functor_type());\
+}
+ABLAS_UNARY_VECTOR_TRANSFORMATION(exp, scalar_exp)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(log, scalar_log)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(sqrt, scalar_sqrt)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(abs, scalar_abs)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(sqr, scalar_sqr)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(tanh, scalar_tanh)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(atanh, scalar_atanh)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(sigmoid, scalar_sigmoid)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(erf, scalar_erf)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(sin, scalar_sin)
+ABLAS_UNARY_VECTOR_TRANSFORMATION(cos, scalar_cos)
+#undef ABLAS_UNARY_VECTOR_TRANSFORMATION
+
+///\brief Applies a functor with a scalar argument to every element, e.g. pow(x,2) or max(x,0) or x < 1.
+///
+/// The comparisons return vectors of 0 and 1.
+#define ABLAS_VECTOR_SCALAR_TRANSFORMATION(name, F)\
+template<class E, class T, class Device>\
+typename boost::enable_if<\
+	boost::is_convertible<T, typename E::value_type>,\
+	vector_unary<E,F<typename E::value_type,T> >\
+>::type name(vector_expression<E, Device> const& e, T t){\
+	typedef F<typename E::value_type,T> functor_type;\
+	return vector_unary<E, functor_type>(e(), functor_type(t));\
+}
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(pow, scalar_pow)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(min, scalar_min)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(max, scalar_max)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator<, scalar_less_than)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator<=, scalar_less_equal_than)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator>, scalar_bigger_than)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator>=, scalar_bigger_equal_than)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator==, scalar_equal)
+ABLAS_VECTOR_SCALAR_TRANSFORMATION(operator!=, scalar_not_equal)
+#undef ABLAS_VECTOR_SCALAR_TRANSFORMATION
+
+///\brief Combines the elements of two vectors, e.g. element_prod(x,y) or max(x,y).
+#define ABLAS_BINARY_VECTOR_TRANSFORMATION(name, F)\
+template<class E1, class E2, class Device>\
+vector_binary<E1,E2,F<typename E1::value_type, typename E2::value_type> >\
+name(vector_expression<E1, Device> const& e1, vector_expression<E2, Device> const& e2){\
+	typedef F<typename E1::value_type, typename E2::value_type> functor_type;\
+	return vector_binary<E1,E2, functor_type>(e1(),e2(), functor_type());\
+}
+ABLAS_BINARY_VECTOR_TRANSFORMATION(element_prod, scalar_binary_multiply)
+ABLAS_BINARY_VECTOR_TRANSFORMATION(element_div, scalar_binary_divide)
+ABLAS_BINARY_VECTOR_TRANSFORMATION(pow, scalar_binary_pow)
+ABLAS_BINARY_VECTOR_TRANSFORMATION(min, scalar_binary_min)
+ABLAS_BINARY_VECTOR_TRANSFORMATION(max, scalar_binary_max)
+#undef ABLAS_BINARY_VECTOR_TRANSFORMATION
+
+///\brief Divides two vectors elementwise, returning default_value where the divisor is zero.
+template<class E1, class E2, class T, class Device>
+typename boost::enable_if<
+	boost::is_convertible<T, typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type>,
+	vector_binary<E1,E2,scalar_binary_safe_divide<typename E1::value_type, typename E2::value_type> >
+>::type safe_div(
+	vector_expression<E1, Device> const& e1,
+	vector_expression<E2, Device> const& e2,
+	T default_value
+){
+	typedef scalar_binary_safe_divide<typename E1::value_type, typename E2::value_type> functor_type;
+	return vector_binary<E1,E2, functor_type>(e1(),e2(), functor_type(default_value));
+}
+
 }
 
 #endif
@@ -140,7 +140,7 @@ public:
 	///\brief Returns the pointer to the beginning of the vector storage
 	///
 	/// Low-level access to the vectors internals. Elements storage()[offset()+i*stride()] for i=1,...,size()-1 are valid
-	storage_type storage()const{
+	storage_type& storage()const{
 		return expression().storage();
 	}
 	